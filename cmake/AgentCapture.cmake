@@ -5,7 +5,6 @@
 
 add_library(capture
   fboss/agent/capture/PcapFile.cpp
-  fboss/agent/capture/PcapPkt.cpp
   fboss/agent/capture/PcapQueue.cpp
   fboss/agent/capture/PcapWriter.cpp
   fboss/agent/capture/PktCapture.cpp
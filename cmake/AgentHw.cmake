@@ -55,6 +55,10 @@ add_library(hw_resource_stats_publisher
   fboss/agent/hw/HwResourceStatsPublisher.cpp
 )
 
+add_library(sflow_exporter
+  fboss/agent/hw/SflowExporter.cpp
+)
+
 target_link_libraries(hw_switch_warmboot_helper
   async_logger
   utils
@@ -106,3 +110,14 @@ target_link_libraries(hw_resource_stats_publisher
   fb303::fb303
   hardware_stats_cpp2
 )
+
+target_link_libraries(sflow_exporter
+  error
+  fb303::fb303
+  FBThrift::thriftcpp2
+  hardware_stats_cpp2
+  sflow_cpp2
+  sflow_structs
+  state
+  Folly::folly
+)
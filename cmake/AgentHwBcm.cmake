@@ -62,7 +62,6 @@ add_library(bcm
   fboss/agent/hw/bcm/BcmRouteCounter.cpp
   fboss/agent/hw/bcm/BcmRtag7LoadBalancer.cpp
   fboss/agent/hw/bcm/BcmRtag7Module.cpp
-  fboss/agent/hw/bcm/BcmSflowExporter.cpp
   fboss/agent/hw/bcm/BcmRxPacket.cpp
   fboss/agent/hw/bcm/BcmStatUpdater.cpp
   fboss/agent/hw/bcm/BcmSwitch.cpp
@@ -102,6 +101,7 @@ target_link_libraries(bcm
   hw_switch_stats
   hw_trunk_counters
   hw_resource_stats_publisher
+  sflow_exporter
   bcm_types
   packettrace_cpp2
   buffer_stats
@@ -13,6 +13,7 @@ add_executable(api_test
     fboss/agent/hw/sai/api/tests/BridgeApiTest.cpp
     fboss/agent/hw/sai/api/tests/BufferApiTest.cpp
     fboss/agent/hw/sai/api/tests/DebugCounterApiTest.cpp
+    fboss/agent/hw/sai/api/tests/FakeSaiLatencyTest.cpp
     fboss/agent/hw/sai/api/tests/FdbApiTest.cpp
     fboss/agent/hw/sai/api/tests/HashApiTest.cpp
     fboss/agent/hw/sai/api/tests/HostifApiTest.cpp
@@ -52,3 +53,23 @@ set_target_properties(api_test PROPERTIES COMPILE_FLAGS
 )
 
 gtest_discover_tests(api_test)
+
+# Not a test, but built along with them so that the fake's scalability is
+# tracked in CI
+add_executable(fake_sai_scale_benchmark
+    fboss/agent/hw/sai/api/tests/FakeSaiScaleBenchmark.cpp
+)
+
+target_link_libraries(fake_sai_scale_benchmark
+    fake_sai
+    sai_api
+    hw_benchmark_main
+    Folly::folly
+    Folly::follybenchmark
+)
+
+set_target_properties(fake_sai_scale_benchmark PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
@@ -426,8 +426,41 @@ function(BUILD_SAI_BENCHMARKS SAI_IMPL_NAME SAI_IMPL_ARG)
 
 endfunction()
 
+# Benchmarks linked against FakeSai need no hardware or SDK, so software
+# regressions (SwSwitch, RIB, SaiStore, managers) can be tracked on any Linux
+# box. Run them with --mode=fake_wedge --config=<agent config> and use
+# --json --rusage_json_file=<file> for machine readable results.
 if(BUILD_SAI_FAKE_BENCHMARKS)
   BUILD_SAI_BENCHMARKS("fake" fake_sai)
+
+  if(BENCHMARK_INSTALL)
+    foreach(FAKE_BENCHMARK
+        sai_fsw_scale_route_add_speed
+        sai_fsw_scale_route_del_speed
+        sai_th_alpm_scale_route_add_speed
+        sai_th_alpm_scale_route_del_speed
+        sai_hgrid_du_scale_route_add_speed
+        sai_hgrid_du_scale_route_del_speed
+        sai_hgrid_uu_scale_route_add_speed
+        sai_hgrid_uu_scale_route_del_speed
+        sai_anticipated_scale_route_add_speed
+        sai_anticipated_scale_route_del_speed
+        sai_stats_collection_speed
+        sai_tx_slow_path_rate
+        sai_warm_boot_exit_speed
+        sai_ecmp_shrink_speed
+        sai_ecmp_shrink_with_competing_route_updates_speed
+        sai_rx_slow_path_rate
+        sai_init_and_exit_40Gx10G
+        sai_init_and_exit_100Gx10G
+        sai_init_and_exit_100Gx25G
+        sai_init_and_exit_100Gx50G
+        sai_init_and_exit_100Gx100G
+        sai_rib_resolution_speed
+        sai_rib_sync_fib_speed)
+      install(TARGETS ${FAKE_BENCHMARK}-fake-${SAI_VER_SUFFIX})
+    endforeach()
+  endif()
 endif()
 
 # If libsai_impl is provided, build sai tests linking with it
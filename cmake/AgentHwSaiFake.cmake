@@ -15,6 +15,7 @@ add_library(fake_sai
     fboss/agent/hw/sai/fake/FakeSaiInSegEntry.cpp
     fboss/agent/hw/sai/fake/FakeSaiInSegEntryManager.cpp
     fboss/agent/hw/sai/fake/FakeSaiLag.cpp
+    fboss/agent/hw/sai/fake/FakeSaiLatency.cpp
     fboss/agent/hw/sai/fake/FakeSaiMacsec.cpp
     fboss/agent/hw/sai/fake/FakeSaiMirror.cpp
     fboss/agent/hw/sai/fake/FakeSaiNeighbor.cpp
@@ -25,6 +25,7 @@ add_executable(store_test
     fboss/agent/hw/sai/store/tests/RouteStoreTest.cpp
     fboss/agent/hw/sai/store/tests/RouterInterfaceStoreTest.cpp
     fboss/agent/hw/sai/store/tests/SaiEmptyStoreTest.cpp
+    fboss/agent/hw/sai/store/tests/SaiObjectEventPublisherTest.cpp
     fboss/agent/hw/sai/store/tests/SamplePacketStoreTest.cpp
     fboss/agent/hw/sai/store/tests/SchedulerStoreTest.cpp
     fboss/agent/hw/sai/store/tests/TamStoreTest.cpp
@@ -46,3 +47,39 @@ set_target_properties(store_test PROPERTIES COMPILE_FLAGS
 )
 
 gtest_discover_tests(store_test)
+
+add_executable(sai_object_event_cascade_benchmark
+    fboss/agent/hw/sai/store/tests/SaiObjectEventCascadeBenchmark.cpp
+)
+
+target_link_libraries(sai_object_event_cascade_benchmark
+    sai_store
+    fake_sai
+    hw_benchmark_main
+    Folly::folly
+    Folly::follybenchmark
+)
+
+set_target_properties(sai_object_event_cascade_benchmark PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
+
+add_executable(sai_store_scale_benchmark
+    fboss/agent/hw/sai/store/tests/SaiStoreScaleBenchmark.cpp
+)
+
+target_link_libraries(sai_store_scale_benchmark
+    sai_store
+    fake_sai
+    hw_benchmark_main
+    Folly::folly
+    Folly::follybenchmark
+)
+
+set_target_properties(sai_store_scale_benchmark PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
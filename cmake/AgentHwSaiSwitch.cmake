@@ -73,6 +73,7 @@ target_link_libraries(sai_switch
   hw_cpu_fb303_stats
   hw_port_fb303_stats
   hw_resource_stats_publisher
+  sflow_exporter
   hw_switch_warmboot_helper
   mka_structs_cpp2
   sai_api
@@ -83,6 +83,33 @@ target_link_libraries(async_logger_test
 
 gtest_discover_tests(async_logger_test)
 
+add_executable(sflow_exporter_test
+  fboss/agent/test/oss/Main.cpp
+  fboss/agent/test/SflowExporterTests.cpp
+)
+
+target_link_libraries(sflow_exporter_test
+  sflow_exporter
+  Folly::folly
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(sflow_exporter_test)
+
+# Needs CAP_SYS_ADMIN to create its own network namespace
+add_executable(tun_manager_benchmark
+  fboss/agent/test/TunManagerBenchmark.cpp
+)
+
+target_link_libraries(tun_manager_benchmark
+  agent_test_utils
+  Folly::folly
+  Folly::follybenchmark
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
 add_library(agent_test_lib
   fboss/agent/test/AgentTest.cpp
 )
@@ -5,6 +5,7 @@
 
 add_library(snapshot_manager
   fboss/lib/link_snapshots/SnapshotManager.cpp
+  fboss/lib/link_snapshots/SnapshotStore.cpp
 )
 
 target_link_libraries(snapshot_manager
@@ -12,4 +13,20 @@ target_link_libraries(snapshot_manager
   fboss_cpp2
   phy_cpp2
   alert_logger
+  error
+  Folly::folly
 )
+
+add_executable(snapshot_manager_test
+  fboss/agent/test/oss/Main.cpp
+  fboss/lib/link_snapshots/tests/RingBufferTest.cpp
+  fboss/lib/link_snapshots/tests/SnapshotStoreTest.cpp
+)
+
+target_link_libraries(snapshot_manager_test
+  snapshot_manager
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(snapshot_manager_test)
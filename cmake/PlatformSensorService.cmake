@@ -32,3 +32,16 @@ target_link_libraries(sensor_service
   sensor_service_lib
   fb303::fb303
 )
+
+add_executable(sensor_service_test
+  fboss/agent/test/oss/Main.cpp
+  fboss/platform/sensor_service/tests/SensorServiceImplTest.cpp
+)
+
+target_link_libraries(sensor_service_test
+  sensor_service_lib
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(sensor_service_test)
@@ -9,6 +9,8 @@
  */
 #include "fboss/agent/ApplyThriftConfig.h"
 
+#include <fb303/ServiceData.h>
+#include <folly/Conv.h>
 #include <folly/FileUtil.h>
 #include <folly/gen/Base.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
@@ -21,6 +23,7 @@
 #include "fboss/agent/LoadBalancerConfigApplier.h"
 #include "fboss/agent/Platform.h"
 #include "fboss/agent/RouteUpdateWrapper.h"
+#include "fboss/agent/Utils.h"
 #include "fboss/agent/if/gen-cpp2/mpls_types.h"
 #include "fboss/agent/normalization/Normalizer.h"
 #include "fboss/agent/rib/RoutingInformationBase.h"
@@ -90,6 +93,8 @@ const uint8_t kV6LinkLocalAddrMask{64};
 // Needed until CoPP is removed from code and put into config
 const int kAclStartPriority = 100000;
 
+constexpr auto kConfigApplyCounterPrefix = "config_apply.";
+
 // Only one buffer pool is supported systemwide. Variable to track the name
 // and validate during a config change.
 std::optional<std::string> sharedBufferPoolName;
@@ -127,15 +132,22 @@ class ThriftConfigApplier {
       const std::shared_ptr<SwitchState>& orig,
       const cfg::SwitchConfig* config,
       const Platform* platform,
-      RoutingInformationBase* rib)
-      : orig_(orig), cfg_(config), platform_(platform), rib_(rib) {}
+      RoutingInformationBase* rib,
+      const cfg::SwitchConfig* prevConfig)
+      : orig_(orig),
+        cfg_(config),
+        prevCfg_(prevConfig),
+        platform_(platform),
+        rib_(rib) {}
   ThriftConfigApplier(
       const std::shared_ptr<SwitchState>& orig,
       const cfg::SwitchConfig* config,
       const Platform* platform,
-      RouteUpdateWrapper* routeUpdater)
+      RouteUpdateWrapper* routeUpdater,
+      const cfg::SwitchConfig* prevConfig)
       : orig_(orig),
         cfg_(config),
+        prevCfg_(prevConfig),
         platform_(platform),
         routeUpdater_(routeUpdater) {}
 
@@ -166,6 +178,41 @@ class ThriftConfigApplier {
     }
   }
 
+  /*
+   * True if any of the top level SwitchConfig fields returned by getFields
+   * differs from the config orig_ was built from (always true if that config
+   * is unknown).
+   */
+  template <typename... GetFieldFn>
+  bool configChanged(GetFieldFn&&... getFields) const {
+    return !prevCfg_ || ((getFields(*prevCfg_) != getFields(*cfg_)) || ...);
+  }
+
+  /*
+   * Run one phase of run(), exporting how long it took.
+   *
+   * When the previous config is known, a phase whose inputs did not change
+   * is skipped entirely: orig_ already reflects those inputs, so rerunning
+   * the phase would only rediscover that nothing changed. Returns true if
+   * the phase modified new_.
+   */
+  template <typename PhaseFn>
+  bool runPhase(folly::StringPiece phase, bool inputsChanged, PhaseFn&& fn) {
+    if (prevCfg_ && !inputsChanged) {
+      XLOG(DBG2) << "Config phase " << phase << " unchanged, skipping";
+      exportPhaseDuration(phase, std::chrono::duration<double, std::milli>(0));
+      return false;
+    }
+    StopWatch timer(std::nullopt, false);
+    bool changed = fn();
+    exportPhaseDuration(phase, timer.msecsElapsed());
+    return changed;
+  }
+
+  void exportPhaseDuration(
+      folly::StringPiece phase,
+      std::chrono::duration<double, std::milli> duration) const;
+
   // Interface route prefix. IPAddress has mask applied
   typedef std::pair<InterfaceID, folly::IPAddress> IntfAddress;
   typedef boost::container::flat_map<folly::CIDRNetwork, IntfAddress> IntfRoute;
@@ -359,6 +406,9 @@ class ThriftConfigApplier {
   std::shared_ptr<SwitchState> orig_;
   std::shared_ptr<SwitchState> new_;
   const cfg::SwitchConfig* cfg_{nullptr};
+  // Config that orig_ was built from, if known. Enables skipping phases
+  // whose config fields are unchanged.
+  const cfg::SwitchConfig* prevCfg_{nullptr};
   const Platform* platform_{nullptr};
   RoutingInformationBase* rib_{nullptr};
   RouteUpdateWrapper* routeUpdater_{nullptr};
@@ -382,167 +432,251 @@ class ThriftConfigApplier {
   flat_map<VlanID, VlanInterfaceInfo> vlanInterfaces_;
 };
 
+void ThriftConfigApplier::exportPhaseDuration(
+    folly::StringPiece phase,
+    std::chrono::duration<double, std::milli> duration) const {
+  auto durationMs =
+      std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+  fb303::fbData->setCounter(
+      folly::to<std::string>(kConfigApplyCounterPrefix, phase, ".duration_ms"),
+      durationMs.count());
+  XLOG(DBG2) << "Config phase " << phase << " took " << durationMs.count()
+             << "ms";
+}
+
 shared_ptr<SwitchState> ThriftConfigApplier::run() {
+  StopWatch totalTimer(std::nullopt, false);
   new_ = orig_->clone();
   bool changed = false;
 
-  {
+  // Switch settings are always processed: thrift calls like
+  // setNeighborsToBlock() override them at runtime, and a config apply has to
+  // reset those overrides even if the config itself did not change.
+  changed |= runPhase("switch_settings", true, [this]() {
     auto newSwitchSettings = updateSwitchSettings();
     if (newSwitchSettings) {
       new_->resetSwitchSettings(std::move(newSwitchSettings));
-      changed = true;
-    }
-  }
-
-  {
-    bool qcmChanged = false;
-    auto newQcmConfig = updateQcmCfg(&qcmChanged);
-    if (qcmChanged) {
-      new_->resetQcmCfg(newQcmConfig);
-      changed = true;
+      return true;
     }
-  }
+    return false;
+  });
+
+  changed |= runPhase(
+      "qcm",
+      configChanged([](auto& c) { return c.qcmConfig_ref(); }),
+      [this]() {
+        bool qcmChanged = false;
+        auto newQcmConfig = updateQcmCfg(&qcmChanged);
+        if (qcmChanged) {
+          new_->resetQcmCfg(newQcmConfig);
+        }
+        return qcmChanged;
+      });
 
-  {
-    auto newControlPlane = updateControlPlane();
-    if (newControlPlane) {
-      new_->resetControlPlane(std::move(newControlPlane));
-      changed = true;
-    }
-  }
+  changed |= runPhase(
+      "control_plane",
+      configChanged(
+          [](auto& c) { return c.cpuQueues_ref(); },
+          [](auto& c) { return c.cpuTrafficPolicy_ref(); },
+          [](auto& c) { return c.dataPlaneTrafficPolicy_ref(); },
+          [](auto& c) { return c.qosPolicies_ref(); }),
+      [this]() {
+        auto newControlPlane = updateControlPlane();
+        if (newControlPlane) {
+          new_->resetControlPlane(std::move(newControlPlane));
+          return true;
+        }
+        return false;
+      });
 
   processVlanPorts();
 
-  {
-    bool bufferPoolConfigChanged = false;
-    auto newBufferPoolCfg = updateBufferPoolConfigs(&bufferPoolConfigChanged);
-    if (bufferPoolConfigChanged) {
-      new_->resetBufferPoolCfgs(newBufferPoolCfg);
-      changed = true;
-    }
-  }
+  changed |= runPhase(
+      "buffer_pools",
+      configChanged([](auto& c) { return c.bufferPoolConfigs_ref(); }),
+      [this]() {
+        bool bufferPoolConfigChanged = false;
+        auto newBufferPoolCfg =
+            updateBufferPoolConfigs(&bufferPoolConfigChanged);
+        if (bufferPoolConfigChanged) {
+          new_->resetBufferPoolCfgs(newBufferPoolCfg);
+        }
+        return bufferPoolConfigChanged;
+      });
 
-  {
+  // Ports are always processed: besides config they are built from the
+  // TransceiverMap, which can change between config applies.
+  bool portsChanged = runPhase("ports", true, [this]() {
     auto newPorts = updatePorts(new_->getTransceivers());
     if (newPorts) {
       new_->resetPorts(std::move(newPorts));
-      changed = true;
-    }
-  }
-
-  {
-    auto newAggPorts = updateAggregatePorts();
-    if (newAggPorts) {
-      new_->resetAggregatePorts(std::move(newAggPorts));
-      changed = true;
+      return true;
     }
-  }
+    return false;
+  });
+  changed |= portsChanged;
+
+  changed |= runPhase(
+      "aggregate_ports",
+      portsChanged ||
+          configChanged(
+              [](auto& c) { return c.aggregatePorts_ref(); },
+              [](auto& c) { return c.lacp_ref(); }),
+      [this]() {
+        auto newAggPorts = updateAggregatePorts();
+        if (newAggPorts) {
+          new_->resetAggregatePorts(std::move(newAggPorts));
+          return true;
+        }
+        return false;
+      });
 
   // updateMirrors must be called after updatePorts, mirror needs ports!
-  {
-    auto newMirrors = updateMirrors();
-    if (newMirrors) {
-      new_->resetMirrors(std::move(newMirrors));
-      changed = true;
-    }
-  }
+  bool mirrorsChanged = runPhase(
+      "mirrors",
+      portsChanged ||
+          configChanged(
+              [](auto& c) { return c.mirrors_ref(); },
+              [](auto& c) { return c.interfaces_ref(); }),
+      [this]() {
+        auto newMirrors = updateMirrors();
+        if (newMirrors) {
+          new_->resetMirrors(std::move(newMirrors));
+          return true;
+        }
+        return false;
+      });
+  changed |= mirrorsChanged;
 
   // updateAcls must be called after updateMirrors, acls may need mirror!
-  {
-    if (FLAGS_enable_acl_table_group) {
-      auto newAclTableGroups = updateAclTableGroups();
-      if (newAclTableGroups) {
-        new_->resetAclTableGroups(std::move(newAclTableGroups));
-        changed = true;
-      }
-    } else {
-      auto newAcls = updateAcls(cfg::AclStage::INGRESS, *cfg_->acls_ref());
-      if (newAcls) {
-        new_->resetAcls(std::move(newAcls));
-        changed = true;
-      }
-    }
-  }
-
-  {
-    auto newQosPolicies = updateQosPolicies();
-    if (newQosPolicies) {
-      new_->resetQosPolicies(std::move(newQosPolicies));
-      changed = true;
-    }
-  }
+  changed |= runPhase(
+      "acls",
+      mirrorsChanged ||
+          configChanged(
+              [](auto& c) { return c.acls_ref(); },
+              [](auto& c) { return c.aclTableGroup_ref(); },
+              [](auto& c) { return c.cpuTrafficPolicy_ref(); },
+              [](auto& c) { return c.dataPlaneTrafficPolicy_ref(); },
+              [](auto& c) { return c.trafficCounters_ref(); }),
+      [this]() {
+        if (FLAGS_enable_acl_table_group) {
+          auto newAclTableGroups = updateAclTableGroups();
+          if (newAclTableGroups) {
+            new_->resetAclTableGroups(std::move(newAclTableGroups));
+            return true;
+          }
+        } else {
+          auto newAcls = updateAcls(cfg::AclStage::INGRESS, *cfg_->acls_ref());
+          if (newAcls) {
+            new_->resetAcls(std::move(newAcls));
+            return true;
+          }
+        }
+        return false;
+      });
 
-  // reset the default qos policy
-  {
-    auto newDefaultQosPolicy = updateDataplaneDefaultQosPolicy();
-    if (new_->getDefaultDataPlaneQosPolicy() != newDefaultQosPolicy) {
-      new_->setDefaultDataPlaneQosPolicy(newDefaultQosPolicy);
-      changed = true;
-    }
-  }
+  changed |= runPhase(
+      "qos_policies",
+      configChanged(
+          [](auto& c) { return c.qosPolicies_ref(); },
+          [](auto& c) { return c.dataPlaneTrafficPolicy_ref(); }),
+      [this]() {
+        bool qosChanged = false;
+        auto newQosPolicies = updateQosPolicies();
+        if (newQosPolicies) {
+          new_->resetQosPolicies(std::move(newQosPolicies));
+          qosChanged = true;
+        }
+        // reset the default qos policy
+        auto newDefaultQosPolicy = updateDataplaneDefaultQosPolicy();
+        if (new_->getDefaultDataPlaneQosPolicy() != newDefaultQosPolicy) {
+          new_->setDefaultDataPlaneQosPolicy(newDefaultQosPolicy);
+          qosChanged = true;
+        }
+        return qosChanged;
+      });
 
-  {
+  // Interfaces and VLANs are always processed, they populate
+  // vlanInterfaces_ and intfRouteTables_ which later phases rely on.
+  bool intfsChanged = runPhase("interfaces", true, [this]() {
     auto newIntfs = updateInterfaces();
     if (newIntfs) {
       new_->resetIntfs(std::move(newIntfs));
-      changed = true;
+      return true;
     }
-  }
+    return false;
+  });
+  changed |= intfsChanged;
 
   // Note: updateInterfaces() must be called before updateVlans(),
   // as updateInterfaces() populates the vlanInterfaces_ data structure.
-  {
+  changed |= runPhase("vlans", true, [this]() {
     auto newVlans = updateVlans();
     if (newVlans) {
       new_->resetVlans(std::move(newVlans));
-      changed = true;
+      return true;
     }
-  }
+    return false;
+  });
+
+  bool routesInputChanged = intfsChanged ||
+      configChanged(
+          [](auto& c) { return c.interfaces_ref(); },
+          [](auto& c) { return c.staticRoutesWithNhops_ref(); },
+          [](auto& c) { return c.staticRoutesToNull_ref(); },
+          [](auto& c) { return c.staticRoutesToCPU_ref(); },
+          [](auto& c) { return c.staticIp2MplsRoutes_ref(); },
+          [](auto& c) { return c.staticMplsRoutesWithNhops_ref(); },
+          [](auto& c) { return c.staticMplsRoutesToNull_ref(); },
+          [](auto& c) { return c.staticMplsRoutesToCPU_ref(); });
+  changed |= runPhase("routes", routesInputChanged, [this]() {
+    bool routesChanged = false;
+    if (routeUpdater_) {
+      routeUpdater_->setRoutesToConfig(
+          intfRouteTables_,
+          *cfg_->staticRoutesWithNhops_ref(),
+          *cfg_->staticRoutesToNull_ref(),
+          *cfg_->staticRoutesToCPU_ref(),
+          *cfg_->staticIp2MplsRoutes_ref(),
+          *cfg_->staticMplsRoutesWithNhops_ref(),
+          *cfg_->staticMplsRoutesToNull_ref(),
+          *cfg_->staticMplsRoutesToCPU_ref());
+    } else if (rib_) {
+      auto newFibs = updateForwardingInformationBaseContainers();
+      if (newFibs) {
+        new_->resetForwardingInformationBases(newFibs);
+        routesChanged = true;
+      }
 
-  if (routeUpdater_) {
-    routeUpdater_->setRoutesToConfig(
-        intfRouteTables_,
-        *cfg_->staticRoutesWithNhops_ref(),
-        *cfg_->staticRoutesToNull_ref(),
-        *cfg_->staticRoutesToCPU_ref(),
-        *cfg_->staticIp2MplsRoutes_ref(),
-        *cfg_->staticMplsRoutesWithNhops_ref(),
-        *cfg_->staticMplsRoutesToNull_ref(),
-        *cfg_->staticMplsRoutesToCPU_ref());
-  } else if (rib_) {
-    auto newFibs = updateForwardingInformationBaseContainers();
-    if (newFibs) {
-      new_->resetForwardingInformationBases(newFibs);
-      changed = true;
+      rib_->reconfigure(
+          intfRouteTables_,
+          *cfg_->staticRoutesWithNhops_ref(),
+          *cfg_->staticRoutesToNull_ref(),
+          *cfg_->staticRoutesToCPU_ref(),
+          *cfg_->staticIp2MplsRoutes_ref(),
+          *cfg_->staticMplsRoutesWithNhops_ref(),
+          *cfg_->staticMplsRoutesToNull_ref(),
+          *cfg_->staticMplsRoutesToCPU_ref(),
+          &updateFibFromConfig,
+          static_cast<void*>(&new_));
+    } else {
+      // switch state UTs don't necessary care about RIB updates
+      XLOG(WARNING)
+          << " Ignoring config updates to rib, should never happen outside of tests";
     }
 
-    rib_->reconfigure(
-        intfRouteTables_,
-        *cfg_->staticRoutesWithNhops_ref(),
-        *cfg_->staticRoutesToNull_ref(),
-        *cfg_->staticRoutesToCPU_ref(),
-        *cfg_->staticIp2MplsRoutes_ref(),
+    // resolving mpls next hops may need interfaces to be setup
+    // process static mpls routes after processing interfaces
+    auto labelFib = updateStaticMplsRoutes(
         *cfg_->staticMplsRoutesWithNhops_ref(),
         *cfg_->staticMplsRoutesToNull_ref(),
-        *cfg_->staticMplsRoutesToCPU_ref(),
-        &updateFibFromConfig,
-        static_cast<void*>(&new_));
-  } else {
-    // switch state UTs don't necessary care about RIB updates
-    XLOG(WARNING)
-        << " Ignoring config updates to rib, should never happen outside of tests";
-  }
-
-  // resolving mpls next hops may need interfaces to be setup
-  // process static mpls routes after processing interfaces
-  auto labelFib = updateStaticMplsRoutes(
-      *cfg_->staticMplsRoutesWithNhops_ref(),
-      *cfg_->staticMplsRoutesToNull_ref(),
-      *cfg_->staticMplsRoutesToNull_ref());
-  if (labelFib) {
-    new_->resetLabelForwardingInformationBase(labelFib);
-    changed = true;
-  }
+        *cfg_->staticMplsRoutesToNull_ref());
+    if (labelFib) {
+      new_->resetLabelForwardingInformationBase(labelFib);
+      routesChanged = true;
+    }
+    return routesChanged;
+  });
 
   auto newVlans = new_->getVlans();
   VlanID dfltVlan(*cfg_->defaultVlan_ref());
@@ -652,23 +786,31 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // Add sFlow collectors
-  {
-    auto newCollectors = updateSflowCollectors();
-    if (newCollectors) {
-      new_->resetSflowCollectors(std::move(newCollectors));
-      changed = true;
-    }
-  }
+  changed |= runPhase(
+      "sflow_collectors",
+      configChanged([](auto& c) { return c.sFlowCollectors_ref(); }),
+      [this]() {
+        auto newCollectors = updateSflowCollectors();
+        if (newCollectors) {
+          new_->resetSflowCollectors(std::move(newCollectors));
+          return true;
+        }
+        return false;
+      });
 
-  {
-    LoadBalancerConfigApplier loadBalancerConfigApplier(
-        orig_->getLoadBalancers(), cfg_->get_loadBalancers(), platform_);
-    auto newLoadBalancers = loadBalancerConfigApplier.updateLoadBalancers();
-    if (newLoadBalancers) {
-      new_->resetLoadBalancers(std::move(newLoadBalancers));
-      changed = true;
-    }
-  }
+  changed |= runPhase(
+      "load_balancers",
+      configChanged([](auto& c) { return c.loadBalancers_ref(); }),
+      [this]() {
+        LoadBalancerConfigApplier loadBalancerConfigApplier(
+            orig_->getLoadBalancers(), cfg_->get_loadBalancers(), platform_);
+        auto newLoadBalancers = loadBalancerConfigApplier.updateLoadBalancers();
+        if (newLoadBalancers) {
+          new_->resetLoadBalancers(std::move(newLoadBalancers));
+          return true;
+        }
+        return false;
+      });
 
   // normalizer to refresh counter tags
   if (auto normalizer = Normalizer::getInstance()) {
@@ -678,6 +820,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
         << "Normalizer failed to initialize, skipping loading counter tags";
   }
 
+  exportPhaseDuration("total", totalTimer.msecsElapsed());
   if (!changed) {
     return nullptr;
   }
@@ -3451,17 +3594,19 @@ shared_ptr<SwitchState> applyThriftConfig(
     const shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RoutingInformationBase* rib) {
-  cfg::SwitchConfig emptyConfig;
-  return ThriftConfigApplier(state, config, platform, rib).run();
+    RoutingInformationBase* rib,
+    const cfg::SwitchConfig* prevConfig) {
+  return ThriftConfigApplier(state, config, platform, rib, prevConfig).run();
 }
 shared_ptr<SwitchState> applyThriftConfig(
     const shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RouteUpdateWrapper* routeUpdater) {
-  cfg::SwitchConfig emptyConfig;
-  return ThriftConfigApplier(state, config, platform, routeUpdater).run();
+    RouteUpdateWrapper* routeUpdater,
+    const cfg::SwitchConfig* prevConfig) {
+  return ThriftConfigApplier(
+             state, config, platform, routeUpdater, prevConfig)
+      .run();
 }
 
 } // namespace facebook::fboss
@@ -29,16 +29,22 @@ class RouteUpdateWrapper;
  *
  * Returns a new SwitchState object with the resulting state, or null if
  * the config file results in no changes.
+ *
+ * If prevConfig is set, it must be the config that state was last built
+ * from. Parts of the state whose config fields are identical in prevConfig
+ * and config are then left untouched instead of being rebuilt and compared.
  */
 std::shared_ptr<SwitchState> applyThriftConfig(
     const std::shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RoutingInformationBase* rib = nullptr);
+    RoutingInformationBase* rib = nullptr,
+    const cfg::SwitchConfig* prevConfig = nullptr);
 
 std::shared_ptr<SwitchState> applyThriftConfig(
     const std::shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RouteUpdateWrapper* routeUpdater);
+    RouteUpdateWrapper* routeUpdater,
+    const cfg::SwitchConfig* prevConfig = nullptr);
 } // namespace facebook::fboss
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/AsyncStateObserver.h"
+
+#include <fb303/ServiceData.h>
+#include <folly/Conv.h>
+#include <folly/logging/xlog.h>
+
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/state/SwitchState.h"
+
+namespace facebook::fboss {
+
+using std::chrono::duration_cast;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+AsyncStateObserver::AsyncStateObserver(const std::string& name)
+    : name_(name),
+      ownedThread_(std::make_unique<folly::ScopedEventBaseThread>(name)),
+      evb_(ownedThread_->getEventBase()),
+      core_(std::make_shared<Core>()) {
+  core_->observer = this;
+}
+
+AsyncStateObserver::AsyncStateObserver(
+    const std::string& name,
+    folly::EventBase* evb)
+    : name_(name), evb_(evb), core_(std::make_shared<Core>()) {
+  DCHECK(evb) << "NULL pointer to EventBase";
+  core_->observer = this;
+}
+
+AsyncStateObserver::~AsyncStateObserver() {
+  stopAsyncProcessing();
+  // Joins the owned thread, if any, after draining callbacks which are
+  // no-ops at this point.
+  ownedThread_.reset();
+}
+
+void AsyncStateObserver::stopAsyncProcessing() {
+  std::lock_guard<std::mutex> guard(core_->processingLock);
+  core_->observer = nullptr;
+}
+
+void AsyncStateObserver::stateUpdated(const StateDelta& delta) {
+  bool schedule = false;
+  {
+    std::lock_guard<std::mutex> guard(core_->pendingLock);
+    if (!core_->newState) {
+      core_->oldState = delta.oldState();
+      core_->firstQueued = steady_clock::now();
+    }
+    core_->newState = delta.newState();
+    ++core_->numCoalesced;
+    if (!core_->scheduled) {
+      core_->scheduled = true;
+      schedule = true;
+    }
+  }
+  if (schedule) {
+    auto core = core_;
+    evb_->runInEventBaseThread([core]() { processPending(core); });
+  }
+}
+
+void AsyncStateObserver::processPending(const std::shared_ptr<Core>& core) {
+  // Keep going until nothing is pending, updates that arrive while we
+  // process are picked up by the next iteration rather than a new callback.
+  while (true) {
+    std::shared_ptr<SwitchState> oldState;
+    std::shared_ptr<SwitchState> newState;
+    uint64_t numCoalesced;
+    steady_clock::time_point firstQueued;
+    {
+      std::lock_guard<std::mutex> guard(core->pendingLock);
+      if (!core->newState) {
+        core->scheduled = false;
+        return;
+      }
+      oldState.swap(core->oldState);
+      newState.swap(core->newState);
+      numCoalesced = core->numCoalesced;
+      core->numCoalesced = 0;
+      firstQueued = core->firstQueued;
+    }
+
+    std::lock_guard<std::mutex> guard(core->processingLock);
+    auto observer = core->observer;
+    if (!observer) {
+      // Stopped, drop what was queued
+      continue;
+    }
+    auto start = steady_clock::now();
+    try {
+      observer->stateUpdatedAsync(StateDelta(oldState, newState));
+    } catch (const std::exception& ex) {
+      // Same policy as synchronous observers in SwSwitch
+      XLOG(FATAL) << "error notifying " << observer->getObserverName()
+                  << " of update: " << folly::exceptionStr(ex);
+    }
+    observer->exportCounters(
+        numCoalesced, start - firstQueued, steady_clock::now() - start);
+  }
+}
+
+void AsyncStateObserver::exportCounters(
+    uint64_t numCoalesced,
+    steady_clock::duration lag,
+    steady_clock::duration processing) const {
+  fb303::fbData->setCounter(
+      folly::to<std::string>(name_, ".async_observer.coalesced_updates"),
+      numCoalesced);
+  fb303::fbData->setCounter(
+      folly::to<std::string>(name_, ".async_observer.lag_ms"),
+      duration_cast<milliseconds>(lag).count());
+  fb303::fbData->setCounter(
+      folly::to<std::string>(name_, ".async_observer.processing_ms"),
+      duration_cast<milliseconds>(processing).count());
+}
+
+} // namespace facebook::fboss
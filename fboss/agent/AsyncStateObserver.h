@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/io/async/EventBase.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
+
+#include "fboss/agent/StateObserver.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace facebook::fboss {
+
+class SwitchState;
+
+/*
+ * A StateObserver that processes state updates off the update thread.
+ *
+ * stateUpdated() is called on the update thread as usual, but only records
+ * the update. Processing happens in stateUpdatedAsync() on the observer's
+ * own EventBase, either one passed in or a dedicated thread owned by the
+ * observer. If several updates arrive while the observer is busy, they are
+ * coalesced and stateUpdatedAsync() sees a single delta from the oldest
+ * unprocessed state to the latest one. Observers that need to see every
+ * intermediate state must stay synchronous.
+ *
+ * Per observer fb303 counters:
+ *  - <name>.async_observer.coalesced_updates: updates folded into the last
+ *    processed delta
+ *  - <name>.async_observer.lag_ms: time from the oldest folded update being
+ *    published to its processing starting
+ *  - <name>.async_observer.processing_ms: time spent in stateUpdatedAsync()
+ *
+ * Subclasses must call stopAsyncProcessing() in their destructor, before
+ * any state used by stateUpdatedAsync() is torn down.
+ */
+class AsyncStateObserver : public StateObserver {
+ public:
+  // Process updates on a dedicated thread owned by this observer
+  explicit AsyncStateObserver(const std::string& name);
+  // Process updates on evb, which must outlive this observer
+  AsyncStateObserver(const std::string& name, folly::EventBase* evb);
+  ~AsyncStateObserver() override;
+
+  void stateUpdated(const StateDelta& delta) override;
+
+  /*
+   * Called on the observer's EventBase with the coalesced delta.
+   */
+  virtual void stateUpdatedAsync(const StateDelta& delta) = 0;
+
+  /*
+   * Stop processing updates. Blocks until an in progress
+   * stateUpdatedAsync() call completes, updates still queued are dropped.
+   */
+  void stopAsyncProcessing();
+
+  const std::string& getObserverName() const {
+    return name_;
+  }
+
+ private:
+  // Shared with callbacks scheduled on evb_, so that callbacks which run
+  // after the observer is gone become no-ops.
+  struct Core {
+    std::mutex pendingLock;
+    std::shared_ptr<SwitchState> oldState;
+    std::shared_ptr<SwitchState> newState;
+    uint64_t numCoalesced{0};
+    std::chrono::steady_clock::time_point firstQueued;
+    bool scheduled{false};
+
+    // Held while processing, observer is reset to null on stop
+    std::mutex processingLock;
+    AsyncStateObserver* observer{nullptr};
+  };
+
+  static void processPending(const std::shared_ptr<Core>& core);
+  void exportCounters(
+      uint64_t numCoalesced,
+      std::chrono::steady_clock::duration lag,
+      std::chrono::steady_clock::duration processing) const;
+
+  const std::string name_;
+  std::unique_ptr<folly::ScopedEventBaseThread> ownedThread_;
+  folly::EventBase* evb_{nullptr};
+  std::shared_ptr<Core> core_;
+};
+
+} // namespace facebook::fboss
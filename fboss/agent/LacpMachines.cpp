@@ -15,6 +15,7 @@
 
 #include <folly/Conv.h>
 #include <folly/ExceptionString.h>
+#include <folly/io/async/EventBaseLocal.h>
 #include <folly/logging/xlog.h>
 #include <algorithm>
 #include <exception>
@@ -405,12 +406,143 @@ void ReceiveMachine::restoreState(AggregatePort::PartnerState partnerState) {
 const std::chrono::seconds PeriodicTransmissionMachine::SHORT_PERIOD(1);
 const std::chrono::seconds PeriodicTransmissionMachine::LONG_PERIOD(30);
 
+const std::chrono::milliseconds PeriodicTransmissionScheduler::TICK_SLACK(
+    500);
+
+PeriodicTransmissionScheduler::PeriodicTransmissionScheduler(
+    folly::EventBase* evb)
+    : folly::AsyncTimeout(evb) {}
+
+PeriodicTransmissionScheduler::~PeriodicTransmissionScheduler() {}
+
+PeriodicTransmissionScheduler& PeriodicTransmissionScheduler::get(
+    folly::EventBase* evb) {
+  static folly::EventBaseLocal<PeriodicTransmissionScheduler> schedulers;
+  return schedulers.getOrCreate(*evb, evb);
+}
+
+void PeriodicTransmissionScheduler::schedule(
+    PeriodicTransmissionMachine* machine,
+    std::chrono::steady_clock::time_point due) {
+  due_[machine] = due;
+  // While servicing a tick, the timer is set once all machines are done
+  if (!batching_ && (!isScheduled() || due < nextTick_)) {
+    scheduleTick(due);
+  }
+}
+
+void PeriodicTransmissionScheduler::scheduleTick(
+    std::chrono::steady_clock::time_point tick) {
+  nextTick_ = tick;
+  if (clock_) {
+    // Whoever set the clock calls tick()
+    return;
+  }
+  auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(
+      tick - std::chrono::steady_clock::now());
+  scheduleTimeout(std::max(delay, std::chrono::milliseconds(0)));
+}
+
+void PeriodicTransmissionScheduler::setClock(Clock clock) {
+  cancelTimeout();
+  clock_ = std::move(clock);
+}
+
+std::chrono::steady_clock::time_point PeriodicTransmissionScheduler::now()
+    const {
+  return clock_ ? clock_() : std::chrono::steady_clock::now();
+}
+
+void PeriodicTransmissionScheduler::cancel(
+    PeriodicTransmissionMachine* machine) {
+  due_.erase(machine);
+  if (due_.empty()) {
+    cancelTimeout();
+  }
+}
+
+bool PeriodicTransmissionScheduler::enqueue(
+    LacpServicerIf* servicer,
+    PortID portID,
+    LACPDU lacpdu) {
+  if (!batching_) {
+    return false;
+  }
+  auto it = std::find_if(
+      batches_.begin(), batches_.end(), [servicer](const auto& batch) {
+        return batch.first == servicer;
+      });
+  if (it == batches_.end()) {
+    it = batches_.emplace(batches_.end(), servicer, Batch());
+  }
+  it->second.emplace_back(portID, std::move(lacpdu));
+  return true;
+}
+
+void PeriodicTransmissionScheduler::timeoutExpired() noexcept {
+  tick();
+}
+
+void PeriodicTransmissionScheduler::tick() {
+  auto deadline = now() + TICK_SLACK;
+
+  // Machines reschedule themselves as they expire, collect them first
+  std::vector<PeriodicTransmissionMachine*> expired;
+  for (const auto& [machine, due] : due_) {
+    if (due <= deadline) {
+      expired.push_back(machine);
+    }
+  }
+  for (auto machine : expired) {
+    due_.erase(machine);
+  }
+
+  batching_ = true;
+  for (auto machine : expired) {
+    machine->periodExpired();
+  }
+  batching_ = false;
+  flush();
+
+  // Sleep until the earliest machine is due, which is a whole LONG_PERIOD
+  // away when only slow machines are left
+  if (!due_.empty()) {
+    auto earliest = std::min_element(
+        due_.begin(), due_.end(), [](const auto& lhs, const auto& rhs) {
+          return lhs.second < rhs.second;
+        });
+    scheduleTick(earliest->second);
+  }
+}
+
+void PeriodicTransmissionScheduler::flush() {
+  for (auto& [servicer, batch] : batches_) {
+    auto numLacpdus = batch.size();
+    auto transmitted = servicer->transmitBatch(std::move(batch));
+    XLOG_IF(DBG4, transmitted != numLacpdus)
+        << "PeriodicTransmissionScheduler: transmitted " << transmitted
+        << " of " << numLacpdus << " LACPDUs";
+  }
+  batches_.clear();
+}
+
 PeriodicTransmissionMachine::PeriodicTransmissionMachine(
     LacpController& controller,
     folly::EventBase* evb)
-    : folly::AsyncTimeout(evb), controller_(controller) {}
+    : controller_(controller), evb_(evb) {}
+
+PeriodicTransmissionMachine::~PeriodicTransmissionMachine() {
+  // Machines are stopped on the LACP EventBase before being destroyed, only
+  // touch the scheduler, on its thread, if that did not happen
+  if (scheduled_) {
+    evb_->runImmediatelyOrRunInEventBaseThreadAndWait(
+        [this]() { scheduler().cancel(this); });
+  }
+}
 
-PeriodicTransmissionMachine::~PeriodicTransmissionMachine() {}
+PeriodicTransmissionScheduler& PeriodicTransmissionMachine::scheduler() {
+  return PeriodicTransmissionScheduler::get(evb_);
+}
 
 void PeriodicTransmissionMachine::start() {
   state_ = determineTransmissionRate();
@@ -418,7 +550,8 @@ void PeriodicTransmissionMachine::start() {
 }
 
 void PeriodicTransmissionMachine::stop() {
-  cancelTimeout();
+  scheduler().cancel(this);
+  scheduled_ = false;
 }
 
 void PeriodicTransmissionMachine::portUp() {
@@ -432,20 +565,23 @@ void PeriodicTransmissionMachine::portUp() {
 void PeriodicTransmissionMachine::portDown() {
   CHECK(controller_.evb()->inRunningEventBaseThread());
 
-  cancelTimeout();
+  stop();
 }
 
 void PeriodicTransmissionMachine::beginNextPeriod() {
+  auto now = scheduler().now();
   switch (state_) {
     case PeriodicState::SLOW:
       XLOG(DBG4) << "PeriodicTransmissionMachine[" << controller_.portID()
                  << "]: scheduling timeout for long period";
-      scheduleTimeout(LONG_PERIOD);
+      scheduler().schedule(this, now + LONG_PERIOD);
+      scheduled_ = true;
       break;
     case PeriodicState::FAST:
       XLOG(DBG4) << "PeriodicTransmissionMachine[" << controller_.portID()
                  << "]: scheduling timeout for short period";
-      scheduleTimeout(SHORT_PERIOD);
+      scheduler().schedule(this, now + SHORT_PERIOD);
+      scheduled_ = true;
       break;
     case PeriodicState::NONE:
       XLOG(DBG4) << "PeriodicTransmissionMachine[" << controller_.portID()
@@ -457,11 +593,12 @@ void PeriodicTransmissionMachine::beginNextPeriod() {
   }
 }
 
-void PeriodicTransmissionMachine::timeoutExpired() noexcept {
+void PeriodicTransmissionMachine::periodExpired() noexcept {
   try {
     XLOG(DBG4) << "PeriodicTransmissionMachine[" << controller_.portID()
                << "]: end of period";
 
+    scheduled_ = false;
     state_ = PeriodicState::TX;
 
     controller_.ntt();
@@ -472,7 +609,7 @@ void PeriodicTransmissionMachine::timeoutExpired() noexcept {
   } catch (...) {
     std::exception_ptr e = std::current_exception();
     CHECK(e);
-    XLOG(FATAL) << "PeriodicTranmissionMachine::timeoutExpired(): "
+    XLOG(FATAL) << "PeriodicTranmissionMachine::periodExpired(): "
                 << folly::exceptionStr(e);
   }
 }
@@ -533,7 +670,11 @@ void TransmitMachine::ntt(LACPDU lacpdu) {
   }
 
   auto outPort = controller_.portID();
-  if (!servicer_->transmit(lacpdu, outPort)) {
+  // Periodic transmissions are batched across ports and transmitted once
+  // all ports due have been serviced
+  auto& scheduler = PeriodicTransmissionScheduler::get(controller_.evb());
+  if (!scheduler.enqueue(servicer_, outPort, lacpdu) &&
+      !servicer_->transmit(lacpdu, outPort)) {
     return;
   }
 
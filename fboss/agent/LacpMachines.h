@@ -10,7 +10,11 @@
 #pragma once
 
 #include <folly/io/async/AsyncTimeout.h>
+#include <chrono>
+#include <functional>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include <boost/container/flat_map.hpp>
 
@@ -98,12 +102,72 @@ class ReceiveMachine : private folly::AsyncTimeout {
 void toAppend(ReceiveMachine::ReceiveState state, std::string* result);
 std::ostream& operator<<(std::ostream& out, ReceiveMachine::ReceiveState s);
 
-class PeriodicTransmissionMachine : private folly::AsyncTimeout {
+class PeriodicTransmissionMachine;
+
+/*
+ * Drives the PeriodicTransmissionMachines of all ports on an EventBase off a
+ * single timer, instead of each port waking up on a timer of its own. The
+ * timer fires when the earliest machine is due, and all the LACPDUs due then
+ * are handed to their servicer in one batch.
+ *
+ * There is one scheduler per EventBase, only accessed from its thread.
+ */
+class PeriodicTransmissionScheduler : private folly::AsyncTimeout {
+ public:
+  explicit PeriodicTransmissionScheduler(folly::EventBase* evb);
+  ~PeriodicTransmissionScheduler() override;
+
+  static PeriodicTransmissionScheduler& get(folly::EventBase* evb);
+
+  void schedule(
+      PeriodicTransmissionMachine* machine,
+      std::chrono::steady_clock::time_point due);
+  void cancel(PeriodicTransmissionMachine* machine);
+
+  /*
+   * Returns false if LACPDUs are not being batched right now, in which case
+   * the caller should transmit on its own.
+   */
+  bool enqueue(LacpServicerIf* servicer, PortID portID, LACPDU lacpdu);
+
+  /*
+   * Tests replace the clock with one of their own and call tick() instead
+   * of waiting on the timer, which is then never armed.
+   */
+  using Clock = std::function<std::chrono::steady_clock::time_point()>;
+  void setClock(Clock clock);
+  std::chrono::steady_clock::time_point now() const;
+
+  // Services all machines due by now()
+  void tick();
+
+  // Machines due this close ahead of their deadline are serviced early
+  // rather than a whole tick late
+  static const std::chrono::milliseconds TICK_SLACK;
+
+ private:
+  void timeoutExpired() noexcept override;
+  void flush();
+  void scheduleTick(std::chrono::steady_clock::time_point tick);
+
+  boost::container::flat_map<
+      PeriodicTransmissionMachine*,
+      std::chrono::steady_clock::time_point>
+      due_;
+  using Batch = std::vector<std::pair<PortID, LACPDU>>;
+  std::vector<std::pair<LacpServicerIf*, Batch>> batches_;
+  bool batching_{false};
+  // When the timer fires, if it is scheduled
+  std::chrono::steady_clock::time_point nextTick_;
+  Clock clock_;
+};
+
+class PeriodicTransmissionMachine {
  public:
   explicit PeriodicTransmissionMachine(
       LacpController& controller,
       folly::EventBase* evb);
-  ~PeriodicTransmissionMachine() override;
+  ~PeriodicTransmissionMachine();
 
   void portUp();
   void portDown();
@@ -121,12 +185,18 @@ class PeriodicTransmissionMachine : private folly::AsyncTimeout {
       PeriodicTransmissionMachine::PeriodicState state,
       std::string* result);
 
-  void timeoutExpired() noexcept override;
+  friend class PeriodicTransmissionScheduler;
+
+  // Invoked by PeriodicTransmissionScheduler
+  void periodExpired() noexcept;
   void beginNextPeriod();
   PeriodicState determineTransmissionRate();
+  PeriodicTransmissionScheduler& scheduler();
 
   PeriodicState state_{PeriodicState::NONE};
   LacpController& controller_;
+  folly::EventBase* evb_{nullptr};
+  bool scheduled_{false};
 };
 void toAppend(
     PeriodicTransmissionMachine::PeriodicState state,
@@ -28,6 +28,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <optional>
 #include <tuple>
 #include <utility>
 
@@ -130,17 +131,34 @@ void LinkAggregationManager::handlePacket(
 void LinkAggregationManager::stateUpdated(const StateDelta& delta) {
   CHECK(sw_->getUpdateEvb()->inRunningEventBaseThread());
 
-  folly::SharedMutexWritePriority::WriteHolder writeGuard(&controllersLock_);
+  // Most deltas touch neither aggregate ports nor the oper state of their
+  // members, don't take the controllers lock for those.
+  std::optional<folly::SharedMutexWritePriority::WriteHolder> writeGuard;
+  if (delta.oldState()->getAggregatePorts() !=
+      delta.newState()->getAggregatePorts()) {
+    writeGuard.emplace(&controllersLock_);
+    DeltaFunctions::forEachChanged(
+        delta.getAggregatePortsDelta(),
+        &LinkAggregationManager::aggregatePortChanged,
+        &LinkAggregationManager::aggregatePortAdded,
+        &LinkAggregationManager::aggregatePortRemoved,
+        this);
+  }
 
-  DeltaFunctions::forEachChanged(
-      delta.getAggregatePortsDelta(),
-      &LinkAggregationManager::aggregatePortChanged,
-      &LinkAggregationManager::aggregatePortAdded,
-      &LinkAggregationManager::aggregatePortRemoved,
-      this);
+  // Controllers are only added and removed on this thread, so it is safe to
+  // look at them without the lock
+  if (portToController_.empty() ||
+      delta.oldState()->getPorts() == delta.newState()->getPorts()) {
+    return;
+  }
 
-  // Downgrade to a reader lock
-  folly::SharedMutexWritePriority::ReadHolder readGuard(std::move(writeGuard));
+  std::optional<folly::SharedMutexWritePriority::ReadHolder> readGuard;
+  if (writeGuard) {
+    // Downgrade to a reader lock
+    readGuard.emplace(std::move(*writeGuard));
+  } else {
+    readGuard.emplace(&controllersLock_);
+  }
 
   DeltaFunctions::forEachChanged(
       delta.getPortsDelta(), &LinkAggregationManager::portChanged, this);
@@ -322,6 +340,34 @@ void LinkAggregationManager::populatePartnerPairs(
 bool LinkAggregationManager::transmit(LACPDU lacpdu, PortID portID) {
   CHECK(sw_->getLacpEvb()->inRunningEventBaseThread());
 
+  auto port = sw_->getState()->getPorts()->getPortIf(portID);
+  CHECK(port);
+
+  return transmit(lacpdu, port, sw_->getPlatform()->getLocalMac());
+}
+
+size_t LinkAggregationManager::transmitBatch(
+    std::vector<std::pair<PortID, LACPDU>> lacpdus) {
+  CHECK(sw_->getLacpEvb()->inRunningEventBaseThread());
+
+  // Look up the state and CPU MAC once for all the ports due
+  auto ports = sw_->getState()->getPorts();
+  folly::MacAddress cpuMac = sw_->getPlatform()->getLocalMac();
+
+  size_t transmitted = 0;
+  for (const auto& [portID, lacpdu] : lacpdus) {
+    auto port = ports->getPortIf(portID);
+    CHECK(port);
+    // Keep going on allocation failures, the rest of the batch may still fit
+    transmitted += transmit(lacpdu, port, cpuMac);
+  }
+  return transmitted;
+}
+
+bool LinkAggregationManager::transmit(
+    const LACPDU& lacpdu,
+    const std::shared_ptr<Port>& port,
+    folly::MacAddress cpuMac) {
   auto pkt = sw_->allocatePacket(LACPDU::LENGTH);
   if (!pkt) {
     XLOG(DBG4) << "Failed to allocate tx packet for LACPDU transmission";
@@ -330,11 +376,6 @@ bool LinkAggregationManager::transmit(LACPDU lacpdu, PortID portID) {
 
   folly::io::RWPrivateCursor writer(pkt->buf());
 
-  folly::MacAddress cpuMac = sw_->getPlatform()->getLocalMac();
-
-  auto port = sw_->getState()->getPorts()->getPortIf(portID);
-  CHECK(port);
-
   TxPacket::writeEthHeader(
       &writer,
       LACPDU::kSlowProtocolsDstMac(),
@@ -348,7 +389,8 @@ bool LinkAggregationManager::transmit(LACPDU lacpdu, PortID portID) {
 
   // TODO(joseph5wu) Actually LACP should be multicast pkt, and using
   // OutOfPacket will actually send the packet to unicast queue.
-  sw_->sendNetworkControlPacketAsync(std::move(pkt), PortDescriptor(portID));
+  sw_->sendNetworkControlPacketAsync(
+      std::move(pkt), PortDescriptor(port->getID()));
 
   return true;
 }
@@ -20,6 +20,7 @@
 #include <folly/io/Cursor.h>
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace facebook::fboss {
@@ -35,6 +36,14 @@ struct LacpServicerIf {
   virtual ~LacpServicerIf() {}
 
   virtual bool transmit(LACPDU lacpdu, PortID portID) = 0;
+  // Returns the number of LACPDUs transmitted
+  virtual size_t transmitBatch(std::vector<std::pair<PortID, LACPDU>> lacpdus) {
+    size_t transmitted = 0;
+    for (auto& [portID, lacpdu] : lacpdus) {
+      transmitted += transmit(std::move(lacpdu), portID);
+    }
+    return transmitted;
+  }
   virtual void enableForwardingAndSetPartnerState(
       PortID portID,
       AggregatePortID aggPortID,
@@ -81,6 +90,7 @@ class LinkAggregationManager : public AutoRegisterStateObserver,
   void populatePartnerPairs(std::vector<LacpPartnerPair>& partnerPairs);
 
   bool transmit(LACPDU lacpdu, PortID portID) override;
+  size_t transmitBatch(std::vector<std::pair<PortID, LACPDU>> lacpdus) override;
   void enableForwardingAndSetPartnerState(
       PortID portID,
       AggregatePortID aggPortID,
@@ -112,6 +122,11 @@ class LinkAggregationManager : public AutoRegisterStateObserver,
       const std::shared_ptr<Port>& oldPort,
       const std::shared_ptr<Port>& newPort);
 
+  bool transmit(
+      const LACPDU& lacpdu,
+      const std::shared_ptr<Port>& port,
+      folly::MacAddress cpuMac);
+
   void updateAggregatePortStats(
       const std::shared_ptr<AggregatePort>& oldAggPort,
       const std::shared_ptr<AggregatePort>& newAggPort);
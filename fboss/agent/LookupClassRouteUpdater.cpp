@@ -507,12 +507,12 @@ void LookupClassRouteUpdater::processNeighborAdded(
    * classID associated with it, then assign *this* nexthop's classID.
    */
   std::vector<RidAndCidr> toBeUpdatedPrefixes;
-  std::set_difference(
-      withoutClassIDPrefixes.begin(),
-      withoutClassIDPrefixes.end(),
-      allPrefixesWithClassID_.begin(),
-      allPrefixesWithClassID_.end(),
-      std::inserter(toBeUpdatedPrefixes, toBeUpdatedPrefixes.end()));
+  for (const auto& ridAndCidr : withoutClassIDPrefixes) {
+    if (allPrefixesWithClassID_.find(ridAndCidr) ==
+        allPrefixesWithClassID_.end()) {
+      toBeUpdatedPrefixes.push_back(ridAndCidr);
+    }
+  }
 
   auto routeClassID = neighborClassID.value();
 
@@ -730,12 +730,15 @@ LookupClassRouteUpdater::addRouteAndFindClassID(
   auto& newState = stateDelta.newState();
   std::optional<cfg::AclLookupClass> routeClassID{std::nullopt};
   std::set<folly::IPAddress> neighborsWithClassId;
+  std::vector<NextHopAndVlan> nextHopsAndVlans;
   for (const auto& nextHop : addedRoute->getForwardInfo().getNextHopSet()) {
     auto vlanID =
         newState->getInterfaces()->getInterfaceIf(nextHop.intf())->getVlanID();
     if (!belongsToSubnetInCache(vlanID, nextHop.addr())) {
       continue;
     }
+    // The omitted nexthop still keeps the prefix in its withoutClassID list
+    nextHopsAndVlans.emplace_back(nextHop.addr(), vlanID);
 
     if (nextHopAndVlanToOmit.has_value()) {
       const auto& [nextHopToOmit, vlanIDToOmit] = nextHopAndVlanToOmit.value();
@@ -788,6 +791,11 @@ LookupClassRouteUpdater::addRouteAndFindClassID(
   } else {
     allPrefixesWithClassID_.erase(ridAndCidr);
   }
+  if (nextHopsAndVlans.empty()) {
+    prefix2NextHopsAndVlans_.erase(ridAndCidr);
+  } else {
+    prefix2NextHopsAndVlans_[ridAndCidr] = std::move(nextHopsAndVlans);
+  }
 
   /*
    * Update prefixesWithMultiNextHops_ to keep track of routes with multiple
@@ -827,7 +835,7 @@ void LookupClassRouteUpdater::updatePrefixesWithMultiNextHops(
 }
 
 void LookupClassRouteUpdater::removePrefixesWithMultiNextHops(
-    const std::set<RidAndCidr>& withoutClassIDPrefixes,
+    const PrefixSet& withoutClassIDPrefixes,
     const folly::IPAddress& removedNeighborIP) {
   for (const auto& ridAndCidr : withoutClassIDPrefixes) {
     if (prefixesWithMultiNextHops_.find(ridAndCidr) !=
@@ -847,7 +855,7 @@ void LookupClassRouteUpdater::removePrefixesWithMultiNextHops(
 }
 
 void LookupClassRouteUpdater::addPrefixesWithMultiNextHops(
-    const std::set<RidAndCidr>& withoutClassIDPrefixes,
+    const PrefixSet& withoutClassIDPrefixes,
     const folly::IPAddress& addedNeighborIP,
     const std::shared_ptr<SwitchState>& newState,
     VlanID vlanID) {
@@ -948,15 +956,23 @@ void LookupClassRouteUpdater::processRouteRemoved(
 
   auto routeClassID = removedRoute->getClassID();
   auto& newState = stateDelta.newState();
-  for (const auto& nextHop : removedRoute->getForwardInfo().getNextHopSet()) {
-    auto vlanID =
-        newState->getInterfaces()->getInterfaceIf(nextHop.intf())->getVlanID();
-    if (!belongsToSubnetInCache(vlanID, nextHop.addr())) {
+
+  // Walk the nexthops recorded when the route was added, rather than looking
+  // up the interface of every nexthop of the removed route again.
+  std::vector<NextHopAndVlan> nextHopsAndVlans;
+  auto nextHopsIt = prefix2NextHopsAndVlans_.find(ridAndCidr);
+  if (nextHopsIt != prefix2NextHopsAndVlans_.end()) {
+    nextHopsAndVlans = std::move(nextHopsIt->second);
+    prefix2NextHopsAndVlans_.erase(nextHopsIt);
+  }
+
+  for (const auto& [nextHopAddr, vlanID] : nextHopsAndVlans) {
+    if (!belongsToSubnetInCache(vlanID, nextHopAddr)) {
       continue;
     }
 
     auto it =
-        nextHopAndVlan2Prefixes_.find(std::make_pair(nextHop.addr(), vlanID));
+        nextHopAndVlan2Prefixes_.find(std::make_pair(nextHopAddr, vlanID));
     CHECK(it != nextHopAndVlan2Prefixes_.end());
     auto& [withClassIDPrefixes, withoutClassIDPrefixes] = it->second;
 
@@ -970,15 +986,13 @@ void LookupClassRouteUpdater::processRouteRemoved(
       // neighbor corresponding to this NextHop, erase it.
       auto vlan = newState->getVlans()->getVlanIf(vlanID);
       if (vlan) {
-        if (nextHop.addr().isV6()) {
-          auto ndpEntry =
-              vlan->getNdpTable()->getEntryIf(nextHop.addr().asV6());
+        if (nextHopAddr.isV6()) {
+          auto ndpEntry = vlan->getNdpTable()->getEntryIf(nextHopAddr.asV6());
           if (!ndpEntry) {
             nextHopAndVlan2Prefixes_.erase(it);
           }
-        } else if (nextHop.addr().isV4()) {
-          auto arpEntry =
-              vlan->getArpTable()->getEntryIf(nextHop.addr().asV4());
+        } else if (nextHopAddr.isV4()) {
+          auto arpEntry = vlan->getArpTable()->getEntryIf(nextHopAddr.asV4());
           if (!arpEntry) {
             nextHopAndVlan2Prefixes_.erase(it);
           }
@@ -34,6 +34,9 @@ class LookupClassRouteUpdater : public AutoRegisterStateObserver {
   int getNumPrefixesWithMultiNextHops() const {
     return prefixesWithMultiNextHops_.size();
   }
+  int getNumPrefixesWithNextHopsInCache() const {
+    return prefix2NextHopsAndVlans_.size();
+  }
 
  private:
   // Helper methods
@@ -159,8 +162,8 @@ class LookupClassRouteUpdater : public AutoRegisterStateObserver {
 
   using RidAndCidr = std::pair<RouterID, folly::CIDRNetwork>;
   using NextHopAndVlan = std::pair<folly::IPAddress, VlanID>;
-  using WithAndWithoutClassIDPrefixes =
-      std::pair<std::set<RidAndCidr>, std::set<RidAndCidr>>;
+  using PrefixSet = folly::F14FastSet<RidAndCidr>;
+  using WithAndWithoutClassIDPrefixes = std::pair<PrefixSet, PrefixSet>;
 
   using RouteAndClassID =
       std::pair<RidAndCidr, std::optional<cfg::AclLookupClass>>;
@@ -205,10 +208,10 @@ class LookupClassRouteUpdater : public AutoRegisterStateObserver {
       const std::set<folly::IPAddress>& neighborsWithClassId,
       const RidAndCidr& ridAndCidr);
   void removePrefixesWithMultiNextHops(
-      const std::set<RidAndCidr>& withoutClassIDPrefixes,
+      const PrefixSet& withoutClassIDPrefixes,
       const folly::IPAddress& removedNeighborIP);
   void addPrefixesWithMultiNextHops(
-      const std::set<RidAndCidr>& withoutClassIDPrefixes,
+      const PrefixSet& withoutClassIDPrefixes,
       const folly::IPAddress& addedNeighborIP,
       const std::shared_ptr<SwitchState>& newState,
       VlanID vlanID);
@@ -296,20 +299,29 @@ class LookupClassRouteUpdater : public AutoRegisterStateObserver {
    * In theory, same IP may exist in different Vlans, thus maintain IP + Vlan
    * to prefixes mapping.
    *
-   * Today, the list of subnets we need to cache is very small. Thus,
-   * std::set is good enough. In future, if we need to cache a large
-   * number of subnets, we could use Radix tree.
-   *
    * This maintains the list of prefixes that inherit classID from this
    * [nexthop, vlan] separately from the list of prefixes that don't.
+   *
+   * With large host route tables, a single nexthop may be shared by many
+   * prefixes. Both lists are hashed so that a neighbor change only touches
+   * the prefixes using that neighbor.
    */
   folly::F14FastMap<NextHopAndVlan, WithAndWithoutClassIDPrefixes>
       nextHopAndVlan2Prefixes_;
 
+  /*
+   * Prefix to [nexthop, vlan] map, the reverse of nextHopAndVlan2Prefixes_.
+   * Holds the nexthops of the prefix that belong to a cached subnet, as of
+   * when the prefix was last processed. Prefixes without such nexthops have
+   * no entry.
+   */
+  folly::F14FastMap<RidAndCidr, std::vector<NextHopAndVlan>>
+      prefix2NextHopsAndVlans_;
+
   /*
    * Set of prefixes with classID (from any [nexthop + vlan]).
    */
-  std::set<RidAndCidr> allPrefixesWithClassID_;
+  PrefixSet allPrefixesWithClassID_;
 
   /*
    * Map of prefixes with multiple nexthops associated to class IDs.
@@ -79,7 +79,7 @@ void LookupClassUpdater::removeClassIDForPortAndMac(
       return MacTableUtils::removeClassIDForEntry(state, vlan, removedEntry);
     };
 
-    sw_->updateState("remove classID: ", std::move(removeMacClassIDFn));
+    queueMacClassIDUpdate(std::move(removeMacClassIDFn));
   } else {
     auto updater = sw_->getNeighborUpdater();
     updater->updateEntryClassID(vlan, removedEntry->getIP());
@@ -195,9 +195,7 @@ void LookupClassUpdater::updateNeighborClassID(
               state, vlanID, newEntry, classID);
         };
 
-    sw_->updateState(
-        folly::to<std::string>("configure lookup classID: ", classID),
-        std::move(updateMacClassIDFn));
+    queueMacClassIDUpdate(std::move(updateMacClassIDFn));
   } else {
     auto updater = sw_->getNeighborUpdater();
     updater->updateEntryClassID(vlanID, newEntry->getIP(), classID);
@@ -343,9 +341,7 @@ void LookupClassUpdater::processChanged(
                   state, vlan, newEntry, classID);
             };
 
-        sw_->updateState(
-            folly::to<std::string>("Reconfigure lookup classID: ", classID),
-            std::move(updateMacClassIDFn));
+        queueMacClassIDUpdate(std::move(updateMacClassIDFn));
       } else {
         updateNeighborClassID(stateDelta.newState(), vlan, newEntry);
       }
@@ -404,7 +400,7 @@ void LookupClassUpdater::clearClassIdsForResolvedNeighbors(
                     state, vlanID, entry);
               };
 
-          sw_->updateState("remove classID: ", std::move(removeMacClassIDFn));
+          queueMacClassIDUpdate(std::move(removeMacClassIDFn));
         } else {
           auto updater = sw_->getNeighborUpdater();
           updater->updateEntryClassID(vlanID, entry.get()->getIP());
@@ -910,6 +906,38 @@ void LookupClassUpdater::processMacAddrsToBlockUpdates(
   }
 }
 
+void LookupClassUpdater::queueMacClassIDUpdate(
+    SwSwitch::StateUpdateFn updateFn) {
+  pendingMacClassIDUpdates_.push_back(std::move(updateFn));
+}
+
+void LookupClassUpdater::flushMacClassIDUpdates() {
+  if (pendingMacClassIDUpdates_.empty()) {
+    return;
+  }
+
+  // A batch of learned MACs is a single state delta, assign classIDs to all
+  // of them in a single state update too rather than one update per MAC.
+  auto updateFns = std::make_shared<std::vector<SwSwitch::StateUpdateFn>>(
+      std::move(pendingMacClassIDUpdates_));
+  pendingMacClassIDUpdates_.clear();
+  auto numUpdates = updateFns->size();
+  auto updateMacClassIDsFn =
+      [updateFns](const std::shared_ptr<SwitchState>& state) {
+        std::shared_ptr<SwitchState> newState{state};
+        for (auto& updateFn : *updateFns) {
+          if (auto updatedState = updateFn(newState)) {
+            newState = updatedState;
+          }
+        }
+        return newState;
+      };
+  sw_->updateState(
+      folly::to<std::string>(
+          "configure lookup classID for ", numUpdates, " MAC entries"),
+      std::move(updateMacClassIDsFn));
+}
+
 void LookupClassUpdater::stateUpdated(const StateDelta& stateDelta) {
   if (!inited_) {
     updateStateObserverLocalCache(stateDelta.newState());
@@ -920,6 +948,7 @@ void LookupClassUpdater::stateUpdated(const StateDelta& stateDelta) {
   processPortUpdates(stateDelta);
   processBlockNeighborUpdates(stateDelta);
   processMacAddrsToBlockUpdates(stateDelta);
+  flushMacClassIDUpdates();
 }
 
 } // namespace facebook::fboss
@@ -152,6 +152,13 @@ class LookupClassUpdater : public AutoRegisterStateObserver {
 
   void processMacAddrsToBlockUpdates(const StateDelta& stateDelta);
 
+  /*
+   * MAC classID changes computed while processing a state delta are queued
+   * and applied in one state update once the whole delta is processed.
+   */
+  void queueMacClassIDUpdate(SwSwitch::StateUpdateFn updateFn);
+  void flushMacClassIDUpdates();
+
   /*
    * Methods to iterate over MacTable, ArpTable or NdpTable or table deltas.
    */
@@ -160,6 +167,8 @@ class LookupClassUpdater : public AutoRegisterStateObserver {
 
   SwSwitch* sw_;
 
+  std::vector<SwSwitch::StateUpdateFn> pendingMacClassIDUpdates_;
+
   /*
    * Maintains the number of times a classID is used. When a new MAC + vlan
    * requires classID assignment, port2ClassIDAndCount_ is used to determine
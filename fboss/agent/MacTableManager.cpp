@@ -12,23 +12,61 @@
 #include "fboss/agent/L2Entry.h"
 #include "fboss/agent/MacTableUtils.h"
 #include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/state/SwitchState.h"
 
 namespace facebook::fboss {
 
-MacTableManager::MacTableManager(SwSwitch* sw) : sw_(sw) {}
+MacTableManager::MacTableManager(SwSwitch* sw)
+    : sw_(sw), pending_(std::make_shared<PendingUpdates>()) {}
 
 void MacTableManager::handleL2LearningUpdate(
     L2Entry l2Entry,
     L2EntryUpdateType l2EntryUpdateType) {
-  auto updateMacTableFn =
-      [l2Entry, l2EntryUpdateType](const std::shared_ptr<SwitchState>& state) {
-        return MacTableUtils::updateMacTable(state, l2Entry, l2EntryUpdateType);
-      };
+  pending_->queue.enqueue(L2LearningUpdate{
+      std::move(l2Entry),
+      l2EntryUpdateType,
+      std::chrono::steady_clock::now()});
+  if (!pending_->updateScheduled.exchange(true)) {
+    scheduleUpdate();
+  }
+}
+
+void MacTableManager::scheduleUpdate() {
+  // Everything queued until the update thread gets to this update is applied
+  // as one MAC table change, so a MAC move storm results in a handful of
+  // state updates rather than one per learning event.
+  auto pending = pending_;
+  auto sw = sw_;
+  auto updateMacTableFn = [pending, sw](
+                              const std::shared_ptr<SwitchState>& state)
+      -> std::shared_ptr<SwitchState> {
+    // Clear before draining, updates queued from here on either get drained
+    // below or schedule another update.
+    pending->updateScheduled.store(false);
+
+    std::shared_ptr<SwitchState> newState{state};
+    size_t numUpdates = 0;
+    std::chrono::steady_clock::time_point oldest;
+    while (auto update = pending->queue.try_dequeue()) {
+      if (numUpdates++ == 0) {
+        oldest = update->received;
+      }
+      newState = MacTableUtils::updateMacTable(
+          newState, update->l2Entry, update->l2EntryUpdateType);
+    }
+    if (numUpdates == 0) {
+      return nullptr;
+    }
+    sw->stats()->macTableUpdateBatch(
+        numUpdates,
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - oldest));
+    return newState;
+  };
 
   sw_->updateState(
-      folly::to<std::string>("Programming : ", l2Entry.str()),
-      std::move(updateMacTableFn));
+      "Programming L2 learning updates", std::move(updateMacTableFn));
 }
 
 } // namespace facebook::fboss
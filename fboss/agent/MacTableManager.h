@@ -11,6 +11,12 @@
 
 #include "fboss/agent/L2Entry.h"
 
+#include <folly/concurrency/UnboundedQueue.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
 namespace facebook::fboss {
 
 class SwSwitch;
@@ -19,16 +25,40 @@ class MacTableManager {
  public:
   explicit MacTableManager(SwSwitch* sw);
 
+  /*
+   * Called from the HwSwitch's learning callback. Updates are queued and
+   * applied to the MAC tables in batches, see scheduleUpdate().
+   */
   void handleL2LearningUpdate(
       L2Entry l2Entry,
       L2EntryUpdateType l2EntryUpdateType);
 
  private:
+  struct L2LearningUpdate {
+    L2Entry l2Entry;
+    L2EntryUpdateType l2EntryUpdateType;
+    std::chrono::steady_clock::time_point received;
+  };
+
+  /*
+   * Learning updates not yet applied. Shared with the queued state update.
+   * Producers (learning callbacks, possibly from several SDK threads) never
+   * block, the only consumer is the state update on the update thread.
+   */
+  struct PendingUpdates {
+    folly::UMPSCQueue<L2LearningUpdate, false /* MayBlock */> queue;
+    // Set while a state update which will drain the queue is scheduled
+    std::atomic<bool> updateScheduled{false};
+  };
+
+  void scheduleUpdate();
+
   // Forbidden copy constructor and assignment operator
   MacTableManager(MacTableManager const&) = delete;
   MacTableManager& operator=(MacTableManager const&) = delete;
 
   SwSwitch* sw_{nullptr};
+  std::shared_ptr<PendingUpdates> pending_;
 };
 
 } // namespace facebook::fboss
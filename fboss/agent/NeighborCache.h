@@ -18,6 +18,7 @@
 #include <folly/MacAddress.h>
 #include <folly/Memory.h>
 #include <folly/io/async/EventBase.h>
+#include <folly/io/async/HHWheelTimer.h>
 #include <folly/logging/xlog.h>
 #include <chrono>
 #include <list>
@@ -117,6 +118,9 @@ class NeighborCache {
         timeout_(timeout),
         maxNeighborProbes_(maxNeighborProbes),
         staleEntryInterval_(staleEntryInterval),
+        timer_(folly::HHWheelTimer::newTimer(
+            sw->getNeighborCacheEvb(),
+            kTimerTickInterval)),
         impl_(std::make_unique<NeighborCacheImpl<NTable>>(
             this,
             sw,
@@ -190,6 +194,14 @@ class NeighborCache {
   }
 
  private:
+  // Granularity of entry timeouts. Entries expiring within the same tick are
+  // processed in one pass over the timer wheel.
+  static constexpr std::chrono::milliseconds kTimerTickInterval{10};
+
+  folly::HHWheelTimer* getTimer() const {
+    return timer_.get();
+  }
+
   // This should only be called by a NeighborCacheEntry
   virtual void checkReachability(
       AddressType /*targetIP*/,
@@ -228,6 +240,9 @@ class NeighborCache {
   std::chrono::seconds timeout_;
   uint32_t maxNeighborProbes_{0};
   std::chrono::seconds staleEntryInterval_;
+  // Drives the timeouts of all entries. Declared before impl_ so that the
+  // entries, which unlink themselves from it, are destroyed first.
+  folly::HHWheelTimer::UniquePtr timer_;
   std::unique_ptr<NeighborCacheImpl<NTable>> impl_;
   std::mutex cacheLock_;
 };
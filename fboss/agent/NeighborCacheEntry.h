@@ -19,6 +19,7 @@
 #include <folly/IPAddress.h>
 #include <folly/MacAddress.h>
 #include <folly/Random.h>
+#include <folly/io/async/HHWheelTimer.h>
 #include <chrono>
 
 /**
@@ -56,6 +57,11 @@
  * next update is scheduled. If the entry ever transitions to the EXPIRED state,
  * we do not schedule another update and the cache will flush the entry.
  *
+ * Timeouts are scheduled on the timer wheel of the owning NeighborCache rather
+ * than as individual event base timers: entries are linked into the wheel
+ * intrusively, so (re)scheduling is O(1) and all entries expiring in the same
+ * tick are processed together.
+ *
  * There is no locking in this class. Instead, the class relies on the
  * synchronization provided by NeighborCache, which should lock around all calls
  * into the cache with a single cache level lock. This class should take care
@@ -78,7 +84,7 @@ template <typename NTable>
 class NeighborCache;
 
 template <typename NTable>
-class NeighborCacheEntry : private folly::AsyncTimeout {
+class NeighborCacheEntry : private folly::HHWheelTimer::Callback {
  public:
   typedef typename NTable::Entry::AddressType AddressType;
   typedef NeighborCache<NTable> Cache;
@@ -89,8 +95,7 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
       folly::EventBase* evb,
       Cache* cache,
       NeighborEntryState state)
-      : AsyncTimeout(evb),
-        fields_(fields),
+      : fields_(fields),
         cache_(cache),
         evb_(evb),
         probesLeft_(cache_->getMaxNeighborProbes()) {
@@ -233,6 +238,16 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
     cache_->processEntry(getIP());
   }
 
+  /*
+   * Only called when the timer wheel itself is destroyed, i.e. the cache is
+   * going away. Nothing to process then.
+   */
+  void callbackCanceled() noexcept override {}
+
+  void scheduleTimeout(std::chrono::milliseconds timeout) {
+    cache_->getTimer()->scheduleTimeout(this, timeout);
+  }
+
   /*
    * Schedules an update on the evb_. This is done synchronously so that we
    * can have a destructor guard around both running the state machine and
@@ -18,6 +18,7 @@
 #include "fboss/agent/ArpHandler.h"
 #include "fboss/agent/IPv6Handler.h"
 #include "fboss/agent/NeighborCacheImpl.h"
+#include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/state/ArpTable.h"
 #include "fboss/agent/state/NdpTable.h"
 #include "fboss/agent/state/NeighborEntry.h"
@@ -61,87 +62,149 @@ bool checkVlanAndIntf(
 } // namespace ncachehelpers
 
 template <typename NTable>
-void NeighborCacheImpl<NTable>::programEntry(Entry* entry) {
-  CHECK(!entry->isPending());
+bool NeighborCacheImpl<NTable>::programEntryInState(
+    std::shared_ptr<SwitchState>* state,
+    VlanID vlanID,
+    const EntryFields& fields) {
+  if (!ncachehelpers::checkVlanAndIntf<NTable>(*state, fields, vlanID)) {
+    // Either the vlan or intf is no longer valid.
+    return false;
+  }
 
-  auto fields = entry->getFields();
-  auto vlanID = vlanID_;
-  auto updateFn = [fields, vlanID](const std::shared_ptr<SwitchState>& state)
-      -> std::shared_ptr<SwitchState> {
-    if (!ncachehelpers::checkVlanAndIntf<NTable>(state, fields, vlanID)) {
-      // Either the vlan or intf is no longer valid.
-      return nullptr;
+  auto vlan = (*state)->getVlans()->getVlanIf(vlanID).get();
+  auto* table = vlan->template getNeighborTable<NTable>().get();
+  auto node = table->getNodeIf(fields.ip);
+
+  if (!node) {
+    table = table->modify(&vlan, state);
+    table->addEntry(fields);
+    XLOG(DBG2) << "Adding entry for " << fields.ip << " --> " << fields.mac
+               << " on interface " << fields.interfaceID << " for vlan "
+               << vlanID;
+  } else {
+    if (node->getMac() == fields.mac && node->getPort() == fields.port &&
+        node->getIntfID() == fields.interfaceID &&
+        node->getState() == fields.state && !node->isPending()) {
+      // This entry was already updated while we were waiting on the lock.
+      return false;
     }
+    table = table->modify(&vlan, state);
+    table->updateEntry(fields);
+    XLOG(DBG2) << "Converting pending entry for " << fields.ip << " --> "
+               << fields.mac << " on interface " << fields.interfaceID
+               << " for vlan " << vlanID;
+  }
+  return true;
+}
 
-    auto vlan = state->getVlans()->getVlanIf(vlanID).get();
-    std::shared_ptr<SwitchState> newState{state};
-    auto* table = vlan->template getNeighborTable<NTable>().get();
-    auto node = table->getNodeIf(fields.ip);
-
-    if (!node) {
-      table = table->modify(&vlan, &newState);
-      table->addEntry(fields);
-      XLOG(DBG2) << "Adding entry for " << fields.ip << " --> " << fields.mac
-                 << " on interface " << fields.interfaceID << " for vlan "
-                 << vlanID;
-    } else {
-      if (node->getMac() == fields.mac && node->getPort() == fields.port &&
-          node->getIntfID() == fields.interfaceID &&
-          node->getState() == fields.state && !node->isPending()) {
-        // This entry was already updated while we were waiting on the lock.
-        return nullptr;
-      }
-      table = table->modify(&vlan, &newState);
-      table->updateEntry(fields);
-      XLOG(DBG2) << "Converting pending entry for " << fields.ip << " --> "
-                 << fields.mac << " on interface " << fields.interfaceID
-                 << " for vlan " << vlanID;
-    }
-    return newState;
-  };
+template <typename NTable>
+bool NeighborCacheImpl<NTable>::programPendingEntryInState(
+    std::shared_ptr<SwitchState>* state,
+    VlanID vlanID,
+    const EntryFields& fields,
+    bool force) {
+  if (!ncachehelpers::checkVlanAndIntf<NTable>(*state, fields, vlanID)) {
+    // Either the vlan or intf is no longer valid.
+    return false;
+  }
+
+  auto vlan = (*state)->getVlans()->getVlanIf(vlanID).get();
+  auto* table = vlan->template getNeighborTable<NTable>().get();
+  auto node = table->getNodeIf(fields.ip);
+  if (node && !force) {
+    // don't replace an existing entry with a pending one unless
+    // explicitly allowed
+    return false;
+  }
+
+  table = table->modify(&vlan, state);
+  if (node) {
+    table->removeEntry(fields.ip);
+  }
+  table->addPendingEntry(fields.ip, fields.interfaceID);
 
-  sw_->updateState(
-      folly::to<std::string>("add neighbor ", fields.ip), std::move(updateFn));
+  XLOG(DBG4) << "Adding pending entry for " << fields.ip << " on interface "
+             << fields.interfaceID << " for vlan " << vlanID;
+  return true;
+}
+
+template <typename NTable>
+void NeighborCacheImpl<NTable>::programEntry(Entry* entry) {
+  CHECK(!entry->isPending());
+  queueUpdate({PendingUpdate::Type::PROGRAM, entry->getFields()});
 }
 
 template <typename NTable>
 void NeighborCacheImpl<NTable>::programPendingEntry(Entry* entry, bool force) {
   CHECK(entry->isPending());
+  queueUpdate(
+      {PendingUpdate::Type::PROGRAM_PENDING, entry->getFields(), force});
+}
 
-  auto fields = entry->getFields();
+template <typename NTable>
+void NeighborCacheImpl<NTable>::queueUpdate(PendingUpdate update) {
+  auto type = update.type;
+  {
+    std::lock_guard<std::mutex> g(pendingBatch_->lock);
+    auto& updates = pendingBatch_->updates;
+    updates.push_back(std::move(update));
+    if (updates.size() > 1) {
+      // A state update which will pick this up is already queued
+      return;
+    }
+    pendingBatch_->firstQueued = std::chrono::steady_clock::now();
+  }
+
+  // Everything queued until the update thread gets to this update is applied
+  // in one go, so the batch grows with the load on the update thread while
+  // an idle switch programs each neighbor right away.
+  auto batch = pendingBatch_;
   auto vlanID = vlanID_;
-  auto updateFn =
-      [fields, vlanID, force](const std::shared_ptr<SwitchState>& state)
+  auto sw = sw_;
+  auto updateFn = [batch, vlanID, sw](const std::shared_ptr<SwitchState>& state)
       -> std::shared_ptr<SwitchState> {
-    if (!ncachehelpers::checkVlanAndIntf<NTable>(state, fields, vlanID)) {
-      // Either the vlan or intf is no longer valid.
+    std::vector<PendingUpdate> updates;
+    std::chrono::steady_clock::time_point firstQueued;
+    {
+      std::lock_guard<std::mutex> g(batch->lock);
+      updates.swap(batch->updates);
+      firstQueued = batch->firstQueued;
+    }
+    if (updates.empty()) {
       return nullptr;
     }
+    sw->stats()->neighborUpdateBatch(
+        updates.size(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - firstQueued));
 
-    auto vlan = state->getVlans()->getVlanIf(vlanID).get();
     std::shared_ptr<SwitchState> newState{state};
-    auto* table = vlan->template getNeighborTable<NTable>().get();
-    auto node = table->getNodeIf(fields.ip);
-    table = table->modify(&vlan, &newState);
-
-    if (node) {
-      if (!force) {
-        // don't replace an existing entry with a pending one unless
-        // explicitly allowed
-        return nullptr;
+    bool changed = false;
+    // Apply in order, later changes for an address depend on earlier ones
+    for (const auto& update : updates) {
+      switch (update.type) {
+        case PendingUpdate::Type::PROGRAM:
+          changed |= programEntryInState(&newState, vlanID, update.fields);
+          break;
+        case PendingUpdate::Type::PROGRAM_PENDING:
+          changed |= programPendingEntryInState(
+              &newState, vlanID, update.fields, update.force);
+          break;
+        case PendingUpdate::Type::FLUSH:
+          changed |= flushEntryInState(&newState, vlanID, update.fields.ip);
+          break;
       }
-      table->removeEntry(fields.ip);
     }
-    table->addPendingEntry(fields.ip, fields.interfaceID);
-
-    XLOG(DBG4) << "Adding pending entry for " << fields.ip << " on interface "
-               << fields.interfaceID << " for vlan " << vlanID;
-    return newState;
+    return changed ? newState : nullptr;
   };
 
-  sw_->updateStateNoCoalescing(
-      folly::to<std::string>("add pending entry ", fields.ip),
-      std::move(updateFn));
+  auto name = folly::to<std::string>("neighbor updates for vlan ", vlanID_);
+  if (type == PendingUpdate::Type::PROGRAM_PENDING) {
+    // As before batching, a pending entry is applied on its own
+    sw_->updateStateNoCoalescing(name, std::move(updateFn));
+  } else {
+    sw_->updateState(name, std::move(updateFn));
+  }
 }
 
 template <typename NTable>
@@ -248,9 +311,8 @@ NeighborCacheEntry<NTable>* NeighborCacheImpl<NTable>::setEntryInternal(
     entry->updateState(state);
     return changed ? entry : nullptr;
   } else if (add) {
-    auto to_store = std::make_shared<Entry>(fields, evb_, cache_, state);
-    entry = to_store.get();
-    setCacheEntry(std::move(to_store));
+    auto ret = entries_.try_emplace(fields.ip, fields, evb_, cache_, state);
+    entry = &ret.first->second;
   }
   return entry;
 }
@@ -285,18 +347,22 @@ void NeighborCacheImpl<NTable>::processEntry(AddressType ip) {
 
 template <typename NTable>
 NeighborCacheEntry<NTable>* NeighborCacheImpl<NTable>::getCacheEntry(
-    AddressType ip) const {
+    AddressType ip) {
   auto it = entries_.find(ip);
   if (it != entries_.end()) {
-    return it->second.get();
+    return &it->second;
   }
   return nullptr;
 }
 
 template <typename NTable>
-void NeighborCacheImpl<NTable>::setCacheEntry(std::shared_ptr<Entry> entry) {
-  const auto& ip = entry->getIP();
-  entries_[ip] = std::move(entry);
+const NeighborCacheEntry<NTable>* NeighborCacheImpl<NTable>::getCacheEntry(
+    AddressType ip) const {
+  auto it = entries_.find(ip);
+  if (it != entries_.end()) {
+    return &it->second;
+  }
+  return nullptr;
 }
 
 template <typename NTable>
@@ -311,6 +377,25 @@ bool NeighborCacheImpl<NTable>::removeEntry(AddressType ip) {
   return true;
 }
 
+template <typename NTable>
+bool NeighborCacheImpl<NTable>::flushEntryInState(
+    std::shared_ptr<SwitchState>* state,
+    VlanID vlanID,
+    AddressType ip) {
+  auto* vlan = (*state)->getVlans()->getVlanIf(vlanID).get();
+  if (!vlan) {
+    return false;
+  }
+  auto* table = vlan->template getNeighborTable<NTable>().get();
+  if (!table->getNodeIf(ip)) {
+    return false;
+  }
+
+  table = table->modify(&vlan, state);
+  table->removeNode(ip);
+  return true;
+}
+
 template <typename NTable>
 bool NeighborCacheImpl<NTable>::flushEntryFromSwitchState(
     std::shared_ptr<SwitchState>* state,
@@ -344,26 +429,25 @@ void NeighborCacheImpl<NTable>::flushEntry(AddressType ip, bool* flushed) {
     return;
   }
 
-  // flush from SwitchState
+  if (!flushed) {
+    queueUpdate(
+        {PendingUpdate::Type::FLUSH,
+         EntryFields(ip, intfID_, NeighborState::PENDING)});
+    return;
+  }
+
+  // need a blocking state update if the caller wants to know if an entry
+  // was actually flushed. Anything batched earlier is queued ahead of it.
   auto updateFn = [this, ip, flushed](const std::shared_ptr<SwitchState>& state)
       -> std::shared_ptr<SwitchState> {
     std::shared_ptr<SwitchState> newState{state};
     if (flushEntryFromSwitchState(&newState, ip)) {
-      if (flushed) {
-        *flushed = true;
-      }
+      *flushed = true;
       return newState;
     }
     return nullptr;
   };
-
-  if (flushed) {
-    // need a blocking state update if the caller wants to know if an entry
-    // was actually flushed
-    sw_->updateStateBlocking("flush neighbor entry", std::move(updateFn));
-  } else {
-    sw_->updateState("remove neighbor entry: " + ip.str(), std::move(updateFn));
-  }
+  sw_->updateStateBlocking("flush neighbor entry", std::move(updateFn));
 }
 
 template <typename NTable>
@@ -378,8 +462,8 @@ NeighborCacheImpl<NTable>::cloneEntryFields(AddressType ip) {
 
 template <typename NTable>
 void NeighborCacheImpl<NTable>::portDown(PortDescriptor port) {
-  for (auto item : entries_) {
-    if (item.second->getPort() != port) {
+  for (const auto& item : entries_) {
+    if (item.second.getPort() != port) {
       continue;
     }
 
@@ -391,18 +475,18 @@ void NeighborCacheImpl<NTable>::portDown(PortDescriptor port) {
     // programmed. Also we need to notify the HwSwitch for ECMP expand
     // when the port comes back up and changing an entry from pending
     // to reachable is how we currently do this.
-    setPendingEntry(item.second->getIP(), true);
+    setPendingEntry(item.second.getIP(), true);
   }
 }
 
 template <typename NTable>
 void NeighborCacheImpl<NTable>::portFlushEntries(PortDescriptor port) {
   std::vector<AddressType> entriesToFlush;
-  for (auto item : entries_) {
-    if (item.second->getPort() != port) {
+  for (const auto& item : entries_) {
+    if (item.second.getPort() != port) {
       continue;
     }
-    entriesToFlush.push_back(item.second->getIP());
+    entriesToFlush.push_back(item.second.getIP());
   }
 
   for (const auto& ip : entriesToFlush) {
@@ -417,7 +501,7 @@ std::list<NeighborEntryThrift> NeighborCacheImpl<NTable>::getCacheData() const {
   std::list<NeighborEntryThrift> thriftEntries;
   for (const auto& item : entries_) {
     NeighborEntryThrift thriftEntry;
-    item.second->populateThriftEntry(thriftEntry);
+    item.second.populateThriftEntry(thriftEntry);
     thriftEntries.push_back(thriftEntry);
   }
   return thriftEntries;
@@ -18,9 +18,13 @@
 
 #include <folly/IPAddress.h>
 #include <folly/Random.h>
+#include <folly/container/F14Map.h>
+#include <chrono>
 #include <list>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -127,9 +131,48 @@ class NeighborCacheImpl {
   std::optional<NeighborEntryThrift> getCacheData(AddressType ip) const;
 
  private:
+  /*
+   * A change to this VLAN's neighbor table. Changes are queued and applied
+   * to the SwitchState in batches, in order.
+   */
+  struct PendingUpdate {
+    enum class Type { PROGRAM, PROGRAM_PENDING, FLUSH };
+    Type type;
+    EntryFields fields;
+    bool force{false};
+  };
+
+  /*
+   * Changes not yet picked up by a state update. Shared with the queued
+   * state update, which may run after the cache is gone. Accessed from the
+   * update thread, so it has its own lock rather than the cache lock, which
+   * is held while waiting for blocking state updates.
+   */
+  struct PendingBatch {
+    std::mutex lock;
+    std::vector<PendingUpdate> updates;
+    std::chrono::steady_clock::time_point firstQueued;
+  };
+
   // These are used to program entries into the SwitchState
   void programEntry(Entry* entry);
   void programPendingEntry(Entry* entry, bool force = false);
+  void queueUpdate(PendingUpdate update);
+
+  // Apply a single change to *state, return true if it modified the state
+  static bool programEntryInState(
+      std::shared_ptr<SwitchState>* state,
+      VlanID vlanID,
+      const EntryFields& fields);
+  static bool programPendingEntryInState(
+      std::shared_ptr<SwitchState>* state,
+      VlanID vlanID,
+      const EntryFields& fields,
+      bool force);
+  static bool flushEntryInState(
+      std::shared_ptr<SwitchState>* state,
+      VlanID vlanID,
+      AddressType ip);
 
   void processEntry(AddressType ip);
 
@@ -141,8 +184,8 @@ class NeighborCacheImpl {
       std::shared_ptr<SwitchState>* state,
       AddressType ip);
 
-  Entry* getCacheEntry(AddressType ip) const;
-  void setCacheEntry(std::shared_ptr<Entry> entry);
+  Entry* getCacheEntry(AddressType ip);
+  const Entry* getCacheEntry(AddressType ip) const;
   bool removeEntry(AddressType ip);
 
   Entry* setEntryInternal(
@@ -161,8 +204,12 @@ class NeighborCacheImpl {
   InterfaceID intfID_;
   folly::EventBase* evb_;
 
-  // Map of all entries
-  std::unordered_map<AddressType, std::shared_ptr<Entry>> entries_;
+  // Map of all entries. Entries are stored in place, a node map keeps their
+  // addresses stable while they are linked into the cache's timer wheel.
+  folly::F14NodeMap<AddressType, Entry> entries_;
+
+  std::shared_ptr<PendingBatch> pendingBatch_{
+      std::make_shared<PendingBatch>()};
 };
 
 } // namespace facebook::fboss
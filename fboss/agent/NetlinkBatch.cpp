@@ -0,0 +1,174 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/NetlinkBatch.h"
+
+#include <folly/ScopeGuard.h>
+#include <folly/logging/xlog.h>
+
+#include "fboss/agent/NlError.h"
+
+extern "C" {
+#include <netlink/netlink.h>
+}
+
+namespace facebook::fboss {
+
+NetlinkBatch::~NetlinkBatch() {
+  clearQueued();
+  for (auto& request : inFlight_) {
+    nlmsg_free(request.msg);
+  }
+}
+
+void NetlinkBatch::add(
+    nl_msg* msg,
+    std::string desc,
+    bool ignoreErrors,
+    std::function<void()> onError) {
+  if (!msg) {
+    throw FbossError("Failed to build netlink request to ", desc);
+  }
+  Request request;
+  request.msg = msg;
+  request.desc = std::move(desc);
+  request.ignoreErrors = ignoreErrors;
+  request.onError = std::move(onError);
+  queued_.push_back(std::move(request));
+}
+
+void NetlinkBatch::commit() {
+  // Don't leave requests behind to be sent with an unrelated commit
+  SCOPE_FAIL {
+    clearQueued();
+  };
+  int firstError = 0;
+  std::string firstErrorDesc;
+  while (!queued_.empty()) {
+    std::vector<std::function<void()>> onErrors;
+    while (!queued_.empty()) {
+      std::string errorDesc;
+      auto error = flushOnce(&errorDesc, &onErrors);
+      if (error < 0 && !firstError) {
+        firstError = error;
+        firstErrorDesc = std::move(errorDesc);
+      }
+    }
+    // May queue more requests, rolling back earlier ones
+    for (auto& onError : onErrors) {
+      onError();
+    }
+  }
+  nlCheckError(firstError, "Failed to ", firstErrorDesc);
+}
+
+void NetlinkBatch::clearQueued() {
+  for (auto& request : queued_) {
+    nlmsg_free(request.msg);
+  }
+  queued_.clear();
+}
+
+int NetlinkBatch::flushOnce(
+    std::string* errorDesc,
+    std::vector<std::function<void()>>* onErrors) {
+  CHECK(inFlight_.empty());
+  SCOPE_EXIT {
+    for (auto& request : inFlight_) {
+      nlmsg_free(request.msg);
+    }
+    inFlight_.clear();
+  };
+
+  // Send a burst of requests without waiting for any ACK
+  numReplies_ = 0;
+  while (!queued_.empty() && inFlight_.size() < maxInFlight_) {
+    inFlight_.push_back(std::move(queued_.front()));
+    queued_.pop_front();
+    auto& request = inFlight_.back();
+    // Fills in port id, sequence number and requests an ACK
+    nl_complete_msg(sock_, request.msg);
+    request.seq = nlmsg_hdr(request.msg)->nlmsg_seq;
+    auto ret = nl_send(sock_, request.msg);
+    if (ret < 0) {
+      // Nothing was sent for this request, so no reply will come for it.
+      // Still collect replies for what was already sent.
+      request.replied = true;
+      request.error = ret;
+      ++numReplies_;
+      break;
+    }
+    ++numRequestsSent_;
+  }
+  ++numRoundTrips_;
+
+  // Collect one reply (ACK or error) per request
+  auto cb = nl_cb_clone(nl_socket_get_cb(sock_));
+  if (!cb) {
+    throw FbossError("Failed to allocate netlink callbacks");
+  }
+  SCOPE_EXIT {
+    nl_cb_put(cb);
+  };
+  nl_cb_set(cb, NL_CB_ACK, NL_CB_CUSTOM, &NetlinkBatch::ackHandler, this);
+  nl_cb_err(cb, NL_CB_CUSTOM, &NetlinkBatch::errorHandler, this);
+
+  while (numReplies_ < inFlight_.size()) {
+    auto ret = nl_recvmsgs(sock_, cb);
+    nlCheckError(ret, "Failed to receive netlink replies");
+  }
+
+  int firstError = 0;
+  for (auto& request : inFlight_) {
+    if (request.error == 0) {
+      continue;
+    }
+    if (request.onError) {
+      onErrors->push_back(std::move(request.onError));
+    }
+    if (request.ignoreErrors) {
+      XLOG(WARNING) << "Failed to " << request.desc
+                    << ". ErrorCode: " << request.error;
+    } else if (!firstError) {
+      firstError = request.error;
+      *errorDesc = request.desc;
+    }
+  }
+  return firstError;
+}
+
+int NetlinkBatch::ackHandler(nl_msg* msg, void* arg) {
+  static_cast<NetlinkBatch*>(arg)->handleReply(nlmsg_hdr(msg)->nlmsg_seq, 0);
+  return NL_OK;
+}
+
+int NetlinkBatch::errorHandler(
+    sockaddr_nl* /* nla */,
+    nlmsgerr* err,
+    void* arg) {
+  // err->msg is the header of the request that failed
+  static_cast<NetlinkBatch*>(arg)->handleReply(
+      err->msg.nlmsg_seq, -nl_syserr2nlerr(err->error));
+  // Keep processing replies for the rest of the batch
+  return NL_SKIP;
+}
+
+void NetlinkBatch::handleReply(uint32_t seq, int error) {
+  for (auto& request : inFlight_) {
+    if (request.seq == seq && !request.replied) {
+      request.replied = true;
+      request.error = error;
+      ++numReplies_;
+      return;
+    }
+  }
+  XLOG(DBG2) << "Ignoring netlink reply for unknown sequence " << seq;
+}
+
+} // namespace facebook::fboss
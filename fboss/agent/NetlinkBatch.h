@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <netlink/msg.h>
+#include <netlink/socket.h>
+}
+
+namespace facebook::fboss {
+
+/*
+ * Queue of netlink requests sent to the kernel back to back.
+ *
+ * Rather than one request/ACK round trip per address, rule or route (what
+ * rtnl_*_add()/rtnl_*_delete() do), requests are sent in bursts of up to
+ * maxInFlight messages and their ACKs collected with a single receive loop.
+ * The kernel processes requests on a socket in order, so requests queued
+ * later still observe the effect of earlier ones.
+ *
+ * Errors are reported when the requests are flushed. commit() throws an
+ * NlError for the first failed request not marked ignoreErrors, after all
+ * queued requests have been sent. Requests left unsent by a failed commit()
+ * are dropped.
+ */
+class NetlinkBatch {
+ public:
+  static constexpr size_t kDefaultMaxInFlight = 128;
+
+  explicit NetlinkBatch(nl_sock* sock, size_t maxInFlight = kDefaultMaxInFlight)
+      : sock_(sock), maxInFlight_(maxInFlight) {}
+  ~NetlinkBatch();
+
+  /*
+   * Queue a request. Takes ownership of msg, typically built with one of
+   * the rtnl_*_build_*_request() functions. desc is used for logging.
+   *
+   * If the request fails, onError is called once the requests queued with
+   * it have been sent. It may queue requests undoing earlier ones, which
+   * are sent before commit() returns.
+   */
+  void add(
+      nl_msg* msg,
+      std::string desc,
+      bool ignoreErrors = false,
+      std::function<void()> onError = nullptr);
+
+  /*
+   * Send all queued requests and wait for their ACKs.
+   */
+  void commit();
+
+  size_t numQueued() const {
+    return queued_.size();
+  }
+
+  // Stats, for logging and benchmarks
+  uint64_t numRequestsSent() const {
+    return numRequestsSent_;
+  }
+  uint64_t numRoundTrips() const {
+    return numRoundTrips_;
+  }
+
+ private:
+  // no copy or assign
+  NetlinkBatch(const NetlinkBatch&) = delete;
+  NetlinkBatch& operator=(const NetlinkBatch&) = delete;
+
+  struct Request {
+    nl_msg* msg{nullptr};
+    std::string desc;
+    bool ignoreErrors{false};
+    uint32_t seq{0};
+    bool replied{false};
+    int error{0};
+    std::function<void()> onError;
+  };
+
+  // Send up to maxInFlight_ queued requests and collect their replies.
+  // Returns the first error which should be reported, or 0, and appends
+  // the onError callbacks of failed requests to onErrors.
+  int flushOnce(
+      std::string* errorDesc,
+      std::vector<std::function<void()>>* onErrors);
+  void clearQueued();
+
+  static int ackHandler(nl_msg* msg, void* arg);
+  static int errorHandler(sockaddr_nl* nla, nlmsgerr* err, void* arg);
+  void handleReply(uint32_t seq, int error);
+
+  nl_sock* sock_{nullptr};
+  const size_t maxInFlight_;
+  std::deque<Request> queued_;
+  std::deque<Request> inFlight_;
+  size_t numReplies_{0};
+  uint64_t numRequestsSent_{0};
+  uint64_t numRoundTrips_{0};
+};
+
+} // namespace facebook::fboss
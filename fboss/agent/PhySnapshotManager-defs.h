@@ -17,7 +17,7 @@ void PhySnapshotManager<intervalSeconds>::updatePhyInfoLocked(
 
   CHECK(!phyInfo.get_name().empty());
   auto result = lockedSnapshotMap->try_emplace(
-      portID, std::set<std::string>({phyInfo.get_name()}));
+      portID, std::set<std::string>({phyInfo.get_name()}), store_);
   auto iter = result.first;
   auto& value = iter->second;
   value.addSnapshot(snapshot);
@@ -80,6 +80,29 @@ PhySnapshotManager<intervalSeconds>::getPhyInfos(
   return infoMap;
 }
 
+template <size_t intervalSeconds>
+std::vector<phy::LinkSnapshot>
+PhySnapshotManager<intervalSeconds>::getLastSnapshots(PortID portID, size_t n)
+    const {
+  auto lockedSnapshotMap = snapshots_.rlock();
+  if (auto it = lockedSnapshotMap->find(portID);
+      it != lockedSnapshotMap->end()) {
+    return it->second.getLastSnapshots(n);
+  }
+  return {};
+}
+
+template <size_t intervalSeconds>
+std::vector<phy::LinkSnapshot>
+PhySnapshotManager<intervalSeconds>::getPublishedSnapshots(
+    const std::string& portName,
+    size_t n) const {
+  if (!store_) {
+    return {};
+  }
+  return store_->getLastSnapshots(portName, n);
+}
+
 template <size_t intervalSeconds>
 void PhySnapshotManager<intervalSeconds>::publishSnapshots(PortID port) {
   auto lockedSnapshotMap = snapshots_.wlock();
@@ -18,11 +18,23 @@ class PhySnapshotManager {
       std::map<PortID, PhySnapshotCache>>::WLockedPtr;
 
  public:
+  explicit PhySnapshotManager(std::shared_ptr<SnapshotStore> store = nullptr)
+      : store_(std::move(store)) {}
+
   void updatePhyInfo(PortID portID, const phy::PhyInfo& phyInfo);
   void updatePhyInfos(const std::map<PortID, phy::PhyInfo>& phyInfo);
   std::optional<phy::PhyInfo> getPhyInfo(PortID portID) const;
   std::map<PortID, const phy::PhyInfo> getPhyInfos(
       const std::vector<PortID>& portIDs) const;
+  // Up to the n newest snapshots of a port, oldest first
+  std::vector<phy::LinkSnapshot> getLastSnapshots(PortID portID, size_t n)
+      const;
+  // Up to the n newest published snapshots of a port, oldest first, read back
+  // from the store so they include those published before a restart. Empty
+  // if snapshots aren't persisted.
+  std::vector<phy::LinkSnapshot> getPublishedSnapshots(
+      const std::string& portName,
+      size_t n) const;
   void publishSnapshots(PortID portID);
 
  private:
@@ -36,6 +48,8 @@ class PhySnapshotManager {
 
   // Map of portID to last few phy diagnostic snapshots
   folly::Synchronized<std::map<PortID, PhySnapshotCache>> snapshots_;
+  // Published snapshots of all ports are persisted here, if set
+  std::shared_ptr<SnapshotStore> store_;
 };
 
 } // namespace facebook::fboss
@@ -226,6 +226,19 @@ void mark(RestartEvent event) {
   }
 }
 
+void markStageDuration(
+    const std::string& stage,
+    std::chrono::milliseconds duration,
+    bool warmBoot) {
+  auto counterName = folly::to<std::string>(
+      warmBoot ? kWarmBootPrefix : kColdBootPrefix,
+      stage,
+      ".",
+      kStageCounterSuffix);
+  fb303::fbData->setCounter(counterName, duration.count());
+  XLOG(DBG2) << counterName << " -> " << duration.count() << "ms";
+}
+
 void stop() {
   auto tracker = impl_.lock();
   (*tracker).reset();
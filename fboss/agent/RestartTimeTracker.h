@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <string>
 
@@ -44,6 +45,15 @@ enum class RestartEvent : uint16_t {
 namespace restart_time {
 void init(const std::string& warmBootDir, bool warmBoot);
 void mark(RestartEvent event);
+/*
+ * Export the duration of a part of a restart stage, timed by the caller
+ * rather than between two events, e.g. reloading hw state. Unlike mark(),
+ * this can be called before init().
+ */
+void markStageDuration(
+    const std::string& stage,
+    std::chrono::milliseconds duration,
+    bool warmBoot);
 void stop();
 }; // namespace restart_time
 
@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <fb303/ThreadCachedServiceData.h>
+#include <folly/Conv.h>
+#include <folly/futures/SharedPromise.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace facebook::fboss {
+
+class SwitchState;
+
+/*
+ * Caches the result of an expensive read-only computation, typically the
+ * response of a thrift read API.
+ *
+ * getForState() caches results per SwitchState snapshot: as long as the
+ * published state doesn't change, repeated calls return the same result
+ * without recomputing it. Identical calls made while the result is being
+ * computed wait for that computation instead of starting their own.
+ *
+ * getCoalesced() is meant for data which does not live in the SwitchState
+ * (e.g. tables walked from hardware). Nothing is cached, but concurrent
+ * callers share a single in-flight computation.
+ *
+ * Hits, misses and coalesced calls are exported as
+ * read_cache.<name>.{hits,misses,coalesced}.
+ */
+template <typename Result>
+class StateReadCache {
+ public:
+  explicit StateReadCache(const std::string& name)
+      : hitsKey_(folly::to<std::string>("read_cache.", name, ".hits")),
+        missesKey_(folly::to<std::string>("read_cache.", name, ".misses")),
+        coalescedKey_(
+            folly::to<std::string>("read_cache.", name, ".coalesced")) {}
+
+  template <typename ComputeFn>
+  std::shared_ptr<const Result> getForState(
+      const std::shared_ptr<SwitchState>& state,
+      ComputeFn&& compute) {
+    return get(
+        state, true /* cache result */, std::forward<ComputeFn>(compute));
+  }
+
+  template <typename ComputeFn>
+  std::shared_ptr<const Result> getCoalesced(ComputeFn&& compute) {
+    return get(
+        nullptr, false /* cache result */, std::forward<ComputeFn>(compute));
+  }
+
+  /*
+   * Drop the cached result, if any. In-flight computations are not affected.
+   */
+  void invalidate() {
+    std::lock_guard<std::mutex> g(lock_);
+    cachedState_.reset();
+    cached_.reset();
+  }
+
+ private:
+  using Promise = folly::SharedPromise<std::shared_ptr<const Result>>;
+
+  // Forbidden copy constructor and assignment operator
+  StateReadCache(StateReadCache const&) = delete;
+  StateReadCache& operator=(StateReadCache const&) = delete;
+
+  template <typename ComputeFn>
+  std::shared_ptr<const Result> get(
+      const std::shared_ptr<SwitchState>& state,
+      bool cacheResult,
+      ComputeFn&& compute) {
+    std::shared_ptr<Promise> promise;
+    {
+      std::unique_lock<std::mutex> g(lock_);
+      if (cacheResult && cached_ && cachedState_.lock() == state) {
+        auto cached = cached_;
+        g.unlock();
+        fb303::tcData().addStatValue(hitsKey_, 1, fb303::SUM);
+        return cached;
+      }
+      if (inFlight_ && inFlightState_ == state.get()) {
+        auto future = inFlight_->getSemiFuture();
+        g.unlock();
+        fb303::tcData().addStatValue(coalescedKey_, 1, fb303::SUM);
+        return std::move(future).get();
+      }
+      if (!inFlight_) {
+        // Later identical calls will wait for this one. If a computation
+        // for another state is still running, don't take its place, we
+        // just don't coalesce with it.
+        inFlight_ = std::make_shared<Promise>();
+        inFlightState_ = state.get();
+        promise = inFlight_;
+      }
+    }
+    fb303::tcData().addStatValue(missesKey_, 1, fb303::SUM);
+
+    std::shared_ptr<const Result> result;
+    try {
+      result = std::make_shared<const Result>(compute());
+    } catch (const std::exception& ex) {
+      if (promise) {
+        finishInFlight(promise);
+        promise->setException(
+            folly::exception_wrapper(std::current_exception(), ex));
+      }
+      throw;
+    }
+
+    if (cacheResult) {
+      std::lock_guard<std::mutex> g(lock_);
+      cachedState_ = state;
+      cached_ = result;
+    }
+    if (promise) {
+      finishInFlight(promise);
+      promise->setValue(result);
+    }
+    return result;
+  }
+
+  void finishInFlight(const std::shared_ptr<Promise>& promise) {
+    std::lock_guard<std::mutex> g(lock_);
+    if (inFlight_ == promise) {
+      inFlight_.reset();
+      inFlightState_ = nullptr;
+    }
+  }
+
+  const std::string hitsKey_;
+  const std::string missesKey_;
+  const std::string coalescedKey_;
+
+  std::mutex lock_;
+  // Only used to compare with the current state, a weak_ptr so that we don't
+  // hold on to old states. The state is compared by identity since
+  // generation numbers are not unique (e.g. across warm boot).
+  std::weak_ptr<SwitchState> cachedState_;
+  std::shared_ptr<const Result> cached_;
+  // Computation currently running, and the state it is computed from.
+  // Never dereferenced.
+  std::shared_ptr<Promise> inFlight_;
+  const SwitchState* inFlightState_{nullptr};
+};
+
+} // namespace facebook::fboss
@@ -125,11 +125,29 @@ DEFINE_bool(
     false,
     "Flag to turn on logging of all updates to the FIB");
 
+DEFINE_bool(
+    incremental_config_apply,
+    true,
+    "Only reapply the parts of the config that changed since the last "
+    "successfully applied config");
+
+DEFINE_bool(
+    enable_state_update_pipelining,
+    false,
+    "Compute the next SwitchState on the update thread while the previous "
+    "one is being programmed to hardware on a dedicated thread");
+
 DEFINE_int32(
     minimum_ethernet_packet_length,
     64,
     "Expected minimum ethernet packet length");
 
+DEFINE_bool(
+    persist_iphy_link_snapshots,
+    false,
+    "Persist published iphy link snapshots under the persistent state "
+    "directory, so they survive agent restarts");
+
 namespace {
 
 /**
@@ -200,8 +218,11 @@ SwSwitch::SwSwitch(std::unique_ptr<Platform> platform)
       lookupClassRouteUpdater_(new LookupClassRouteUpdater(this)),
       staticL2ForNeighborObserver_(new StaticL2ForNeighborObserver(this)),
       macTableManager_(new MacTableManager(this)),
-      phySnapshotManager_(
-          new PhySnapshotManager<kIphySnapshotIntervalSeconds>()),
+      phySnapshotManager_(new PhySnapshotManager<kIphySnapshotIntervalSeconds>(
+          FLAGS_persist_iphy_link_snapshots
+              ? std::make_shared<SnapshotStore>(
+                    platform_->getPersistentStateDir() + "/iphy_snapshots")
+              : nullptr)),
       aclNexthopHandler_(new AclNexthopHandler(this)) {
   // Create the platform-specific state directories if they
   // don't exist already.
@@ -794,12 +815,48 @@ void SwSwitch::handlePendingUpdatesHelper(SwSwitch* sw) {
 }
 
 void SwSwitch::handlePendingUpdates() {
+  if (FLAGS_enable_state_update_pipelining && hwUpdateThread_ &&
+      !isExiting()) {
+    handlePendingUpdatesPipelined();
+    return;
+  }
   // Get the list of updates to run.
   //
   // We might pull multiple updates off the list at once if several updates
   // were scheduled before we had a chance to process them.  In some cases we
   // might also end up finding 0 updates to process if a previous
   // handlePendingUpdates() call processed multiple updates.
+  StateUpdateList updates = dequeuePendingUpdates();
+
+  // handlePendingUpdates() is invoked once for each update, but a previous
+  // call might have already processed everything.  If we don't have anything
+  // to do just return early.
+  if (updates.empty()) {
+    return;
+  }
+
+  // This function should never be called with valid updates while we are
+  // not initialized yet
+  DCHECK(isInitialized());
+
+  // Call all of the update functions to prepare the new SwitchState
+  auto oldAppliedState = getState();
+  auto newDesiredState = computeDesiredState(oldAppliedState, updates);
+  // Start newAppliedState as equal to newDesiredState unless
+  // we learn otherwise
+  auto newAppliedState = newDesiredState;
+  // Now apply the update and notify subscribers
+  if (newDesiredState != oldAppliedState) {
+    auto isTransaction = updates.begin()->hwFailureProtected() &&
+        getHw()->transactionsSupported();
+    // There was some change during these state updates
+    newAppliedState =
+        applyUpdate(oldAppliedState, newDesiredState, isTransaction);
+  }
+  finishStateUpdates(updates, newDesiredState, newAppliedState);
+}
+
+SwSwitch::StateUpdateList SwSwitch::dequeuePendingUpdates() {
   StateUpdateList updates;
   {
     std::unique_lock guard(pendingUpdatesLock_);
@@ -826,12 +883,8 @@ void SwSwitch::handlePendingUpdates() {
     updates.splice(
         updates.begin(), pendingUpdates_, pendingUpdates_.begin(), iter);
   }
-
-  // handlePendingUpdates() is invoked once for each update, but a previous
-  // call might have already processed everything.  If we don't have anything
-  // to do just return early.
   if (updates.empty()) {
-    return;
+    return updates;
   }
 
   // Non coalescing updates should be applied individually
@@ -844,15 +897,14 @@ void SwSwitch::handlePendingUpdates() {
     CHECK(isNonCoalescing)
         << " Hw Failure protected updates should be non coalescing";
   }
+  return updates;
+}
 
-  // This function should never be called with valid updates while we are
-  // not initialized yet
-  DCHECK(isInitialized());
-
-  // Call all of the update functions to prepare the new SwitchState
-  auto oldAppliedState = getState();
-  // We start with the old state, and apply state updates one at a time.
-  auto newDesiredState = oldAppliedState;
+std::shared_ptr<SwitchState> SwSwitch::computeDesiredState(
+    const std::shared_ptr<SwitchState>& baseState,
+    StateUpdateList& updates) {
+  // We start with the base state, and apply state updates one at a time.
+  auto newDesiredState = baseState;
   auto iter = updates.begin();
   while (iter != updates.end()) {
     StateUpdate* update = &(*iter);
@@ -881,55 +933,51 @@ void SwSwitch::handlePendingUpdates() {
       newDesiredState = intermediateState;
     }
   }
-  // Start newAppliedState as equal to newDesiredState unless
-  // we learn otherwise
-  auto newAppliedState = newDesiredState;
-  // Now apply the update and notify subscribers
-  if (newDesiredState != oldAppliedState) {
-    auto isTransaction = updates.begin()->hwFailureProtected() &&
-        getHw()->transactionsSupported();
-    // There was some change during these state updates
-    newAppliedState =
-        applyUpdate(oldAppliedState, newDesiredState, isTransaction);
-    if (newDesiredState != newAppliedState) {
-      if (isExiting()) {
-        /*
-         * If we started exit, applyUpdate will reject updates leading
-         * to a mismatch b/w applied and desired states. Log, but otherwise
-         * ignore this error. Ideally, we should throw this error back to
-         * the callers, but during exit with threads in various state of
-         * stoppage, it becomes hard to manage. Since we require a resync
-         * of state post restart anyways (through WB state replay, config
-         * application and FIB sync) this should not cause problems. Note
-         * that this sync is not optional, but required for external clients
-         * post restart - agent could COLD boot, or there could be a mismatch
-         * with the HW state.
-         * If we ever want to relax this requirement - viz. only require a
-         * resync from external clients on COLD boot, we will need to get
-         * more rigorous here.
-         */
-        XLOG(INFO) << " Failed to apply updates to HW since SwSwtich already "
-                      "started exit";
-      } else if (updates.size() == 1 && updates.begin()->hwFailureProtected()) {
-        fb303::fbData->incrementCounter(kHwUpdateFailures);
-        unique_ptr<StateUpdate> update(&updates.front());
-        try {
-          throw FbossHwUpdateError(
-              newDesiredState,
-              newAppliedState,
-              "Update : ",
-              update->getName(),
-              " application to HW failed");
-
-        } catch (const std::exception& ex) {
-          update->onError(ex);
-        }
-        return;
-      } else {
-        XLOG(FATAL)
-            << " Failed to apply update to HW and the update is not marked for "
-               "HW failure protection";
+  return newDesiredState;
+}
+
+void SwSwitch::finishStateUpdates(
+    StateUpdateList& updates,
+    const std::shared_ptr<SwitchState>& newDesiredState,
+    const std::shared_ptr<SwitchState>& newAppliedState) {
+  if (newDesiredState != newAppliedState) {
+    if (isExiting()) {
+      /*
+       * If we started exit, applyUpdate will reject updates leading
+       * to a mismatch b/w applied and desired states. Log, but otherwise
+       * ignore this error. Ideally, we should throw this error back to
+       * the callers, but during exit with threads in various state of
+       * stoppage, it becomes hard to manage. Since we require a resync
+       * of state post restart anyways (through WB state replay, config
+       * application and FIB sync) this should not cause problems. Note
+       * that this sync is not optional, but required for external clients
+       * post restart - agent could COLD boot, or there could be a mismatch
+       * with the HW state.
+       * If we ever want to relax this requirement - viz. only require a
+       * resync from external clients on COLD boot, we will need to get
+       * more rigorous here.
+       */
+      XLOG(INFO) << " Failed to apply updates to HW since SwSwtich already "
+                    "started exit";
+    } else if (updates.size() == 1 && updates.begin()->hwFailureProtected()) {
+      fb303::fbData->incrementCounter(kHwUpdateFailures);
+      unique_ptr<StateUpdate> update(&updates.front());
+      try {
+        throw FbossHwUpdateError(
+            newDesiredState,
+            newAppliedState,
+            "Update : ",
+            update->getName(),
+            " application to HW failed");
+
+      } catch (const std::exception& ex) {
+        update->onError(ex);
       }
+      return;
+    } else {
+      XLOG(FATAL)
+          << " Failed to apply update to HW and the update is not marked for "
+             "HW failure protection";
     }
   }
   updatePtpTcCounter();
@@ -941,6 +989,85 @@ void SwSwitch::handlePendingUpdates() {
   }
 }
 
+void SwSwitch::handlePendingUpdatesPipelined() {
+  // Only one batch may be computed ahead of the one being programmed. Any
+  // further updates stay queued, where they keep coalescing, and are picked
+  // up once the in flight batch completes.
+  if (preparedBatch_) {
+    return;
+  }
+  // Whether a hw failure protected update sticks is only known once hw
+  // programming completes, so never build on top of one.
+  if (inFlightBatch_ && inFlightBatch_->hwFailureProtected) {
+    return;
+  }
+  auto batch = std::make_unique<StateUpdateBatch>();
+  batch->updates = dequeuePendingUpdates();
+  if (batch->updates.empty()) {
+    return;
+  }
+  DCHECK(isInitialized());
+
+  batch->start = std::chrono::steady_clock::now();
+  batch->hwFailureProtected = batch->updates.begin()->hwFailureProtected();
+  batch->isTransaction =
+      batch->hwFailureProtected && getHw()->transactionsSupported();
+  // Stage one: compute the next state on top of whatever is being programmed
+  // to hardware right now.
+  auto baseState =
+      inFlightBatch_ ? inFlightBatch_->desiredState : getAppliedState();
+  batch->desiredState = computeDesiredState(baseState, batch->updates);
+
+  if (inFlightBatch_) {
+    preparedBatch_ = std::move(batch);
+  } else {
+    startHwUpdate(std::move(batch));
+  }
+}
+
+void SwSwitch::startHwUpdate(std::unique_ptr<StateUpdateBatch> batch) {
+  CHECK(!inFlightBatch_);
+  batch->oldState = getAppliedState();
+  if (batch->desiredState == batch->oldState || isExiting()) {
+    // Nothing to program, or we are exiting and would not program anyway.
+    batch->appliedState = batch->oldState;
+    finishBatch(std::move(batch));
+    return;
+  }
+  // Stage two: program hardware on the hw update thread and hand the result
+  // back to the update thread.
+  inFlightBatch_ = std::move(batch);
+  auto inFlight = inFlightBatch_.get();
+  hwUpdateEventBase_.runInEventBaseThread([this, inFlight]() {
+    inFlight->appliedState = programHw(
+        inFlight->oldState, inFlight->desiredState, inFlight->isTransaction);
+    updateEventBase_.runInEventBaseThread([this]() { hwUpdateDone(); });
+  });
+}
+
+void SwSwitch::hwUpdateDone() {
+  DCHECK(inFlightBatch_);
+  auto batch = std::move(inFlightBatch_);
+  if (batch->appliedState) {
+    finishApplyUpdate(batch->oldState, batch->appliedState, batch->start);
+  } else {
+    // Skipped due to exit, nothing made it to hardware
+    batch->appliedState = batch->oldState;
+  }
+  finishBatch(std::move(batch));
+
+  if (preparedBatch_) {
+    startHwUpdate(std::move(preparedBatch_));
+  }
+  // Pick up anything that was queued while the pipeline was full
+  handlePendingUpdates();
+}
+
+void SwSwitch::finishBatch(std::unique_ptr<StateUpdateBatch> batch) {
+  finishStateUpdates(
+      batch->updates, batch->desiredState, batch->appliedState);
+}
+
 void SwSwitch::updatePtpTcCounter() {
   // update fb303 counter to reflect current state of PTP
   // should be invoked post update
@@ -971,12 +1098,24 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
              << " new_gen=" << newState->getGeneration();
   DCHECK_GT(newState->getGeneration(), oldState->getGeneration());
 
+  auto newAppliedState = programHw(oldState, newState, isTransaction);
+  if (!newAppliedState) {
+    return oldState;
+  }
+  finishApplyUpdate(oldState, newAppliedState, start);
+  return newAppliedState;
+}
+
+std::shared_ptr<SwitchState> SwSwitch::programHw(
+    const shared_ptr<SwitchState>& oldState,
+    const shared_ptr<SwitchState>& newState,
+    bool isTransaction) {
   StateDelta delta(oldState, newState);
 
   // If we are already exiting, abort the update
   if (isExiting()) {
     XLOG(INFO) << " Agent exiting before all updates could be applied";
-    return oldState;
+    return nullptr;
   }
 
   std::shared_ptr<SwitchState> newAppliedState;
@@ -1008,7 +1147,13 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
     XLOG(FATAL) << "error applying state change to hardware: "
                 << folly::exceptionStr(ex);
   }
+  return newAppliedState;
+}
 
+void SwSwitch::finishApplyUpdate(
+    const shared_ptr<SwitchState>& oldState,
+    const shared_ptr<SwitchState>& newAppliedState,
+    std::chrono::steady_clock::time_point start) {
   setStateInternal(newAppliedState);
 
   // Notifies all observers of the current state update.
@@ -1021,7 +1166,6 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
 
   publishToFsdb(newAppliedState);
   XLOG(DBG0) << "Update state took " << duration.count() << "us";
-  return newAppliedState;
 }
 
 void SwSwitch::dumpBadStateUpdate(
@@ -1293,6 +1437,11 @@ void SwSwitch::startThreads() {
       [=] { this->threadLoop("fbossBgThread", &backgroundEventBase_); }));
   updateThread_.reset(new std::thread(
       [=] { this->threadLoop("fbossUpdateThread", &updateEventBase_); }));
+  if (FLAGS_enable_state_update_pipelining) {
+    hwUpdateThread_.reset(new std::thread([=] {
+      this->threadLoop("fbossHwUpdateThread", &hwUpdateEventBase_);
+    }));
+  }
   packetTxThread_.reset(new std::thread(
       [=] { this->threadLoop("fbossPktTxThread", &packetTxEventBase_); }));
   pcapDistributionThread_.reset(new std::thread([=] {
@@ -1315,6 +1464,15 @@ void SwSwitch::stopThreads() {
     backgroundEventBase_.runInEventBaseThread(
         [this] { backgroundEventBase_.terminateLoopSoon(); });
   }
+  if (hwUpdateThread_) {
+    // Stop the hw update thread first. Every batch it was handed posts its
+    // completion to the update thread, which completes the batches still
+    // in the pipeline before it stops. Since we are exiting, nothing more
+    // is programmed to hardware.
+    hwUpdateEventBase_.runInEventBaseThread(
+        [this] { hwUpdateEventBase_.terminateLoopSoon(); });
+    hwUpdateThread_->join();
+  }
   if (updateThread_) {
     updateEventBase_.runInEventBaseThread(
         [this] { updateEventBase_.terminateLoopSoon(); });
@@ -1341,6 +1499,7 @@ void SwSwitch::stopThreads() {
   if (updateThread_) {
     updateThread_->join();
   }
+  DCHECK(!inFlightBatch_ && !preparedBatch_);
   if (packetTxThread_) {
     packetTxThread_->join();
   }
@@ -1671,6 +1830,16 @@ void SwSwitch::applyConfig(
     const cfg::SwitchConfig& newConfig) {
   // We don't need to hold a lock here. updateStateBlocking() does that for us.
   auto routeUpdater = getRouteUpdater();
+  // curConfig_ only describes the current state if the last apply made it all
+  // the way to hardware. Otherwise fall back to a full config apply. Work
+  // on a copy, the update below overwrites curConfig_.
+  std::optional<cfg::SwitchConfig> prevConfigCopy;
+  if (FLAGS_incremental_config_apply && curConfigApplied_) {
+    prevConfigCopy = curConfig_;
+  }
+  const cfg::SwitchConfig* prevConfig =
+      prevConfigCopy ? &*prevConfigCopy : nullptr;
+  curConfigApplied_ = false;
   updateStateBlocking(
       reason,
       [&](const shared_ptr<SwitchState>& state) -> shared_ptr<SwitchState> {
@@ -1692,10 +1861,19 @@ void SwSwitch::applyConfig(
           XLOG(WARN) << "Current platform doesn't have QsfpCache. "
                      << "No need to build TransceiverMap";
         }
-        auto newState = rib_
-            ? applyThriftConfig(
-                  originalState, &newConfig, getPlatform(), &routeUpdater)
-            : applyThriftConfig(originalState, &newConfig, getPlatform());
+        auto newState = rib_ ? applyThriftConfig(
+                                   originalState,
+                                   &newConfig,
+                                   getPlatform(),
+                                   &routeUpdater,
+                                   prevConfig)
+                             : applyThriftConfig(
+                                   originalState,
+                                   &newConfig,
+                                   getPlatform(),
+                                   static_cast<RoutingInformationBase*>(
+                                       nullptr),
+                                   prevConfig);
 
         if (newState && !isValidStateUpdate(StateDelta(state, newState))) {
           throw FbossError("Invalid config passed in, skipping");
@@ -1738,6 +1916,7 @@ void SwSwitch::applyConfig(
    */
 
   routeUpdater.program();
+  curConfigApplied_ = true;
   if (fsdbStateSyncer_) {
     // TODO - figure out a way to send full agent config
     fsdbStateSyncer_->cfgUpdated(newConfig);
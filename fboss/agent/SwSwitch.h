@@ -784,10 +784,52 @@ class SwSwitch : public HwSwitch::Callback {
   void updatePtpTcCounter();
   static void handlePendingUpdatesHelper(SwSwitch* sw);
   void handlePendingUpdates();
+  StateUpdateList dequeuePendingUpdates();
+  std::shared_ptr<SwitchState> computeDesiredState(
+      const std::shared_ptr<SwitchState>& baseState,
+      StateUpdateList& updates);
+  void finishStateUpdates(
+      StateUpdateList& updates,
+      const std::shared_ptr<SwitchState>& newDesiredState,
+      const std::shared_ptr<SwitchState>& newAppliedState);
   std::shared_ptr<SwitchState> applyUpdate(
       const std::shared_ptr<SwitchState>& oldState,
       const std::shared_ptr<SwitchState>& newState,
       bool isTransaction);
+  /*
+   * applyUpdate() is split in two halves so that state update pipelining
+   * can program hardware off the update thread. programHw() returns the
+   * state that made it to hardware, or null if the update was skipped
+   * because we are exiting. finishApplyUpdate() must then be called on the
+   * update thread to publish the applied state and notify observers.
+   */
+  std::shared_ptr<SwitchState> programHw(
+      const std::shared_ptr<SwitchState>& oldState,
+      const std::shared_ptr<SwitchState>& newState,
+      bool isTransaction);
+  void finishApplyUpdate(
+      const std::shared_ptr<SwitchState>& oldState,
+      const std::shared_ptr<SwitchState>& newAppliedState,
+      std::chrono::steady_clock::time_point start);
+
+  /*
+   * A batch of coalesced state updates travelling through the update
+   * pipeline. See --enable_state_update_pipelining.
+   */
+  struct StateUpdateBatch {
+    StateUpdateList updates;
+    std::shared_ptr<SwitchState> oldState;
+    std::shared_ptr<SwitchState> desiredState;
+    // Set by the hw update thread once programming completes
+    std::shared_ptr<SwitchState> appliedState;
+    bool isTransaction{false};
+    bool hwFailureProtected{false};
+    std::chrono::steady_clock::time_point start;
+  };
+  void handlePendingUpdatesPipelined();
+  void startHwUpdate(std::unique_ptr<StateUpdateBatch> batch);
+  void hwUpdateDone();
+  void finishBatch(std::unique_ptr<StateUpdateBatch> batch);
 
   void publishToFsdb(const std::shared_ptr<SwitchState>& state) const;
 
@@ -832,6 +874,9 @@ class SwSwitch : public HwSwitch::Callback {
 
   std::string curConfigStr_;
   cfg::SwitchConfig curConfig_;
+  // Whether curConfig_ was fully applied, i.e. the current state was built
+  // from it and it can serve as the base of an incremental config apply.
+  std::atomic<bool> curConfigApplied_{false};
 
   // The HwSwitch object.  This object is owned by the Platform.
   HwSwitch* hw_;
@@ -897,6 +942,19 @@ class SwSwitch : public HwSwitch::Callback {
   folly::EventBase updateEventBase_;
   std::shared_ptr<ThreadHeartbeat> updThreadHeartbeat_;
 
+  /*
+   * With --enable_state_update_pipelining, hardware programming happens on
+   * this thread while the update thread computes the next SwitchState.
+   *
+   * inFlightBatch_ is being programmed to hardware, preparedBatch_ was
+   * computed on top of inFlightBatch_->desiredState and is waiting for its
+   * turn. Both are only accessed from the update thread.
+   */
+  std::unique_ptr<std::thread> hwUpdateThread_;
+  folly::EventBase hwUpdateEventBase_;
+  std::unique_ptr<StateUpdateBatch> inFlightBatch_;
+  std::unique_ptr<StateUpdateBatch> preparedBatch_;
+
   /*
    * A thread dedicated to LACP processing.
    */
@@ -222,6 +222,42 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
           AVG,
           50,
           100)),
+      neighborUpdateBatchSize_(makeTLTHistogram(
+          map,
+          kCounterPrefix + "neighbor_update_batch_size",
+          10,
+          0,
+          1000,
+          AVG,
+          50,
+          100)),
+      neighborUpdateLatency_(makeTLTHistogram(
+          map,
+          kCounterPrefix + "neighbor_update_latency.ms",
+          10,
+          0,
+          2000,
+          AVG,
+          50,
+          100)),
+      macTableUpdateBatchSize_(makeTLTHistogram(
+          map,
+          kCounterPrefix + "mac_table_update_batch_size",
+          100,
+          0,
+          10000,
+          AVG,
+          50,
+          100)),
+      macTableUpdateLatency_(makeTLTHistogram(
+          map,
+          kCounterPrefix + "mac_table_update_latency.ms",
+          10,
+          0,
+          2000,
+          AVG,
+          50,
+          100)),
       linkStateChange_(
           makeTLTimeseries(map, kCounterPrefix + "link_state.flap", SUM)),
       pcapDistFailure_(map, kCounterPrefix + "pcap_dist_failure.error"),
@@ -275,6 +275,16 @@ class SwitchStats : public boost::noncopyable {
     addValue(*neighborCacheEventBacklog_, value);
   }
 
+  void neighborUpdateBatch(int numUpdates, std::chrono::milliseconds latency) {
+    addValue(*neighborUpdateBatchSize_, numUpdates);
+    addValue(*neighborUpdateLatency_, latency.count());
+  }
+
+  void macTableUpdateBatch(int numUpdates, std::chrono::milliseconds latency) {
+    addValue(*macTableUpdateBatchSize_, numUpdates);
+    addValue(*macTableUpdateLatency_, latency.count());
+  }
+
   void linkStateChange() {
     addValue(*linkStateChange_, 1);
   }
@@ -532,6 +542,25 @@ class SwitchStats : public boost::noncopyable {
    */
   TLHistogramPtr neighborCacheEventBacklog_;
 
+  /**
+   * Number of neighbor changes applied in one state update
+   */
+  TLHistogramPtr neighborUpdateBatchSize_;
+  /**
+   * Time in milliseconds from a neighbor change in the cache until it is
+   * applied to the SwitchState, for the oldest change of each batch
+   */
+  TLHistogramPtr neighborUpdateLatency_;
+  /**
+   * Number of L2 learning updates applied in one state update
+   */
+  TLHistogramPtr macTableUpdateBatchSize_;
+  /**
+   * Time in milliseconds from receiving an L2 learning update until it is
+   * applied to the SwitchState, for the oldest update of each batch
+   */
+  TLHistogramPtr macTableUpdateLatency_;
+
   /**
    * Link state up/down change count
    */
@@ -103,6 +103,11 @@ DEFINE_bool(
     enable_running_config_mutations,
     false,
     "Allow external mutations of running config");
+DEFINE_bool(
+    enable_thrift_read_cache,
+    true,
+    "Cache responses of read-heavy thrift APIs per SwitchState and "
+    "coalesce identical concurrent calls");
 DECLARE_bool(skip_xphy_programming);
 
 namespace facebook::fboss {
@@ -167,8 +172,13 @@ void fillPortStats(PortInfoThrift& portInfo, int numPortQs) {
   }
 }
 
-void getPortInfoHelper(
+/*
+ * Fill in everything derived from the port's state and platform, i.e.
+ * everything but the stats. state is the switch state port was taken from.
+ */
+void populatePortInfo(
     const SwSwitch& sw,
+    const std::shared_ptr<SwitchState>& state,
     PortInfoThrift& portInfo,
     const std::shared_ptr<Port> port) {
   *portInfo.portId_ref() = port->getID();
@@ -180,7 +190,6 @@ void getPortInfoHelper(
   }
 
   std::shared_ptr<QosPolicy> qosPolicy;
-  auto state = sw.getState();
   if (port->getQosPolicy().has_value()) {
     auto appliedPolicyName = port->getQosPolicy();
     qosPolicy =
@@ -342,10 +351,36 @@ void getPortInfoHelper(
   } catch (const facebook::fboss::FbossError& err) {
     // No problem, we just don't set the other info
   }
+}
 
+void getPortInfoHelper(
+    const SwSwitch& sw,
+    const std::shared_ptr<SwitchState>& state,
+    PortInfoThrift& portInfo,
+    const std::shared_ptr<Port> port) {
+  populatePortInfo(sw, state, portInfo, port);
   fillPortStats(portInfo, portInfo.portQueues_ref()->size());
 }
 
+/*
+ * Serve a read API through cache. With a state the result is cached for
+ * that state, without one identical concurrent calls are only coalesced.
+ */
+template <typename Result, typename ComputeFn>
+void getCached(
+    StateReadCache<Result>& cache,
+    const std::shared_ptr<SwitchState>& state,
+    Result& result,
+    ComputeFn compute) {
+  if (!FLAGS_enable_thrift_read_cache) {
+    result = compute();
+  } else if (state) {
+    result = *cache.getForState(state, compute);
+  } else {
+    result = *cache.getCoalesced(compute);
+  }
+}
+
 LacpPortRateThrift fromLacpPortRate(facebook::fboss::cfg::LacpPortRate rate) {
   switch (rate) {
     case facebook::fboss::cfg::LacpPortRate::SLOW:
@@ -831,39 +866,45 @@ void ThriftHandler::getInterfaceDetail(
 void ThriftHandler::getNdpTable(std::vector<NdpEntryThrift>& ndpTable) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
-  auto entries = sw_->getNeighborUpdater()->getNdpCacheData().get();
-  ndpTable.reserve(entries.size());
-  ndpTable.insert(
-      ndpTable.begin(),
-      std::make_move_iterator(std::begin(entries)),
-      std::make_move_iterator(std::end(entries)));
+  // Neighbor caches live outside the SwitchState, coalesce calls only
+  getCached(ndpTableCache_, nullptr, ndpTable, [this]() {
+    return sw_->getNeighborUpdater()->getNdpCacheData().get();
+  });
 }
 
 void ThriftHandler::getArpTable(std::vector<ArpEntryThrift>& arpTable) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
-  auto entries = sw_->getNeighborUpdater()->getArpCacheData().get();
-  arpTable.reserve(entries.size());
-  arpTable.insert(
-      arpTable.begin(),
-      std::make_move_iterator(std::begin(entries)),
-      std::make_move_iterator(std::end(entries)));
+  // Neighbor caches live outside the SwitchState, coalesce calls only
+  getCached(arpTableCache_, nullptr, arpTable, [this]() {
+    return sw_->getNeighborUpdater()->getArpCacheData().get();
+  });
 }
 
 void ThriftHandler::getL2Table(std::vector<L2EntryThrift>& l2Table) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
-  sw_->getHw()->fetchL2Table(&l2Table);
+  // Walks the hardware table, so coalesce concurrent calls into one walk
+  getCached(l2TableCache_, nullptr, l2Table, [this]() {
+    std::vector<L2EntryThrift> entries;
+    sw_->getHw()->fetchL2Table(&entries);
+    return entries;
+  });
   XLOG(DBG6) << "L2 Table size:" << l2Table.size();
 }
 
 void ThriftHandler::getAclTable(std::vector<AclEntryThrift>& aclTable) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
-  aclTable.reserve(sw_->getState()->getAcls()->numEntries());
-  for (const auto& aclEntry : *(sw_->getState()->getAcls())) {
-    aclTable.push_back(populateAclEntryThrift(*aclEntry));
-  }
+  auto state = sw_->getState();
+  getCached(aclTableCache_, state, aclTable, [&state]() {
+    std::vector<AclEntryThrift> entries;
+    entries.reserve(state->getAcls()->numEntries());
+    for (const auto& aclEntry : *(state->getAcls())) {
+      entries.push_back(populateAclEntryThrift(*aclEntry));
+    }
+    return entries;
+  });
 }
 
 void ThriftHandler::getAggregatePort(
@@ -912,12 +953,13 @@ void ThriftHandler::getPortInfo(PortInfoThrift& portInfo, int32_t portId) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
 
-  const auto port = sw_->getState()->getPorts()->getPortIf(PortID(portId));
+  auto state = sw_->getState();
+  const auto port = state->getPorts()->getPortIf(PortID(portId));
   if (!port) {
     throw FbossError("no such port ", portId);
   }
 
-  getPortInfoHelper(*sw_, portInfo, port);
+  getPortInfoHelper(*sw_, state, portInfo, port);
 }
 
 void ThriftHandler::getAllPortInfo(map<int32_t, PortInfoThrift>& portInfoMap) {
@@ -927,10 +969,16 @@ void ThriftHandler::getAllPortInfo(map<int32_t, PortInfoThrift>& portInfoMap) {
   // NOTE: important to take pointer to switch state before iterating over
   // list of ports
   std::shared_ptr<SwitchState> swState = sw_->getState();
-  for (const auto& port : *(swState->getPorts())) {
-    auto portId = port->getID();
-    auto& portInfo = portInfoMap[portId];
-    getPortInfoHelper(*sw_, portInfo, port);
+  // Only the state derived part is cached, stats are always filled in fresh
+  getCached(portInfoCache_, swState, portInfoMap, [this, &swState]() {
+    map<int32_t, PortInfoThrift> portInfos;
+    for (const auto& port : *(swState->getPorts())) {
+      populatePortInfo(*sw_, swState, portInfos[port->getID()], port);
+    }
+    return portInfos;
+  });
+  for (auto& portInfo : portInfoMap) {
+    fillPortStats(portInfo.second, portInfo.second.portQueues_ref()->size());
   }
 }
 
@@ -1454,8 +1502,13 @@ void ThriftHandler::getRouteTableByClient(
 void ThriftHandler::getRouteTableDetails(std::vector<RouteDetails>& routes) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
-  forAllRoutes(sw_->getState(), [&routes](RouterID /*rid*/, const auto& route) {
-    routes.emplace_back(route->toRouteDetails(true));
+  auto state = sw_->getState();
+  getCached(routeDetailsCache_, state, routes, [&state]() {
+    std::vector<RouteDetails> details;
+    forAllRoutes(state, [&details](RouterID /*rid*/, const auto& route) {
+      details.emplace_back(route->toRouteDetails(true));
+    });
+    return details;
   });
 }
 
@@ -1573,10 +1626,10 @@ void ThriftHandler::getLldpNeighbors(vector<LinkNeighborThrift>& results) {
   auto* db = lldpMgr->getDB();
   // Do an immediate check for expired neighbors
   db->pruneExpiredNeighbors();
-  auto neighbors = db->getNeighbors();
-  results.reserve(neighbors.size());
+  auto neighbors = db->getNeighborsSnapshot();
+  results.reserve(neighbors->size());
   auto now = steady_clock::now();
-  for (const auto& entry : db->getNeighbors()) {
+  for (const auto& entry : *neighbors) {
     results.push_back(thriftLinkNeighbor(*sw_, entry, now));
   }
 }
@@ -1630,7 +1683,8 @@ void ThriftHandler::startPktCapture(unique_ptr<CaptureInfo> info) {
       *info->name_ref(),
       *info->maxPackets_ref(),
       *info->direction_ref(),
-      *info->filter_ref());
+      *info->filter_ref(),
+      *info->snaplen_ref());
   mgr->startCapture(std::move(capture));
 }
 
@@ -16,6 +16,7 @@
 
 #include "common/fb303/cpp/FacebookBase2.h"
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/StateReadCache.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/if/gen-cpp2/FbossCtrl.h"
 #include "fboss/agent/if/gen-cpp2/NeighborListenerClient.h"
@@ -437,6 +438,16 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
   apache::thrift::SSLPolicy sslPolicy_;
 
   std::unordered_set<uint16_t> syncedFibClients;
+
+  // Responses of read APIs polled by monitoring, see StateReadCache
+  StateReadCache<std::map<int32_t, PortInfoThrift>> portInfoCache_{
+      "port_info"};
+  StateReadCache<std::vector<ArpEntryThrift>> arpTableCache_{"arp_table"};
+  StateReadCache<std::vector<NdpEntryThrift>> ndpTableCache_{"ndp_table"};
+  StateReadCache<std::vector<L2EntryThrift>> l2TableCache_{"l2_table"};
+  StateReadCache<std::vector<AclEntryThrift>> aclTableCache_{"acl_table"};
+  StateReadCache<std::vector<RouteDetails>> routeDetailsCache_{
+      "route_details"};
 };
 
 } // namespace facebook::fboss
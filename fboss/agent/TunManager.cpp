@@ -18,10 +18,12 @@ extern "C" {
 #include <sys/ioctl.h>
 }
 
+#include <folly/Conv.h>
 #include <folly/MapUtil.h>
 #include <folly/io/async/EventBase.h>
 #include <folly/lang/CString.h>
 #include <folly/logging/xlog.h>
+#include "fboss/agent/NetlinkBatch.h"
 #include "fboss/agent/NlError.h"
 #include "fboss/agent/RxPacket.h"
 #include "fboss/agent/SysError.h"
@@ -42,7 +44,8 @@ namespace facebook::fboss {
 using folly::EventBase;
 using folly::IPAddress;
 
-TunManager::TunManager(SwSwitch* sw, EventBase* evb) : sw_(sw), evb_(evb) {
+TunManager::TunManager(SwSwitch* sw, EventBase* evb)
+    : AsyncStateObserver("TunManager", evb), sw_(sw), evb_(evb) {
   DCHECK(sw) << "NULL pointer to SwSwitch.";
   DCHECK(evb) << "NULL pointer to EventBase";
 
@@ -52,15 +55,18 @@ TunManager::TunManager(SwSwitch* sw, EventBase* evb) : sw_(sw), evb_(evb) {
   }
   auto error = nl_connect(sock_, NETLINK_ROUTE);
   nlCheckError(error, "failed to connect netlink socket to NETLINK_ROUTE");
+  nlBatch_ = std::make_unique<NetlinkBatch>(sock_);
 }
 
 TunManager::~TunManager() {
   if (observingState_) {
     sw_->unregisterStateObserver(this);
   }
+  stopAsyncProcessing();
 
   std::lock_guard<std::mutex> lock(mutex_);
   stop();
+  nlBatch_.reset();
   nl_close(sock_);
   nl_socket_free(sock_);
 }
@@ -70,7 +76,7 @@ void TunManager::startObservingUpdates() {
   observingState_ = true;
 }
 
-void TunManager::stateUpdated(const StateDelta& delta) {
+void TunManager::stateUpdatedAsync(const StateDelta& delta) {
   // TODO(aeckert): t15067879 We currently compare the entire
   // interface map instead of using the iterator in this delta because
   // some of the interfaces may get get probed from hardware before
@@ -82,8 +88,7 @@ void TunManager::stateUpdated(const StateDelta& delta) {
   // SwSwitch is in the configured state. t4155406 should also help
   // with that.
 
-  auto state = delta.newState();
-  evb_->runInEventBaseThread([this, state]() { this->sync(state); });
+  sync(delta.newState());
 }
 
 bool TunManager::sendPacketToHost(
@@ -164,6 +169,8 @@ void TunManager::removeIntf(InterfaceID ifID) {
 
   // Remove the route table and associated rule
   removeRouteTable(ifID, intf->getIfIndex());
+  // Requests above refer to the interface, send them before it goes away
+  nlBatch_->commit();
   intf->setDelete();
   intfs_.erase(iter);
 }
@@ -306,28 +313,34 @@ void TunManager::addRemoveRouteTable(InterfaceID ifID, int ifIndex, bool add) {
     rtnl_route_nh_set_ifindex(nexthop, ifIndex);
     rtnl_route_add_nexthop(route, nexthop);
 
+    struct nl_msg* msg = nullptr;
     if (add) {
-      error = rtnl_route_add(sock_, route, NLM_F_REPLACE);
+      error = rtnl_route_build_add_request(route, NLM_F_REPLACE, &msg);
     } else {
-      error = rtnl_route_delete(sock_, route, 0);
+      error = rtnl_route_build_del_request(route, 0, &msg);
     }
+    nlCheckError(error, "Failed to build default route request for ", addr);
     /**
-     * Disable: Because of some weird reason this CHECK fails while deleting
+     * Ignore errors: Because of some weird reason removal fails while deleting
      * v4 default route. However route actually gets wiped off from Linux
      * routing table.
-    nlCheckError(error, "Failed to ", add ? "add" : "remove",
-                  " default route ", addr, " @ index ", ifIndex,
-                  " in table ", getTableId(ifID), " for interface ", ifID,
-                  ". ErrorCode: ", error);
-      */
-    if (error < 0) {
-      XLOG(WARNING) << "Failed to " << (add ? "add" : "remove")
-                    << " default route " << addr << " @index " << ifIndex
-                    << ". ErrorCode: " << error;
-    }
-    XLOG(INFO) << (add ? "Added" : "Removed") << " default route " << addr
-               << " @ index " << ifIndex << " in table " << getTableId(ifID)
-               << " for interface " << ifID;
+     */
+    nlBatch_->add(
+        msg,
+        folly::to<std::string>(
+            add ? "add" : "remove",
+            " default route ",
+            addr.str(),
+            " @ index ",
+            ifIndex,
+            " in table ",
+            getTableId(ifID),
+            " for interface ",
+            ifID),
+        true /* ignoreErrors */);
+    XLOG(DBG2) << "Queued " << (add ? "add" : "removal") << " of default route "
+               << addr << " @ index " << ifIndex << " in table "
+               << getTableId(ifID) << " for interface " << ifID;
   }
 }
 
@@ -367,24 +380,26 @@ void TunManager::addRemoveSourceRouteRule(
   auto error = rtnl_rule_set_src(rule, sourceaddr);
   nlCheckError(error, "Failed to set destination route to ", addr);
 
+  struct nl_msg* msg = nullptr;
   if (add) {
-    error = rtnl_rule_add(sock_, rule, NLM_F_REPLACE);
+    error = rtnl_rule_build_add_request(rule, NLM_F_REPLACE, &msg);
   } else {
-    error = rtnl_rule_delete(sock_, rule, 0);
-  }
-  nlCheckError(
-      error,
-      "Failed to ",
-      add ? "add" : "remove",
-      " rule for address ",
-      addr,
-      " to lookup table ",
-      getTableId(ifID),
-      " for interface ",
-      ifID);
-  XLOG(INFO) << (add ? "Added" : "Removed") << " rule for address " << addr
-             << " to lookup table " << getTableId(ifID) << " for interface "
-             << ifID;
+    error = rtnl_rule_build_delete_request(rule, 0, &msg);
+  }
+  nlCheckError(error, "Failed to build rule request for address ", addr);
+  nlBatch_->add(
+      msg,
+      folly::to<std::string>(
+          add ? "add" : "remove",
+          " rule for address ",
+          addr.str(),
+          " to lookup table ",
+          getTableId(ifID),
+          " for interface ",
+          ifID));
+  XLOG(DBG2) << "Queued " << (add ? "add" : "removal")
+             << " of rule for address " << addr << " to lookup table "
+             << getTableId(ifID) << " for interface " << ifID;
 }
 
 void TunManager::addRemoveTunAddress(
@@ -392,7 +407,8 @@ void TunManager::addRemoveTunAddress(
     uint32_t ifIndex,
     const folly::IPAddress& addr,
     uint8_t mask,
-    bool add) {
+    bool add,
+    std::function<void()> onError) {
   auto tunaddr = rtnl_addr_alloc();
   if (!tunaddr) {
     throw FbossError("Failed to allocate address");
@@ -419,6 +435,7 @@ void TunManager::addRemoveTunAddress(
   rtnl_addr_set_prefixlen(tunaddr, mask);
   rtnl_addr_set_ifindex(tunaddr, ifIndex);
 
+  struct nl_msg* msg = nullptr;
   if (add) {
     /**
      * When you bring down interface some routes are purged but some still stay
@@ -427,25 +444,28 @@ void TunManager::addRemoveTunAddress(
      * addresses and routes for that interface with REPLACE flag overriding
      * existing ones if any.
      */
-    error = rtnl_addr_add(sock_, tunaddr, NLM_F_REPLACE);
+    error = rtnl_addr_build_add_request(tunaddr, NLM_F_REPLACE, &msg);
   } else {
-    error = rtnl_addr_delete(sock_, tunaddr, 0);
-  }
-  nlCheckError(
-      error,
-      "Failed to ",
-      add ? "add" : "remove",
-      " address ",
-      addr,
-      "/",
-      static_cast<int>(mask),
-      " to interface ",
-      ifName,
-      " @ index ",
-      ifIndex);
-  XLOG(INFO) << (add ? "Added" : "Removed") << " address " << addr.str() << "/"
-             << static_cast<int>(mask) << " on interface " << ifName
-             << " @ index " << ifIndex;
+    error = rtnl_addr_build_delete_request(tunaddr, 0, &msg);
+  }
+  nlCheckError(error, "Failed to build address request for ", addr);
+  nlBatch_->add(
+      msg,
+      folly::to<std::string>(
+          add ? "add" : "remove",
+          " address ",
+          addr.str(),
+          "/",
+          static_cast<int>(mask),
+          " to interface ",
+          ifName,
+          " @ index ",
+          ifIndex),
+      false /* ignoreErrors */,
+      std::move(onError));
+  XLOG(DBG2) << "Queued " << (add ? "add" : "removal") << " of address "
+             << addr.str() << "/" << static_cast<int>(mask) << " on interface "
+             << ifName << " @ index " << ifIndex;
 }
 
 void TunManager::addTunAddress(
@@ -455,15 +475,16 @@ void TunManager::addTunAddress(
     folly::IPAddress addr,
     uint8_t mask) {
   addRemoveSourceRouteRule(ifID, addr, true);
-  SCOPE_FAIL {
-    try {
-      addRemoveSourceRouteRule(ifID, addr, false);
-    } catch (const std::exception& ex) {
-      XLOG(ERR) << "Failed to removed partially added source rule on "
-                << "interface " << ifName;
-    }
-  };
-  addRemoveTunAddress(ifName, ifIndex, addr, mask, true);
+  // Requests only fail once committed, remove the rule then
+  addRemoveTunAddress(
+      ifName, ifIndex, addr, mask, true, [this, ifID, ifName, addr]() {
+        try {
+          addRemoveSourceRouteRule(ifID, addr, false);
+        } catch (const std::exception& ex) {
+          XLOG(ERR) << "Failed to removed partially added source rule on "
+                    << "interface " << ifName;
+        }
+      });
 }
 
 void TunManager::removeTunAddress(
@@ -473,15 +494,16 @@ void TunManager::removeTunAddress(
     folly::IPAddress addr,
     uint8_t mask) {
   addRemoveSourceRouteRule(ifID, addr, false);
-  SCOPE_FAIL {
-    try {
-      addRemoveSourceRouteRule(ifID, addr, true);
-    } catch (const std::exception& ex) {
-      XLOG(ERR) << "Failed to add partially added source rule on "
-                << "interface " << ifName;
-    }
-  };
-  addRemoveTunAddress(ifName, ifIndex, addr, mask, false);
+  // Requests only fail once committed, add the rule back then
+  addRemoveTunAddress(
+      ifName, ifIndex, addr, mask, false, [this, ifID, ifName, addr]() {
+        try {
+          addRemoveSourceRouteRule(ifID, addr, true);
+        } catch (const std::exception& ex) {
+          XLOG(ERR) << "Failed to add partially added source rule on "
+                    << "interface " << ifName;
+        }
+      });
 }
 
 void TunManager::start() const {
@@ -761,6 +783,14 @@ void TunManager::sync(std::shared_ptr<SwitchState> state) {
       },
       [&](ConstIntfToAddrsMapIter& oldIter) { removeIntf(oldIter->first); });
 
+  // Send everything queued above in as few round trips as possible
+  auto numSent = nlBatch_->numRequestsSent();
+  auto numRoundTrips = nlBatch_->numRoundTrips();
+  nlBatch_->commit();
+  XLOG(INFO) << "Applied " << nlBatch_->numRequestsSent() - numSent
+             << " netlink requests in "
+             << nlBatch_->numRoundTrips() - numRoundTrips << " round trips";
+
   start();
 
   // track number of times sync is called
@@ -10,11 +10,12 @@
 #pragma once
 
 #include <folly/io/async/EventBase.h>
-#include "fboss/agent/StateObserver.h"
+#include "fboss/agent/AsyncStateObserver.h"
 #include "fboss/agent/state/Interface.h"
 #include "fboss/agent/types.h"
 
 #include <boost/container/flat_map.hpp>
+#include <functional>
 
 extern "C" {
 #include <netlink/object.h>
@@ -24,21 +25,22 @@ extern "C" {
 namespace facebook::fboss {
 
 class InterfaceMap;
+class NetlinkBatch;
 class RxPacket;
 class SwSwitch;
 class TunIntf;
 
-class TunManager : public StateObserver {
+class TunManager : public AsyncStateObserver {
  public:
   TunManager(SwSwitch* sw, folly::EventBase* evb);
   ~TunManager() override;
 
   /**
-   * Update the intfs_ map based on the given state update. This
-   * overrides the StateObserver stateUpdated api, which is always
-   * guaranteed to be called from the update thread.
+   * Update the intfs_ map based on the given state update. This is called
+   * on the thread that serves evb_, with back to back updates coalesced so
+   * slow netlink calls do not hold up the update thread.
    */
-  void stateUpdated(const StateDelta& delta) override;
+  void stateUpdatedAsync(const StateDelta& delta) override;
 
   /**
    * Send a packet to host.
@@ -145,14 +147,16 @@ class TunManager : public StateObserver {
       bool add);
 
   /**
-   * Add/Remove an address to/from a TUN interface on the host
+   * Add/Remove an address to/from a TUN interface on the host. onError is
+   * called on commit if the request failed.
    */
   void addRemoveTunAddress(
       const std::string& ifName,
       uint32_t ifIndex,
       const folly::IPAddress& addr,
       uint8_t mask,
-      bool add);
+      bool add,
+      std::function<void()> onError = nullptr);
 
   /**
    * Add/Remove address as well source-routing-rule for TUN interface on host.
@@ -221,6 +225,10 @@ class TunManager : public StateObserver {
   // Netlink socket for managing interface/addresses in Host/Linux
   nl_sock* sock_{nullptr};
 
+  // Address, rule and route requests queued on sock_. Only accessed while
+  // holding mutex_, sync() commits them.
+  std::unique_ptr<NetlinkBatch> nlBatch_;
+
   /**
    * The mutex used to protect `intfs_` which can be used by
    * sync() could manipulate intfs_. Called on the thread that serves evb_.
@@ -9,95 +9,228 @@
  */
 #include "fboss/agent/capture/PcapFile.h"
 
-#include "fboss/agent/capture/PcapPkt.h"
+#include "fboss/agent/capture/PcapQueue.h"
 
 #include <folly/Exception.h>
 #include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <folly/logging/xlog.h>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
 #include <chrono>
+#include <cstring>
+#include <utility>
 
-using folly::IOBuf;
-using folly::writeFull;
-using folly::writevFull;
 using std::chrono::microseconds;
-using std::chrono::seconds;
 
-namespace facebook::fboss {
+namespace {
+
+// How much of the file to map at a time
+constexpr size_t kMappingChunkSize = 4 * 1024 * 1024;
+
+// pcapng block types and options, see
+// https://www.ietf.org/archive/id/draft-tuexen-opsawg-pcapng-03.html
+constexpr uint32_t kSectionHeaderBlock = 0x0A0D0D0A;
+constexpr uint32_t kInterfaceDescriptionBlock = 0x00000001;
+constexpr uint32_t kEnhancedPacketBlock = 0x00000006;
+constexpr uint32_t kByteOrderMagic = 0x1A2B3C4D;
+constexpr uint16_t kOptEndOfOpt = 0;
+constexpr uint16_t kOptEpbFlags = 2;
+constexpr uint32_t kEpbFlagsInbound = 1;
+constexpr uint32_t kEpbFlagsOutbound = 2;
+
+struct SectionHeaderBlock {
+  uint32_t blockType{kSectionHeaderBlock};
+  uint32_t blockLength{sizeof(SectionHeaderBlock)};
+  uint32_t byteOrderMagic{kByteOrderMagic};
+  uint16_t versionMajor{1};
+  uint16_t versionMinor{0};
+  // -1 means the section length is not specified
+  int64_t sectionLength{-1};
+  uint32_t blockLengthTrailer{sizeof(SectionHeaderBlock)};
+};
+static_assert(sizeof(SectionHeaderBlock) == 28);
+
+struct InterfaceDescriptionBlock {
+  uint32_t blockType{kInterfaceDescriptionBlock};
+  uint32_t blockLength{sizeof(InterfaceDescriptionBlock)};
+  // Link type 1 is ethernet.  Other possible types we might want to use
+  // include 113 for linux "cooked" capture format.
+  uint16_t linkType{1};
+  uint16_t reserved{0};
+  uint32_t snaplen{0};
+  uint32_t blockLengthTrailer{sizeof(InterfaceDescriptionBlock)};
+};
+static_assert(sizeof(InterfaceDescriptionBlock) == 20);
+
+// Followed by the packet data, padded to 4 bytes, and EnhancedPacketTrailer
+struct EnhancedPacketHeader {
+  uint32_t blockType{kEnhancedPacketBlock};
+  uint32_t blockLength{0};
+  uint32_t interfaceId{0};
+  // Microseconds since the epoch, the default interface timestamp resolution
+  uint32_t timestampHigh{0};
+  uint32_t timestampLow{0};
+  uint32_t capturedLength{0};
+  uint32_t originalLength{0};
+};
+
+struct EnhancedPacketTrailer {
+  uint16_t flagsCode{kOptEpbFlags};
+  uint16_t flagsLength{sizeof(uint32_t)};
+  uint32_t flags{0};
+  uint16_t endOfOptCode{kOptEndOfOpt};
+  uint16_t endOfOptLength{0};
+  uint32_t blockLengthTrailer{0};
+};
+static_assert(sizeof(EnhancedPacketHeader) == 28);
+static_assert(sizeof(EnhancedPacketTrailer) == 16);
+
+size_t padTo4(size_t len) {
+  return (len + 3) & ~size_t(3);
+}
 
-PcapFile::PktHeader::PktHeader(const PcapPkt& pkt) {
-  auto ts = pkt.timestamp().time_since_epoch();
-  seconds tsSec = std::chrono::duration_cast<seconds>(ts);
-  microseconds tsUsec = std::chrono::duration_cast<microseconds>(ts);
-  auto len = pkt.buf()->computeChainDataLength();
+} // namespace
 
-  timeSec = tsSec.count();
-  timeUsec = (tsUsec - tsSec).count();
-  includedLen = len;
-  origLen = len;
-}
+namespace facebook::fboss {
 
 PcapFile::PcapFile() {}
 
 PcapFile::PcapFile(folly::StringPiece path, bool overwriteExisting)
     : file_(path.str().c_str(), openFlags(overwriteExisting), 0644) {}
 
-PcapFile::~PcapFile() {}
+PcapFile::~PcapFile() {
+  try {
+    close();
+  } catch (const std::exception& ex) {
+    XLOG(ERR) << "error closing pcap file: " << folly::exceptionStr(ex);
+  }
+}
+
+PcapFile::PcapFile(PcapFile&& other) noexcept
+    : file_(std::move(other.file_)),
+      offset_(std::exchange(other.offset_, 0)),
+      mapping_(std::exchange(other.mapping_, nullptr)),
+      mappingOffset_(std::exchange(other.mappingOffset_, 0)),
+      mappingLength_(std::exchange(other.mappingLength_, 0)) {}
+
+PcapFile& PcapFile::operator=(PcapFile&& other) noexcept {
+  if (this != &other) {
+    unmap();
+    file_ = std::move(other.file_);
+    offset_ = std::exchange(other.offset_, 0);
+    mapping_ = std::exchange(other.mapping_, nullptr);
+    mappingOffset_ = std::exchange(other.mappingOffset_, 0);
+    mappingLength_ = std::exchange(other.mappingLength_, 0);
+  }
+  return *this;
+}
 
 void PcapFile::close() {
-  file_.close();
+  unmap();
+  if (file_) {
+    // Drop the unused part of the last chunk we mapped
+    int ret = folly::ftruncateNoInt(file_.fd(), offset_);
+    folly::checkUnixError(ret, "error truncating pcap file");
+    file_.close();
+  }
 }
 
-void PcapFile::writeGlobalHeader() {
-  struct GlobalHeader {
-    uint32_t magic;
-    uint16_t versionMajor;
-    uint16_t versionMinor;
-    uint32_t tzOffset;
-    uint32_t sigfigs;
-    uint32_t snaplen;
-    uint32_t linkType;
-  } hdr;
-  hdr.magic = 0xa1b2c3d4;
-  hdr.versionMajor = 2;
-  hdr.versionMinor = 4;
-  hdr.tzOffset = 0;
-  hdr.sigfigs = 0;
-  hdr.snaplen = 0xffff;
-  // Link type 1 is ethernet.  Other possible types we might want to use
-  // include 113 for linux "cooked" capture format.
-  hdr.linkType = 1;
+void PcapFile::writeGlobalHeader(uint32_t snaplen) {
+  SectionHeaderBlock shb;
+  std::memcpy(append(sizeof(shb)), &shb, sizeof(shb));
 
-  int ret = writeFull(file_.fd(), &hdr, sizeof(hdr));
-  folly::checkUnixError(ret, "error writing pcap global header");
+  InterfaceDescriptionBlock idb;
+  idb.snaplen = snaplen;
+  std::memcpy(append(sizeof(idb)), &idb, sizeof(idb));
 }
 
-void PcapFile::writePackets(const std::vector<PcapPkt>& pkts) {
-  folly::fbvector<PktHeader> hdrs;
-  hdrs.reserve(pkts.size());
-  folly::fbvector<struct iovec> iov;
-  // Reserve enough space, assuming each packet is in a single IOBuf.
-  // If some packets are split across IOBuf chains then we will end up
-  // allocating more space as needed in the loop below.
-  iov.reserve(pkts.size() * 2);
-
-  // Build iovecs for all of the packet headers and data
-  for (const auto& pkt : pkts) {
-    hdrs.emplace_back(pkt);
-    PktHeader* curHdr = &hdrs.back();
-    iov.push_back({(void*)curHdr, sizeof(PktHeader)});
-    pkt.buf()->appendToIov(&iov);
+void PcapFile::writePackets(const std::vector<const PcapSlot*>& slots) {
+  for (const auto* slot : slots) {
+    auto capturedLength = slot->data.size();
+    auto paddedLength = padTo4(capturedLength);
+    auto blockLength = sizeof(EnhancedPacketHeader) + paddedLength +
+        sizeof(EnhancedPacketTrailer);
+
+    auto ts = std::chrono::duration_cast<microseconds>(
+                  slot->timestamp.time_since_epoch())
+                  .count();
+    EnhancedPacketHeader hdr;
+    hdr.blockLength = blockLength;
+    hdr.timestampHigh = static_cast<uint64_t>(ts) >> 32;
+    hdr.timestampLow = static_cast<uint64_t>(ts) & 0xffffffff;
+    hdr.capturedLength = capturedLength;
+    hdr.originalLength = slot->origLen;
+
+    EnhancedPacketTrailer trailer;
+    trailer.flags = slot->rx ? kEpbFlagsInbound : kEpbFlagsOutbound;
+    trailer.blockLengthTrailer = blockLength;
+
+    auto out = append(blockLength);
+    std::memcpy(out, &hdr, sizeof(hdr));
+    out += sizeof(hdr);
+    std::memcpy(out, slot->data.data(), capturedLength);
+    std::memset(out + capturedLength, 0, paddedLength - capturedLength);
+    out += paddedLength;
+    std::memcpy(out, &trailer, sizeof(trailer));
   }
-
-  int ret = writevFull(file_.fd(), iov.data(), iov.size());
-  folly::checkUnixError(ret, "error writing pcap data");
 }
 
 int PcapFile::openFlags(bool overwriteExisting) {
-  int flags = O_CREAT | O_WRONLY;
+  // Mapping the file for writing requires it to be open for reading too
+  int flags = O_CREAT | O_RDWR;
   if (!overwriteExisting) {
     flags |= O_EXCL;
   }
   return flags;
 }
 
+uint8_t* PcapFile::append(size_t len) {
+  if (!mapping_ || offset_ + len > mappingOffset_ + mappingLength_) {
+    remap(len);
+  }
+  auto out = mapping_ + (offset_ - mappingOffset_);
+  offset_ += len;
+  return out;
+}
+
+void PcapFile::remap(size_t len) {
+  unmap();
+
+  static const size_t pageSize = sysconf(_SC_PAGESIZE);
+  mappingOffset_ = offset_ - offset_ % pageSize;
+  auto length = std::max(kMappingChunkSize, offset_ - mappingOffset_ + len);
+  length = (length + pageSize - 1) / pageSize * pageSize;
+
+  // Allocate the blocks backing the mapping up front: running out of space
+  // while writing through the mapping would raise SIGBUS rather than fail.
+  int err = posix_fallocate(file_.fd(), mappingOffset_, length);
+  if (err != 0) {
+    folly::throwSystemErrorExplicit(err, "error extending pcap file");
+  }
+  void* addr = mmap(
+      nullptr,
+      length,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED,
+      file_.fd(),
+      mappingOffset_);
+  if (addr == MAP_FAILED) {
+    folly::throwSystemError("error mapping pcap file");
+  }
+  mapping_ = static_cast<uint8_t*>(addr);
+  mappingLength_ = length;
+}
+
+void PcapFile::unmap() {
+  if (mapping_) {
+    munmap(mapping_, mappingLength_);
+    mapping_ = nullptr;
+    mappingLength_ = 0;
+  }
+}
+
 } // namespace facebook::fboss
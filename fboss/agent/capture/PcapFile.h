@@ -15,10 +15,15 @@
 
 namespace facebook::fboss {
 
-class PcapPkt;
+struct PcapSlot;
 
 /*
- * PcapFile supports writing packets to a file in pcap format.
+ * PcapFile supports writing packets to a file in pcapng format.
+ *
+ * The file is written through a shared memory mapping, which is grown a chunk
+ * at a time, and trimmed to the data actually written on close().  Each chunk
+ * is allocated on disk before it is mapped, so running out of space fails the
+ * write instead of faulting.
  *
  * PcapFile uses blocking I/O.  If you are recording packets from a
  * non-blocking thread, you should use PcapWriter instead of using PcapFile
@@ -32,30 +37,38 @@ class PcapFile {
 
   void close();
 
-  void writeGlobalHeader();
-  void writePackets(const std::vector<PcapPkt>& pkt);
+  /*
+   * Write the section header, and the description of the single ethernet
+   * interface all packets are recorded on.
+   */
+  void writeGlobalHeader(uint32_t snaplen);
+  void writePackets(const std::vector<const PcapSlot*>& slots);
 
   // Move constructor and assignment operator
-  PcapFile(PcapFile&&) = default;
-  PcapFile& operator=(PcapFile&&) = default;
+  PcapFile(PcapFile&& other) noexcept;
+  PcapFile& operator=(PcapFile&& other) noexcept;
 
  private:
-  struct PktHeader {
-    explicit PktHeader(const PcapPkt& pkt);
-
-    uint32_t timeSec{0};
-    uint32_t timeUsec{0};
-    uint32_t includedLen{0};
-    uint32_t origLen{0};
-  };
-
   // Forbidden copy constructor and assignment operator
   PcapFile(PcapFile const&) = delete;
   PcapFile& operator=(PcapFile const&) = delete;
 
   static int openFlags(bool overwriteExisting);
 
+  /*
+   * Return a pointer to len bytes at the current end of the file, and advance
+   * past them.  Maps the next chunk of the file if needed.
+   */
+  uint8_t* append(size_t len);
+  void remap(size_t len);
+  void unmap();
+
   folly::File file_;
+  // Offset of the end of the data written so far
+  size_t offset_{0};
+  uint8_t* mapping_{nullptr};
+  size_t mappingOffset_{0};
+  size_t mappingLength_{0};
 };
 
 } // namespace facebook::fboss
@@ -9,9 +9,13 @@
  */
 #include "fboss/agent/capture/PcapQueue.h"
 
+#include "fboss/agent/FbossError.h"
 #include "fboss/agent/RxPacket.h"
 #include "fboss/agent/TxPacket.h"
-#include "fboss/agent/capture/PcapPkt.h"
+
+#include <folly/io/Cursor.h>
+
+#include <algorithm>
 
 DEFINE_int32(
     fboss_pcap_queue_depth,
@@ -19,101 +23,148 @@ DEFINE_int32(
     "When taking packet captures, the maximum number of packets "
     "to buffer in memory while waiting them to be written to the "
     "capture file");
+DEFINE_int32(
+    fboss_pcap_snaplen,
+    2048,
+    "When taking packet captures, the maximum number of bytes of each "
+    "packet to capture, at most 16384. Memory for this many bytes per "
+    "buffered packet is allocated up front when a capture starts");
 
 namespace facebook::fboss {
 
-PcapQueue::PcapQueue(uint32_t pktCapacity, uint64_t bytesCapacity)
+PcapQueue::PcapQueue(uint32_t pktCapacity, uint32_t snaplen)
     : pktCapacity_(
           pktCapacity == 0 ? FLAGS_fboss_pcap_queue_depth : pktCapacity),
-      bytesCapacity_(bytesCapacity) {
-  queue_.reserve(pktCapacity_);
+      snaplen_(std::min<uint32_t>(
+          snaplen == 0 ? FLAGS_fboss_pcap_snaplen : snaplen,
+          kMaxSnaplen)) {
+  if (pktCapacity_ == 0 || snaplen_ == 0) {
+    throw FbossError(
+        "invalid pcap queue of ",
+        pktCapacity_,
+        " packets of ",
+        snaplen_,
+        " bytes");
+  }
+  storage_ = std::make_unique<uint8_t[]>(size_t(pktCapacity_) * snaplen_);
+  slots_.resize(pktCapacity_);
 }
 
 PcapQueue::~PcapQueue() {}
 
-template <typename PktType>
-void PcapQueue::addPktInternal(const PktType* pkt) {
-  // Check to see if this would exceed the queue capacity.
-  if (queue_.size() >= pktCapacity_) {
-    pktsDropped_ += 1;
+void PcapQueue::addPktInternal(
+    const folly::IOBuf* buf,
+    bool rx,
+    PortID port,
+    VlanID vlan) {
+  if (finished_.load(std::memory_order_relaxed)) {
+    // The reader may already have freed the slots
     return;
   }
-  auto newBytes = bytesInQueue_ + pkt->buf()->computeChainDataLength();
-  if (bytesCapacity_ > 0 && newBytes >= bytesCapacity_) {
-    pktsDropped_ += 1;
+  // Check to see if this would exceed the queue capacity.
+  auto head = head_.load(std::memory_order_relaxed);
+  if (head - tail_.load(std::memory_order_acquire) >= pktCapacity_) {
+    pktsDropped_.fetch_add(1, std::memory_order_relaxed);
     return;
   }
 
-  queue_.emplace_back(pkt);
+  auto index = head % pktCapacity_;
+  auto origLen = buf->computeChainDataLength();
+  auto capturedLen = std::min<size_t>(origLen, snaplen_);
+  auto data = storage_.get() + index * snaplen_;
+  folly::io::Cursor(buf).pull(data, capturedLen);
+
+  auto& slot = slots_[index];
+  slot.rx = rx;
+  slot.port = port;
+  slot.vlan = vlan;
+  slot.timestamp = std::chrono::system_clock::now();
+  slot.origLen = origLen;
+  slot.data = folly::ByteRange(data, capturedLen);
+
+  // Publishing head_ and checking readerWaiting_ are both sequentially
+  // consistent, so either the reader sees the new packet or we see that it
+  // went to sleep.
+  head_.store(head + 1);
+  if (readerWaiting_.load()) {
+    std::lock_guard<std::mutex> guard(readerMutex_);
+    readerCv_.notify_one();
+  }
 }
 
 void PcapQueue::addPkt(const RxPacket* pkt) {
-  {
-    std::lock_guard<std::mutex> guard(mutex_);
-    addPktInternal(pkt);
-  }
-  cv_.notify_one();
+  std::lock_guard<std::mutex> guard(mutex_);
+  addPktLocked(pkt);
 }
 
 void PcapQueue::addPktLocked(const RxPacket* pkt) {
-  addPktInternal(pkt);
-  // It is preferred not to be holding the lock when we signal cv_,
-  // but it is okay to call it with the lock held anyway.  (Having the lock
-  // held will just prevent the reader thread from being able to acquire it
-  // immediately when the reader wakes.)
-  cv_.notify_one();
+  addPktInternal(pkt->buf(), true, pkt->getSrcPort(), pkt->getSrcVlan());
 }
 
 void PcapQueue::addPkt(const TxPacket* pkt) {
-  {
-    std::lock_guard<std::mutex> guard(mutex_);
-    addPktInternal(pkt);
-  }
-  cv_.notify_one();
+  std::lock_guard<std::mutex> guard(mutex_);
+  addPktLocked(pkt);
 }
 
 void PcapQueue::addPktLocked(const TxPacket* pkt) {
-  addPktInternal(pkt);
-  // It is preferred not to be holding the lock when we signal cv_,
-  // but it is okay to call it with the lock held anyway.  (Having the lock
-  // held will just prevent the reader thread from being able to acquire it
-  // immediately when the reader wakes.)
-  cv_.notify_one();
+  addPktInternal(pkt->buf(), false, PortID(0), VlanID(0));
 }
 
 void PcapQueue::finish() {
-  std::lock_guard<std::mutex> guard(mutex_);
-  finished_ = true;
-  cv_.notify_all();
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    finished_.store(true);
+  }
+  std::lock_guard<std::mutex> guard(readerMutex_);
+  readerCv_.notify_all();
 }
 
 bool PcapQueue::isFinished() const {
-  std::lock_guard<std::mutex> guard(mutex_);
-  return finished_;
+  return finished_.load();
 }
 
 uint64_t PcapQueue::numDropped() const {
-  std::lock_guard<std::mutex> guard(mutex_);
-  return pktsDropped_;
+  return pktsDropped_.load(std::memory_order_relaxed);
 }
 
-bool PcapQueue::wait(std::vector<PcapPkt>* swapQueue) {
-  swapQueue->clear();
-  swapQueue->reserve(pktCapacity_);
-
-  std::unique_lock<std::mutex> guard(mutex_);
-  while (queue_.empty() && !finished_) {
-    cv_.wait(guard);
+bool PcapQueue::wait(std::vector<const PcapSlot*>* slots) {
+  slots->clear();
+
+  auto tail = tail_.load(std::memory_order_relaxed);
+  auto head = head_.load();
+  if (head == tail) {
+    std::unique_lock<std::mutex> guard(readerMutex_);
+    readerWaiting_.store(true);
+    while ((head = head_.load()) == tail) {
+      if (finished_.load()) {
+        // Packets added before finish() are visible now
+        head = head_.load();
+        break;
+      }
+      readerCv_.wait(guard);
+    }
+    readerWaiting_.store(false);
   }
-  if (queue_.empty()) {
-    DCHECK(finished_);
-    queue_.shrink_to_fit();
+
+  if (head == tail) {
+    DCHECK(finished_.load());
+    slots_.clear();
+    slots_.shrink_to_fit();
+    storage_.reset();
     return false;
   }
 
-  swapQueue->swap(queue_);
-  bytesInQueue_ = 0;
+  slots->reserve(head - tail);
+  for (auto i = tail; i != head; ++i) {
+    slots->push_back(&slots_[i % pktCapacity_]);
+  }
   return true;
 }
 
+void PcapQueue::release(size_t numSlots) {
+  tail_.store(
+      tail_.load(std::memory_order_relaxed) + numSlots,
+      std::memory_order_release);
+}
+
 } // namespace facebook::fboss
@@ -9,35 +9,73 @@
  */
 #pragma once
 
+#include "fboss/agent/types.h"
+
+#include <folly/Range.h>
+
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <vector>
 
+namespace folly {
+class IOBuf;
+}
+
 namespace facebook::fboss {
 
 class RxPacket;
 class TxPacket;
-class PcapPkt;
 
 /*
- * PcapQueue stores a queue of PcapPkt objects, for transferring packets
- * from an asynchronous capture thread to a blocking thread that will process
+ * A packet stored in a PcapQueue slot.
+ *
+ * data points into the queue's preallocated storage, and holds at most
+ * snaplen bytes of the packet.  It is only valid until the slot is released.
+ */
+struct PcapSlot {
+  bool rx{false};
+  PortID port{0};
+  VlanID vlan{0};
+  std::chrono::system_clock::time_point timestamp;
+  uint32_t origLen{0};
+  folly::ByteRange data;
+};
+
+/*
+ * PcapQueue stores captured packets, for transferring them from an
+ * asynchronous capture thread to a blocking thread that will process
  * the packets.  (For instance, writing them to disk using blocking I/O.)
  *
- * There can only be a single reader.
+ * The queue is a ring of fixed size slots allocated up front.  Adding a
+ * packet copies at most snaplen bytes of it into the next free slot, without
+ * any allocation, and drops the packet if the ring is full.  snaplen is
+ * capped at kMaxSnaplen to bound the size of the ring.
+ *
+ * Writers are serialized by mutex().  There can only be a single reader,
+ * which never takes mutex(): it consumes slots in place, and hands them back
+ * with release() once it is done with them.
  */
 class PcapQueue {
  public:
-  explicit PcapQueue(uint32_t pktCapacity, uint64_t bytesCapacity = 0);
+  // Larger than any frame the CPU sees, including jumbo frames
+  static constexpr uint32_t kMaxSnaplen = 16384;
+
+  explicit PcapQueue(uint32_t pktCapacity, uint32_t snaplen = 0);
   virtual ~PcapQueue();
 
   uint32_t getPktCapacity() const {
     // pktCapacity_ is const, so no need for locking
     return pktCapacity_;
   }
+  uint32_t getSnaplen() const {
+    return snaplen_;
+  }
 
   /*
-   * Get the mutex protecting this PcapQueue.
+   * Get the mutex serializing writers to this PcapQueue.
    *
    * This is exposed to allow callers to also protect their own data
    * with the same mutex if desired.  Callers should call addPktLocked()
@@ -71,31 +109,45 @@ class PcapQueue {
   uint64_t numDropped() const;
 
   /*
-   * Wait for new packets from the queue.
+   * Wait for new packets from the queue, and return all of the slots that are
+   * ready to be read.
    *
-   * Note: for best performance, the writer should re-use the same vector
-   * for multiple wait() calls.  On subsequent calls the queue will already
-   * have the desired capacity, and will not need to reallocate memory.
+   * The slots remain owned by the reader until they are passed back with
+   * release().  Once the queue is finished and drained this returns false,
+   * and frees the slot storage.
    */
-  bool wait(std::vector<PcapPkt>* swapQueue);
+  bool wait(std::vector<const PcapSlot*>* slots);
+  void release(size_t numSlots);
 
  private:
   // Forbidden copy constructor and assignment operator
   PcapQueue(PcapQueue const&) = delete;
   PcapQueue& operator=(PcapQueue const&) = delete;
 
-  template <typename PktType>
-  void addPktInternal(const PktType* pkt);
+  void addPktInternal(
+      const folly::IOBuf* buf,
+      bool rx,
+      PortID port,
+      VlanID vlan);
 
+  // Serializes writers
   mutable std::mutex mutex_;
-  std::condition_variable cv_;
+  // Only used to put the reader to sleep when the queue is empty
+  std::mutex readerMutex_;
+  std::condition_variable readerCv_;
+  std::atomic<bool> readerWaiting_{false};
 
-  bool finished_{false};
+  std::atomic<bool> finished_{false};
   const uint32_t pktCapacity_{0};
-  uint64_t bytesCapacity_{0};
-  uint64_t bytesInQueue_{0};
-  uint64_t pktsDropped_{0};
-  std::vector<PcapPkt> queue_;
+  const uint32_t snaplen_{0};
+  std::atomic<uint64_t> pktsDropped_{0};
+
+  // Slot i stores its packet data at storage_[i * snaplen_].  head_ is only
+  // advanced by writers and tail_ only by the reader.
+  std::vector<PcapSlot> slots_;
+  std::unique_ptr<uint8_t[]> storage_;
+  std::atomic<uint64_t> head_{0};
+  std::atomic<uint64_t> tail_{0};
 };
 
 } // namespace facebook::fboss
@@ -9,8 +9,6 @@
  */
 #include "fboss/agent/capture/PcapWriter.h"
 
-#include "fboss/agent/capture/PcapPkt.h"
-
 #include <folly/String.h>
 #include <folly/logging/xlog.h>
 
@@ -18,14 +16,16 @@ using folly::StringPiece;
 
 namespace facebook::fboss {
 
-PcapWriter::PcapWriter(uint32_t maxBufferedPkts) : queue_(maxBufferedPkts) {}
+PcapWriter::PcapWriter(uint32_t maxBufferedPkts, uint32_t snaplen)
+    : queue_(maxBufferedPkts, snaplen) {}
 
 PcapWriter::PcapWriter(
     StringPiece path,
     bool overwriteExisting,
-    uint32_t maxBufferedPkts)
+    uint32_t maxBufferedPkts,
+    uint32_t snaplen)
     : file_(path, overwriteExisting),
-      queue_(maxBufferedPkts),
+      queue_(maxBufferedPkts, snaplen),
       thread_(&PcapWriter::threadMain, this) {}
 
 PcapWriter::~PcapWriter() {
@@ -60,7 +60,7 @@ void PcapWriter::finish() {
 
 void PcapWriter::threadMain() {
   try {
-    file_.writeGlobalHeader();
+    file_.writeGlobalHeader(queue_.getSnaplen());
     writeLoop();
     file_.close();
   } catch (const std::exception& ex) {
@@ -70,16 +70,11 @@ void PcapWriter::threadMain() {
 }
 
 void PcapWriter::writeLoop() {
-  std::vector<PcapPkt> pkts;
-  while (true) {
-    pkts.clear();
-    if (!queue_.wait(&pkts)) {
-      DCHECK(pkts.empty());
-      return;
-    }
-
-    DCHECK(!pkts.empty());
-    file_.writePackets(pkts);
+  std::vector<const PcapSlot*> slots;
+  while (queue_.wait(&slots)) {
+    DCHECK(!slots.empty());
+    file_.writePackets(slots);
+    queue_.release(slots.size());
   }
 }
 
@@ -18,17 +18,18 @@ namespace facebook::fboss {
 
 /*
  * PcapWriter listes to a PcapQueue and writes the packets it receives
- * to a pcap file.
+ * to a pcapng file, straight out of the queue's slots.
  *
  * It performs blocking disk I/O, so it performs the writes in its own thread.
  */
 class PcapWriter {
  public:
-  explicit PcapWriter(uint32_t maxBufferedPkts = 0);
+  explicit PcapWriter(uint32_t maxBufferedPkts = 0, uint32_t snaplen = 0);
   explicit PcapWriter(
       folly::StringPiece path,
       bool overwriteExisting = false,
-      uint32_t maxBufferedPkts = 0);
+      uint32_t maxBufferedPkts = 0,
+      uint32_t snaplen = 0);
   virtual ~PcapWriter();
 
   void start(folly::StringPiece path, bool overwriteExisting = false);
@@ -58,6 +59,10 @@ class PcapWriter {
   }
   void finish();
 
+  uint32_t getSnaplen() const {
+    return queue_.getSnaplen();
+  }
+
   /*
    * Return the number of packets dropped.
    *
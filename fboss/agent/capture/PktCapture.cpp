@@ -11,10 +11,22 @@
 
 #include <folly/Conv.h>
 #include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+#include <algorithm>
 #include <sstream>
 
+DECLARE_int32(fboss_pcap_queue_depth);
+
 using folly::StringPiece;
 
+namespace {
+// No point in buffering more packets than the capture will take
+uint32_t queueDepth(uint64_t maxPackets) {
+  return std::max<uint64_t>(
+      std::min<uint64_t>(maxPackets, FLAGS_fboss_pcap_queue_depth), 1);
+}
+} // namespace
+
 namespace facebook::fboss {
 
 PktCapture::PktCapture(
@@ -27,8 +39,10 @@ PktCapture::PktCapture(
     folly::StringPiece name,
     uint64_t maxPackets,
     CaptureDirection direction,
-    const CaptureFilter& captureFilter)
+    const CaptureFilter& captureFilter,
+    uint32_t snaplen)
     : name_(name.str()),
+      writer_(queueDepth(maxPackets), snaplen),
       maxPackets_(maxPackets),
       direction_(direction),
       packetFilter_(captureFilter) {}
@@ -55,7 +69,8 @@ bool PktCapture::packetReceived(const RxPacket* pkt) {
 
 bool PktCapture::packetSent(const TxPacket* pkt) {
   std::lock_guard<std::mutex> guard(writer_.mutex());
-  if (direction_ != CaptureDirection::CAPTURE_ONLY_RX) {
+  if (direction_ != CaptureDirection::CAPTURE_ONLY_RX &&
+      packetFilter_.passes(pkt)) {
     ++numPacketsSent_;
     writer_.addPktLocked(pkt);
   }
@@ -64,14 +79,16 @@ bool PktCapture::packetSent(const TxPacket* pkt) {
 
 std::string PktCapture::toString(bool withStats) const {
   std::stringstream ss;
-  ss << "Name:\"" << name_ << "\", maxPackets:" << maxPackets_ << ", Direction:"
+  ss << "Name:\"" << name_ << "\", maxPackets:" << maxPackets_
+     << ", snaplen:" << writer_.getSnaplen() << ", Direction:"
      << ((direction_ == CaptureDirection::CAPTURE_TX_RX)
              ? "Tx and Rx"
              : ((direction_ == CaptureDirection::CAPTURE_ONLY_RX) ? "RX only"
                                                                   : "TX only"));
   if (withStats) {
     ss << ", Packet received:" << numPacketsReceived_
-       << ", Packet sent:" << numPacketsSent_;
+       << ", Packet sent:" << numPacketsSent_
+       << ", Packets dropped:" << writer_.numDropped();
   }
   return ss.str();
 }
@@ -9,12 +9,15 @@
  */
 #pragma once
 
+#include "fboss/agent/FbossError.h"
 #include "fboss/agent/capture/PcapWriter.h"
 #include "fboss/agent/if/gen-cpp2/ctrl_types.h"
 
 #include <boost/container/flat_set.hpp>
 #include <folly/Range.h>
+#include <folly/io/Cursor.h>
 #include <string>
+#include <vector>
 #include "fboss/agent/RxPacket.h"
 #include "fboss/agent/TxPacket.h"
 
@@ -37,17 +40,78 @@ class RxPacketFilter {
   boost::container::flat_set<CpuCosQueueId> cosQueues_;
 };
 
+/*
+ * Compares masked packet bytes at fixed offsets, like the filters tcpdump
+ * compiles to BPF.  Evaluated on the packet buffer in place, before anything
+ * is copied into the capture.
+ */
+class ByteMatchFilter {
+ public:
+  explicit ByteMatchFilter(const std::vector<CaptureByteMatch>& byteMatches) {
+    for (const auto& byteMatch : byteMatches) {
+      const auto& value = *byteMatch.value_ref();
+      const auto& mask = *byteMatch.mask_ref();
+      if (*byteMatch.offset_ref() < 0 || value.empty() ||
+          (!mask.empty() && mask.size() != value.size())) {
+        throw FbossError(
+            "invalid capture byte match at offset ",
+            *byteMatch.offset_ref(),
+            ": value must not be empty, and mask must be empty or the same "
+            "length as value");
+      }
+      Match match;
+      match.offset = *byteMatch.offset_ref();
+      match.mask = mask.empty() ? std::string(value.size(), '\xff') : mask;
+      match.value = value;
+      for (size_t i = 0; i < value.size(); ++i) {
+        match.value[i] &= match.mask[i];
+      }
+      matches_.push_back(std::move(match));
+    }
+  }
+
+  bool passes(const folly::IOBuf* buf) const {
+    for (const auto& match : matches_) {
+      folly::io::Cursor cursor(buf);
+      if (!cursor.canAdvance(match.offset + match.value.size())) {
+        return false;
+      }
+      cursor.skip(match.offset);
+      for (size_t i = 0; i < match.value.size(); ++i) {
+        if ((cursor.read<uint8_t>() & uint8_t(match.mask[i])) !=
+            uint8_t(match.value[i])) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+ private:
+  struct Match {
+    size_t offset;
+    std::string value;
+    std::string mask;
+  };
+  std::vector<Match> matches_;
+};
+
 class PacketFilter {
  public:
   explicit PacketFilter(const CaptureFilter& captureFilter)
-      : rxPacketFilter_(captureFilter.get_rxCaptureFilter()) {}
+      : rxPacketFilter_(captureFilter.get_rxCaptureFilter()),
+        byteMatchFilter_(captureFilter.get_byteMatches()) {}
 
   bool passes(const RxPacket* pkt) {
-    return rxPacketFilter_.passes(pkt);
+    return rxPacketFilter_.passes(pkt) && byteMatchFilter_.passes(pkt->buf());
+  }
+  bool passes(const TxPacket* pkt) {
+    return byteMatchFilter_.passes(pkt->buf());
   }
 
  private:
   RxPacketFilter rxPacketFilter_;
+  ByteMatchFilter byteMatchFilter_;
 };
 
 /*
@@ -63,7 +127,8 @@ class PktCapture {
       folly::StringPiece name,
       uint64_t maxPackets,
       CaptureDirection direction,
-      const CaptureFilter& captureFilter);
+      const CaptureFilter& captureFilter,
+      uint32_t snaplen = 0);
 
   const std::string& name() const {
     return name_;
@@ -270,3 +270,52 @@ TEST(CaptureTest, FullCapture) {
   //
   // EXPECT_BUF_EQ(updatedIpPktData, pcapPkts.at(4).data);
 }
+
+TEST(CaptureTest, ByteMatchFilter) {
+  auto arpPkt = MockRxPacket::fromHex(
+      // dst mac, src mac
+      "ff ff ff ff ff ff 02 01 02 03 04 05"
+      // 802.1q, VLAN 1
+      "81 00  00 01"
+      // ARP, htype: ethernet, ptype: IPv4, hlen: 6, plen: 4
+      "08 06  00 01  08 00  06  04");
+  auto ipPkt = MockRxPacket::fromHex(
+      // dst mac, src mac
+      "02 00 01 00 00 01  02 00 02 01 02 03"
+      // 802.1q, VLAN 1
+      "81 00 00 01"
+      // IPv4
+      "08 00");
+
+  CaptureByteMatch ethertype;
+  *ethertype.offset_ref() = 16;
+  *ethertype.value_ref() = std::string("\x08\x06", 2);
+  CaptureFilter filter;
+  filter.byteMatches_ref()->push_back(ethertype);
+  PacketFilter arpFilter(filter);
+  EXPECT_TRUE(arpFilter.passes(arpPkt.get()));
+  EXPECT_FALSE(arpFilter.passes(ipPkt.get()));
+
+  // Multicast/broadcast destination mac, also ARP
+  CaptureByteMatch groupBit;
+  *groupBit.offset_ref() = 0;
+  *groupBit.value_ref() = std::string("\x01", 1);
+  *groupBit.mask_ref() = std::string("\x01", 1);
+  filter.byteMatches_ref()->push_back(groupBit);
+  PacketFilter broadcastArpFilter(filter);
+  EXPECT_TRUE(broadcastArpFilter.passes(arpPkt.get()));
+  EXPECT_FALSE(broadcastArpFilter.passes(ipPkt.get()));
+
+  // Matches beyond the end of the packet fail
+  CaptureByteMatch pastEnd;
+  *pastEnd.offset_ref() = 100;
+  *pastEnd.value_ref() = std::string("\x00", 1);
+  CaptureFilter pastEndFilter;
+  pastEndFilter.byteMatches_ref()->push_back(pastEnd);
+  EXPECT_FALSE(PacketFilter(pastEndFilter).passes(arpPkt.get()));
+
+  // Mask and value have to be the same length
+  groupBit.mask_ref()->append("\xff");
+  filter.byteMatches_ref()->push_back(groupBit);
+  EXPECT_THROW(PacketFilter{filter}, FbossError);
+}
@@ -8,7 +8,6 @@
  *
  */
 #include "fboss/agent/capture/PcapQueue.h"
-#include "fboss/agent/capture/PcapPkt.h"
 #include "fboss/agent/hw/mock/MockRxPacket.h"
 
 #include <gtest/gtest.h>
@@ -17,27 +16,32 @@
 using namespace facebook::fboss;
 using folly::ByteRange;
 
-void pktWaitThread(PcapQueue* queue, std::vector<PcapPkt>* results) {
-  std::vector<PcapPkt> pkts;
-  while (true) {
-    bool gotPkts = queue->wait(&pkts);
-    if (!gotPkts) {
-      return;
-    }
-    for (PcapPkt& pkt : pkts) {
-      results->push_back(std::move(pkt));
+namespace {
+
+struct WaitedPkt {
+  explicit WaitedPkt(const PcapSlot& slot)
+      : rx(slot.rx),
+        port(slot.port),
+        origLen(slot.origLen),
+        data(slot.data.begin(), slot.data.end()) {}
+
+  bool rx;
+  PortID port;
+  uint32_t origLen;
+  std::vector<uint8_t> data;
+};
+
+void pktWaitThread(PcapQueue* queue, std::vector<WaitedPkt>* results) {
+  std::vector<const PcapSlot*> slots;
+  while (queue->wait(&slots)) {
+    for (const auto* slot : slots) {
+      results->emplace_back(*slot);
     }
-    pkts.clear();
+    queue->release(slots.size());
   }
 }
 
-TEST(PcapQueueTest, SimpleAdd) {
-  PcapQueue queue(100);
-  std::vector<PcapPkt> waitedPkts;
-
-  std::thread waiter([&]() { pktWaitThread(&queue, &waitedPkts); });
-
-  // Create a packet to add to the queue
+std::unique_ptr<MockRxPacket> makePkt() {
   auto pkt = MockRxPacket::fromHex(
       // dst mac, src mac
       "02 00 01 00 00 01  02 00 02 01 02 03"
@@ -58,16 +62,80 @@ TEST(PcapQueueTest, SimpleAdd) {
   pkt->padToLength(68);
   pkt->setSrcPort(PortID(1));
   pkt->setSrcVlan(VlanID(1));
+  return pkt;
+}
+
+} // namespace
+
+TEST(PcapQueueTest, SimpleAdd) {
+  PcapQueue queue(100);
+  std::vector<WaitedPkt> waitedPkts;
 
+  std::thread waiter([&]() { pktWaitThread(&queue, &waitedPkts); });
+
+  // Create a packet to add to the queue
+  auto pkt = makePkt();
   queue.addPkt(pkt.get());
   queue.finish();
   waiter.join();
 
   ASSERT_EQ(1, waitedPkts.size());
-  EXPECT_TRUE(waitedPkts[0].isRx());
+  EXPECT_TRUE(waitedPkts[0].rx);
+  EXPECT_EQ(PortID(1), waitedPkts[0].port);
+  EXPECT_EQ(68, waitedPkts[0].origLen);
 
   ByteRange expectedPktData = pkt->buf()->coalesce();
-  auto waitedPktBufClone = waitedPkts[0].buf()->clone();
-  ByteRange waitedPktData = waitedPktBufClone->coalesce();
-  EXPECT_EQ(expectedPktData, waitedPktData);
+  EXPECT_EQ(
+      expectedPktData,
+      ByteRange(waitedPkts[0].data.data(), waitedPkts[0].data.size()));
+}
+
+TEST(PcapQueueTest, Snaplen) {
+  PcapQueue queue(100, 14);
+  std::vector<WaitedPkt> waitedPkts;
+
+  std::thread waiter([&]() { pktWaitThread(&queue, &waitedPkts); });
+
+  auto pkt = makePkt();
+  queue.addPkt(pkt.get());
+  queue.finish();
+  waiter.join();
+
+  // Only the first 14 bytes are captured, but the original length is kept
+  ASSERT_EQ(1, waitedPkts.size());
+  EXPECT_EQ(68, waitedPkts[0].origLen);
+  ByteRange expectedPktData = pkt->buf()->coalesce().subpiece(0, 14);
+  EXPECT_EQ(
+      expectedPktData,
+      ByteRange(waitedPkts[0].data.data(), waitedPkts[0].data.size()));
+}
+
+TEST(PcapQueueTest, DropWhenFull) {
+  PcapQueue queue(2);
+  auto pkt = makePkt();
+  for (int i = 0; i < 5; ++i) {
+    queue.addPkt(pkt.get());
+  }
+  EXPECT_EQ(3, queue.numDropped());
+
+  // Releasing slots makes room again
+  std::vector<const PcapSlot*> slots;
+  ASSERT_TRUE(queue.wait(&slots));
+  EXPECT_EQ(2, slots.size());
+  queue.release(slots.size());
+  queue.addPkt(pkt.get());
+  EXPECT_EQ(3, queue.numDropped());
+
+  queue.finish();
+  // Packets are not added once finished
+  queue.addPkt(pkt.get());
+  ASSERT_TRUE(queue.wait(&slots));
+  EXPECT_EQ(1, slots.size());
+  queue.release(slots.size());
+  EXPECT_FALSE(queue.wait(&slots));
+}
+
+TEST(PcapQueueTest, SnaplenIsCapped) {
+  PcapQueue queue(2, 1 << 20);
+  EXPECT_EQ(PcapQueue::kMaxSnaplen, queue.getSnaplen());
 }
@@ -0,0 +1,679 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/hw/SflowExporter.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <fcntl.h>
+#include <ifaddrs.h>
+#include <sys/socket.h>
+
+#include <fb303/ServiceData.h>
+#include <folly/Conv.h>
+#include <folly/Range.h>
+#include <folly/ScopeGuard.h>
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
+#include <folly/logging/xlog.h>
+#include <glog/logging.h>
+#include <optional>
+
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/packet/SflowStructs.h"
+
+using namespace std;
+
+DEFINE_bool(
+    sflow_v5_export,
+    false,
+    "Export sFlow samples in batched sFlow v5 datagrams, instead of a thrift "
+    "serialized SflowPacketInfo per sample");
+DEFINE_int32(
+    sflow_max_datagram_size,
+    1400,
+    "Max size of the sFlow v5 datagrams, to fit in the path MTU");
+DEFINE_int32(
+    sflow_export_batch_size,
+    32,
+    "Number of full sFlow v5 datagrams to send at once");
+DEFINE_int32(
+    sflow_export_max_delay_ms,
+    100,
+    "Max time an sFlow sample waits for its datagram to fill up");
+DEFINE_int32(
+    sflow_counter_sample_interval_s,
+    20,
+    "Interval for sFlow v5 counter samples of sampled ports, 0 to disable");
+
+namespace {
+
+std::optional<folly::IPAddress> getLocalIPv6FromWhoAmI() {
+  const std::string whoAmIFn = "/etc/fbwhoami";
+  const std::string key = "DEVICE_PRIMARY_IPV6";
+
+  std::ifstream infile(whoAmIFn);
+  std::string line;
+
+  while (std::getline(infile, line)) {
+    std::vector<std::string> kv;
+    folly::split("=", line, kv);
+    if (kv.size() != 2) {
+      continue;
+    }
+    if (kv[0] == key) {
+      try {
+        return folly::IPAddress(kv[1]);
+      } catch (std::exception const& e) {
+        XLOG(DBG2) << folly::exceptionStr(e);
+        return std::nullopt;
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+folly::IPAddress getLocalIPv6() {
+  // We first try to get the local IPv6 in fbwhoami
+  auto ret = getLocalIPv6FromWhoAmI();
+  if (ret.has_value()) {
+    XLOG(DBG2) << "Got local IPv6 address from fbwhoami";
+    return ret.value();
+  }
+
+  struct ifaddrs* ifaddr{nullptr};
+  std::vector<char> host;
+  host.reserve(NI_MAXHOST);
+
+  if (getifaddrs(&ifaddr) == -1) {
+    XLOG(DBG2) << "getifaddrs failed. Returned default address ::";
+    return folly::IPAddress("::");
+  }
+  SCOPE_EXIT {
+    freeifaddrs(ifaddr);
+  };
+
+  for (struct ifaddrs* ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next) {
+    if (ifa->ifa_addr == nullptr) {
+      continue;
+    }
+    std::string ifname{ifa->ifa_name};
+    if (ifname != "eth0" or ifa->ifa_addr->sa_family != AF_INET6) {
+      continue;
+    }
+    int retno = getnameinfo(
+        ifa->ifa_addr,
+        sizeof(struct sockaddr_in6),
+        host.data(),
+        NI_MAXHOST,
+        nullptr,
+        0,
+        NI_NUMERICHOST);
+    if (retno != 0) {
+      XLOG(DBG2) << "getnameinfo() failed: " << gai_strerror(retno);
+      continue;
+    }
+    try {
+      return folly::IPAddress(host.data());
+    } catch (std::exception const& e) {
+      XLOG(DBG2) << folly::exceptionStr(e);
+      continue;
+    }
+  }
+  XLOG(DBG2) << "Failed to get loopback ipv6 address, returned default one ::";
+  return folly::IPAddress("::");
+}
+} // namespace
+
+namespace facebook::fboss {
+
+namespace {
+
+// sFlow v5, see https://sflow.org/sflow_version_5.txt
+constexpr sflow::DataFormat kFlowSampleFormat = 1;
+constexpr sflow::DataFormat kCounterSampleFormat = 2;
+constexpr sflow::DataFormat kRawPacketHeaderFormat = 1;
+constexpr sflow::DataFormat kGenericInterfaceCountersFormat = 1;
+constexpr uint32_t kIfTypeEthernetCsmacd = 6;
+constexpr uint32_t kIfDirectionFullDuplex = 1;
+// Type and length of a sample record in a datagram
+constexpr size_t kSampleRecordHeaderSize = 8;
+
+// Sizes of opaque data are padded to XDR blocks
+uint32_t xdrSize(uint32_t size) {
+  return (size + sflow::XDR_BASIC_BLOCK_SIZE - 1) /
+      sflow::XDR_BASIC_BLOCK_SIZE * sflow::XDR_BASIC_BLOCK_SIZE;
+}
+
+// Serialize an sFlow struct taking up to maxSize bytes
+template <typename SflowStruct>
+std::string serializeSflow(const SflowStruct& data, uint32_t maxSize) {
+  std::string out(maxSize, '\0');
+  auto buf = folly::IOBuf::wrapBufferAsValue(out.data(), out.size());
+  folly::io::RWPrivateCursor cursor(&buf);
+  data.serialize(&cursor);
+  out.resize(maxSize - cursor.length());
+  return out;
+}
+
+// Counters are uninitialized until the first stats collection
+uint64_t counterValue(int64_t value) {
+  return value < 0 ? 0 : value;
+}
+
+} // namespace
+
+SflowPacketInfo makeSflowPacketInfo(
+    bool ingressSampled,
+    bool egressSampled,
+    uint32_t srcPort,
+    uint32_t dstPort,
+    uint32_t vlan,
+    folly::ByteRange packet) {
+  SflowPacketInfo info;
+
+  auto currentTime = std::chrono::high_resolution_clock::now();
+  auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      currentTime.time_since_epoch());
+  *info.timestamp_ref()->seconds_ref() =
+      std::chrono::duration_cast<std::chrono::seconds>(duration).count();
+  *info.timestamp_ref()->nanoseconds_ref() =
+      (duration % std::chrono::seconds(1)).count();
+  *info.ingressSampled_ref() = ingressSampled;
+  *info.egressSampled_ref() = egressSampled;
+  info.srcPort_ref() = srcPort;
+  info.dstPort_ref() = dstPort;
+  info.vlan_ref() = vlan;
+
+  auto snapLen = std::min(kMaxSflowSnapLen, packet.size());
+  *info.packetData_ref() = std::string(
+      reinterpret_cast<const char*>(packet.data()), snapLen);
+  *info.frameLength_ref() = packet.size();
+  *info.payloadRemoved_ref() = packet.size() - snapLen;
+  return info;
+}
+
+SflowExporter::SflowExporter(const folly::SocketAddress& address)
+    : address_(address) {
+  SCOPE_FAIL {
+    close(socket_);
+  };
+
+  socket_ = ::socket(address_.getFamily(), SOCK_DGRAM, IPPROTO_UDP);
+
+  if (socket_ == -1) {
+    throw FbossError("Error creating UDP socket: ", folly::errnoStr(errno));
+  }
+
+  // put the socket in non-blocking mode
+  if (fcntl(socket_, F_SETFL, O_NONBLOCK) != 0) {
+    throw FbossError(
+        "Failed to put socket in non-blocking mode: ", folly::errnoStr(errno));
+  }
+
+  // put the socket in reuse mode
+  int val = 1;
+  if (setsockopt(socket_, SOL_SOCKET, SO_REUSEADDR, &val, sizeof(val)) != 0) {
+    throw FbossError(
+        "Failed to put socket in reuse_addr mode: ", folly::errnoStr(errno));
+  }
+
+  // put the socket in port reuse mode
+  val = 1;
+  if (setsockopt(socket_, SOL_SOCKET, SO_REUSEPORT, &val, sizeof(val)) != 0) {
+    throw FbossError(
+        "Failed to put socket in reuse_port mode: ", folly::errnoStr(errno));
+  }
+
+  // bind the socket.
+  folly::SocketAddress localAddr;
+
+  switch (address.getFamily()) {
+    case AF_INET6:
+      localAddr = folly::SocketAddress("::", 0);
+      break;
+    case AF_INET:
+      localAddr = folly::SocketAddress("0.0.0.0", 0);
+      break;
+    default:
+      throw FbossError("Unsupported address family for exporter target");
+  }
+
+  sockaddr_storage addrStorage;
+  localAddr.getAddress(&addrStorage);
+  sockaddr* saddr = reinterpret_cast<sockaddr*>(&addrStorage);
+  if (bind(socket_, saddr, localAddr.getActualSize()) != 0) {
+    throw FbossError(
+        "Failed to bind the async udp socket for ",
+        address_.describe(),
+        ": ",
+        folly::errnoStr(errno));
+  }
+}
+
+ssize_t SflowExporter::sendUDPDatagram(iovec* vec, const size_t iovec_len) {
+  XLOG(DBG4) << "Sending an sFlow packet to " << address_.describe();
+
+  sockaddr_storage addrStorage;
+  address_.getAddress(&addrStorage);
+
+  struct msghdr msg = {};
+  msg.msg_name = reinterpret_cast<void*>(&addrStorage);
+  msg.msg_namelen = address_.getActualSize();
+  msg.msg_iov = vec;
+  msg.msg_iovlen = iovec_len;
+  msg.msg_control = nullptr;
+  msg.msg_controllen = 0;
+  msg.msg_flags = 0;
+  auto ret = ::sendmsg(socket_, &msg, 0);
+  if (ret < 0) {
+    XLOG(DBG1) << "Failed sending sFlow packet to " << address_.describe()
+               << " reason: " << folly::errnoStr(errno);
+  }
+  XLOG(DBG4) << "Sent " << ret << " bytes of sFlow packet to "
+             << address_.describe();
+  return ret;
+}
+
+size_t SflowExporter::sendUDPDatagrams(std::vector<iovec>& datagrams) {
+  sockaddr_storage addrStorage;
+  address_.getAddress(&addrStorage);
+
+  std::vector<mmsghdr> msgs(datagrams.size());
+  for (size_t i = 0; i < datagrams.size(); ++i) {
+    auto& hdr = msgs[i].msg_hdr;
+    hdr.msg_name = reinterpret_cast<void*>(&addrStorage);
+    hdr.msg_namelen = address_.getActualSize();
+    hdr.msg_iov = &datagrams[i];
+    hdr.msg_iovlen = 1;
+  }
+
+  size_t sent = 0;
+  while (sent < msgs.size()) {
+    auto ret = ::sendmmsg(socket_, msgs.data() + sent, msgs.size() - sent, 0);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      XLOG(DBG1) << "Failed sending " << msgs.size() - sent
+                 << " sFlow datagrams to " << address_.describe()
+                 << " reason: " << folly::errnoStr(errno);
+      break;
+    }
+    sent += ret;
+  }
+  XLOG(DBG4) << "Sent " << sent << " sFlow datagrams to "
+             << address_.describe();
+  return sent;
+}
+
+SflowExporter::~SflowExporter() {
+  if (socket_ != -1) {
+    close(socket_);
+  }
+}
+
+SflowExporterTable::SflowExporterTable()
+    : startTime_(std::chrono::steady_clock::now()) {}
+
+SflowExporterTable::~SflowExporterTable() {
+  try {
+    flush();
+  } catch (const std::exception& ex) {
+    XLOG(ERR) << "Failed to flush sFlow samples: " << folly::exceptionStr(ex);
+  }
+}
+
+bool SflowExporterTable::contains(const shared_ptr<SflowCollector>& c) const {
+  std::lock_guard<std::mutex> g(mutex_);
+  auto iter = map_.find(c->getID());
+  return iter != map_.end();
+}
+
+size_t SflowExporterTable::size() const {
+  std::lock_guard<std::mutex> g(mutex_);
+  return map_.size();
+}
+
+void SflowExporterTable::addExporter(const shared_ptr<SflowCollector>& c) {
+  try {
+    auto exporter = make_unique<SflowExporter>(c->getAddress());
+    std::lock_guard<std::mutex> g(mutex_);
+    map_.emplace(c->getID(), Collector{std::move(exporter), {}});
+  } catch (const fboss::thrift::FbossBaseError& ex) {
+    XLOG(ERR) << "Could not add exporter: "
+              << c->getAddress().getFullyQualified()
+              << " reason: " << folly::exceptionStr(ex);
+    return;
+  }
+
+  XLOG(INFO) << "Successfully added exporter for "
+             << c->getAddress().getFullyQualified();
+}
+
+void SflowExporterTable::removeExporter(const std::string& id) {
+  XLOG(INFO) << "Removed sFlow exporter " << id;
+  std::lock_guard<std::mutex> g(mutex_);
+  map_.erase(id);
+}
+
+void SflowExporterTable::updateSamplingRates(
+    PortID id,
+    int64_t inRate,
+    int64_t outRate) {
+  // We piggyback the update of local IPv6
+  auto localIP = getLocalIPv6();
+
+  std::lock_guard<std::mutex> g(mutex_);
+  std::pair<int64_t, int64_t> rates(inRate, outRate);
+  auto it = port2samplingRates_.find(id);
+  if (it != port2samplingRates_.end()) {
+    it->second = rates;
+  } else {
+    port2samplingRates_.insert(std::make_pair(id, rates));
+  }
+  localIP_ = localIP;
+}
+
+void SflowExporterTable::removeSamplingRates(PortID id) {
+  std::lock_guard<std::mutex> g(mutex_);
+  port2samplingRates_.erase(id);
+  sources_.erase(id);
+}
+
+void SflowExporterTable::sendToAll(const SflowPacketInfo& info) {
+  std::lock_guard<std::mutex> g(mutex_);
+  if (map_.empty()) {
+    XLOG(DBG1)
+        << "zero sFlow collectors with sflow enabled, skipping sample export";
+    return;
+  }
+  if (!FLAGS_sflow_v5_export) {
+    sendThriftToAllLocked(info);
+    return;
+  }
+
+  bool ingress = *info.ingressSampled_ref();
+  auto srcPort = static_cast<uint16_t>(*info.srcPort_ref());
+  auto dstPort = static_cast<uint16_t>(*info.dstPort_ref());
+  PortID port(ingress ? srcPort : dstPort);
+  uint32_t samplingRate = 0;
+  auto rates = port2samplingRates_.find(port);
+  if (rates != port2samplingRates_.end()) {
+    samplingRate = ingress ? rates->second.first : rates->second.second;
+  }
+  auto& source = sources_[port];
+  source.samplePool += samplingRate;
+  const auto& packet = *info.packetData_ref();
+  uint32_t frameLength =
+      *info.frameLength_ref() > 0 ? *info.frameLength_ref() : packet.size();
+
+  sflow::SampledHeader header;
+  header.protocol = sflow::HeaderProtocol::ETHERNET_ISO88023;
+  header.frameLength = frameLength;
+  header.stripped = 0;
+  header.headerLength = packet.size();
+  header.header = reinterpret_cast<const sflow::byte*>(packet.data());
+  auto headerData = serializeSflow(header, xdrSize(header.size()));
+
+  sflow::FlowRecord record;
+  record.flowFormat = kRawPacketHeaderFormat;
+  record.flowDataLen = headerData.size();
+  record.flowData = reinterpret_cast<sflow::byte*>(headerData.data());
+
+  sflow::FlowSample sample;
+  sample.sequenceNumber = ++source.flowSequence;
+  // Source id type 0 is ifIndex, for which we use the port id
+  sample.sourceID = port;
+  sample.samplingRate = samplingRate;
+  sample.samplePool = source.samplePool;
+  sample.drops = 0;
+  sample.input = srcPort;
+  sample.output = dstPort;
+  sample.flowRecordsCnt = 1;
+  sample.flowRecords = &record;
+  addSampleLocked(
+      kFlowSampleFormat, serializeSflow(sample, sample.size(record.size())));
+}
+
+std::vector<PortID> SflowExporterTable::portsDueForCounterSamples() {
+  std::vector<PortID> ports;
+  std::lock_guard<std::mutex> g(mutex_);
+  if (!FLAGS_sflow_v5_export || map_.empty() ||
+      FLAGS_sflow_counter_sample_interval_s <= 0) {
+    return ports;
+  }
+  auto now = std::chrono::steady_clock::now();
+  if (now - lastCounterSamples_ <
+      std::chrono::seconds(FLAGS_sflow_counter_sample_interval_s)) {
+    return ports;
+  }
+  lastCounterSamples_ = now;
+  for (const auto& [port, rates] : port2samplingRates_) {
+    if (rates.first || rates.second) {
+      ports.push_back(port);
+    }
+  }
+  return ports;
+}
+
+void SflowExporterTable::addCounterSample(
+    PortID port,
+    uint64_t speedBps,
+    bool adminUp,
+    bool operUp,
+    const HwPortStats& stats) {
+  std::lock_guard<std::mutex> g(mutex_);
+  if (map_.empty()) {
+    return;
+  }
+  auto& source = sources_[port];
+
+  sflow::IfCounters counters;
+  counters.ifIndex = port;
+  counters.ifType = kIfTypeEthernetCsmacd;
+  counters.ifSpeed = speedBps;
+  counters.ifDirection = kIfDirectionFullDuplex;
+  counters.ifStatus = (adminUp ? 1 : 0) | (operUp ? 2 : 0);
+  counters.ifInOctets = counterValue(*stats.inBytes__ref());
+  counters.ifInUcastPkts = counterValue(*stats.inUnicastPkts__ref());
+  counters.ifInMulticastPkts = counterValue(*stats.inMulticastPkts__ref());
+  counters.ifInBroadcastPkts = counterValue(*stats.inBroadcastPkts__ref());
+  counters.ifInDiscards = counterValue(*stats.inDiscards__ref());
+  counters.ifInErrors = counterValue(*stats.inErrors__ref());
+  counters.ifInUnknownProtos = 0;
+  counters.ifOutOctets = counterValue(*stats.outBytes__ref());
+  counters.ifOutUcastPkts = counterValue(*stats.outUnicastPkts__ref());
+  counters.ifOutMulticastPkts = counterValue(*stats.outMulticastPkts__ref());
+  counters.ifOutBroadcastPkts = counterValue(*stats.outBroadcastPkts__ref());
+  counters.ifOutDiscards = counterValue(*stats.outDiscards__ref());
+  counters.ifOutErrors = counterValue(*stats.outErrors__ref());
+  counters.ifPromiscuousMode = 0;
+  auto countersData = serializeSflow(counters, counters.size());
+
+  sflow::CounterRecord record;
+  record.counterFormat = kGenericInterfaceCountersFormat;
+  record.counterDataLen = countersData.size();
+  record.counterData = reinterpret_cast<sflow::byte*>(countersData.data());
+
+  sflow::CounterSample sample;
+  sample.sequenceNumber = ++source.counterSequence;
+  sample.sourceID = port;
+  sample.counterRecordsCnt = 1;
+  sample.counterRecords = &record;
+  addSampleLocked(
+      kCounterSampleFormat,
+      serializeSflow(sample, sample.size(record.size())));
+}
+
+void SflowExporterTable::flush() {
+  std::lock_guard<std::mutex> g(mutex_);
+  flushLocked();
+}
+
+std::optional<SflowCollectorStats> SflowExporterTable::getCollectorStats(
+    const std::string& id) const {
+  std::lock_guard<std::mutex> g(mutex_);
+  auto iter = map_.find(id);
+  if (iter == map_.end()) {
+    return std::nullopt;
+  }
+  return iter->second.stats;
+}
+
+void SflowExporterTable::sendThriftToAllLocked(const SflowPacketInfo& info) {
+  // Serialize info to a string and wrap it in an IOBuf for sending
+  string output;
+  apache::thrift::BinarySerializer::serialize(info, &output);
+  auto buf = folly::IOBuf::wrapBuffer(output.data(), output.length());
+
+  // Map the IOBuf to a Linux iovec like a champ
+  iovec vec[16] = {};
+  size_t iovec_len = buf->fillIov(vec, sizeof(vec) / sizeof(vec[0])).numIovecs;
+  if (UNLIKELY(iovec_len == 0)) {
+    buf->coalesce();
+    vec[0].iov_base = const_cast<uint8_t*>(buf->data());
+    vec[0].iov_len = buf->length();
+    iovec_len = 1;
+  }
+
+  for (auto& [id, collector] : map_) {
+    if (collector.exporter->sendUDPDatagram(vec, iovec_len) < 0) {
+      updateStatsLocked(id, collector, 0, 1, 0, 1);
+    } else {
+      updateStatsLocked(id, collector, 1, 0, 1, 0);
+    }
+  }
+}
+
+folly::IPAddress SflowExporterTable::agentAddressLocked() const {
+  return localIP_.empty() ? folly::IPAddress(folly::IPAddressV6()) : localIP_;
+}
+
+void SflowExporterTable::addSampleLocked(
+    sflow::DataFormat format,
+    std::string sample) {
+  sflow::SampleDatagram header;
+  header.datagramV5.agentAddress = agentAddressLocked();
+  auto headerSize = header.size(0);
+  auto recordSize = kSampleRecordHeaderSize + sample.size();
+  auto maxSize = static_cast<size_t>(FLAGS_sflow_max_datagram_size);
+  if (headerSize + recordSize > maxSize) {
+    XLOG(DBG2) << "Dropping sFlow sample of " << sample.size()
+               << " bytes, larger than max datagram size " << maxSize;
+    for (auto& [id, collector] : map_) {
+      updateStatsLocked(id, collector, 0, 1, 0, 0);
+    }
+    return;
+  }
+  if (pending_ && headerSize + pending_->samplesSize + recordSize > maxSize) {
+    finishDatagramLocked();
+  }
+  auto now = std::chrono::steady_clock::now();
+  if (!pending_) {
+    pending_ = PendingDatagram();
+    pending_->uptime =
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime_)
+            .count();
+    pendingSince_ = now;
+  }
+  pending_->samplesSize += recordSize;
+  pending_->samples.emplace_back(format, std::move(sample));
+
+  if (ready_.size() >= static_cast<size_t>(FLAGS_sflow_export_batch_size) ||
+      now - pendingSince_ >=
+          std::chrono::milliseconds(FLAGS_sflow_export_max_delay_ms)) {
+    flushLocked();
+  }
+}
+
+void SflowExporterTable::finishDatagramLocked() {
+  if (!pending_) {
+    return;
+  }
+  std::vector<sflow::SampleRecord> records;
+  records.reserve(pending_->samples.size());
+  for (auto& [format, sample] : pending_->samples) {
+    sflow::SampleRecord record;
+    record.sampleType = format;
+    record.sampleDataLen = sample.size();
+    record.sampleData = reinterpret_cast<sflow::byte*>(sample.data());
+    records.push_back(record);
+  }
+
+  sflow::SampleDatagram datagram;
+  datagram.datagramV5.agentAddress = agentAddressLocked();
+  datagram.datagramV5.subAgentID = 0;
+  datagram.datagramV5.sequenceNumber = ++datagramSequence_;
+  datagram.datagramV5.uptime = pending_->uptime;
+  datagram.datagramV5.samplesCnt = records.size();
+  datagram.datagramV5.samples = records.data();
+  ready_.push_back(
+      {serializeSflow(datagram, datagram.size(pending_->samplesSize)),
+       static_cast<uint32_t>(records.size())});
+  pending_.reset();
+}
+
+void SflowExporterTable::flushLocked() {
+  finishDatagramLocked();
+  if (ready_.empty()) {
+    return;
+  }
+  std::vector<iovec> datagrams;
+  datagrams.reserve(ready_.size());
+  for (auto& datagram : ready_) {
+    datagrams.push_back({datagram.data.data(), datagram.data.size()});
+  }
+
+  for (auto& [id, collector] : map_) {
+    auto sent = collector.exporter->sendUDPDatagrams(datagrams);
+    uint64_t samplesSent = 0;
+    uint64_t samplesDropped = 0;
+    for (size_t i = 0; i < ready_.size(); ++i) {
+      (i < sent ? samplesSent : samplesDropped) += ready_[i].numSamples;
+    }
+    updateStatsLocked(
+        id,
+        collector,
+        samplesSent,
+        samplesDropped,
+        sent,
+        ready_.size() - sent);
+  }
+  ready_.clear();
+}
+
+void SflowExporterTable::updateStatsLocked(
+    const std::string& id,
+    Collector& collector,
+    uint64_t samplesSent,
+    uint64_t samplesDropped,
+    uint64_t datagramsSent,
+    uint64_t datagramsDropped) {
+  collector.stats.samplesSent += samplesSent;
+  collector.stats.samplesDropped += samplesDropped;
+  collector.stats.datagramsSent += datagramsSent;
+  collector.stats.datagramsDropped += datagramsDropped;
+  if (samplesSent) {
+    fb303::fbData->incrementCounter(
+        folly::to<std::string>("sflow.", id, ".samples_sent"), samplesSent);
+  }
+  if (samplesDropped) {
+    fb303::fbData->incrementCounter(
+        folly::to<std::string>("sflow.", id, ".samples_dropped"),
+        samplesDropped);
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,195 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <folly/IPAddress.h>
+#include <folly/Range.h>
+#include <folly/SocketAddress.h>
+#include <gflags/gflags.h>
+#include <sys/uio.h>
+
+#include "fboss/agent/hw/gen-cpp2/hardware_stats_types.h"
+#include "fboss/agent/if/gen-cpp2/sflow_types.h"
+#include "fboss/agent/packet/SflowStructs.h"
+#include "fboss/agent/state/SflowCollector.h"
+#include "fboss/agent/types.h"
+
+DECLARE_bool(sflow_v5_export);
+
+namespace facebook::fboss {
+
+/*
+ * How many bytes we copy for sFlow sampling
+ */
+constexpr size_t kMaxSflowSnapLen = 128;
+
+/*
+ * Metadata and the first kMaxSflowSnapLen bytes of a sampled packet
+ */
+SflowPacketInfo makeSflowPacketInfo(
+    bool ingressSampled,
+    bool egressSampled,
+    uint32_t srcPort,
+    uint32_t dstPort,
+    uint32_t vlan,
+    folly::ByteRange packet);
+
+class SflowExporter {
+ public:
+  /*
+   * Constructor for an sFlow collector.
+   *
+   * @param[in] address    IP:port of the collector.
+   */
+  explicit SflowExporter(const folly::SocketAddress& address);
+  ~SflowExporter();
+
+  /*
+   * Send out the data in vec using UDP.  Called after init().
+   */
+  ssize_t sendUDPDatagram(iovec* vec, const size_t iovec_len);
+
+  /*
+   * Send out one UDP datagram per iovec, batching them in as few syscalls
+   * as possible. Returns the number of datagrams sent, the rest were
+   * dropped.
+   */
+  size_t sendUDPDatagrams(std::vector<iovec>& datagrams);
+
+ private:
+  // no copy or assignment
+  SflowExporter(SflowExporter const&) = delete;
+  SflowExporter& operator=(SflowExporter const&) = delete;
+
+  const folly::SocketAddress address_;
+  int socket_{-1};
+};
+
+struct SflowCollectorStats {
+  uint64_t samplesSent{0};
+  uint64_t samplesDropped{0};
+  uint64_t datagramsSent{0};
+  uint64_t datagramsDropped{0};
+};
+
+/*
+ * Exports sampled packets to all sFlow collectors.
+ *
+ * By default, each sample is sent as a thrift serialized SflowPacketInfo.
+ * With --sflow_v5_export, flow samples and periodic port counter samples are
+ * packed into sFlow v5 datagrams instead, which are sent in batches once
+ * enough of them are ready or the oldest sample is due.
+ *
+ * Samples are added from the packet rx thread while collectors are
+ * updated from the state update thread, so all methods are thread safe.
+ */
+class SflowExporterTable {
+ public:
+  SflowExporterTable();
+  ~SflowExporterTable();
+
+  bool contains(const std::shared_ptr<SflowCollector>& collector) const;
+  size_t size() const;
+  void addExporter(const std::shared_ptr<SflowCollector>& collector);
+  void removeExporter(const std::string& ID);
+
+  void updateSamplingRates(PortID id, int64_t inRate, int64_t outRate);
+  void removeSamplingRates(PortID id);
+
+  void sendToAll(const SflowPacketInfo& info);
+
+  /*
+   * Sampled ports to add counter samples for, once every
+   * --sflow_counter_sample_interval_s. Empty when not due.
+   */
+  std::vector<PortID> portsDueForCounterSamples();
+  void addCounterSample(
+      PortID port,
+      uint64_t speedBps,
+      bool adminUp,
+      bool operUp,
+      const HwPortStats& stats);
+
+  /*
+   * Send out all pending samples. Called periodically so samples don't
+   * linger when sampling slows down.
+   */
+  void flush();
+
+  std::optional<SflowCollectorStats> getCollectorStats(
+      const std::string& id) const;
+
+ private:
+  // no copy or assignment
+  SflowExporterTable(SflowExporterTable const&) = delete;
+  SflowExporterTable& operator=(SflowExporterTable const&) = delete;
+
+  struct Collector {
+    std::unique_ptr<SflowExporter> exporter;
+    SflowCollectorStats stats;
+  };
+
+  struct SourceState {
+    uint32_t flowSequence{0};
+    uint32_t counterSequence{0};
+    uint32_t samplePool{0};
+  };
+
+  struct PendingDatagram {
+    uint32_t uptime{0};
+    // Encoded samples, along with their sample record type and length
+    std::vector<std::pair<sflow::DataFormat, std::string>> samples;
+    size_t samplesSize{0};
+  };
+
+  struct Datagram {
+    std::string data;
+    uint32_t numSamples{0};
+  };
+
+  void sendThriftToAllLocked(const SflowPacketInfo& info);
+  folly::IPAddress agentAddressLocked() const;
+  void addSampleLocked(sflow::DataFormat format, std::string sample);
+  void finishDatagramLocked();
+  void flushLocked();
+  void updateStatsLocked(
+      const std::string& id,
+      Collector& collector,
+      uint64_t samplesSent,
+      uint64_t samplesDropped,
+      uint64_t datagramsSent,
+      uint64_t datagramsDropped);
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Collector> map_;
+  std::unordered_map<
+      PortID,
+      std::pair<int64_t /* ingress rate */, int64_t /* egress rate */>>
+      port2samplingRates_;
+  folly::IPAddress localIP_;
+
+  const std::chrono::steady_clock::time_point startTime_;
+  std::unordered_map<PortID, SourceState> sources_;
+  uint32_t datagramSequence_{0};
+  // Datagram being filled, and those ready to be sent
+  std::optional<PendingDatagram> pending_;
+  std::chrono::steady_clock::time_point pendingSince_;
+  std::vector<Datagram> ready_;
+  std::chrono::steady_clock::time_point lastCounterSamples_;
+};
+
+} // namespace facebook::fboss
@@ -32,6 +32,7 @@
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/hw/BufferStatsLogger.h"
 #include "fboss/agent/hw/HwSwitchStats.h"
+#include "fboss/agent/hw/SflowExporter.h"
 #include "fboss/agent/hw/bcm/BcmAPI.h"
 #include "fboss/agent/hw/bcm/BcmAclEntry.h"
 #include "fboss/agent/hw/bcm/BcmAclTable.h"
@@ -66,7 +67,6 @@
 #include "fboss/agent/hw/bcm/BcmRtag7LoadBalancer.h"
 #include "fboss/agent/hw/bcm/BcmRxPacket.h"
 #include "fboss/agent/hw/bcm/BcmSdkVer.h"
-#include "fboss/agent/hw/bcm/BcmSflowExporter.h"
 #include "fboss/agent/hw/bcm/BcmStatUpdater.h"
 #include "fboss/agent/hw/bcm/BcmSwitchEventCallback.h"
 #include "fboss/agent/hw/bcm/BcmSwitchEventUtils.h"
@@ -281,11 +281,6 @@ L2EntryUpdateType getL2EntryUpdateType(int operation, bool detailedUpdate) {
   return kL2AddrBasicUpdateOperationsOfInterest.find(operation)->second;
 }
 
-/*
- * How many bytes we copy for sFlow sampling
- */
-const unsigned int kMaxSflowSnapLen = 128;
-
 bool isValidLabeledNextHopSet(
     facebook::fboss::BcmPlatform* platform,
     const facebook::fboss::LabelNextHopSet& nexthops) {
@@ -355,7 +350,7 @@ BcmSwitch::BcmSwitch(BcmPlatform* platform, uint32_t featuresDesired)
       qosPolicyTable_(new BcmQosPolicyTable(this)),
       aclTable_(new BcmAclTable(this)),
       trunkTable_(new BcmTrunkTable(this)),
-      sFlowExporterTable_(new BcmSflowExporterTable()),
+      sFlowExporterTable_(new SflowExporterTable()),
       rtag7LoadBalancer_(new BcmRtag7LoadBalancer(this)),
       mirrorTable_(new BcmMirrorTable(this)),
       bstStatsMgr_(new BcmBstStatsMgr(this)),
@@ -2611,6 +2606,25 @@ folly::F14FastMap<std::string, HwPortStats> BcmSwitch::getPortStats() const {
   return portStats;
 }
 
+void BcmSwitch::updateSflowCounterSamples() {
+  for (auto portId : sFlowExporterTable_->portsDueForCounterSamples()) {
+    auto bcmPort = portTable_->getBcmPortIf(portId);
+    if (!bcmPort) {
+      continue;
+    }
+    auto stats = bcmPort->getPortStats();
+    if (!stats) {
+      continue;
+    }
+    // Port speeds are in Mbps
+    uint64_t speedBps = static_cast<uint64_t>(bcmPort->getSpeed()) * 1000000;
+    sFlowExporterTable_->addCounterSample(
+        portId, speedBps, bcmPort->isEnabled(), bcmPort->isUp(), *stats);
+  }
+  // Don't hold samples longer than a stats interval
+  sFlowExporterTable_->flush();
+}
+
 shared_ptr<BcmSwitchEventCallback> BcmSwitch::registerSwitchEventCallback(
     bcm_switch_event_t eventID,
     shared_ptr<BcmSwitchEventCallback> callback) {
@@ -2625,6 +2639,7 @@ void BcmSwitch::updateGlobalStats() {
   portTable_->updatePortStats();
   trunkTable_->updateStats();
   bcmStatUpdater_->updateStats();
+  updateSflowCounterSamples();
 
   auto now =
       std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
@@ -3136,34 +3151,20 @@ bool BcmSwitch::handleSflowPacket(BcmPacketT& bcmPacket) noexcept {
     return false;
   }
 
-  // Assemble packet metadata
-  SflowPacketInfo info;
-
-  auto currentTime = std::chrono::high_resolution_clock::now();
-  auto duration =
-      duration_cast<std::chrono::nanoseconds>(currentTime.time_since_epoch());
-  *info.timestamp_ref()->seconds_ref() =
-      duration_cast<std::chrono::seconds>(duration).count();
-  *info.timestamp_ref()->nanoseconds_ref() =
-      duration_cast<std::chrono::nanoseconds>(
-          duration % std::chrono::seconds(1))
-          .count();
-  *info.ingressSampled_ref() = ingressSample;
-  *info.egressSampled_ref() = egressSample;
-  info.srcPort_ref() = src_port;
-  info.dstPort_ref() = dest_port;
-  info.vlan_ref() = vlan;
-
-  auto snapLen = std::min(kMaxSflowSnapLen, (unsigned int)(pkt_len));
-
   XLOG(DBG6) << "sFlow captured packet of size " << pkt_len;
   XLOG(DBG6) << "Packet dump following (max 128 bytes):\n "
-             << folly::hexDump(pkt_data, snapLen);
+             << folly::hexDump(
+                    pkt_data,
+                    std::min(kMaxSflowSnapLen, static_cast<size_t>(pkt_len)));
 
-  {
-    std::string packetData(pkt_data, pkt_data + snapLen);
-    *info.packetData_ref() = std::move(packetData);
-  }
+  // Assemble packet metadata
+  auto info = makeSflowPacketInfo(
+      ingressSample,
+      egressSample,
+      src_port,
+      dest_port,
+      vlan,
+      folly::ByteRange(pkt_data, pkt_len));
 
   // Print it for debugging
   XLOG(DBG6) << "sFlowSample: (" << *info.timestamp_ref()->seconds_ref() << ','
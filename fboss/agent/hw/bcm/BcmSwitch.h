@@ -74,7 +74,7 @@ class BcmUnit;
 class BcmWarmBootCache;
 class BcmWarmBootHelper;
 class BcmRtag7LoadBalancer;
-class BcmSflowExporterTable;
+class SflowExporterTable;
 class LoadBalancer;
 class PacketTraceInfo;
 class SflowCollector;
@@ -809,6 +809,11 @@ class BcmSwitch : public BcmSwitchIf {
    */
   void updateGlobalStats();
 
+  /*
+   * Export sFlow counter samples of sampled ports, when due.
+   */
+  void updateSflowCounterSamples();
+
   /*
    * Drop IPv6 Router Advertisements.
    */
@@ -1005,7 +1010,7 @@ class BcmSwitch : public BcmSwitchIf {
   std::unique_ptr<BcmStatUpdater> bcmStatUpdater_;
   std::unique_ptr<BcmCosManager> cosManager_;
   std::unique_ptr<BcmTrunkTable> trunkTable_;
-  std::unique_ptr<BcmSflowExporterTable> sFlowExporterTable_;
+  std::unique_ptr<SflowExporterTable> sFlowExporterTable_;
   std::unique_ptr<BcmControlPlane> controlPlane_;
   std::unique_ptr<BcmRtag7LoadBalancer> rtag7LoadBalancer_;
   std::unique_ptr<BcmMirrorTable> mirrorTable_;
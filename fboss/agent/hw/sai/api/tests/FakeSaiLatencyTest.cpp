@@ -0,0 +1,187 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+
+#include <folly/FileUtil.h>
+#include <folly/experimental/TestUtil.h>
+#include <folly/json.h>
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+DECLARE_string(fake_sai_latency_profile);
+
+using namespace facebook::fboss;
+using std::chrono::microseconds;
+
+namespace {
+std::vector<sai_port_oper_status_notification_t> portNotifications;
+std::vector<std::pair<sai_fdb_event_t, sai_object_id_t>> fdbNotifications;
+
+void onPortStateChange(
+    uint32_t count,
+    const sai_port_oper_status_notification_t* data) {
+  portNotifications.insert(portNotifications.end(), data, data + count);
+}
+
+void onFdbEvent(uint32_t count, const sai_fdb_event_notification_data_t* data) {
+  for (uint32_t i = 0; i < count; ++i) {
+    for (uint32_t j = 0; j < data[i].attr_count; ++j) {
+      if (data[i].attr[j].id == SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID) {
+        fdbNotifications.emplace_back(
+            data[i].event_type, data[i].attr[j].value.oid);
+      }
+    }
+  }
+}
+} // namespace
+
+class FakeSaiLatencyTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    fs = FakeSai::getInstance();
+    sai_api_initialize(0, nullptr);
+  }
+  void TearDown() override {
+    fs->latency.clear();
+    fs->notifier.loadProfile(folly::dynamic::object);
+    fs->notifier.setPortStateChangeCallback(nullptr);
+    fs->notifier.setFdbEventCallback(nullptr);
+  }
+  std::shared_ptr<FakeSai> fs;
+};
+
+TEST_F(FakeSaiLatencyTest, noProfile) {
+  EXPECT_FALSE(fs->latency.enabled());
+  EXPECT_EQ(
+      microseconds(0),
+      fs->latency.getLatency(
+          SAI_OBJECT_TYPE_ROUTE_ENTRY, FakeSaiOp::CREATE, 1));
+}
+
+TEST_F(FakeSaiLatencyTest, perObjectTypeAndDefault) {
+  fs->latency.loadProfile(folly::parseJson(R"({
+    "default": {"create": {"fixed_us": 5}},
+    "route_entry": {"create": {"fixed_us": 20}, "get": {"samples_us": [3]}}
+  })"));
+  EXPECT_TRUE(fs->latency.enabled());
+  EXPECT_EQ(
+      microseconds(20),
+      fs->latency.getLatency(
+          SAI_OBJECT_TYPE_ROUTE_ENTRY, FakeSaiOp::CREATE, 1));
+  EXPECT_EQ(
+      microseconds(3),
+      fs->latency.getLatency(SAI_OBJECT_TYPE_ROUTE_ENTRY, FakeSaiOp::GET, 1));
+  EXPECT_EQ(
+      microseconds(5),
+      fs->latency.getLatency(SAI_OBJECT_TYPE_NEXT_HOP, FakeSaiOp::CREATE, 1));
+  EXPECT_EQ(
+      microseconds(0),
+      fs->latency.getLatency(SAI_OBJECT_TYPE_NEXT_HOP, FakeSaiOp::REMOVE, 1));
+}
+
+TEST_F(FakeSaiLatencyTest, bulkCost) {
+  fs->latency.loadProfile(folly::parseJson(R"({
+    "route_entry": {
+      "create": {"fixed_us": 20},
+      "remove": {"fixed_us": 10},
+      "bulk_create": {"fixed_us": 40, "per_object_us": 2}
+    }
+  })"));
+  EXPECT_EQ(
+      microseconds(40 + 100 * 2),
+      fs->latency.getLatency(
+          SAI_OBJECT_TYPE_ROUTE_ENTRY, FakeSaiOp::BULK_CREATE, 100));
+  // No bulk remove profile, costs as much as removing one by one
+  EXPECT_EQ(
+      microseconds(100 * 10),
+      fs->latency.getLatency(
+          SAI_OBJECT_TYPE_ROUTE_ENTRY, FakeSaiOp::BULK_REMOVE, 100));
+}
+
+TEST_F(FakeSaiLatencyTest, invalidProfile) {
+  EXPECT_THROW(
+      fs->latency.loadProfile(
+          folly::parseJson(R"({"bogus": {"create": {"fixed_us": 1}}})")),
+      std::runtime_error);
+  EXPECT_THROW(
+      fs->latency.loadProfile(
+          folly::parseJson(R"({"port": {"bogus": {"fixed_us": 1}}})")),
+      std::runtime_error);
+}
+
+TEST_F(FakeSaiLatencyTest, asyncLinkNotifications) {
+  fs->notifier.loadProfile(folly::parseJson(
+      R"({"notification_delay_ms": 1, "link_notifications": true})"));
+  fs->notifier.setPortStateChangeCallback(&onPortStateChange);
+  portNotifications.clear();
+
+  sai_port_api_t* portApi;
+  sai_api_query(SAI_API_PORT, reinterpret_cast<void**>(&portApi));
+  std::vector<uint32_t> lanes{42};
+  auto portId = fs->portManager.create(lanes, 100000);
+  sai_attribute_t attr;
+  attr.id = SAI_PORT_ATTR_ADMIN_STATE;
+  attr.value.booldata = true;
+  EXPECT_EQ(SAI_STATUS_SUCCESS, portApi->set_port_attribute(portId, &attr));
+  // Setting the same state again does not flap the link
+  EXPECT_EQ(SAI_STATUS_SUCCESS, portApi->set_port_attribute(portId, &attr));
+  attr.value.booldata = false;
+  EXPECT_EQ(SAI_STATUS_SUCCESS, portApi->set_port_attribute(portId, &attr));
+
+  fs->notifier.drain();
+  ASSERT_EQ(2, portNotifications.size());
+  EXPECT_EQ(portId, portNotifications[0].port_id);
+  EXPECT_EQ(SAI_PORT_OPER_STATUS_UP, portNotifications[0].port_state);
+  EXPECT_EQ(SAI_PORT_OPER_STATUS_DOWN, portNotifications[1].port_state);
+}
+
+TEST_F(FakeSaiLatencyTest, asyncFdbNotifications) {
+  fs->notifier.loadProfile(folly::parseJson(
+      R"({"notification_delay_ms": 1, "fdb_notifications": true})"));
+  fs->notifier.setFdbEventCallback(&onFdbEvent);
+  fdbNotifications.clear();
+
+  sai_fdb_api_t* fdbApi;
+  sai_api_query(SAI_API_FDB, reinterpret_cast<void**>(&fdbApi));
+  sai_fdb_entry_t fdbEntry{};
+  fdbEntry.switch_id = 0;
+  fdbEntry.bv_id = 42;
+  fdbEntry.mac_address[5] = 1;
+  sai_attribute_t attr;
+  attr.id = SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID;
+  attr.value.oid = 7;
+  EXPECT_EQ(SAI_STATUS_SUCCESS, fdbApi->create_fdb_entry(&fdbEntry, 1, &attr));
+  EXPECT_EQ(SAI_STATUS_SUCCESS, fdbApi->remove_fdb_entry(&fdbEntry));
+
+  fs->notifier.drain();
+  ASSERT_EQ(2, fdbNotifications.size());
+  EXPECT_EQ(SAI_FDB_EVENT_LEARNED, fdbNotifications[0].first);
+  EXPECT_EQ(7, fdbNotifications[0].second);
+  EXPECT_EQ(SAI_FDB_EVENT_AGED, fdbNotifications[1].first);
+  EXPECT_EQ(7, fdbNotifications[1].second);
+}
+
+TEST_F(FakeSaiLatencyTest, invalidProfileFailsInitialize) {
+  folly::test::TemporaryFile profile;
+  folly::writeFile(std::string("{\"port\": {"), profile.path().c_str());
+  FakeSai::clear();
+  fs->initialized = false;
+  gflags::FlagSaver flagSaver;
+  FLAGS_fake_sai_latency_profile = profile.path().string();
+
+  EXPECT_EQ(SAI_STATUS_FAILURE, sai_api_initialize(0, nullptr));
+  EXPECT_FALSE(fs->initialized);
+  EXPECT_FALSE(fs->latency.enabled());
+  // Leave the fake to be initialized afresh by the next test
+  FakeSai::clear();
+}
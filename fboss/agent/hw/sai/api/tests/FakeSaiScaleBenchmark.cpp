@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/hw/sai/api/NeighborApi.h"
+#include "fboss/agent/hw/sai/api/RouteApi.h"
+#include "fboss/agent/hw/sai/api/SaiObjectApi.h"
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddress.h>
+#include <folly/MacAddress.h>
+
+/*
+ * Programs production scale route and neighbor tables through the SAI api
+ * layer into FakeSai, to make sure the fake itself is not the bottleneck
+ * (in time or memory) of agent tests at scale. Linked with the hw benchmark
+ * main, which reports max RSS along with the timings.
+ */
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr uint32_t kNumNeighbors = 128 * 1024;
+constexpr uint32_t kNumRoutes = 1000 * 1000;
+constexpr uint32_t kNumRifs = 64;
+
+// 2401:db00:<prefix>::<host>
+folly::IPAddressV6 makeV6(uint32_t prefix, uint32_t host) {
+  folly::ByteArray16 bytes{};
+  bytes[0] = 0x24;
+  bytes[1] = 0x01;
+  bytes[2] = 0xdb;
+  for (int i = 0; i < 4; ++i) {
+    bytes[4 + i] = (prefix >> (24 - 8 * i)) & 0xff;
+    bytes[12 + i] = (host >> (24 - 8 * i)) & 0xff;
+  }
+  return folly::IPAddressV6(bytes);
+}
+
+folly::IPAddress neighborIp(uint32_t i) {
+  return folly::IPAddress(makeV6(i % kNumRifs, i / kNumRifs + 1));
+}
+
+folly::CIDRNetwork routePrefix(uint32_t i) {
+  // Half v4 /24s, half v6 /64s
+  if (i % 2) {
+    return folly::CIDRNetwork(
+        folly::IPAddress::fromLongHBO((10u << 24) + ((i / 2) << 8)), 24);
+  }
+  return folly::CIDRNetwork(folly::IPAddress(makeV6(i / 2, 0)), 64);
+}
+
+} // namespace
+
+BENCHMARK(FakeSaiScale1MRoutes128kNeighbors) {
+  folly::BenchmarkSuspender suspender;
+  sai_api_initialize(0, nullptr);
+  NeighborApi neighborApi;
+  RouteApi routeApi;
+  folly::MacAddress dstMac("02:00:00:00:00:01");
+  suspender.dismiss();
+
+  for (uint32_t i = 0; i < kNumNeighbors; ++i) {
+    SaiNeighborTraits::NeighborEntry neighbor(0, i % kNumRifs, neighborIp(i));
+    neighborApi.create<SaiNeighborTraits>(
+        neighbor,
+        SaiNeighborTraits::CreateAttributes{
+            SaiNeighborTraits::Attributes::DstMac{dstMac}, std::nullopt});
+  }
+  for (uint32_t i = 0; i < kNumRoutes; ++i) {
+    SaiRouteTraits::RouteEntry route(0, 0, routePrefix(i));
+    routeApi.create<SaiRouteTraits>(
+        route,
+        SaiRouteTraits::CreateAttributes{
+            SaiRouteTraits::Attributes::PacketAction{SAI_PACKET_ACTION_FORWARD},
+            SaiRouteTraits::Attributes::NextHopId{i % kNumNeighbors},
+            std::nullopt});
+  }
+  // Warm boot reload walks all the keys
+  folly::doNotOptimizeAway(getObjectKeys<SaiRouteTraits>(0));
+  folly::doNotOptimizeAway(getObjectKeys<SaiNeighborTraits>(0));
+
+  for (uint32_t i = 0; i < kNumRoutes; ++i) {
+    routeApi.remove(SaiRouteTraits::RouteEntry(0, 0, routePrefix(i)));
+  }
+  for (uint32_t i = 0; i < kNumNeighbors; ++i) {
+    neighborApi.remove(
+        SaiNeighborTraits::NeighborEntry(0, i % kNumRifs, neighborIp(i)));
+  }
+
+  suspender.rehire();
+  FakeSai::clear();
+}
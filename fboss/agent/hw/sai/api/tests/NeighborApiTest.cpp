@@ -43,14 +43,14 @@ class NeighborApiTest : public ::testing::Test {
 
 TEST_F(NeighborApiTest, createV4Neighbor) {
   SaiNeighborTraits::NeighborEntry n(0, 0, ip4);
-  FakeNeighborEntry fn = std::make_tuple(0, 0, ip4);
+  FakeNeighborEntry fn(0, 0, ip4);
   neighborApi->create<SaiNeighborTraits>(n, createAttrs());
   EXPECT_EQ(fs->neighborManager.get(fn).dstMac, dstMac);
 }
 
 TEST_F(NeighborApiTest, createV4NeighborWithMetadata) {
   SaiNeighborTraits::NeighborEntry n(0, 0, ip4);
-  FakeNeighborEntry fn = std::make_tuple(0, 0, ip4);
+  FakeNeighborEntry fn(0, 0, ip4);
   neighborApi->create<SaiNeighborTraits>(n, createAttrs(42));
   EXPECT_EQ(fs->neighborManager.get(fn).dstMac, dstMac);
   EXPECT_EQ(fs->neighborManager.get(fn).metadata, 42);
@@ -58,7 +58,7 @@ TEST_F(NeighborApiTest, createV4NeighborWithMetadata) {
 
 TEST_F(NeighborApiTest, createV6Neighbor) {
   SaiNeighborTraits::NeighborEntry n(0, 0, ip6);
-  FakeNeighborEntry fn = std::make_tuple(0, 0, ip6);
+  FakeNeighborEntry fn(0, 0, ip6);
   neighborApi->create<SaiNeighborTraits>(n, createAttrs());
   EXPECT_EQ(fs->neighborManager.get(fn).dstMac, dstMac);
 }
@@ -66,7 +66,7 @@ TEST_F(NeighborApiTest, createV6Neighbor) {
 TEST_F(NeighborApiTest, createV6NeighborWithMetdata) {
   SaiNeighborTraits::Attributes::DstMac dstMacAttribute(dstMac);
   SaiNeighborTraits::NeighborEntry n(0, 0, ip6);
-  FakeNeighborEntry fn = std::make_tuple(0, 0, ip6);
+  FakeNeighborEntry fn(0, 0, ip6);
   neighborApi->create<SaiNeighborTraits>(n, createAttrs(42));
   EXPECT_EQ(fs->neighborManager.get(fn).dstMac, dstMac);
   EXPECT_EQ(fs->neighborManager.get(fn).metadata, 42);
@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/IPAddress.h>
+#include <folly/hash/Hash.h>
+
+#include <array>
+#include <cstring>
+
+namespace facebook::fboss {
+
+/*
+ * Flat, fixed size encoding of an IP address for use in the keys of fake
+ * route and neighbor tables. Unlike folly::IPAddress it is trivially
+ * copyable and cheap to hash and compare, which matters with a million
+ * routes in the fake.
+ */
+struct FakeIpAddress {
+  explicit FakeIpAddress(const folly::IPAddress& ip) : isV6(ip.isV6()) {
+    auto bytesIn = ip.bytes();
+    std::memcpy(bytes.data(), bytesIn, ip.byteCount());
+  }
+
+  folly::IPAddress ip() const {
+    if (isV6) {
+      return folly::IPAddress(folly::IPAddressV6::fromBinary(
+          folly::ByteRange(bytes.data(), folly::IPAddressV6::byteCount())));
+    }
+    return folly::IPAddress(folly::IPAddressV4::fromBinary(
+        folly::ByteRange(bytes.data(), folly::IPAddressV4::byteCount())));
+  }
+
+  size_t hash() const {
+    uint64_t high;
+    uint64_t low;
+    std::memcpy(&high, bytes.data(), sizeof(high));
+    std::memcpy(&low, bytes.data() + sizeof(high), sizeof(low));
+    return folly::hash::hash_combine(high, low, isV6);
+  }
+
+  bool operator==(const FakeIpAddress& other) const {
+    return isV6 == other.isV6 && bytes == other.bytes;
+  }
+
+  std::array<uint8_t, 16> bytes{};
+  bool isV6;
+};
+
+} // namespace facebook::fboss
@@ -9,10 +9,10 @@
  */
 #pragma once
 
+#include <folly/container/F14Map.h>
 #include <folly/logging/xlog.h>
 
 #include <stdexcept>
-#include <unordered_map>
 
 extern "C" {
 #include <sai.h>
@@ -22,7 +22,18 @@ extern "C" {
 
 namespace facebook::fboss {
 
-template <typename K, typename T, size_t count = 0>
+/*
+ * Objects are stored in a node map by default, since the fakes hand out
+ * references to objects and expect them to stay valid while other objects
+ * are created. Managers for large tables of small objects which are only
+ * accessed by key (routes, neighbors, fdb entries) use a flat
+ * F14ValueMap to keep the fake's footprint low at production scale.
+ */
+template <
+    typename K,
+    typename T,
+    size_t count = 0,
+    typename Map = folly::F14NodeMap<K, T>>
 class FakeManager {
  public:
   template <typename E = K, typename... Args>
@@ -56,10 +67,10 @@ class FakeManager {
     return map_.at(k);
   }
 
-  std::unordered_map<K, T>& map() {
+  Map& map() {
     return map_;
   }
-  const std::unordered_map<K, T>& map() const {
+  const Map& map() const {
     return map_;
   }
 
@@ -74,11 +85,11 @@ class FakeManager {
 
  private:
   static size_t count_;
-  std::unordered_map<K, T> map_;
+  Map map_;
 };
 
-template <typename K, typename T, size_t count>
-size_t FakeManager<K, T, count>::count_ = count;
+template <typename K, typename T, size_t count, typename Map>
+size_t FakeManager<K, T, count, Map>::count_ = count;
 /*
  * For managing fakes of sai apis that have a membership concept, we will
  * nest fake managers. In this class template, GroupT denotes an owning "group"
@@ -121,7 +132,7 @@ class FakeManagerWithMembers : public FakeManager<sai_object_id_t, GroupT> {
   }
 
  private:
-  std::unordered_map<sai_object_id_t, sai_object_id_t> memberToGroupMap_;
+  folly::F14FastMap<sai_object_id_t, sai_object_id_t> memberToGroupMap_;
 };
 
 } // namespace facebook::fboss
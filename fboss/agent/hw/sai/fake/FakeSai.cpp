@@ -9,11 +9,15 @@
  */
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
 
+#include <folly/ExceptionString.h>
 #include <folly/FileUtil.h>
 #include <folly/Singleton.h>
+#include <folly/json.h>
 
 #include <folly/logging/xlog.h>
 
+DECLARE_string(fake_sai_latency_profile);
+
 namespace {
 struct singleton_tag_type {};
 } // namespace
@@ -95,6 +99,27 @@ sai_status_t sai_api_initialize(
   // Create the CPU port
   sai_create_cpu_port();
 
+  if (!FLAGS_fake_sai_latency_profile.empty()) {
+    std::string profileJson;
+    if (!folly::readFile(
+            FLAGS_fake_sai_latency_profile.c_str(), profileJson)) {
+      XLOG(ERR) << "Unable to read fake SAI latency profile "
+                << FLAGS_fake_sai_latency_profile;
+      return SAI_STATUS_FAILURE;
+    }
+    try {
+      auto profile = folly::parseJson(profileJson);
+      fs->latency.loadProfile(profile);
+      fs->notifier.loadProfile(profile);
+    } catch (const std::exception& ex) {
+      XLOG(ERR) << "Invalid fake SAI latency profile "
+                << FLAGS_fake_sai_latency_profile << ": "
+                << folly::exceptionStr(ex);
+      fs->latency.clear();
+      return SAI_STATUS_FAILURE;
+    }
+  }
+
   fs->initialized = true;
   return SAI_STATUS_SUCCESS;
 }
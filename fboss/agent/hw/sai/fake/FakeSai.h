@@ -18,6 +18,7 @@
 #include "fboss/agent/hw/sai/fake/FakeSaiHostif.h"
 #include "fboss/agent/hw/sai/fake/FakeSaiInSegEntryManager.h"
 #include "fboss/agent/hw/sai/fake/FakeSaiLag.h"
+#include "fboss/agent/hw/sai/fake/FakeSaiLatency.h"
 #include "fboss/agent/hw/sai/fake/FakeSaiMacsec.h"
 #include "fboss/agent/hw/sai/fake/FakeSaiMirror.h"
 #include "fboss/agent/hw/sai/fake/FakeSaiNeighbor.h"
@@ -89,11 +90,33 @@ struct FakeSai {
   FakeMacsecSAManager macsecSAManager;
   FakeMacsecSCManager macsecSCManager;
   FakeMacsecFlowManager macsecFlowManager;
+  FakeSaiLatency latency;
+  FakeSaiNotifier notifier;
   bool initialized = false;
   sai_object_id_t cpuPortId;
   sai_object_id_t getCpuPort();
 };
 
+/*
+ * Wraps a fake SAI api function so that calls made through the api table
+ * take as long as the latency profile says. Calls made within the fake
+ * itself (e.g. create setting the initial attributes) are not slowed down.
+ */
+template <sai_object_type_t ObjectType, FakeSaiOp Op, auto Fn>
+struct FakeSaiWithLatency;
+
+template <
+    sai_object_type_t ObjectType,
+    FakeSaiOp Op,
+    typename... Args,
+    sai_status_t (*Fn)(Args...)>
+struct FakeSaiWithLatency<ObjectType, Op, Fn> {
+  static sai_status_t call(Args... args) {
+    FakeSai::getInstance()->latency.simulate(ObjectType, Op);
+    return Fn(args...);
+  }
+};
+
 } // namespace facebook::fboss
 
 sai_status_t sai_api_initialize(
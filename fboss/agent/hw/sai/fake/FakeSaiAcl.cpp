@@ -14,6 +14,7 @@
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
 
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiOp;
 
 namespace facebook::fboss {
 bool FakeAclTable::entryFieldSupported(const sai_attribute_t& attr) const {
@@ -1270,10 +1271,22 @@ sai_acl_api_t* FakeAclTable::kApi() {
       &remove_acl_table_fn,
       &set_acl_table_attribute_fn,
       &get_acl_table_attribute_fn,
-      &create_acl_entry_fn,
-      &remove_acl_entry_fn,
-      &set_acl_entry_attribute_fn,
-      &get_acl_entry_attribute_fn,
+      &FakeSaiWithLatency<
+          SAI_OBJECT_TYPE_ACL_ENTRY,
+          FakeSaiOp::CREATE,
+          create_acl_entry_fn>::call,
+      &FakeSaiWithLatency<
+          SAI_OBJECT_TYPE_ACL_ENTRY,
+          FakeSaiOp::REMOVE,
+          remove_acl_entry_fn>::call,
+      &FakeSaiWithLatency<
+          SAI_OBJECT_TYPE_ACL_ENTRY,
+          FakeSaiOp::SET,
+          set_acl_entry_attribute_fn>::call,
+      &FakeSaiWithLatency<
+          SAI_OBJECT_TYPE_ACL_ENTRY,
+          FakeSaiOp::GET,
+          get_acl_entry_attribute_fn>::call,
       &create_acl_counter_fn,
       &remove_acl_counter_fn,
       &set_acl_counter_attribute_fn,
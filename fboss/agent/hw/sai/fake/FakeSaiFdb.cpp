@@ -17,6 +17,7 @@
 
 using facebook::fboss::FakeFdb;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_fdb_entry_fn(
     const sai_fdb_entry_t* fdb_entry,
@@ -44,14 +45,23 @@ sai_status_t create_fdb_entry_fn(
       std::make_tuple(fdb_entry->switch_id, fdb_entry->bv_id, mac),
       bridgePortId,
       metadata);
+  if (fs->notifier.fdbNotifications()) {
+    fs->notifier.fdbEvent(SAI_FDB_EVENT_LEARNED, *fdb_entry, bridgePortId);
+  }
   return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t remove_fdb_entry_fn(const sai_fdb_entry_t* fdb_entry) {
   auto fs = FakeSai::getInstance();
   auto mac = facebook::fboss::fromSaiMacAddress(fdb_entry->mac_address);
-  fs->fdbManager.remove(
-      std::make_tuple(fdb_entry->switch_id, fdb_entry->bv_id, mac));
+  auto fdbKey = std::make_tuple(fdb_entry->switch_id, fdb_entry->bv_id, mac);
+  bool notify = fs->notifier.fdbNotifications();
+  sai_object_id_t bridgePortId =
+      notify ? fs->fdbManager.get(fdbKey).bridgePortId : 0;
+  fs->fdbManager.remove(fdbKey);
+  if (notify) {
+    fs->notifier.fdbEvent(SAI_FDB_EVENT_AGED, *fdb_entry, bridgePortId);
+  }
   return SAI_STATUS_SUCCESS;
 }
 
@@ -107,10 +117,22 @@ namespace facebook::fboss {
 static sai_fdb_api_t _fdb_api;
 
 void populate_fdb_api(sai_fdb_api_t** fdb_api) {
-  _fdb_api.create_fdb_entry = &create_fdb_entry_fn;
-  _fdb_api.remove_fdb_entry = &remove_fdb_entry_fn;
-  _fdb_api.set_fdb_entry_attribute = &set_fdb_entry_attribute_fn;
-  _fdb_api.get_fdb_entry_attribute = &get_fdb_entry_attribute_fn;
+  _fdb_api.create_fdb_entry = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_FDB_ENTRY,
+      FakeSaiOp::CREATE,
+      create_fdb_entry_fn>::call;
+  _fdb_api.remove_fdb_entry = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_FDB_ENTRY,
+      FakeSaiOp::REMOVE,
+      remove_fdb_entry_fn>::call;
+  _fdb_api.set_fdb_entry_attribute = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_FDB_ENTRY,
+      FakeSaiOp::SET,
+      set_fdb_entry_attribute_fn>::call;
+  _fdb_api.get_fdb_entry_attribute = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_FDB_ENTRY,
+      FakeSaiOp::GET,
+      get_fdb_entry_attribute_fn>::call;
   *fdb_api = &_fdb_api;
 }
 
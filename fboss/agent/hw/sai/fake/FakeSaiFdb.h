@@ -29,7 +29,12 @@ struct FakeFdb {
 
 using FakeFdbEntry =
     std::tuple<sai_object_id_t, sai_object_id_t, folly::MacAddress>;
-using FakeFdbManager = FakeManager<FakeFdbEntry, FakeFdb>;
+// Keys and values are small, store them flat
+using FakeFdbManager = FakeManager<
+    FakeFdbEntry,
+    FakeFdb,
+    0,
+    folly::F14ValueMap<FakeFdbEntry, FakeFdb>>;
 
 void populate_fdb_api(sai_fdb_api_t** fdb_api);
 
@@ -0,0 +1,277 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/hw/sai/fake/FakeSaiLatency.h"
+
+#include <folly/logging/xlog.h>
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+DEFINE_string(
+    fake_sai_latency_profile,
+    "",
+    "JSON file describing how long fake SAI calls should take. "
+    "Calls complete instantly if not set");
+
+namespace {
+
+using facebook::fboss::FakeSaiOp;
+
+const std::map<std::string, sai_object_type_t> kObjectTypes = {
+    {"default", SAI_OBJECT_TYPE_NULL},
+    {"acl_entry", SAI_OBJECT_TYPE_ACL_ENTRY},
+    {"fdb_entry", SAI_OBJECT_TYPE_FDB_ENTRY},
+    {"neighbor_entry", SAI_OBJECT_TYPE_NEIGHBOR_ENTRY},
+    {"next_hop", SAI_OBJECT_TYPE_NEXT_HOP},
+    {"next_hop_group", SAI_OBJECT_TYPE_NEXT_HOP_GROUP},
+    {"next_hop_group_member", SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER},
+    {"port", SAI_OBJECT_TYPE_PORT},
+    {"route_entry", SAI_OBJECT_TYPE_ROUTE_ENTRY},
+};
+
+const std::map<std::string, FakeSaiOp> kOps = {
+    {"create", FakeSaiOp::CREATE},
+    {"remove", FakeSaiOp::REMOVE},
+    {"set", FakeSaiOp::SET},
+    {"get", FakeSaiOp::GET},
+    {"get_stats", FakeSaiOp::GET_STATS},
+    {"bulk_create", FakeSaiOp::BULK_CREATE},
+    {"bulk_remove", FakeSaiOp::BULK_REMOVE},
+};
+
+std::optional<FakeSaiOp> nonBulkOp(FakeSaiOp op) {
+  switch (op) {
+    case FakeSaiOp::BULK_CREATE:
+      return FakeSaiOp::CREATE;
+    case FakeSaiOp::BULK_REMOVE:
+      return FakeSaiOp::REMOVE;
+    default:
+      return std::nullopt;
+  }
+}
+
+} // namespace
+
+namespace facebook::fboss {
+
+void FakeSaiLatency::loadProfile(const folly::dynamic& profile) {
+  std::map<LatencyKey, OpLatency> latencies;
+  for (const auto& [typeName, ops] : profile.items()) {
+    auto type = kObjectTypes.find(typeName.asString());
+    if (type == kObjectTypes.end()) {
+      if (typeName == "notification_delay_ms" ||
+          typeName == "link_notifications" ||
+          typeName == "fdb_notifications") {
+        // Handled by FakeSaiNotifier
+        continue;
+      }
+      throw std::runtime_error(
+          "Unsupported object type in fake SAI latency profile: " +
+          typeName.asString());
+    }
+    for (const auto& [opName, spec] : ops.items()) {
+      auto op = kOps.find(opName.asString());
+      if (op == kOps.end()) {
+        throw std::runtime_error(
+            "Unknown operation in fake SAI latency profile: " +
+            opName.asString());
+      }
+      latencies[std::make_pair(type->second, op->second)] =
+          parseOpLatency(spec);
+    }
+  }
+  latencies_ = std::move(latencies);
+  XLOG(DBG2) << "Loaded fake SAI latencies for " << latencies_.size()
+             << " operations";
+}
+
+void FakeSaiLatency::clear() {
+  latencies_.clear();
+}
+
+FakeSaiLatency::OpLatency FakeSaiLatency::parseOpLatency(
+    const folly::dynamic& spec) {
+  OpLatency latency;
+  if (auto fixed = spec.get_ptr("fixed_us")) {
+    latency.fixed = std::chrono::microseconds(fixed->asInt());
+  }
+  if (auto perObject = spec.get_ptr("per_object_us")) {
+    latency.perObject = std::chrono::microseconds(perObject->asInt());
+  }
+  if (auto mean = spec.get_ptr("mean_us")) {
+    auto stddev = spec.getDefault("stddev_us", 0);
+    latency.distribution.emplace(mean->asDouble(), stddev.asDouble());
+  }
+  if (auto samples = spec.get_ptr("samples_us")) {
+    for (const auto& sample : *samples) {
+      latency.samples.emplace_back(sample.asInt());
+    }
+  }
+  return latency;
+}
+
+const FakeSaiLatency::OpLatency* FakeSaiLatency::findLatency(
+    sai_object_type_t objectType,
+    FakeSaiOp op) const {
+  auto itr = latencies_.find(std::make_pair(objectType, op));
+  if (itr == latencies_.end()) {
+    itr = latencies_.find(std::make_pair(SAI_OBJECT_TYPE_NULL, op));
+  }
+  return itr == latencies_.end() ? nullptr : &itr->second;
+}
+
+std::chrono::microseconds FakeSaiLatency::getLatency(
+    sai_object_type_t objectType,
+    FakeSaiOp op,
+    uint32_t numObjects) {
+  if (auto latency = findLatency(objectType, op)) {
+    return sample(*latency) + latency->perObject * numObjects;
+  }
+  if (auto singleOp = nonBulkOp(op)) {
+    // No bulk profile, as expensive as doing it one object at a time
+    if (auto latency = findLatency(objectType, *singleOp)) {
+      std::chrono::microseconds total{0};
+      for (uint32_t i = 0; i < numObjects; ++i) {
+        total += sample(*latency);
+      }
+      return total;
+    }
+  }
+  return std::chrono::microseconds(0);
+}
+
+std::chrono::microseconds FakeSaiLatency::sample(const OpLatency& latency) {
+  auto result = latency.fixed;
+  if (!latency.distribution && latency.samples.empty()) {
+    return result;
+  }
+  std::lock_guard<std::mutex> g(rngLock_);
+  if (latency.distribution) {
+    // Copied so that the profile itself is never modified
+    auto distribution = *latency.distribution;
+    result += std::chrono::microseconds(
+        std::max<int64_t>(0, std::llround(distribution(rng_))));
+  }
+  if (!latency.samples.empty()) {
+    std::uniform_int_distribution<size_t> pick(0, latency.samples.size() - 1);
+    result += latency.samples[pick(rng_)];
+  }
+  return result;
+}
+
+void FakeSaiLatency::wait(std::chrono::microseconds latency) {
+  // Sleeping overshoots short latencies somewhat, but unlike spinning it
+  // doesn't starve the other threads of a benchmark of CPU
+  std::this_thread::sleep_for(latency);
+}
+
+void FakeSaiNotifier::loadProfile(const folly::dynamic& profile) {
+  std::lock_guard<std::mutex> g(lock_);
+  delay_ = std::chrono::milliseconds(
+      profile.getDefault("notification_delay_ms", 0).asInt());
+  linkNotifications_ = profile.getDefault("link_notifications", false).asBool();
+  fdbNotifications_ = profile.getDefault("fdb_notifications", false).asBool();
+}
+
+void FakeSaiNotifier::setPortStateChangeCallback(
+    sai_port_state_change_notification_fn callback) {
+  std::lock_guard<std::mutex> g(lock_);
+  portStateChangeCallback_ = callback;
+}
+
+void FakeSaiNotifier::setFdbEventCallback(
+    sai_fdb_event_notification_fn callback) {
+  std::lock_guard<std::mutex> g(lock_);
+  fdbEventCallback_ = callback;
+}
+
+void FakeSaiNotifier::portOperStatusChanged(
+    sai_object_id_t portId,
+    sai_port_oper_status_t status) {
+  schedule([this, portId, status]() {
+    sai_port_state_change_notification_fn callback;
+    {
+      std::lock_guard<std::mutex> g(lock_);
+      callback = portStateChangeCallback_;
+    }
+    if (callback) {
+      sai_port_oper_status_notification_t data;
+      data.port_id = portId;
+      data.port_state = status;
+      callback(1, &data);
+    }
+  });
+}
+
+void FakeSaiNotifier::fdbEvent(
+    sai_fdb_event_t eventType,
+    const sai_fdb_entry_t& fdbEntry,
+    sai_object_id_t bridgePortId) {
+  schedule([this, eventType, fdbEntry, bridgePortId]() {
+    sai_fdb_event_notification_fn callback;
+    {
+      std::lock_guard<std::mutex> g(lock_);
+      callback = fdbEventCallback_;
+    }
+    if (callback) {
+      std::array<sai_attribute_t, 2> attrs;
+      attrs[0].id = SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID;
+      attrs[0].value.oid = bridgePortId;
+      attrs[1].id = SAI_FDB_ENTRY_ATTR_TYPE;
+      attrs[1].value.s32 = SAI_FDB_ENTRY_TYPE_DYNAMIC;
+      sai_fdb_event_notification_data_t data;
+      data.event_type = eventType;
+      data.fdb_entry = fdbEntry;
+      data.attr_count = attrs.size();
+      data.attr = attrs.data();
+      callback(1, &data);
+    }
+  });
+}
+
+void FakeSaiNotifier::drain() {
+  folly::EventBase* evb{nullptr};
+  {
+    std::lock_guard<std::mutex> g(lock_);
+    if (!thread_) {
+      return;
+    }
+    evb = thread_->getEventBase();
+  }
+  evb->runInEventBaseThreadAndWait([]() {});
+}
+
+void FakeSaiNotifier::schedule(folly::Func notify) {
+  folly::EventBase* evb{nullptr};
+  std::chrono::steady_clock::time_point deliverAt;
+  {
+    std::lock_guard<std::mutex> g(lock_);
+    if (!thread_) {
+      // Most users of the fake never get notifications, only start the
+      // thread once needed
+      thread_ =
+          std::make_unique<folly::ScopedEventBaseThread>("FakeSaiNotifier");
+    }
+    evb = thread_->getEventBase();
+    deliverAt = std::chrono::steady_clock::now() + delay_;
+  }
+  // Notifications are delivered in order, each no earlier than its delay
+  evb->runInEventBaseThread([deliverAt, notify = std::move(notify)]() mutable {
+    std::this_thread::sleep_until(deliverAt);
+    notify();
+  });
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,165 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/dynamic.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include <sai.h>
+}
+
+namespace facebook::fboss {
+
+enum class FakeSaiOp {
+  CREATE,
+  REMOVE,
+  SET,
+  GET,
+  GET_STATS,
+  BULK_CREATE,
+  BULK_REMOVE,
+};
+
+/*
+ * Models how long SAI calls take on real hardware. Without a profile every
+ * fake call completes instantly, which over-states software performance and
+ * hides the benefit of batching.
+ *
+ * A profile is a JSON object keyed by object type (or "default"), mapping
+ * operations to their latency, e.g.
+ *
+ *   {
+ *     "default": {"create": {"fixed_us": 5}},
+ *     "route_entry": {
+ *       "create": {"mean_us": 20, "stddev_us": 4},
+ *       "get": {"samples_us": [3, 3, 4, 9]},
+ *       "bulk_create": {"fixed_us": 40, "per_object_us": 2}
+ *     },
+ *     "notification_delay_ms": 10,
+ *     "link_notifications": true,
+ *     "fdb_notifications": true
+ *   }
+ *
+ * Latency is either fixed, normally distributed or drawn from samples
+ * captured on hardware. per_object_us is added for each object of a bulk
+ * call; bulk calls without a profile of their own cost as much as the
+ * equivalent individual calls. With link_notifications, port admin state
+ * changes produce oper status notifications, and with fdb_notifications FDB
+ * entries created and removed through the API produce learned and aged
+ * events. Notifications are delivered notification_delay_ms late.
+ */
+class FakeSaiLatency {
+ public:
+  void loadProfile(const folly::dynamic& profile);
+  void clear();
+
+  bool enabled() const {
+    return !latencies_.empty();
+  }
+
+  /*
+   * Block the calling thread for as long as the operation would take.
+   */
+  void simulate(
+      sai_object_type_t objectType,
+      FakeSaiOp op,
+      uint32_t numObjects = 1) {
+    if (!enabled()) {
+      return;
+    }
+    wait(getLatency(objectType, op, numObjects));
+  }
+
+  std::chrono::microseconds
+  getLatency(sai_object_type_t objectType, FakeSaiOp op, uint32_t numObjects);
+
+ private:
+  struct OpLatency {
+    std::chrono::microseconds fixed{0};
+    std::chrono::microseconds perObject{0};
+    std::optional<std::normal_distribution<double>> distribution;
+    std::vector<std::chrono::microseconds> samples;
+  };
+  // SAI_OBJECT_TYPE_NULL holds the defaults
+  using LatencyKey = std::pair<sai_object_type_t, FakeSaiOp>;
+
+  static OpLatency parseOpLatency(const folly::dynamic& spec);
+  const OpLatency* findLatency(sai_object_type_t objectType, FakeSaiOp op)
+      const;
+  std::chrono::microseconds sample(const OpLatency& latency);
+  static void wait(std::chrono::microseconds latency);
+
+  // Only modified while loading a profile, before the fake is in use
+  std::map<LatencyKey, OpLatency> latencies_;
+  std::mutex rngLock_;
+  std::mt19937 rng_;
+};
+
+/*
+ * Delivers port state change and FDB event notifications asynchronously,
+ * on a thread of its own, like the SDK does.
+ */
+class FakeSaiNotifier {
+ public:
+  /*
+   * Apply notification_delay_ms, link_notifications and fdb_notifications
+   * from a latency profile.
+   */
+  void loadProfile(const folly::dynamic& profile);
+
+  void setPortStateChangeCallback(
+      sai_port_state_change_notification_fn callback);
+  void setFdbEventCallback(sai_fdb_event_notification_fn callback);
+
+  bool linkNotifications() const {
+    return linkNotifications_;
+  }
+  bool fdbNotifications() const {
+    return fdbNotifications_;
+  }
+
+  void portOperStatusChanged(
+      sai_object_id_t portId,
+      sai_port_oper_status_t status);
+  void fdbEvent(
+      sai_fdb_event_t eventType,
+      const sai_fdb_entry_t& fdbEntry,
+      sai_object_id_t bridgePortId);
+
+  /*
+   * Block until all notifications queued so far have been delivered.
+   */
+  void drain();
+
+ private:
+  void schedule(folly::Func notify);
+
+  std::mutex lock_;
+  std::unique_ptr<folly::ScopedEventBaseThread> thread_;
+  sai_port_state_change_notification_fn portStateChangeCallback_{nullptr};
+  sai_fdb_event_notification_fn fdbEventCallback_{nullptr};
+  std::chrono::milliseconds delay_{0};
+  std::atomic<bool> linkNotifications_{false};
+  std::atomic<bool> fdbNotifications_{false};
+};
+
+} // namespace facebook::fboss
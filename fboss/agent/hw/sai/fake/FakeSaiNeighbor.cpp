@@ -16,7 +16,9 @@
 #include <optional>
 
 using facebook::fboss::FakeNeighbor;
+using facebook::fboss::FakeNeighborEntry;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_neighbor_entry_fn(
     const sai_neighbor_entry_t* neighbor_entry,
@@ -42,7 +44,7 @@ sai_status_t create_neighbor_entry_fn(
     return SAI_STATUS_INVALID_PARAMETER;
   }
   fs->neighborManager.create(
-      std::make_tuple(neighbor_entry->switch_id, neighbor_entry->rif_id, ip),
+      FakeNeighborEntry(neighbor_entry->switch_id, neighbor_entry->rif_id, ip),
       dstMac.value(),
       metadata);
   return SAI_STATUS_SUCCESS;
@@ -52,8 +54,8 @@ sai_status_t remove_neighbor_entry_fn(
     const sai_neighbor_entry_t* neighbor_entry) {
   auto fs = FakeSai::getInstance();
   auto ip = facebook::fboss::fromSaiIpAddress(neighbor_entry->ip_address);
-  fs->neighborManager.remove(
-      std::make_tuple(neighbor_entry->switch_id, neighbor_entry->rif_id, ip));
+  fs->neighborManager.remove(FakeNeighborEntry(
+      neighbor_entry->switch_id, neighbor_entry->rif_id, ip));
   return SAI_STATUS_SUCCESS;
 }
 
@@ -62,8 +64,7 @@ sai_status_t set_neighbor_entry_attribute_fn(
     const sai_attribute_t* attr) {
   auto fs = FakeSai::getInstance();
   auto ip = facebook::fboss::fromSaiIpAddress(neighbor_entry->ip_address);
-  auto n =
-      std::make_tuple(neighbor_entry->switch_id, neighbor_entry->rif_id, ip);
+  FakeNeighborEntry n(neighbor_entry->switch_id, neighbor_entry->rif_id, ip);
   auto& fn = fs->neighborManager.get(n);
   switch (attr->id) {
     case SAI_NEIGHBOR_ENTRY_ATTR_DST_MAC_ADDRESS:
@@ -84,8 +85,7 @@ sai_status_t get_neighbor_entry_attribute_fn(
     sai_attribute_t* attr_list) {
   auto fs = FakeSai::getInstance();
   auto ip = facebook::fboss::fromSaiIpAddress(neighbor_entry->ip_address);
-  auto n =
-      std::make_tuple(neighbor_entry->switch_id, neighbor_entry->rif_id, ip);
+  FakeNeighborEntry n(neighbor_entry->switch_id, neighbor_entry->rif_id, ip);
   auto& fn = fs->neighborManager.get(n);
   for (int i = 0; i < attr_count; ++i) {
     switch (attr_list[i].id) {
@@ -107,10 +107,22 @@ namespace facebook::fboss {
 static sai_neighbor_api_t _neighbor_api;
 
 void populate_neighbor_api(sai_neighbor_api_t** neighbor_api) {
-  _neighbor_api.create_neighbor_entry = &create_neighbor_entry_fn;
-  _neighbor_api.remove_neighbor_entry = &remove_neighbor_entry_fn;
-  _neighbor_api.set_neighbor_entry_attribute = &set_neighbor_entry_attribute_fn;
-  _neighbor_api.get_neighbor_entry_attribute = &get_neighbor_entry_attribute_fn;
+  _neighbor_api.create_neighbor_entry = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+      FakeSaiOp::CREATE,
+      create_neighbor_entry_fn>::call;
+  _neighbor_api.remove_neighbor_entry = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+      FakeSaiOp::REMOVE,
+      remove_neighbor_entry_fn>::call;
+  _neighbor_api.set_neighbor_entry_attribute = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+      FakeSaiOp::SET,
+      set_neighbor_entry_attribute_fn>::call;
+  _neighbor_api.get_neighbor_entry_attribute = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+      FakeSaiOp::GET,
+      get_neighbor_entry_attribute_fn>::call;
   *neighbor_api = &_neighbor_api;
 }
 
@@ -9,13 +9,12 @@
  */
 #pragma once
 
+#include "fboss/agent/hw/sai/fake/FakeIpAddress.h"
 #include "fboss/agent/hw/sai/fake/FakeManager.h"
 
 #include <folly/IPAddress.h>
 #include <folly/MacAddress.h>
 
-#include <tuple>
-
 extern "C" {
 #include <sai.h>
 }
@@ -29,9 +28,33 @@ struct FakeNeighbor {
   sai_uint32_t metadata{0};
 };
 
-using FakeNeighborEntry =
-    std::tuple<sai_object_id_t, sai_object_id_t, folly::IPAddress>;
-using FakeNeighborManager = FakeManager<FakeNeighborEntry, FakeNeighbor>;
+struct FakeNeighborEntry {
+  FakeNeighborEntry(
+      sai_object_id_t switchId,
+      sai_object_id_t rifId,
+      const folly::IPAddress& ip)
+      : switchId(switchId), rifId(rifId), ip(ip) {}
+
+  bool operator==(const FakeNeighborEntry& other) const {
+    return switchId == other.switchId && rifId == other.rifId &&
+        ip == other.ip;
+  }
+  struct Hash {
+    size_t operator()(const FakeNeighborEntry& entry) const {
+      return folly::hash::hash_combine(
+          entry.switchId, entry.rifId, entry.ip.hash());
+    }
+  };
+
+  sai_object_id_t switchId;
+  sai_object_id_t rifId;
+  FakeIpAddress ip;
+};
+
+using FakeNeighborMap = folly::
+    F14ValueMap<FakeNeighborEntry, FakeNeighbor, FakeNeighborEntry::Hash>;
+using FakeNeighborManager =
+    FakeManager<FakeNeighborEntry, FakeNeighbor, 0, FakeNeighborMap>;
 
 void populate_neighbor_api(sai_neighbor_api_t** neighbor_api);
 
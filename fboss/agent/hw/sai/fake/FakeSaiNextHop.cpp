@@ -17,6 +17,7 @@
 
 using facebook::fboss::FakePort;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_next_hop_fn(
     sai_object_id_t* next_hop_id,
@@ -129,10 +130,22 @@ namespace facebook::fboss {
 static sai_next_hop_api_t _next_hop_api;
 
 void populate_next_hop_api(sai_next_hop_api_t** next_hop_api) {
-  _next_hop_api.create_next_hop = &create_next_hop_fn;
-  _next_hop_api.remove_next_hop = &remove_next_hop_fn;
-  _next_hop_api.set_next_hop_attribute = &set_next_hop_attribute_fn;
-  _next_hop_api.get_next_hop_attribute = &get_next_hop_attribute_fn;
+  _next_hop_api.create_next_hop = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_NEXT_HOP,
+      FakeSaiOp::CREATE,
+      create_next_hop_fn>::call;
+  _next_hop_api.remove_next_hop = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_NEXT_HOP,
+      FakeSaiOp::REMOVE,
+      remove_next_hop_fn>::call;
+  _next_hop_api.set_next_hop_attribute = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_NEXT_HOP,
+      FakeSaiOp::SET,
+      set_next_hop_attribute_fn>::call;
+  _next_hop_api.get_next_hop_attribute = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_NEXT_HOP,
+      FakeSaiOp::GET,
+      get_next_hop_attribute_fn>::call;
   *next_hop_api = &_next_hop_api;
 }
 
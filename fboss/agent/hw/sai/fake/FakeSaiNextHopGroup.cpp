@@ -17,6 +17,7 @@
 using facebook::fboss::FakeNextHopGroup;
 using facebook::fboss::FakeNextHopGroupMember;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_next_hop_group_fn(
     sai_object_id_t* next_hop_group_id,
@@ -177,20 +178,38 @@ static sai_next_hop_group_api_t _next_hop_group_api;
 
 void populate_next_hop_group_api(
     sai_next_hop_group_api_t** next_hop_group_api) {
-  _next_hop_group_api.create_next_hop_group = &create_next_hop_group_fn;
-  _next_hop_group_api.remove_next_hop_group = &remove_next_hop_group_fn;
-  _next_hop_group_api.set_next_hop_group_attribute =
-      &set_next_hop_group_attribute_fn;
-  _next_hop_group_api.get_next_hop_group_attribute =
-      &get_next_hop_group_attribute_fn;
-  _next_hop_group_api.create_next_hop_group_member =
-      &create_next_hop_group_member_fn;
-  _next_hop_group_api.remove_next_hop_group_member =
-      &remove_next_hop_group_member_fn;
-  _next_hop_group_api.set_next_hop_group_member_attribute =
-      &set_next_hop_group_member_attribute_fn;
-  _next_hop_group_api.get_next_hop_group_member_attribute =
-      &get_next_hop_group_member_attribute_fn;
+  _next_hop_group_api.create_next_hop_group = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_NEXT_HOP_GROUP,
+      FakeSaiOp::CREATE,
+      create_next_hop_group_fn>::call;
+  _next_hop_group_api.remove_next_hop_group = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_NEXT_HOP_GROUP,
+      FakeSaiOp::REMOVE,
+      remove_next_hop_group_fn>::call;
+  _next_hop_group_api.set_next_hop_group_attribute = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_NEXT_HOP_GROUP,
+      FakeSaiOp::SET,
+      set_next_hop_group_attribute_fn>::call;
+  _next_hop_group_api.get_next_hop_group_attribute = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_NEXT_HOP_GROUP,
+      FakeSaiOp::GET,
+      get_next_hop_group_attribute_fn>::call;
+  _next_hop_group_api.create_next_hop_group_member = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
+      FakeSaiOp::CREATE,
+      create_next_hop_group_member_fn>::call;
+  _next_hop_group_api.remove_next_hop_group_member = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
+      FakeSaiOp::REMOVE,
+      remove_next_hop_group_member_fn>::call;
+  _next_hop_group_api.set_next_hop_group_member_attribute = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
+      FakeSaiOp::SET,
+      set_next_hop_group_member_attribute_fn>::call;
+  _next_hop_group_api.get_next_hop_group_member_attribute = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
+      FakeSaiOp::GET,
+      get_next_hop_group_member_attribute_fn>::call;
   *next_hop_group_api = &_next_hop_group_api;
 }
 
@@ -289,20 +289,20 @@ sai_status_t sai_get_object_key(
     }
     case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY: {
       for (const auto& nbr : fs->neighborManager.map()) {
-        object_list[i].key.neighbor_entry.switch_id = std::get<0>(nbr.first);
-        object_list[i].key.neighbor_entry.rif_id = std::get<1>(nbr.first);
+        object_list[i].key.neighbor_entry.switch_id = nbr.first.switchId;
+        object_list[i].key.neighbor_entry.rif_id = nbr.first.rifId;
         object_list[i].key.neighbor_entry.ip_address =
-            facebook::fboss::toSaiIpAddress(std::get<2>(nbr.first));
+            facebook::fboss::toSaiIpAddress(nbr.first.ip.ip());
         ++i;
       }
       break;
     }
     case SAI_OBJECT_TYPE_ROUTE_ENTRY: {
       for (const auto& route : fs->routeManager.map()) {
-        object_list[i].key.route_entry.switch_id = std::get<0>(route.first);
-        object_list[i].key.route_entry.vr_id = std::get<1>(route.first);
+        object_list[i].key.route_entry.switch_id = route.first.switchId;
+        object_list[i].key.route_entry.vr_id = route.first.vrId;
         object_list[i].key.route_entry.destination =
-            facebook::fboss::toSaiIpPrefix(std::get<2>(route.first));
+            facebook::fboss::toSaiIpPrefix(route.first.destination());
         ++i;
       }
       break;
@@ -17,6 +17,7 @@
 
 using facebook::fboss::FakePort;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t create_port_fn(
     sai_object_id_t* port_id,
@@ -245,6 +246,14 @@ sai_status_t set_port_attribute_fn(
   }
   switch (attr->id) {
     case SAI_PORT_ATTR_ADMIN_STATE:
+      if (port.adminState != attr->value.booldata &&
+          fs->notifier.linkNotifications()) {
+        // Fake links come up as soon as they are enabled
+        fs->notifier.portOperStatusChanged(
+            port_id,
+            attr->value.booldata ? SAI_PORT_OPER_STATUS_UP
+                                 : SAI_PORT_OPER_STATUS_DOWN);
+      }
       port.adminState = attr->value.booldata;
       break;
     case SAI_PORT_ATTR_HW_LANE_LIST: {
@@ -972,12 +981,30 @@ namespace facebook::fboss {
 static sai_port_api_t _port_api;
 
 void populate_port_api(sai_port_api_t** port_api) {
-  _port_api.create_port = &create_port_fn;
-  _port_api.remove_port = &remove_port_fn;
-  _port_api.set_port_attribute = &set_port_attribute_fn;
-  _port_api.get_port_attribute = &get_port_attribute_fn;
-  _port_api.get_port_stats = &get_port_stats_fn;
-  _port_api.get_port_stats_ext = &get_port_stats_ext_fn;
+  _port_api.create_port = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_PORT,
+      FakeSaiOp::CREATE,
+      create_port_fn>::call;
+  _port_api.remove_port = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_PORT,
+      FakeSaiOp::REMOVE,
+      remove_port_fn>::call;
+  _port_api.set_port_attribute = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_PORT,
+      FakeSaiOp::SET,
+      set_port_attribute_fn>::call;
+  _port_api.get_port_attribute = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_PORT,
+      FakeSaiOp::GET,
+      get_port_attribute_fn>::call;
+  _port_api.get_port_stats = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_PORT,
+      FakeSaiOp::GET_STATS,
+      get_port_stats_fn>::call;
+  _port_api.get_port_stats_ext = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_PORT,
+      FakeSaiOp::GET_STATS,
+      get_port_stats_ext_fn>::call;
   _port_api.clear_port_stats = &clear_port_stats_fn;
   _port_api.create_port_serdes = &create_port_serdes_fn;
   _port_api.remove_port_serdes = &remove_port_serdes_fn;
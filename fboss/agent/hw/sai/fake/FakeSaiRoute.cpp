@@ -15,13 +15,15 @@
 #include <folly/logging/xlog.h>
 
 using facebook::fboss::FakeRoute;
+using facebook::fboss::FakeRouteEntry;
 using facebook::fboss::FakeSai;
+using facebook::fboss::FakeSaiOp;
 
 sai_status_t set_route_entry_attribute_fn(
     const sai_route_entry_t* route_entry,
     const sai_attribute_t* attr) {
   auto fs = FakeSai::getInstance();
-  auto re = std::make_tuple(
+  FakeRouteEntry re(
       route_entry->switch_id,
       route_entry->vr_id,
       facebook::fboss::fromSaiIpPrefix(route_entry->destination));
@@ -47,7 +49,7 @@ sai_status_t create_route_entry_fn(
     uint32_t attr_count,
     const sai_attribute_t* attr_list) {
   auto fs = FakeSai::getInstance();
-  auto re = std::make_tuple(
+  FakeRouteEntry re(
       route_entry->switch_id,
       route_entry->vr_id,
       facebook::fboss::fromSaiIpPrefix(route_entry->destination));
@@ -60,7 +62,7 @@ sai_status_t create_route_entry_fn(
 
 sai_status_t remove_route_entry_fn(const sai_route_entry_t* route_entry) {
   auto fs = FakeSai::getInstance();
-  auto re = std::make_tuple(
+  FakeRouteEntry re(
       route_entry->switch_id,
       route_entry->vr_id,
       facebook::fboss::fromSaiIpPrefix(route_entry->destination));
@@ -75,7 +77,7 @@ sai_status_t get_route_entry_attribute_fn(
     uint32_t attr_count,
     sai_attribute_t* attr_list) {
   auto fs = FakeSai::getInstance();
-  auto re = std::make_tuple(
+  FakeRouteEntry re(
       route_entry->switch_id,
       route_entry->vr_id,
       facebook::fboss::fromSaiIpPrefix(route_entry->destination));
@@ -98,15 +100,82 @@ sai_status_t get_route_entry_attribute_fn(
   return SAI_STATUS_SUCCESS;
 }
 
+sai_status_t create_route_entries_fn(
+    uint32_t object_count,
+    const sai_route_entry_t* route_entry,
+    const uint32_t* attr_count,
+    const sai_attribute_t** attr_list,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  auto fs = FakeSai::getInstance();
+  fs->latency.simulate(
+      SAI_OBJECT_TYPE_ROUTE_ENTRY, FakeSaiOp::BULK_CREATE, object_count);
+  sai_status_t res = SAI_STATUS_SUCCESS;
+  for (uint32_t i = 0; i < object_count; ++i) {
+    if (res != SAI_STATUS_SUCCESS &&
+        mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+      object_statuses[i] = SAI_STATUS_NOT_EXECUTED;
+      continue;
+    }
+    try {
+      object_statuses[i] =
+          create_route_entry_fn(&route_entry[i], attr_count[i], attr_list[i]);
+    } catch (const std::exception&) {
+      object_statuses[i] = SAI_STATUS_ITEM_ALREADY_EXISTS;
+    }
+    if (object_statuses[i] != SAI_STATUS_SUCCESS) {
+      res = SAI_STATUS_FAILURE;
+    }
+  }
+  return res;
+}
+
+sai_status_t remove_route_entries_fn(
+    uint32_t object_count,
+    const sai_route_entry_t* route_entry,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  auto fs = FakeSai::getInstance();
+  fs->latency.simulate(
+      SAI_OBJECT_TYPE_ROUTE_ENTRY, FakeSaiOp::BULK_REMOVE, object_count);
+  sai_status_t res = SAI_STATUS_SUCCESS;
+  for (uint32_t i = 0; i < object_count; ++i) {
+    if (res != SAI_STATUS_SUCCESS &&
+        mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+      object_statuses[i] = SAI_STATUS_NOT_EXECUTED;
+      continue;
+    }
+    object_statuses[i] = remove_route_entry_fn(&route_entry[i]);
+    if (object_statuses[i] != SAI_STATUS_SUCCESS) {
+      res = SAI_STATUS_FAILURE;
+    }
+  }
+  return res;
+}
+
 namespace facebook::fboss {
 
 static sai_route_api_t _route_api;
 
 void populate_route_api(sai_route_api_t** route_api) {
-  _route_api.create_route_entry = &create_route_entry_fn;
-  _route_api.remove_route_entry = &remove_route_entry_fn;
-  _route_api.set_route_entry_attribute = &set_route_entry_attribute_fn;
-  _route_api.get_route_entry_attribute = &get_route_entry_attribute_fn;
+  _route_api.create_route_entry = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_ROUTE_ENTRY,
+      FakeSaiOp::CREATE,
+      create_route_entry_fn>::call;
+  _route_api.remove_route_entry = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_ROUTE_ENTRY,
+      FakeSaiOp::REMOVE,
+      remove_route_entry_fn>::call;
+  _route_api.set_route_entry_attribute = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_ROUTE_ENTRY,
+      FakeSaiOp::SET,
+      set_route_entry_attribute_fn>::call;
+  _route_api.get_route_entry_attribute = &FakeSaiWithLatency<
+      SAI_OBJECT_TYPE_ROUTE_ENTRY,
+      FakeSaiOp::GET,
+      get_route_entry_attribute_fn>::call;
+  _route_api.create_route_entries = &create_route_entries_fn;
+  _route_api.remove_route_entries = &remove_route_entries_fn;
   *route_api = &_route_api;
 }
 
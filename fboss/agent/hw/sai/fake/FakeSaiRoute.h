@@ -9,13 +9,12 @@
  */
 #pragma once
 
+#include "fboss/agent/hw/sai/fake/FakeIpAddress.h"
 #include "fboss/agent/hw/sai/fake/FakeManager.h"
 
 #include <folly/IPAddress.h>
 #include <folly/MacAddress.h>
 
-#include <tuple>
-
 extern "C" {
 #include <sai.h>
 }
@@ -28,9 +27,41 @@ struct FakeRoute {
   uint32_t metadata{0};
 };
 
-using FakeRouteEntry =
-    std::tuple<sai_object_id_t, sai_object_id_t, folly::CIDRNetwork>;
-using FakeRouteManager = FakeManager<FakeRouteEntry, FakeRoute>;
+struct FakeRouteEntry {
+  FakeRouteEntry(
+      sai_object_id_t switchId,
+      sai_object_id_t vrId,
+      const folly::CIDRNetwork& destination)
+      : switchId(switchId),
+        vrId(vrId),
+        prefix(destination.first),
+        mask(destination.second) {}
+
+  folly::CIDRNetwork destination() const {
+    return folly::CIDRNetwork(prefix.ip(), mask);
+  }
+
+  bool operator==(const FakeRouteEntry& other) const {
+    return switchId == other.switchId && vrId == other.vrId &&
+        mask == other.mask && prefix == other.prefix;
+  }
+  struct Hash {
+    size_t operator()(const FakeRouteEntry& entry) const {
+      return folly::hash::hash_combine(
+          entry.switchId, entry.vrId, entry.prefix.hash(), entry.mask);
+    }
+  };
+
+  sai_object_id_t switchId;
+  sai_object_id_t vrId;
+  FakeIpAddress prefix;
+  uint8_t mask;
+};
+
+using FakeRouteMap =
+    folly::F14ValueMap<FakeRouteEntry, FakeRoute, FakeRouteEntry::Hash>;
+using FakeRouteManager =
+    FakeManager<FakeRouteEntry, FakeRoute, 0, FakeRouteMap>;
 
 void populate_route_api(sai_route_api_t** route_api);
 
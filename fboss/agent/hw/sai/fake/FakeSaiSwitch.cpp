@@ -204,7 +204,14 @@ sai_status_t set_switch_attribute_fn(
     case SAI_SWITCH_ATTR_EXT_FAKE_LED_RESET:
       return sw.setLed(attr);
     case SAI_SWITCH_ATTR_PORT_STATE_CHANGE_NOTIFY:
+      fs->notifier.setPortStateChangeCallback(
+          reinterpret_cast<sai_port_state_change_notification_fn>(
+              attr->value.ptr));
+      break;
     case SAI_SWITCH_ATTR_FDB_EVENT_NOTIFY:
+      fs->notifier.setFdbEventCallback(
+          reinterpret_cast<sai_fdb_event_notification_fn>(attr->value.ptr));
+      break;
     case SAI_SWITCH_ATTR_PACKET_EVENT_NOTIFY:
     case SAI_SWITCH_ATTR_TAM_EVENT_NOTIFY:
       // No callback implementation in SAI
@@ -212,8 +212,10 @@ class SaiObject {
     // XXX TODO: side-effect mode does NOT work with optionals
     attributes_ = api.getAttribute(adapterKey_, attributes_);
     live_ = true;
-    adapterHostKey_ =
-        detail::adapterHostKey<SaiObjectTraits>(adapterKey_, attributes_);
+    if constexpr (!kAdapterHostKeyIsAdapterKey) {
+      adapterHostKey_ =
+          detail::adapterHostKey<SaiObjectTraits>(adapterKey_, attributes_);
+    }
   }
 
   // load with adapter key and adapter host key
@@ -237,7 +239,8 @@ class SaiObject {
       const typename SaiObjectTraits::AdapterHostKey& adapterHostKey,
       const typename SaiObjectTraits::CreateAttributes& attributes,
       sai_object_id_t switchId)
-      : adapterHostKey_(adapterHostKey), attributes_(attributes) {
+      : adapterHostKey_(adapterHostKeyStorage(adapterHostKey)),
+        attributes_(attributes) {
     adapterKey_ = createHelper(adapterHostKey, attributes, switchId);
     live_ = true;
   }
@@ -258,10 +261,9 @@ class SaiObject {
 
   SaiObject& operator=(SaiObject&& other) {
     if (LIKELY(other.live_)) {
-      // TODO(borisb): move members instead of copy?!
-      adapterKey_ = other.adapterKey();
-      adapterHostKey_ = other.adapterHostKey();
-      attributes_ = other.attributes();
+      adapterKey_ = std::move(other.adapterKey_);
+      adapterHostKey_ = std::move(other.adapterHostKey_);
+      attributes_ = std::move(other.attributes_);
       live_ = true;
       other.live_ = false;
     } else {
@@ -317,7 +319,11 @@ class SaiObject {
     if (UNLIKELY(!live_)) {
       XLOG(FATAL) << "Attempted to get Adapter Host Key of non-live SaiObject";
     }
-    return adapterHostKey_;
+    if constexpr (kAdapterHostKeyIsAdapterKey) {
+      return adapterKey_;
+    } else {
+      return adapterHostKey_;
+    }
   }
 
   const typename SaiObjectTraits::CreateAttributes& attributes() const {
@@ -334,7 +340,11 @@ class SaiObject {
     if constexpr (IsPublisherKeyCustomType<SaiObjectTraits>::value) {
       return publisherKey_;
     } else if constexpr (IsPublisherKeyAdapterHostKey<SaiObjectTraits>::value) {
-      return adapterHostKey_;
+      if constexpr (kAdapterHostKeyIsAdapterKey) {
+        return adapterKey_;
+      } else {
+        return adapterHostKey_;
+      }
     } else {
       static_assert(
           IsPublisherKeyCreateAttributes<SaiObjectTraits>::value,
@@ -481,13 +491,32 @@ class SaiObject {
       setAttributeInHardware(newAttrOpt.value());
     }
   }
+  // Entry structs (routes, neighbors, fdb entries...) are both the adapter
+  // key and the adapter host key. Those are also by far the most numerous
+  // objects, so only keep one copy of the key for them.
+  static constexpr bool kAdapterHostKeyIsAdapterKey =
+      AdapterKeyIsEntryStruct<SaiObjectTraits>::value;
+  using AdapterHostKeyStorage = std::conditional_t<
+      kAdapterHostKeyIsAdapterKey,
+      std::monostate,
+      typename SaiObjectTraits::AdapterHostKey>;
+
+  static AdapterHostKeyStorage adapterHostKeyStorage(
+      const typename SaiObjectTraits::AdapterHostKey& adapterHostKey) {
+    if constexpr (kAdapterHostKeyIsAdapterKey) {
+      return std::monostate{};
+    } else {
+      return adapterHostKey;
+    }
+  }
+
   bool live_{false};
   bool ownedByAdapter_{IsSaiObjectOwnedByAdapter<SaiObjectTraits>::value};
   // For some object types we can ignore missing in HW errors
   // on when deleting.
   bool ignoreMissingInHwOnDelete_{false};
   typename SaiObjectTraits::AdapterKey adapterKey_;
-  typename SaiObjectTraits::AdapterHostKey adapterHostKey_;
+  AdapterHostKeyStorage adapterHostKey_;
   typename SaiObjectTraits::CreateAttributes attributes_;
   typename PublisherKey<SaiObjectTraits>::custom_type publisherKey_{};
 };
@@ -2,7 +2,11 @@
 
 #include "fboss/agent/hw/sai/store/SaiObjectEventPublisher.h"
 
+#include <folly/ScopeGuard.h>
 #include <folly/Singleton.h>
+#include <folly/logging/xlog.h>
+
+#include <tuple>
 
 namespace {
 struct singleton_tag_type {};
@@ -18,4 +22,58 @@ SaiObjectEventPublisher::getInstance() {
   return kSingleton.try_get();
 }
 
+void SaiObjectEventPublisher::startBatch() {
+  if (batchDepth_++ == 0) {
+    std::apply(
+        [](auto&... publisher) { (publisher.startBatch(), ...); },
+        publishers_);
+  }
+}
+
+void SaiObjectEventPublisher::endBatch() {
+  CHECK_GT(batchDepth_, 0);
+  SCOPE_EXIT {
+    if (--batchDepth_ == 0) {
+      stopBatch();
+    }
+  };
+  // keep batching while delivering, so that what subscribers publish in
+  // response is also delivered a publisher type at a time
+  while (deliverPending()) {
+  }
+}
+
+void SaiObjectEventPublisher::endBatchOnError() {
+  if (batchDepth_ == 0) {
+    return;
+  }
+  SCOPE_EXIT {
+    if (--batchDepth_ == 0) {
+      stopBatch();
+    }
+  };
+  try {
+    while (deliverPending()) {
+    }
+  } catch (const std::exception& ex) {
+    XLOG(ERR) << "Failed to deliver notifications of a failed batch: "
+              << folly::exceptionStr(ex);
+  }
+}
+
+bool SaiObjectEventPublisher::deliverPending() {
+  bool delivered = false;
+  std::apply(
+      [&delivered](auto&... publisher) {
+        ((delivered = publisher.deliverPending() || delivered), ...);
+      },
+      publishers_);
+  return delivered;
+}
+
+void SaiObjectEventPublisher::stopBatch() {
+  std::apply(
+      [](auto&... publisher) { (publisher.stopBatch(), ...); }, publishers_);
+}
+
 } // namespace facebook::fboss
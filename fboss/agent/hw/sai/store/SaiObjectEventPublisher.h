@@ -2,7 +2,10 @@
 
 #pragma once
 
-#include <boost/signals2.hpp>
+#include <folly/ScopeGuard.h>
+
+#include <unordered_map>
+#include <vector>
 
 #include "fboss/agent/hw/sai/api/BridgeApi.h"
 #include "fboss/agent/hw/sai/api/FdbApi.h"
@@ -82,7 +85,10 @@ namespace detail {
  * subscribers
  * 5) tracks live publishers, this is done to handle situation if
  * subscribers come after publishers without having subscribers to actively poll
- * publisher */
+ * publisher
+ * 6) while batching, queues create and link down notifications until
+ * deliverPending(). Remove notifications are never queued, subscribers have
+ * to release their objects before the publisher object goes away. */
 template <typename PublishedObjectTrait>
 class SaiObjectEventPublisher {
  public:
@@ -93,26 +99,25 @@ class SaiObjectEventPublisher {
 
  private:
   class Subscription {
-    // a subscription, using boost signals since they are fast in issuing
-    // notifications to large number of subscribers, thread safe, re-entrant.
-    template <typename T>
-    using CreateSignal =
-        boost::signals2::signal<void(std::shared_ptr<const T>)>;
-    CreateSignal<SaiObject<PublishedObjectTrait>> createSignal_;
-    using CreateSignalSlot =
-        typename CreateSignal<SaiObject<PublishedObjectTrait>>::slot_type;
-
-    using RemoveSignal = boost::signals2::signal<void()>;
-    RemoveSignal removeSignal_;
-    using RemoveSignalSlot = typename RemoveSignal::slot_type;
-
-    using LinkDownSignal = boost::signals2::signal<void()>;
-    LinkDownSignal linkDownSignal_;
-    using LinkDownSignalSlot = typename LinkDownSignal::slot_type;
+    // subscribers of a publisher key. Subscribers are not owned, expired ones
+    // are skipped and dropped on the next subscribe.
+    std::vector<std::weak_ptr<Subscriber>> subscribers_;
+    // nesting depth of notifications being delivered to subscribers_
+    int delivering_{0};
 
     friend class SaiObjectEventPublisher<PublishedObjectTrait>;
   };
 
+  enum class PendingEvent {
+    CREATE,
+    LINK_DOWN,
+  };
+  struct PendingNotification {
+    Key key;
+    PendingEvent event;
+    uint64_t sequence;
+  };
+
  public:
   void subscribe(std::weak_ptr<Subscriber> subscriberWeakPtr) {
     auto subscriber = subscriberWeakPtr.lock(); // non-owning reference
@@ -123,33 +128,33 @@ class SaiObjectEventPublisher {
 
     // add a subscriber here for create or remove notifications.
     // subscriptions are self managed, because they're put in ref map.
-    // further if subscriber gets removed, its not notified because
-    // "track_foreign" will delete its slot in general following principles hold
+    // in general following principles hold
     // 1. a subscription exists only if at least one subscriber exists
     // 2. a subscription is deleted if no subscriber exists
     // 3. a slot for subscriber in subscription is freed if subscriber is
     // removed.
     // 4. a subscriber is not notified only if it exists
-    typename Subscription::CreateSignalSlot createSignalSlot = std::bind(
-        &Subscriber::afterCreate, subscriber.get(), std::placeholders::_1);
-    subscription->createSignal_.connect(
-        createSignalSlot.track_foreign(subscriberWeakPtr));
-
-    typename Subscription::RemoveSignalSlot removeSignalSlot =
-        std::bind(&Subscriber::beforeRemove, subscriber.get());
-    subscription->removeSignal_.connect(
-        removeSignalSlot.track_foreign(subscriberWeakPtr));
-
-    typename Subscription::LinkDownSignalSlot linkDownSignalSlot =
-        std::bind(&Subscriber::linkDown, subscriber.get());
-    subscription->linkDownSignal_.connect(
-        linkDownSignalSlot.track_foreign(subscriberWeakPtr));
+    auto& subscribers = subscription->subscribers_;
+    if (!subscription->delivering_) {
+      subscribers.erase(
+          std::remove_if(
+              subscribers.begin(),
+              subscribers.end(),
+              [](const auto& weakPtr) { return weakPtr.expired(); }),
+          subscribers.end());
+    }
+    subscribers.push_back(subscriberWeakPtr);
 
     subscriber->saveSubscription(subscription);
     XLOGF(
         DBG3,
         "subscription added for publisher {}",
         subscriber->getPublisherKey());
+    if (pendingCreates_.find(subscriber->getPublisherKey()) !=
+        pendingCreates_.end()) {
+      // creation is queued, subscriber will be notified along with the rest
+      return;
+    }
     // check if publisher is already live
     auto publisher = livePublishers_.find(subscriber->getPublisherKey());
     if (publisher != livePublishers_.end()) {
@@ -160,36 +165,147 @@ class SaiObjectEventPublisher {
 
   void notifyCreate(Key key, const std::shared_ptr<PublisherObject> object) {
     livePublishers_.emplace(key, object);
-    auto subscription = subscriptions_.get(key);
-    if (!subscription) {
+    if (batching_) {
+      queue(key, PendingEvent::CREATE, &pendingCreates_);
       return;
     }
-    XLOGF(DBG3, "publisher object {} notify create", key);
-    subscription->createSignal_(object);
+    deliverCreate(key, object);
   }
 
   void notifyDelete(Key key) {
     XLOGF(DBG3, "publisher object {} notify remove", key);
     livePublishers_.erase(key);
-    auto subscription = subscriptions_.get(key);
+    // anything queued for this publisher is moot now
+    pendingCreates_.erase(key);
+    pendingLinkDowns_.erase(key);
+    auto subscription = subscriptions_.ref(key);
     if (!subscription) {
       return;
     }
-    subscription->removeSignal_();
+    forEachSubscriber(
+        subscription.get(), [](auto* subscriber) { subscriber->beforeRemove(); });
   }
 
   void notifyLinkDown(Key key) {
+    if (batching_) {
+      queue(key, PendingEvent::LINK_DOWN, &pendingLinkDowns_);
+      return;
+    }
+    deliverLinkDown(key);
+  }
+
+  void startBatch() {
+    batching_ = true;
+  }
+
+  /*
+   * Deliver all queued notifications, in the order they were published. A
+   * publisher notified more than once is only delivered its latest
+   * notification of each kind. Notifications published while delivering are
+   * queued for the next call.
+   *
+   * Returns false if there was nothing to deliver.
+   */
+  bool deliverPending() {
+    if (pending_.empty()) {
+      return false;
+    }
+    auto pending = std::move(pending_);
+    pending_.clear();
+    for (const auto& notification : pending) {
+      auto& latest = notification.event == PendingEvent::CREATE
+          ? pendingCreates_
+          : pendingLinkDowns_;
+      auto itr = latest.find(notification.key);
+      if (itr == latest.end() || itr->second != notification.sequence) {
+        // superseded, or publisher removed since
+        continue;
+      }
+      latest.erase(itr);
+      if (notification.event == PendingEvent::LINK_DOWN) {
+        deliverLinkDown(notification.key);
+        continue;
+      }
+      auto publisher = livePublishers_.find(notification.key);
+      if (publisher == livePublishers_.end()) {
+        continue;
+      }
+      if (auto object = publisher->second.lock()) {
+        deliverCreate(notification.key, object);
+      }
+    }
+    return true;
+  }
+
+  /*
+   * Stop batching. Anything still queued is dropped.
+   */
+  void stopBatch() {
+    batching_ = false;
+    pending_.clear();
+    pendingCreates_.clear();
+    pendingLinkDowns_.clear();
+  }
+
+ private:
+  template <typename Fn>
+  void forEachSubscriber(Subscription* subscription, Fn fn) {
+    // subscribers may subscribe to this publisher while being notified, which
+    // can grow the vector. Only those present up front are notified.
+    ++subscription->delivering_;
+    SCOPE_EXIT {
+      --subscription->delivering_;
+    };
+    auto numSubscribers = subscription->subscribers_.size();
+    for (size_t i = 0; i < numSubscribers; ++i) {
+      if (auto subscriber = subscription->subscribers_[i].lock()) {
+        fn(subscriber.get());
+      }
+    }
+  }
+
+  void deliverCreate(
+      const Key& key,
+      const std::shared_ptr<PublisherObject>& object) {
+    // hold on to the subscription, subscribers may all go away while notified
+    auto subscription = subscriptions_.ref(key);
+    if (!subscription) {
+      return;
+    }
+    XLOGF(DBG3, "publisher object {} notify create", key);
+    forEachSubscriber(subscription.get(), [&object](auto* subscriber) {
+      subscriber->afterCreate(object);
+    });
+  }
+
+  void deliverLinkDown(const Key& key) {
     XLOGF(DBG3, "publisher object {} notify link down", key);
-    auto subscription = subscriptions_.get(key);
+    auto subscription = subscriptions_.ref(key);
     if (!subscription) {
       return;
     }
-    subscription->linkDownSignal_();
+    forEachSubscriber(
+        subscription.get(), [](auto* subscriber) { subscriber->linkDown(); });
+  }
+
+  void queue(
+      const Key& key,
+      PendingEvent event,
+      std::unordered_map<Key, uint64_t>* latest) {
+    auto sequence = nextSequence_++;
+    (*latest)[key] = sequence;
+    pending_.push_back({key, event, sequence});
   }
 
- private:
   std::unordered_map<Key, std::weak_ptr<PublisherObject>> livePublishers_;
   UnorderedRefMap<Key, Subscription> subscriptions_;
+
+  bool batching_{false};
+  std::vector<PendingNotification> pending_;
+  // sequence number of the latest queued notification per publisher
+  std::unordered_map<Key, uint64_t> pendingCreates_;
+  std::unordered_map<Key, uint64_t> pendingLinkDowns_;
+  uint64_t nextSequence_{0};
 };
 
 } // namespace detail
@@ -224,15 +340,47 @@ class SaiObjectEventPublisher {
         publishers_);
   }
 
+  /*
+   * Batch create and link down notifications until the matching endBatch().
+   *
+   * endBatch() delivers everything queued so far: all queued notifications
+   * of one publisher type are delivered before moving on to the next type,
+   * and whatever subscribers publish in turn is delivered in further rounds
+   * until nothing is left. This way a state delta touching many neighbors
+   * notifies all of their next hops together, rather than cascading through
+   * next hops and next hop group members one neighbor at a time.
+   *
+   * Batches nest, batching stops when the outermost one ends. An inner batch
+   * (e.g. link down handling while a state delta is being applied) still
+   * delivers when it ends, so that it is not held up by the outer one.
+   *
+   * Callers have to serialize these with all other uses of the publisher.
+   */
+  void startBatch();
+  void endBatch();
+  /*
+   * End a batch cut short by an error, e.g. when the state delta it covered
+   * failed to apply. The objects created so far exist regardless, so queued
+   * notifications are still delivered, but delivery errors are only logged
+   * as the caller is already handling one.
+   */
+  void endBatchOnError();
+
  private:
+  bool deliverPending();
+  void stopBatch();
+
+  // pending notifications are delivered in this order, which follows the
+  // dependencies between publishers and their subscribers
   std::tuple<
       detail::SaiObjectEventPublisher<SaiBridgePortTraits>,
       detail::SaiObjectEventPublisher<SaiFdbTraits>,
+      detail::SaiObjectEventPublisher<SaiVlanRouterInterfaceTraits>,
       detail::SaiObjectEventPublisher<SaiNeighborTraits>,
       detail::SaiObjectEventPublisher<SaiIpNextHopTraits>,
-      detail::SaiObjectEventPublisher<SaiMplsNextHopTraits>,
-      detail::SaiObjectEventPublisher<SaiVlanRouterInterfaceTraits>>
+      detail::SaiObjectEventPublisher<SaiMplsNextHopTraits>>
       publishers_;
+  int batchDepth_{0};
 };
 
 } // namespace facebook::fboss
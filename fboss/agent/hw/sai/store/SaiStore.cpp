@@ -10,6 +10,22 @@
 
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
+
+#include <gflags/gflags.h>
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+DEFINE_int32(
+    sai_store_reload_threads,
+    8,
+    "Number of threads reloading SaiStore object types in parallel, if the "
+    "adapter is thread safe");
+
 namespace facebook::fboss {
 
 SaiStore::SaiStore() {}
@@ -27,8 +43,14 @@ void SaiStore::setSwitchId(sai_object_id_t switchId) {
 void SaiStore::reload(
     const folly::dynamic* adapterKeysJson,
     const folly::dynamic* adapterKeys2AdapterHostKeyJson) {
+  struct ReloadTask {
+    folly::StringPiece objectTypeName;
+    std::function<void()> reload;
+    std::chrono::steady_clock::duration duration{};
+  };
+  std::vector<ReloadTask> tasks;
   tupleForEach(
-      [adapterKeysJson, adapterKeys2AdapterHostKeyJson](auto& store) {
+      [&tasks, adapterKeysJson, adapterKeys2AdapterHostKeyJson](auto& store) {
         const folly::dynamic* adapterKeys = adapterKeysJson
             ? adapterKeysJson->get_ptr(store.objectTypeName())
             : nullptr;
@@ -36,9 +58,64 @@ void SaiStore::reload(
             ? adapterKeys2AdapterHostKeyJson->get_ptr(store.objectTypeName())
             : nullptr;
 
-        store.reload(adapterKeys, adapterHostKeys);
+        tasks.push_back(
+            {store.objectTypeName(), [&store, adapterKeys, adapterHostKeys]() {
+               store.reload(adapterKeys, adapterHostKeys);
+             }});
       },
       stores_);
+
+  auto runTask = [](ReloadTask& task) {
+    auto begin = std::chrono::steady_clock::now();
+    task.reload();
+    task.duration = std::chrono::steady_clock::now() - begin;
+  };
+
+  // There is no point in reloading in parallel if all the SAI calls have to
+  // be serialized anyway
+  size_t numThreads = SaiApiLock::getInstance()->isAdaptorThreadSafe()
+      ? std::min<size_t>(
+            std::max(FLAGS_sai_store_reload_threads, 1), tasks.size())
+      : 1;
+  if (numThreads <= 1) {
+    for (auto& task : tasks) {
+      runTask(task);
+    }
+  } else {
+    std::atomic<size_t> nextTask{0};
+    std::vector<std::exception_ptr> errors(tasks.size());
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i) {
+      threads.emplace_back([&]() {
+        for (auto index = nextTask++; index < tasks.size();
+             index = nextTask++) {
+          try {
+            runTask(tasks[index]);
+          } catch (...) {
+            errors[index] = std::current_exception();
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (const auto& error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+  }
+
+  reloadDurations_.clear();
+  for (const auto& task : tasks) {
+    // Some object types have more than one store, e.g. ip and mpls next hops
+    reloadDurations_[task.objectTypeName.str()] +=
+        std::chrono::duration_cast<std::chrono::milliseconds>(task.duration);
+  }
+  XLOG(DBG2) << "SaiStore reloaded " << tasks.size() << " object stores with "
+             << numThreads << " threads";
 }
 
 void SaiStore::release() {
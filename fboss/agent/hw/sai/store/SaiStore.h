@@ -24,8 +24,11 @@
 #include "fboss/agent/hw/sai/store/Traits.h"
 #include "fboss/lib/RefMap.h"
 
+#include <folly/container/F14Map.h>
 #include <folly/dynamic.h>
 
+#include <chrono>
+#include <map>
 #include <memory>
 #include <optional>
 #include <sstream>
@@ -60,11 +63,13 @@ class SaiObjectStore {
       SaiObjectWithCounters<SaiObjectTraits>,
       SaiObject<SaiObjectTraits>>::type;
   using ObjectTraits = SaiObjectTraits;
+  using ObjectMap =
+      F14NodeRefMap<typename SaiObjectTraits::AdapterHostKey, ObjectType>;
 
   explicit SaiObjectStore(sai_object_id_t switchId) : switchId_(switchId) {}
   SaiObjectStore() {}
   ~SaiObjectStore() {
-    for (auto iter : warmBootHandles_) {
+    for (const auto& iter : warmBootHandles_) {
       iter.second->release();
     }
   }
@@ -168,7 +173,8 @@ class SaiObjectStore {
     if (shouldSkipReloadingObjects()) {
       return;
     }
-    for (const auto k : keys) {
+    warmBootHandles_.reserve(warmBootHandles_.size() + keys.size());
+    for (const auto& k : keys) {
       ObjectType obj = getObject(k, adapterKeys2AdapterHostKey);
       auto adapterHostKey = obj.adapterHostKey();
       XLOGF(DBG5, "SaiStore reloaded {}", obj);
@@ -257,12 +263,12 @@ class SaiObjectStore {
   std::shared_ptr<ObjectType> find(
       const typename SaiObjectTraits::AdapterKey& adapterKey) {
     XLOGF(DBG5, "SaiStore find object {}", adapterKey);
-    for (auto iter : warmBootHandles_) {
+    for (const auto& iter : warmBootHandles_) {
       if (iter.second->adapterKey() == adapterKey) {
         return iter.second;
       }
     }
-    for (auto iter : objects_) {
+    for (const auto& iter : objects_) {
       auto obj = iter.second.lock();
       if (obj->adapterKey() == adapterKey) {
         return obj;
@@ -295,7 +301,7 @@ class SaiObjectStore {
     return adapterKeys;
   }
   void exitForWarmBoot() {
-    for (auto itr : objects_) {
+    for (const auto& itr : objects_) {
       if (auto object = itr.second.lock()) {
         object->release();
       }
@@ -303,25 +309,18 @@ class SaiObjectStore {
     objects_.clear();
   }
 
-  const UnorderedRefMap<typename SaiObjectTraits::AdapterHostKey, ObjectType>&
-  objects() const {
+  const ObjectMap& objects() const {
     return objects_;
   }
 
   uint64_t size() const {
     return objects_.size();
   }
-  typename UnorderedRefMap<
-      typename SaiObjectTraits::AdapterHostKey,
-      ObjectType>::MapType::const_iterator
-  begin() const {
+  typename ObjectMap::MapType::const_iterator begin() const {
     return objects_.begin();
   }
 
-  typename UnorderedRefMap<
-      typename SaiObjectTraits::AdapterHostKey,
-      ObjectType>::MapType::const_iterator
-  end() const {
+  typename ObjectMap::MapType::const_iterator end() const {
     return objects_.end();
   }
 
@@ -348,7 +347,7 @@ class SaiObjectStore {
     if (warmBootHandlesCount()) {
       XLOGF(DBG1, "unclaimed {} entries", objectTypeName());
     }
-    for (auto iter : warmBootHandles_) {
+    for (const auto& iter : warmBootHandles_) {
       XLOGF(DBG1, "{}", *iter.second);
     }
   }
@@ -443,9 +442,8 @@ class SaiObjectStore {
   }
 
   std::optional<sai_object_id_t> switchId_;
-  UnorderedRefMap<typename SaiObjectTraits::AdapterHostKey, ObjectType>
-      objects_;
-  std::unordered_map<
+  ObjectMap objects_;
+  folly::F14NodeMap<
       typename SaiObjectTraits::AdapterHostKey,
       std::shared_ptr<ObjectType>>
       warmBootHandles_;
@@ -481,11 +479,23 @@ class SaiStore {
 
   /*
    * Reload the SaiStore from the current SAI state via SAI api calls.
+   *
+   * Object types are independent of each other here, so if the adapter is
+   * thread safe they are reloaded in parallel.
    */
   void reload(
       const folly::dynamic* adapterKeys = nullptr,
       const folly::dynamic* adapterKeys2AdapterHostKey = nullptr);
 
+  /*
+   * Time spent reloading each object type in the last reload(), keyed by
+   * object type name.
+   */
+  const std::map<std::string, std::chrono::milliseconds>& getReloadDurations()
+      const {
+    return reloadDurations_;
+  }
+
   /*
    *
    */
@@ -515,6 +525,7 @@ class SaiStore {
 
  private:
   sai_object_id_t switchId_{};
+  std::map<std::string, std::chrono::milliseconds> reloadDurations_;
   std::tuple<
       SaiObjectStore<SaiAclTableGroupTraits>,
       SaiObjectStore<SaiAclTableGroupMemberTraits>,
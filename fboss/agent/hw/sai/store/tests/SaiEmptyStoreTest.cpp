@@ -23,3 +23,12 @@ TEST_F(SaiStoreTest, singletonLoadEmpty) {
   saiStore->setSwitchId(0);
   saiStore->reload();
 }
+
+TEST_F(SaiStoreTest, reloadDurations) {
+  SaiStore s(0);
+  s.reload();
+  const auto& durations = s.getReloadDurations();
+  EXPECT_NE(durations.find("route-entry"), durations.end());
+  // Stores of the same object type are accounted together
+  EXPECT_EQ(durations.count("nhop"), 1);
+}
@@ -0,0 +1,188 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/store/SaiObject.h"
+#include "fboss/agent/hw/sai/store/SaiObjectEventPublisher.h"
+#include "fboss/agent/hw/sai/store/SaiObjectEventSubscriber-defs.h"
+#include "fboss/agent/hw/sai/store/SaiStore.h"
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddress.h>
+#include <folly/MacAddress.h>
+
+/*
+ * Flaps 10k neighbors, each resolving a next hop which is a member of a few
+ * next hop groups, and measures the cost of cascading the neighbor events
+ * through next hops and next hop group members in the store, with and
+ * without batching the notifications.
+ */
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr uint32_t kNumNeighbors = 10 * 1000;
+constexpr uint32_t kNumRifs = 64;
+constexpr uint32_t kNumGroups = 4;
+
+folly::IPAddress neighborIp(uint32_t i) {
+  return folly::IPAddress::fromLongHBO((10u << 24) + i + 1);
+}
+
+SaiNeighborTraits::NeighborEntry neighborEntry(uint32_t i) {
+  return SaiNeighborTraits::NeighborEntry(0, i % kNumRifs, neighborIp(i));
+}
+
+SaiIpNextHopTraits::AdapterHostKey nextHopKey(uint32_t i) {
+  return SaiIpNextHopTraits::AdapterHostKey{
+      RouterInterfaceSaiId(i % kNumRifs), neighborIp(i)};
+}
+
+// Adds the next hop to all groups once it is created
+class NextHopSubscriber
+    : public detail::SaiObjectEventSubscriber<SaiIpNextHopTraits> {
+ public:
+  NextHopSubscriber(
+      SaiIpNextHopTraits::AdapterHostKey key,
+      SaiStore* store,
+      const std::vector<NextHopGroupSaiId>& groups)
+      : detail::SaiObjectEventSubscriber<SaiIpNextHopTraits>(key),
+        store_(store),
+        groups_(groups) {}
+
+  void afterCreate(PublisherObjectSharedPtr nextHop) override {
+    setPublisherObject(nextHop);
+    auto nextHopId = nextHop->adapterKey();
+    members_.clear();
+    for (auto groupId : groups_) {
+      members_.push_back(
+          store_->get<SaiNextHopGroupMemberTraits>().setObject(
+              SaiNextHopGroupMemberTraits::AdapterHostKey{groupId, nextHopId},
+              SaiNextHopGroupMemberTraits::CreateAttributes{
+                  groupId, nextHopId, std::nullopt}));
+    }
+  }
+  void beforeRemove() override {
+    members_.clear();
+    setPublisherObject(nullptr);
+  }
+  void linkDown() override {}
+
+ private:
+  SaiStore* store_;
+  const std::vector<NextHopGroupSaiId>& groups_;
+  std::vector<std::shared_ptr<SaiObject<SaiNextHopGroupMemberTraits>>>
+      members_;
+};
+
+// Creates a next hop once the neighbor is resolved
+class NeighborSubscriber
+    : public detail::SaiObjectEventSubscriber<SaiNeighborTraits> {
+ public:
+  NeighborSubscriber(uint32_t i, SaiStore* store)
+      : detail::SaiObjectEventSubscriber<SaiNeighborTraits>(neighborEntry(i)),
+        index_(i),
+        store_(store) {}
+
+  void afterCreate(PublisherObjectSharedPtr neighbor) override {
+    setPublisherObject(neighbor);
+    auto key = nextHopKey(index_);
+    nextHop_ = store_->get<SaiIpNextHopTraits>().setObject(
+        key,
+        SaiIpNextHopTraits::CreateAttributes{
+            SAI_NEXT_HOP_TYPE_IP,
+            std::get<SaiIpNextHopTraits::Attributes::RouterInterfaceId>(key),
+            std::get<SaiIpNextHopTraits::Attributes::Ip>(key),
+            std::nullopt});
+  }
+  void beforeRemove() override {
+    nextHop_.reset();
+    setPublisherObject(nullptr);
+  }
+  void linkDown() override {}
+
+ private:
+  uint32_t index_;
+  SaiStore* store_;
+  std::shared_ptr<SaiObject<SaiIpNextHopTraits>> nextHop_;
+};
+
+void flapNeighbors(bool batched) {
+  folly::BenchmarkSuspender suspender;
+  auto fs = FakeSai::getInstance();
+  auto saiApiTable = SaiApiTable::getInstance();
+  saiApiTable->queryApis(nullptr, saiApiTable->getFullApiList());
+  auto store = std::make_unique<SaiStore>(0);
+  store->reload();
+  auto publisher = SaiObjectEventPublisher::getInstance();
+
+  std::vector<std::shared_ptr<SaiObject<SaiNextHopGroupTraits>>> groupObjects;
+  std::vector<NextHopGroupSaiId> groups;
+  for (uint32_t i = 0; i < kNumGroups; ++i) {
+    SaiNextHopGroupTraits::AdapterHostKey key;
+    key.insert(std::make_pair(nextHopKey(i), i + 1));
+    groupObjects.push_back(store->get<SaiNextHopGroupTraits>().setObject(
+        key,
+        SaiNextHopGroupTraits::CreateAttributes{SAI_NEXT_HOP_GROUP_TYPE_ECMP}));
+    groups.push_back(groupObjects.back()->adapterKey());
+  }
+
+  std::vector<std::shared_ptr<NeighborSubscriber>> neighborSubscribers;
+  std::vector<std::shared_ptr<NextHopSubscriber>> nextHopSubscribers;
+  for (uint32_t i = 0; i < kNumNeighbors; ++i) {
+    neighborSubscribers.push_back(
+        std::make_shared<NeighborSubscriber>(i, store.get()));
+    publisher->get<SaiNeighborTraits>().subscribe(neighborSubscribers.back());
+    nextHopSubscribers.push_back(
+        std::make_shared<NextHopSubscriber>(nextHopKey(i), store.get(), groups));
+    publisher->get<SaiIpNextHopTraits>().subscribe(nextHopSubscribers.back());
+  }
+
+  folly::MacAddress dstMac("02:00:00:00:00:01");
+  auto resolveAll = [&]() {
+    std::vector<std::shared_ptr<SaiObject<SaiNeighborTraits>>> neighbors;
+    neighbors.reserve(kNumNeighbors);
+    if (batched) {
+      publisher->startBatch();
+    }
+    for (uint32_t i = 0; i < kNumNeighbors; ++i) {
+      neighbors.push_back(store->get<SaiNeighborTraits>().setObject(
+          neighborEntry(i),
+          SaiNeighborTraits::CreateAttributes{dstMac, std::nullopt}));
+    }
+    if (batched) {
+      publisher->endBatch();
+    }
+    return neighbors;
+  };
+  auto neighbors = resolveAll();
+  suspender.dismiss();
+
+  // All neighbors go away and come back, as on a neighbor table flush
+  neighbors.clear();
+  neighbors = resolveAll();
+
+  suspender.rehire();
+  neighbors.clear();
+  nextHopSubscribers.clear();
+  neighborSubscribers.clear();
+  groupObjects.clear();
+  store.reset();
+}
+
+} // namespace
+
+BENCHMARK(SaiObjectEventCascade10kNeighborFlap) {
+  flapNeighbors(false);
+}
+
+BENCHMARK(SaiObjectEventCascade10kNeighborFlapBatched) {
+  flapNeighbors(true);
+}
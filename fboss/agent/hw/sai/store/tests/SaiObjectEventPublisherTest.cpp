@@ -0,0 +1,173 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/api/NeighborApi.h"
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/store/SaiObject.h"
+#include "fboss/agent/hw/sai/store/SaiObjectEventPublisher.h"
+#include "fboss/agent/hw/sai/store/SaiObjectEventSubscriber-defs.h"
+#include "fboss/agent/hw/sai/store/SaiStore.h"
+#include "fboss/agent/hw/sai/store/tests/SaiStoreTest.h"
+
+using namespace facebook::fboss;
+
+namespace {
+
+class RecordingNeighborSubscriber
+    : public detail::SaiObjectEventSubscriber<SaiNeighborTraits> {
+ public:
+  explicit RecordingNeighborSubscriber(SaiNeighborTraits::NeighborEntry entry)
+      : detail::SaiObjectEventSubscriber<SaiNeighborTraits>(entry) {}
+
+  void afterCreate(PublisherObjectSharedPtr object) override {
+    setPublisherObject(object);
+    events.push_back("create");
+  }
+  void beforeRemove() override {
+    setPublisherObject(nullptr);
+    events.push_back("remove");
+  }
+  void linkDown() override {
+    events.push_back("linkDown");
+  }
+
+  std::vector<std::string> events;
+};
+
+using Events = std::vector<std::string>;
+
+} // namespace
+
+class SaiObjectEventPublisherTest : public SaiStoreTest {
+ public:
+  void SetUp() override {
+    SaiStoreTest::SetUp();
+    saiStore->setSwitchId(0);
+    saiStore->reload();
+  }
+
+  std::shared_ptr<SaiObject<SaiNeighborTraits>> createNeighbor() {
+    return saiStore->get<SaiNeighborTraits>().setObject(
+        neighborEntry, {folly::MacAddress("42:42:42:42:42:42"), std::nullopt});
+  }
+
+  std::shared_ptr<RecordingNeighborSubscriber> subscribe() {
+    auto subscriber =
+        std::make_shared<RecordingNeighborSubscriber>(neighborEntry);
+    publisher().get<SaiNeighborTraits>().subscribe(subscriber);
+    return subscriber;
+  }
+
+  SaiObjectEventPublisher& publisher() {
+    return *SaiObjectEventPublisher::getInstance();
+  }
+
+  SaiNeighborTraits::NeighborEntry neighborEntry{
+      0,
+      0,
+      folly::IPAddress("10.0.0.1")};
+};
+
+TEST_F(SaiObjectEventPublisherTest, notifyImmediately) {
+  auto subscriber = subscribe();
+  auto neighbor = createNeighbor();
+  EXPECT_EQ(subscriber->events, Events({"create"}));
+  EXPECT_TRUE(subscriber->isReady());
+
+  neighbor.reset();
+  EXPECT_EQ(subscriber->events, Events({"create", "remove"}));
+}
+
+TEST_F(SaiObjectEventPublisherTest, subscribeToLivePublisher) {
+  auto neighbor = createNeighbor();
+  auto subscriber = subscribe();
+  EXPECT_EQ(subscriber->events, Events({"create"}));
+}
+
+TEST_F(SaiObjectEventPublisherTest, batchCreates) {
+  auto subscriber = subscribe();
+  publisher().startBatch();
+  auto neighbor = createNeighbor();
+  // Re-notifying only delivers once
+  neighbor->notifyAfterCreate(neighbor);
+  EXPECT_TRUE(subscriber->events.empty());
+
+  publisher().endBatch();
+  EXPECT_EQ(subscriber->events, Events({"create"}));
+  EXPECT_TRUE(subscriber->isReady());
+}
+
+TEST_F(SaiObjectEventPublisherTest, removeDuringBatch) {
+  auto subscriber = subscribe();
+  publisher().startBatch();
+  auto neighbor = createNeighbor();
+  // Removal can't wait for the batch to end
+  neighbor.reset();
+  EXPECT_EQ(subscriber->events, Events({"remove"}));
+
+  publisher().endBatch();
+  EXPECT_EQ(subscriber->events, Events({"remove"}));
+  EXPECT_FALSE(subscriber->isReady());
+}
+
+TEST_F(SaiObjectEventPublisherTest, subscribeDuringBatch) {
+  publisher().startBatch();
+  auto neighbor = createNeighbor();
+  auto subscriber = subscribe();
+  EXPECT_TRUE(subscriber->events.empty());
+
+  publisher().endBatch();
+  EXPECT_EQ(subscriber->events, Events({"create"}));
+}
+
+TEST_F(SaiObjectEventPublisherTest, batchKeepsOrder) {
+  auto subscriber = subscribe();
+  auto neighbor = createNeighbor();
+
+  publisher().startBatch();
+  publisher().get<SaiNeighborTraits>().notifyLinkDown(neighborEntry);
+  neighbor->notifyAfterCreate(neighbor);
+  publisher().endBatch();
+  EXPECT_EQ(subscriber->events, Events({"create", "linkDown", "create"}));
+}
+
+TEST_F(SaiObjectEventPublisherTest, nestedBatches) {
+  auto subscriber = subscribe();
+  publisher().startBatch();
+  auto neighbor = createNeighbor();
+
+  // Ending the inner batch delivers what is queued so far
+  publisher().startBatch();
+  publisher().endBatch();
+  EXPECT_EQ(subscriber->events, Events({"create"}));
+
+  // Still batching until the outer batch ends
+  publisher().get<SaiNeighborTraits>().notifyLinkDown(neighborEntry);
+  EXPECT_EQ(subscriber->events, Events({"create"}));
+  publisher().endBatch();
+  EXPECT_EQ(subscriber->events, Events({"create", "linkDown"}));
+
+  // And not anymore after
+  publisher().get<SaiNeighborTraits>().notifyLinkDown(neighborEntry);
+  EXPECT_EQ(subscriber->events, Events({"create", "linkDown", "linkDown"}));
+}
+
+TEST_F(SaiObjectEventPublisherTest, endBatchOnError) {
+  auto subscriber = subscribe();
+  publisher().startBatch();
+  auto neighbor = createNeighbor();
+  // The neighbor exists even though the batch failed
+  publisher().endBatchOnError();
+  EXPECT_EQ(subscriber->events, Events({"create"}));
+  EXPECT_TRUE(subscriber->isReady());
+
+  publisher().get<SaiNeighborTraits>().notifyLinkDown(neighborEntry);
+  EXPECT_EQ(subscriber->events, Events({"create", "linkDown"}));
+}
@@ -0,0 +1,150 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/store/SaiObject.h"
+#include "fboss/agent/hw/sai/store/SaiStore.h"
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddress.h>
+#include <folly/MacAddress.h>
+
+/*
+ * Programs production scale route and neighbor tables through SaiStore,
+ * then looks every entry up, and reloads the store as on warm boot. Linked
+ * with the hw benchmark main, which reports max RSS along with the timings.
+ */
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr uint32_t kNumNeighbors = 128 * 1024;
+constexpr uint32_t kNumRoutes = 500 * 1000;
+constexpr uint32_t kNumRifs = 64;
+
+// 2401:db00:<prefix>::<host>
+folly::IPAddressV6 makeV6(uint32_t prefix, uint32_t host) {
+  folly::ByteArray16 bytes{};
+  bytes[0] = 0x24;
+  bytes[1] = 0x01;
+  bytes[2] = 0xdb;
+  for (int i = 0; i < 4; ++i) {
+    bytes[4 + i] = (prefix >> (24 - 8 * i)) & 0xff;
+    bytes[12 + i] = (host >> (24 - 8 * i)) & 0xff;
+  }
+  return folly::IPAddressV6(bytes);
+}
+
+SaiNeighborTraits::NeighborEntry neighborEntry(uint32_t i) {
+  return SaiNeighborTraits::NeighborEntry(
+      0, i % kNumRifs, folly::IPAddress(makeV6(i % kNumRifs, i / kNumRifs + 1)));
+}
+
+SaiRouteTraits::RouteEntry routeEntry(uint32_t i) {
+  // Half v4 /24s, half v6 /64s
+  if (i % 2) {
+    return SaiRouteTraits::RouteEntry(
+        0,
+        0,
+        folly::CIDRNetwork(
+            folly::IPAddress::fromLongHBO((10u << 24) + ((i / 2) << 8)), 24));
+  }
+  return SaiRouteTraits::RouteEntry(
+      0, 0, folly::CIDRNetwork(folly::IPAddress(makeV6(i / 2, 0)), 64));
+}
+
+struct ScaleTables {
+  std::vector<std::shared_ptr<SaiObject<SaiNeighborTraits>>> neighbors;
+  std::vector<std::shared_ptr<SaiObject<SaiRouteTraits>>> routes;
+};
+
+ScaleTables programTables(SaiStore* store) {
+  ScaleTables tables;
+  tables.neighbors.reserve(kNumNeighbors);
+  tables.routes.reserve(kNumRoutes);
+  folly::MacAddress dstMac("02:00:00:00:00:01");
+  for (uint32_t i = 0; i < kNumNeighbors; ++i) {
+    tables.neighbors.push_back(store->get<SaiNeighborTraits>().setObject(
+        neighborEntry(i),
+        SaiNeighborTraits::CreateAttributes{dstMac, std::nullopt}));
+  }
+  for (uint32_t i = 0; i < kNumRoutes; ++i) {
+    tables.routes.push_back(store->get<SaiRouteTraits>().setObject(
+        routeEntry(i),
+        SaiRouteTraits::CreateAttributes{
+            SAI_PACKET_ACTION_FORWARD, i % kNumNeighbors, std::nullopt}));
+  }
+  return tables;
+}
+
+std::unique_ptr<SaiStore> makeStore() {
+  auto saiApiTable = SaiApiTable::getInstance();
+  saiApiTable->queryApis(nullptr, saiApiTable->getFullApiList());
+  auto store = std::make_unique<SaiStore>(0);
+  store->reload();
+  return store;
+}
+
+} // namespace
+
+BENCHMARK(SaiStoreScaleProgram500kRoutes128kNeighbors) {
+  folly::BenchmarkSuspender suspender;
+  auto fs = FakeSai::getInstance();
+  auto store = makeStore();
+  suspender.dismiss();
+
+  auto tables = programTables(store.get());
+
+  suspender.rehire();
+  tables = ScaleTables();
+  store.reset();
+  FakeSai::clear();
+}
+
+BENCHMARK(SaiStoreScaleLookup500kRoutes128kNeighbors) {
+  folly::BenchmarkSuspender suspender;
+  auto fs = FakeSai::getInstance();
+  auto store = makeStore();
+  auto tables = programTables(store.get());
+  suspender.dismiss();
+
+  for (uint32_t i = 0; i < kNumNeighbors; ++i) {
+    folly::doNotOptimizeAway(
+        store->get<SaiNeighborTraits>().get(neighborEntry(i)));
+  }
+  for (uint32_t i = 0; i < kNumRoutes; ++i) {
+    folly::doNotOptimizeAway(store->get<SaiRouteTraits>().get(routeEntry(i)));
+  }
+
+  suspender.rehire();
+  tables = ScaleTables();
+  store.reset();
+  FakeSai::clear();
+}
+
+BENCHMARK(SaiStoreScaleReload500kRoutes128kNeighbors) {
+  folly::BenchmarkSuspender suspender;
+  auto fs = FakeSai::getInstance();
+  auto store = makeStore();
+  auto tables = programTables(store.get());
+  // Leave the entries in the fake, as over warm boot
+  store->exitForWarmBoot();
+  tables = ScaleTables();
+  store.reset();
+  suspender.dismiss();
+
+  auto reloaded = makeStore();
+
+  suspender.rehire();
+  reloaded->get<SaiRouteTraits>().removeUnexpectedUnclaimedWarmbootHandles();
+  reloaded->get<SaiNeighborTraits>().removeUnexpectedUnclaimedWarmbootHandles();
+  reloaded.reset();
+  FakeSai::clear();
+}
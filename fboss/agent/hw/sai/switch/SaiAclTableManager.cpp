@@ -24,12 +24,53 @@
 #include "fboss/agent/hw/switch_asics/HwAsic.h"
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 
+#include <fb303/ServiceData.h>
 #include <folly/MacAddress.h>
+#include <gflags/gflags.h>
 #include <chrono>
 #include <memory>
 
 using namespace std::chrono;
 
+DEFINE_bool(
+    sai_acl_entry_update_in_place,
+    true,
+    "Update fields and actions of a changed ACL entry on the existing SAI "
+    "entry instead of removing and re-adding it");
+
+namespace {
+
+template <typename AttrT>
+bool unsetsAttribute(const AttrT& /*oldAttr*/, const AttrT& /*newAttr*/) {
+  return false;
+}
+
+template <typename AttrT>
+bool unsetsAttribute(
+    const std::optional<AttrT>& oldAttr,
+    const std::optional<AttrT>& newAttr) {
+  return oldAttr.has_value() && !newAttr.has_value();
+}
+
+/*
+ * SaiObject::setAttributes only writes attributes which are set, so an entry
+ * can't be updated in place if it loses a field or action.
+ */
+bool canUpdateAclEntryInPlace(
+    const facebook::fboss::SaiAclEntryTraits::CreateAttributes& oldAttrs,
+    const facebook::fboss::SaiAclEntryTraits::CreateAttributes& newAttrs) {
+  return std::apply(
+      [&newAttrs](const auto&... oldAttr) {
+        return !(
+            unsetsAttribute(
+                oldAttr, std::get<std::decay_t<decltype(oldAttr)>>(newAttrs)) ||
+            ...);
+      },
+      oldAttrs);
+}
+
+} // namespace
+
 namespace facebook::fboss {
 
 sai_u32_range_t SaiAclTableManager::getFdbDstUserMetaDataRange() const {
@@ -456,6 +497,13 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
         "attempted to add a duplicate aclEntry: ", addedAclEntry->getID());
   }
 
+  return programAclEntry(aclTableHandle, addedAclEntry, nullptr);
+}
+
+AclEntrySaiId SaiAclTableManager::programAclEntry(
+    SaiAclTableHandle* aclTableHandle,
+    const std::shared_ptr<AclEntry>& addedAclEntry,
+    std::unique_ptr<SaiAclEntryHandle> replacedHandle) {
   auto& aclEntryStore = saiStore_->get<SaiAclEntryTraits>();
 
   SaiAclEntryTraits::Attributes::TableId aclTableId{
@@ -881,6 +929,10 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
                   << addedAclEntry->getID() << " MactherValid "
                   << ((matcherIsValid) ? "true" : "false") << " ActionValid "
                   << ((actionIsValid) ? "true" : "false");
+    if (replacedHandle) {
+      // The entry being replaced is removed along with its handle
+      ++programmingStats_.removed;
+    }
     return AclEntrySaiId{0};
   }
 
@@ -922,6 +974,17 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
       aclActionMacsecFlow,
   };
 
+  if (!replacedHandle) {
+    ++programmingStats_.added;
+  } else if (canUpdateAclEntryInPlace(
+                 replacedHandle->aclEntry->attributes(), attributes)) {
+    // The replaced handle keeps the SAI entry alive, so setObject below
+    // writes just the changed attributes to it.
+    ++programmingStats_.updatedInPlace;
+  } else {
+    replacedHandle.reset();
+    ++programmingStats_.recreated;
+  }
   auto saiAclEntry = aclEntryStore.setObject(adapterHostKey, attributes);
   auto entryHandle = std::make_unique<SaiAclEntryHandle>();
   entryHandle->aclEntry = saiAclEntry;
@@ -962,6 +1025,7 @@ void SaiAclTableManager::removeAclEntry(
   }
 
   aclTableHandle->aclTableMembers.erase(itr);
+  ++programmingStats_.removed;
 
   auto action = removedAclEntry->getAclAction();
   if (action && action.value().getTrafficCounter()) {
@@ -984,13 +1048,43 @@ void SaiAclTableManager::changedAclEntry(
     const std::shared_ptr<AclEntry>& oldAclEntry,
     const std::shared_ptr<AclEntry>& newAclEntry,
     const std::string& aclTableName) {
+  XLOG(INFO) << "changing acl entry " << oldAclEntry->getID();
+  auto aclTableHandle = getAclTableHandle(aclTableName);
+  if (!aclTableHandle) {
+    throw FbossError(
+        "attempted to change AclEntry in a AclTable that does not exist: ",
+        aclTableName);
+  }
   /*
-   * ASIC/SAI implementation typically does not allow modifying an ACL entry.
-   * Thus, remove and re-add.
+   * The SAI priority is part of the entry's adapter host key, so a priority
+   * change needs a new entry. Otherwise, fields and actions are updated on
+   * the existing entry.
    */
-  XLOG(INFO) << "changing acl entry " << oldAclEntry->getID();
-  removeAclEntry(oldAclEntry, aclTableName);
-  addAclEntry(newAclEntry, aclTableName);
+  auto itr = aclTableHandle->aclTableMembers.find(oldAclEntry->getPriority());
+  if (!FLAGS_sai_acl_entry_update_in_place ||
+      oldAclEntry->getPriority() != newAclEntry->getPriority() ||
+      itr == aclTableHandle->aclTableMembers.end()) {
+    auto prevStats = programmingStats_;
+    removeAclEntry(oldAclEntry, aclTableName);
+    addAclEntry(newAclEntry, aclTableName);
+    // Replacing an entry with a new one counts as recreating it
+    if (programmingStats_.removed > prevStats.removed &&
+        programmingStats_.added > prevStats.added) {
+      --programmingStats_.removed;
+      --programmingStats_.added;
+      ++programmingStats_.recreated;
+    }
+    return;
+  }
+
+  auto replacedHandle = std::move(itr->second);
+  aclTableHandle->aclTableMembers.erase(itr);
+  // Counter stats are reinitialized when programming the new entry
+  auto action = oldAclEntry->getAclAction();
+  if (action && action.value().getTrafficCounter()) {
+    removeAclCounter(action.value().getTrafficCounter().value());
+  }
+  programAclEntry(aclTableHandle, newAclEntry, std::move(replacedHandle));
 }
 
 const SaiAclEntryHandle* FOLLY_NULLABLE SaiAclTableManager::getAclEntryHandle(
@@ -1086,6 +1180,26 @@ void SaiAclTableManager::updateStats() {
   }
 }
 
+void SaiAclTableManager::exportProgrammingStats() {
+  if (programmingStats_.added || programmingStats_.removed ||
+      programmingStats_.updatedInPlace || programmingStats_.recreated) {
+    XLOG(DBG2) << "acl entries added: " << programmingStats_.added
+               << " removed: " << programmingStats_.removed
+               << " updated in place: " << programmingStats_.updatedInPlace
+               << " recreated: " << programmingStats_.recreated;
+  }
+  fb303::fbData->incrementCounter(
+      "acl_entry_programming.added", programmingStats_.added);
+  fb303::fbData->incrementCounter(
+      "acl_entry_programming.removed", programmingStats_.removed);
+  fb303::fbData->incrementCounter(
+      "acl_entry_programming.updated_in_place",
+      programmingStats_.updatedInPlace);
+  fb303::fbData->incrementCounter(
+      "acl_entry_programming.recreated", programmingStats_.recreated);
+  programmingStats_ = SaiAclEntryProgrammingStats();
+}
+
 std::set<cfg::AclTableQualifier> SaiAclTableManager::getSupportedQualifierSet()
     const {
   /*
@@ -58,6 +58,20 @@ struct SaiAclEntryHandle {
   }
 };
 
+/*
+ * ACL entry programming operations since the stats were last exported,
+ * which is once per state delta.
+ */
+struct SaiAclEntryProgrammingStats {
+  uint64_t added{0};
+  uint64_t removed{0};
+  // Fields or actions changed on the existing SAI entry
+  uint64_t updatedInPlace{0};
+  // Changes that can't be made in place, including priority changes, so the
+  // SAI entry was recreated
+  uint64_t recreated{0};
+};
+
 struct SaiAclTableHandle {
   std::shared_ptr<SaiAclTable> aclTable;
   // SAI ACL priority to corresponding handle
@@ -162,6 +176,11 @@ class SaiAclTableManager {
 
   void updateStats();
 
+  const SaiAclEntryProgrammingStats& getProgrammingStats() const {
+    return programmingStats_;
+  }
+  void exportProgrammingStats();
+
   std::set<cfg::AclTableQualifier> getSupportedQualifierSet() const;
 
   void addDefaultAclTable();
@@ -200,6 +219,11 @@ class SaiAclTableManager {
   SaiAclTableHandle* FOLLY_NULLABLE
   getAclTableHandleImpl(const std::string& aclTableName) const;
 
+  AclEntrySaiId programAclEntry(
+      SaiAclTableHandle* aclTableHandle,
+      const std::shared_ptr<AclEntry>& addedAclEntry,
+      std::unique_ptr<SaiAclEntryHandle> replacedHandle);
+
   std::pair<
       SaiAclTableTraits::AdapterHostKey,
       SaiAclTableTraits::CreateAttributes>
@@ -252,6 +276,7 @@ class SaiAclTableManager {
   SaiAclTableHandles handles_;
 
   HwFb303Stats aclStats_;
+  SaiAclEntryProgrammingStats programmingStats_;
 
   const sai_uint32_t aclEntryMinimumPriority_;
   const sai_uint32_t aclEntryMaximumPriority_;
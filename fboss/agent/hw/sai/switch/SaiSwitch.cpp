@@ -13,10 +13,12 @@
 #include "fboss/agent/Constants.h"
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/LockPolicy.h"
+#include "fboss/agent/RestartTimeTracker.h"
 #include "fboss/agent/Utils.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/hw/HwPortFb303Stats.h"
 #include "fboss/agent/hw/HwResourceStatsPublisher.h"
+#include "fboss/agent/hw/SflowExporter.h"
 #include "fboss/agent/hw/gen-cpp2/hardware_stats_types.h"
 #include "fboss/agent/hw/sai/api/AclApi.h"
 #include "fboss/agent/hw/sai/api/AdapterKeySerializers.h"
@@ -28,6 +30,7 @@
 #include "fboss/agent/hw/sai/api/SaiApiTable.h"
 #include "fboss/agent/hw/sai/api/SaiObjectApi.h"
 #include "fboss/agent/hw/sai/api/Types.h"
+#include "fboss/agent/hw/sai/store/SaiObjectEventPublisher.h"
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 #include "fboss/agent/hw/sai/switch/ConcurrentIndices.h"
 #include "fboss/agent/hw/sai/switch/SaiAclTableGroupManager.h"
@@ -57,6 +60,8 @@
 
 #include "fboss/agent/rib/RoutingInformationBase.h"
 #include "fboss/agent/state/Port.h"
+#include "fboss/agent/state/SflowCollector.h"
+#include "fboss/agent/state/SflowCollectorMap.h"
 #include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/state/SwitchState.h"
 
@@ -64,6 +69,7 @@
 #include "fboss/agent/hw/switch_asics/HwAsic.h"
 #include "folly/MacAddress.h"
 
+#include <folly/ScopeGuard.h>
 #include <folly/logging/xlog.h>
 
 #include <chrono>
@@ -204,7 +210,8 @@ PortSaiId SaiSwitch::getCPUPortSaiId() const {
 SaiSwitch::SaiSwitch(SaiPlatform* platform, uint32_t featuresDesired)
     : HwSwitch(featuresDesired),
       platform_(platform),
-      saiStore_(std::make_unique<SaiStore>()) {
+      saiStore_(std::make_unique<SaiStore>()),
+      sflowExporterTable_(std::make_unique<SflowExporterTable>()) {
   utilCreateDir(platform_->getVolatileStateDir());
   utilCreateDir(platform_->getPersistentStateDir());
 }
@@ -571,6 +578,18 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImpl(
       &SaiRouterInterfaceManager::addRouterInterface,
       &SaiRouterInterfaceManager::removeRouterInterface);
 
+  // Neighbors and MACs coming and going in this delta notify their next
+  // hops etc. together, once all of them are processed and before any route
+  // is programmed on top of them
+  auto publisher = SaiObjectEventPublisher::getInstance();
+  {
+    [[maybe_unused]] const auto& lock = lockPolicy.lock();
+    publisher->startBatch();
+  }
+  auto batchGuard = folly::makeGuard([&publisher, &lockPolicy]() {
+    [[maybe_unused]] const auto& lock = lockPolicy.lock();
+    publisher->endBatchOnError();
+  });
   for (const auto& vlanDelta : delta.getVlansDelta()) {
     processDelta(
         vlanDelta.getArpDelta(),
@@ -596,6 +615,12 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImpl(
         &SaiFdbManager::addMac,
         &SaiFdbManager::removeMac);
   }
+  {
+    [[maybe_unused]] const auto& lock = lockPolicy.lock();
+    // endBatch() ends the batch even if delivery throws
+    batchGuard.dismiss();
+    publisher->endBatch();
+  }
 
   auto processV4RoutesDelta = [this, &lockPolicy](
                                   RouterID rid, const auto& routesDelta) {
@@ -741,6 +766,13 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImpl(
         kAclTable1);
   }
 
+  processSflowDelta(delta);
+
+  {
+    [[maybe_unused]] const auto& lock = lockPolicy.lock();
+    managerTable_->aclTableManager().exportProgrammingStats();
+  }
+
   if (platform_->getAsic()->isSupported(
           HwAsic::Feature::RESOURCE_USAGE_STATS)) {
     updateResourceUsage(lockPolicy);
@@ -752,6 +784,46 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImpl(
   return delta.newState();
 }
 
+void SaiSwitch::processSflowDelta(const StateDelta& delta) {
+  DeltaFunctions::forEachChanged(
+      delta.getSflowCollectorsDelta(),
+      [](const std::shared_ptr<SflowCollector>& /* oldCollector */,
+         const std::shared_ptr<SflowCollector>& /* newCollector */) {
+        // Collectors are identified by their address, so can't change
+      },
+      [this](const std::shared_ptr<SflowCollector>& addedCollector) {
+        sflowExporterTable_->addExporter(addedCollector);
+      },
+      [this](const std::shared_ptr<SflowCollector>& removedCollector) {
+        sflowExporterTable_->removeExporter(removedCollector->getID());
+      });
+
+  DeltaFunctions::forEachChanged(
+      delta.getPortsDelta(),
+      [this](
+          const std::shared_ptr<Port>& oldPort,
+          const std::shared_ptr<Port>& newPort) {
+        if (oldPort->getSflowIngressRate() != newPort->getSflowIngressRate() ||
+            oldPort->getSflowEgressRate() != newPort->getSflowEgressRate()) {
+          sflowExporterTable_->updateSamplingRates(
+              newPort->getID(),
+              newPort->getSflowIngressRate(),
+              newPort->getSflowEgressRate());
+        }
+      },
+      [this](const std::shared_ptr<Port>& newPort) {
+        if (newPort->getSflowIngressRate() || newPort->getSflowEgressRate()) {
+          sflowExporterTable_->updateSamplingRates(
+              newPort->getID(),
+              newPort->getSflowIngressRate(),
+              newPort->getSflowEgressRate());
+        }
+      },
+      [this](const std::shared_ptr<Port>& removedPort) {
+        sflowExporterTable_->removeSamplingRates(removedPort->getID());
+      });
+}
+
 template <typename LockPolicyT>
 void SaiSwitch::updateResourceUsage(const LockPolicyT& lockPolicy) {
   [[maybe_unused]] const auto& lock = lockPolicy.lock();
@@ -1109,6 +1181,12 @@ void SaiSwitch::linkStateChangedCallbackBottomHalf(
        * we already resolved neighbors over that link.
        */
       std::lock_guard<std::mutex> lock{saiSwitchMutex_};
+      // deliver link down to neighbors, and from them to next hops, a
+      // publisher type at a time
+      auto publisher = SaiObjectEventPublisher::getInstance();
+      publisher->startBatch();
+      auto batchGuard =
+          folly::makeGuard([&publisher]() { publisher->endBatchOnError(); });
       if (swAggPort) {
         // member of lag is gone down. unbundle it from LAG
         // once link comes back up LACP engine in SwSwitch will bundle it
@@ -1122,6 +1200,8 @@ void SaiSwitch::linkStateChangedCallbackBottomHalf(
         }
       }
       managerTable_->fdbManager().handleLinkDown(SaiPortDescriptor(swPortId));
+      batchGuard.dismiss();
+      publisher->endBatch();
       /*
        * Enable AFE adaptive mode (S249471) on TAJO platforms when a port
        * flaps
@@ -1222,6 +1302,12 @@ HwInitResult SaiSwitch::initLocked(
       behavior,
       adapterKeysJson.get(),
       adapterKeys2AdapterHostKeysJson.get());
+  for (const auto& [objectType, duration] : saiStore_->getReloadDurations()) {
+    restart_time::markStageDuration(
+        folly::to<std::string>("sai_store_reload.", objectType),
+        duration,
+        bootType_ == BootType::WARM_BOOT);
+  }
   if (bootType_ != BootType::WARM_BOOT) {
     ret.switchState = getColdBootSwitchState();
     if (getPlatform()->getAsic()->isSupported(HwAsic::Feature::MAC_AGING)) {
@@ -1472,6 +1558,19 @@ void SaiSwitch::packetRxCallbackPort(
     swVlanId = vlanItr->second;
   }
 
+  if (rxReason == cfg::PacketRxReason::SAMPLEPACKET &&
+      sflowExporterTable_->size()) {
+    // Sampled packets go to the sFlow collectors, not the slow path
+    sflowExporterTable_->sendToAll(makeSflowPacketInfo(
+        true /* ingressSampled */,
+        false /* egressSampled */,
+        swPortId,
+        0 /* dstPort */,
+        swVlanId,
+        folly::ByteRange(static_cast<const uint8_t*>(buffer), buffer_size)));
+    return;
+  }
+
   /*
    * Set the correct vlan and port ID for the rx packet
    */
@@ -33,6 +33,7 @@ namespace facebook::fboss {
 
 struct ConcurrentIndices;
 class SaiStore;
+class SflowExporterTable;
 
 /*
  * This is equivalent to sai_fdb_event_notification_data_t. Copy only the
@@ -312,6 +313,8 @@ class SaiSwitch : public HwSwitch {
       const StateDelta& delta,
       const LockPolicyT& lockPolicy);
 
+  void processSflowDelta(const StateDelta& delta);
+
   template <
       typename Delta,
       typename Manager,
@@ -438,6 +441,8 @@ class SaiSwitch : public HwSwitch {
   // SaiSwitch to support multiple SaiSwitch in one single service.
   std::unique_ptr<SaiStore> saiStore_;
   std::unique_ptr<SaiManagerTable> managerTable_;
+  // Has its own lock, as samples are exported from the rx path
+  std::unique_ptr<SflowExporterTable> sflowExporterTable_;
   std::atomic<BootType> bootType_{BootType::UNINITIALIZED};
   Callback* callback_{nullptr};
 
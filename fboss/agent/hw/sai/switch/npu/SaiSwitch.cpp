@@ -11,6 +11,7 @@
 #include "fboss/agent/hw/sai/switch/SaiSwitch.h"
 
 #include "fboss/agent/hw/HwResourceStatsPublisher.h"
+#include "fboss/agent/hw/SflowExporter.h"
 #include "fboss/agent/hw/sai/switch/ConcurrentIndices.h"
 #include "fboss/agent/hw/sai/switch/SaiAclTableManager.h"
 #include "fboss/agent/hw/sai/switch/SaiBufferManager.h"
@@ -61,5 +62,32 @@ void SaiSwitch::updateStatsImpl(SwitchStats* /* switchStats */) {
     std::lock_guard<std::mutex> locked(saiSwitchMutex_);
     managerTable_->aclTableManager().updateStats();
   }
+  for (auto portId : sflowExporterTable_->portsDueForCounterSamples()) {
+    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+    auto& portManager = managerTable_->portManager();
+    const auto* portHandle = portManager.getPortHandle(portId);
+    const auto* portStats = portManager.getLastPortStat(portId);
+    if (!portHandle || !portStats) {
+      continue;
+    }
+    const auto& attributes = portHandle->port->attributes();
+    // Port speed is in Mbps
+    uint64_t speedBps =
+        static_cast<uint64_t>(GET_ATTR(Port, Speed, attributes)) * 1000000;
+    auto adminState =
+        std::get<std::optional<SaiPortTraits::Attributes::AdminState>>(
+            attributes);
+    auto operStatus = SaiApiTable::getInstance()->portApi().getAttribute(
+        portHandle->port->adapterKey(),
+        SaiPortTraits::Attributes::OperStatus{});
+    sflowExporterTable_->addCounterSample(
+        portId,
+        speedBps,
+        adminState.has_value() && adminState->value(),
+        operStatus == SAI_PORT_OPER_STATUS_UP,
+        portStats->portStats());
+  }
+  // Don't hold samples longer than a stats interval
+  sflowExporterTable_->flush();
 }
 } // namespace facebook::fboss
@@ -243,3 +243,77 @@ TEST_F(AclTableManagerTest, aclMirroring) {
       aclEntryId, SaiAclEntryTraits::Attributes::ActionMirrorIngress());
   EXPECT_EQ((gotMirrorSaiIdList.getData())[0], mirrorHandle->adapterKey());
 }
+
+TEST_F(AclTableManagerTest, changeAclEntryInPlace) {
+  auto& aclTableManager = saiManagerTable->aclTableManager();
+  auto aclEntry = std::make_shared<AclEntry>(kPriority(), "AclEntry1");
+  aclEntry->setDscp(kDscp());
+  aclEntry->setActionType(kActionType());
+  AclEntrySaiId aclEntryId = aclTableManager.addAclEntry(aclEntry, kAclTable1);
+  aclTableManager.exportProgrammingStats();
+
+  auto newAclEntry = std::make_shared<AclEntry>(kPriority(), "AclEntry1");
+  newAclEntry->setDscp(kDscp2());
+  newAclEntry->setActionType(kActionType());
+  aclTableManager.changedAclEntry(aclEntry, newAclEntry, kAclTable1);
+
+  auto aclTableHandle = aclTableManager.getAclTableHandle(kAclTable1);
+  auto aclEntryHandle =
+      aclTableManager.getAclEntryHandle(aclTableHandle, kPriority());
+  EXPECT_EQ(aclEntryHandle->aclEntry->adapterKey(), aclEntryId);
+  auto dscpGot = saiApiTable->aclApi().getAttribute(
+      aclEntryId, SaiAclEntryTraits::Attributes::FieldDscp());
+  EXPECT_EQ(dscpGot.getDataAndMask().first, kDscp2());
+  EXPECT_EQ(aclTableManager.getProgrammingStats().updatedInPlace, 1);
+  EXPECT_EQ(aclTableManager.getProgrammingStats().recreated, 0);
+  EXPECT_EQ(aclTableManager.getProgrammingStats().removed, 0);
+}
+
+TEST_F(AclTableManagerTest, changeAclEntryRemoveField) {
+  auto& aclTableManager = saiManagerTable->aclTableManager();
+  auto aclEntry = std::make_shared<AclEntry>(kPriority(), "AclEntry1");
+  aclEntry->setDscp(kDscp());
+  aclEntry->setProto(6);
+  aclEntry->setActionType(kActionType());
+  aclTableManager.addAclEntry(aclEntry, kAclTable1);
+  aclTableManager.exportProgrammingStats();
+
+  // Dropping a field can't be done in place
+  auto newAclEntry = std::make_shared<AclEntry>(kPriority(), "AclEntry1");
+  newAclEntry->setDscp(kDscp());
+  newAclEntry->setActionType(kActionType());
+  aclTableManager.changedAclEntry(aclEntry, newAclEntry, kAclTable1);
+
+  auto aclTableHandle = aclTableManager.getAclTableHandle(kAclTable1);
+  auto aclEntryHandle =
+      aclTableManager.getAclEntryHandle(aclTableHandle, kPriority());
+  EXPECT_FALSE(std::get<std::optional<
+                   SaiAclEntryTraits::Attributes::FieldIpProtocol>>(
+                   aclEntryHandle->aclEntry->attributes())
+                   .has_value());
+  EXPECT_EQ(aclTableManager.getProgrammingStats().updatedInPlace, 0);
+  EXPECT_EQ(aclTableManager.getProgrammingStats().recreated, 1);
+}
+
+TEST_F(AclTableManagerTest, changeAclEntryPriority) {
+  auto& aclTableManager = saiManagerTable->aclTableManager();
+  auto aclEntry = std::make_shared<AclEntry>(kPriority(), "AclEntry1");
+  aclEntry->setDscp(kDscp());
+  aclEntry->setActionType(kActionType());
+  aclTableManager.addAclEntry(aclEntry, kAclTable1);
+  aclTableManager.exportProgrammingStats();
+
+  auto newAclEntry = std::make_shared<AclEntry>(kPriority2(), "AclEntry1");
+  newAclEntry->setDscp(kDscp());
+  newAclEntry->setActionType(kActionType());
+  aclTableManager.changedAclEntry(aclEntry, newAclEntry, kAclTable1);
+
+  EXPECT_FALSE(
+      aclTableManager.hasAclEntryWithPriority(kAclTable1, kPriority()));
+  EXPECT_TRUE(
+      aclTableManager.hasAclEntryWithPriority(kAclTable1, kPriority2()));
+  EXPECT_EQ(aclTableManager.getProgrammingStats().recreated, 1);
+  EXPECT_EQ(aclTableManager.getProgrammingStats().removed, 0);
+  EXPECT_EQ(aclTableManager.getProgrammingStats().added, 0);
+  EXPECT_EQ(aclTableManager.getProgrammingStats().updatedInPlace, 0);
+}
@@ -422,8 +422,22 @@ struct RxCaptureFilter {
 # can put additional Rx filters here if need be
 }
 
+/*
+ * Match on packet contents, similar to tcpdump's
+ * "ether[offset:len] & mask = value". The bytes starting at offset from the
+ * beginning of the ethernet header, ANDed with mask, must equal value ANDed
+ * with mask. An empty mask compares all bits of value.
+ */
+struct CaptureByteMatch {
+  1: i32 offset;
+  2: binary value;
+  3: binary mask;
+}
+
 struct CaptureFilter {
   1: RxCaptureFilter rxCaptureFilter;
+  // Applies to both Rx and Tx packets, all of them must match
+  2: list<CaptureByteMatch> byteMatches;
 }
 
 struct CaptureInfo {
@@ -443,6 +457,11 @@ struct CaptureInfo {
    * set of criteria that packet must meet to be captured
    */
   4: CaptureFilter filter;
+  /*
+   * Only store up to this many bytes of each packet, at most 16384.
+   * 0 uses the agent's --fboss_pcap_snaplen.
+   */
+  5: i32 snaplen = 0;
 }
 
 struct RouteUpdateLoggingInfo {
@@ -49,37 +49,69 @@ bool LinkNeighborDB::NeighborKey::operator==(const NeighborKey& other) const {
       portId_ == other.portId_);
 }
 
-LinkNeighborDB::LinkNeighborDB() {}
+namespace {
+
+// Refreshes of a neighbor that change nothing but its expiration time are
+// not worth telling subscribers about.
+bool sameNeighborInfo(const LinkNeighbor& a, const LinkNeighbor& b) {
+  return a.getProtocol() == b.getProtocol() &&
+      a.getLocalVlan() == b.getLocalVlan() && a.getMac() == b.getMac() &&
+      a.getSystemName() == b.getSystemName() &&
+      a.getPortDescription() == b.getPortDescription() &&
+      a.getSystemDescription() == b.getSystemDescription() &&
+      a.getTTL() == b.getTTL();
+}
 
-void LinkNeighborDB::update(const LinkNeighbor& neighbor) {
-  lock_guard<mutex> guard(mutex_);
+// Rebuild the expiry heap once stale entries outnumber live ones by this much
+constexpr size_t kMaxStaleExpiryEntries = 64;
 
-  // Go ahead and prune expired neighbors each time we get updated.
-  pruneLocked(steady_clock::now());
+} // namespace
 
-  auto it = byLocalPort_.find(neighbor.getLocalPort());
-  if (it == byLocalPort_.end()) {
-    // This is the first time we have seen data for this port.
-    auto ret = byLocalPort_.emplace(neighbor.getLocalPort(), NeighborMap());
-    it = ret.first;
-  }
+LinkNeighborDB::LinkNeighborDB() {}
 
-  NeighborKey key(neighbor);
-  // It would be nicer to use insert_or_assign() once we move to C++17
-  it->second[key] = neighbor;
+void LinkNeighborDB::update(const LinkNeighbor& neighbor) {
+  vector<NeighborChange> changes;
+  {
+    lock_guard<mutex> guard(mutex_);
+
+    // Go ahead and prune expired neighbors each time we get updated.
+    pruneLocked(steady_clock::now(), &changes);
+
+    auto& map = byLocalPort_[neighbor.getLocalPort()];
+    NeighborKey key(neighbor);
+    auto ret = map.emplace(key, neighbor);
+    if (ret.second) {
+      ++numNeighbors_;
+      changes.push_back({NeighborChange::Type::ADDED, neighbor});
+    } else {
+      if (!sameNeighborInfo(ret.first->second, neighbor)) {
+        changes.push_back({NeighborChange::Type::UPDATED, neighbor});
+      }
+      ret.first->second = neighbor;
+    }
+    pushExpiryLocked(neighbor);
+    snapshot_.reset();
+  }
+  publish(changes);
 }
 
 vector<LinkNeighbor> LinkNeighborDB::getNeighbors() {
-  vector<LinkNeighbor> results;
-  lock_guard<mutex> guard(mutex_);
+  return *getNeighborsSnapshot();
+}
 
-  for (const auto& portEntry : byLocalPort_) {
-    for (const auto& entry : portEntry.second) {
-      results.push_back(entry.second);
+LinkNeighborDB::NeighborsSnapshot LinkNeighborDB::getNeighborsSnapshot() {
+  lock_guard<mutex> guard(mutex_);
+  if (!snapshot_) {
+    auto neighbors = std::make_shared<vector<LinkNeighbor>>();
+    neighbors->reserve(numNeighbors_);
+    for (const auto& portEntry : byLocalPort_) {
+      for (const auto& entry : portEntry.second) {
+        neighbors->push_back(entry.second);
+      }
     }
+    snapshot_ = std::move(neighbors);
   }
-
-  return results;
+  return snapshot_;
 }
 
 vector<LinkNeighbor> LinkNeighborDB::getNeighbors(PortID port) {
@@ -97,47 +129,123 @@ vector<LinkNeighbor> LinkNeighborDB::getNeighbors(PortID port) {
 }
 
 int LinkNeighborDB::pruneExpiredNeighbors() {
-  lock_guard<mutex> guard(mutex_);
-  return pruneLocked(steady_clock::now());
+  return pruneExpiredNeighbors(steady_clock::now());
 }
 
 int LinkNeighborDB::pruneExpiredNeighbors(steady_clock::time_point now) {
-  lock_guard<mutex> guard(mutex_);
-  return pruneLocked(now);
+  vector<NeighborChange> changes;
+  int count;
+  {
+    lock_guard<mutex> guard(mutex_);
+    count = pruneLocked(now, &changes);
+  }
+  publish(changes);
+  return count;
 }
 
 void LinkNeighborDB::portDown(PortID port) {
-  lock_guard<mutex> guard(mutex_);
-  // Port went down, prune lldp entries for that port
-  byLocalPort_.erase(port);
-}
-
-int LinkNeighborDB::pruneLocked(steady_clock::time_point now) {
-  // We just do a linear scan for now.
-  //
-  // We could maintain a priority queue of entries by expiration time,
-  // to make this scanning faster.  However, we don't expect the number of
-  // neighbors to be very large, so the extra complexity isn't worth
-  // implementing right now.
-
-  int count = 0;
-  for (auto& portEntry : byLocalPort_) {
-    // Advance the iterator manually to avoid make sure we don't
-    // have invalid iterators to erased elements.
-    auto& map = portEntry.second;
-    auto it = map.begin();
-    while (it != map.end()) {
-      auto current = it;
-      ++it;
-      if (current->second.isExpired(now)) {
-        map.erase(current);
-      } else {
-        count++;
+  vector<NeighborChange> changes;
+  {
+    lock_guard<mutex> guard(mutex_);
+    // Port went down, prune lldp entries for that port. Their expiry heap
+    // entries are now stale and get skipped.
+    auto it = byLocalPort_.find(port);
+    if (it == byLocalPort_.end()) {
+      return;
+    }
+    for (auto& entry : it->second) {
+      changes.push_back(
+          {NeighborChange::Type::REMOVED, std::move(entry.second)});
+    }
+    numNeighbors_ -= it->second.size();
+    byLocalPort_.erase(it);
+    snapshot_.reset();
+  }
+  publish(changes);
+}
+
+LinkNeighborDB::SubscriberId LinkNeighborDB::subscribe(Subscriber subscriber) {
+  lock_guard<mutex> guard(subscribersMutex_);
+  auto id = nextSubscriberId_++;
+  subscribers_.emplace(
+      id, std::make_shared<const Subscriber>(std::move(subscriber)));
+  return id;
+}
+
+void LinkNeighborDB::unsubscribe(SubscriberId id) {
+  lock_guard<mutex> guard(subscribersMutex_);
+  subscribers_.erase(id);
+}
+
+int LinkNeighborDB::pruneLocked(
+    steady_clock::time_point now,
+    vector<NeighborChange>* changes) {
+  while (!expiry_.empty() && now > expiry_.top().expiration) {
+    const auto& top = expiry_.top();
+    auto portIt = byLocalPort_.find(top.port);
+    if (portIt != byLocalPort_.end()) {
+      auto it = portIt->second.find(top.key);
+      // Neighbors refreshed since this entry was pushed expire later
+      if (it != portIt->second.end() &&
+          it->second.getExpirationTime() == top.expiration) {
+        eraseLocked(it, &portIt->second, changes);
       }
     }
+    expiry_.pop();
   }
+  return numNeighbors_;
+}
 
-  return count;
+void LinkNeighborDB::eraseLocked(
+    NeighborMap::iterator it,
+    NeighborMap* map,
+    vector<NeighborChange>* changes) {
+  changes->push_back({NeighborChange::Type::REMOVED, std::move(it->second)});
+  map->erase(it);
+  --numNeighbors_;
+  snapshot_.reset();
+}
+
+void LinkNeighborDB::pushExpiryLocked(const LinkNeighbor& neighbor) {
+  if (expiry_.size() >
+      static_cast<size_t>(numNeighbors_) * 2 + kMaxStaleExpiryEntries) {
+    compactExpiryLocked();
+  }
+  expiry_.push(
+      {neighbor.getExpirationTime(),
+       neighbor.getLocalPort(),
+       NeighborKey(neighbor)});
+}
+
+void LinkNeighborDB::compactExpiryLocked() {
+  // Neighbors are refreshed every few seconds, each refresh leaving a stale
+  // entry behind. Rather than letting those pile up until they expire,
+  // rebuild the heap from the live neighbors.
+  ExpiryHeap live;
+  for (const auto& portEntry : byLocalPort_) {
+    for (const auto& entry : portEntry.second) {
+      live.push(
+          {entry.second.getExpirationTime(), portEntry.first, entry.first});
+    }
+  }
+  expiry_ = std::move(live);
+}
+
+void LinkNeighborDB::publish(const vector<NeighborChange>& changes) {
+  if (changes.empty()) {
+    return;
+  }
+  vector<std::shared_ptr<const Subscriber>> subscribers;
+  {
+    lock_guard<mutex> guard(subscribersMutex_);
+    subscribers.reserve(subscribers_.size());
+    for (const auto& subscriber : subscribers_) {
+      subscribers.push_back(subscriber.second);
+    }
+  }
+  for (const auto& subscriber : subscribers) {
+    (*subscriber)(changes);
+  }
 }
 
 } // namespace facebook::fboss
@@ -5,8 +5,11 @@
 #include "fboss/agent/types.h"
 
 #include <chrono>
+#include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <queue>
 #include <vector>
 
 namespace facebook::fboss {
@@ -17,9 +20,36 @@ class LinkNeighbor;
  * LinkNeighborDB maintains information about known neighbors.
  *
  * This class is thread-safe, and performs synchronization internally.
+ *
+ * Neighbors are expired off a min-heap ordered by expiration time, so pruning
+ * only touches the entries that actually expired. Readers get an immutable
+ * snapshot which is only rebuilt after the DB changed, so thrift queries
+ * don't hold the lock packet processing needs for longer than it takes to
+ * copy a shared_ptr.
  */
 class LinkNeighborDB {
  public:
+  using NeighborsSnapshot = std::shared_ptr<const std::vector<LinkNeighbor>>;
+
+  struct NeighborChange {
+    enum class Type {
+      ADDED,
+      UPDATED,
+      REMOVED,
+    };
+    Type type;
+    LinkNeighbor neighbor;
+  };
+  /*
+   * Called outside of the DB lock, on the thread that made the change, so
+   * changes made on different threads may be delivered concurrently.
+   * Subscribers may subscribe and unsubscribe from within the callback. A
+   * delivery already under way when unsubscribe() is called still runs.
+   * Refreshes that only extend a neighbor's expiration are not reported.
+   */
+  using Subscriber = std::function<void(const std::vector<NeighborChange>&)>;
+  using SubscriberId = uint32_t;
+
   LinkNeighborDB();
 
   /*
@@ -34,6 +64,13 @@ class LinkNeighborDB {
    */
   std::vector<LinkNeighbor> getNeighbors();
 
+  /*
+   * Get all known neighbors without copying them.
+   *
+   * The snapshot is immutable and stays valid after the DB changes.
+   */
+  NeighborsSnapshot getNeighborsSnapshot();
+
   /*
    * Get all known neighbors on a specific port.
    *
@@ -50,6 +87,9 @@ class LinkNeighborDB {
 
   void portDown(PortID port);
 
+  SubscriberId subscribe(Subscriber subscriber);
+  void unsubscribe(SubscriberId id);
+
  private:
   class NeighborKey {
    public:
@@ -65,15 +105,52 @@ class LinkNeighborDB {
   };
   typedef std::map<NeighborKey, LinkNeighbor> NeighborMap;
 
+  /*
+   * Heap entries are not removed when a neighbor is refreshed or its port
+   * goes down. An entry is stale, and skipped, unless the neighbor is still
+   * present with the same expiration time.
+   */
+  struct ExpiryEntry {
+    std::chrono::steady_clock::time_point expiration;
+    PortID port;
+    NeighborKey key;
+
+    bool operator>(const ExpiryEntry& other) const {
+      return expiration > other.expiration;
+    }
+  };
+  using ExpiryHeap = std::priority_queue<
+      ExpiryEntry,
+      std::vector<ExpiryEntry>,
+      std::greater<ExpiryEntry>>;
+
   // Forbidden copy constructor and assignment operator
   LinkNeighborDB(LinkNeighborDB const&) = delete;
   LinkNeighborDB& operator=(LinkNeighborDB const&) = delete;
 
   // Returns number of entries left after pruning
-  int pruneLocked(std::chrono::steady_clock::time_point now);
+  int pruneLocked(
+      std::chrono::steady_clock::time_point now,
+      std::vector<NeighborChange>* changes);
+  void eraseLocked(
+      NeighborMap::iterator it,
+      NeighborMap* map,
+      std::vector<NeighborChange>* changes);
+  void pushExpiryLocked(const LinkNeighbor& neighbor);
+  void compactExpiryLocked();
+  void publish(const std::vector<NeighborChange>& changes);
 
   std::mutex mutex_;
   std::map<PortID, NeighborMap> byLocalPort_;
+  ExpiryHeap expiry_;
+  int numNeighbors_{0};
+  // Reset whenever the DB changes, rebuilt on the next read
+  NeighborsSnapshot snapshot_;
+
+  std::mutex subscribersMutex_;
+  // Shared so that publish() can call them without holding the lock
+  std::map<SubscriberId, std::shared_ptr<const Subscriber>> subscribers_;
+  SubscriberId nextSubscriberId_{0};
 };
 
 } // namespace facebook::fboss
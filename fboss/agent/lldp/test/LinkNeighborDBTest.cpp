@@ -105,3 +105,117 @@ TEST(LinkNeighborDB, test) {
   ASSERT_EQ(1, neighbors.size());
   EXPECT_EQ("neighbor3 name", neighbors[0].getSystemName());
 }
+
+namespace {
+LinkNeighbor makeNeighbor(PortID port, const std::string& chassis) {
+  LinkNeighbor n;
+  n.setProtocol(LinkProtocol::LLDP);
+  n.setLocalPort(port);
+  n.setLocalVlan(VlanID(1));
+  n.setMac(MacAddress("00:11:22:33:44:55"));
+  n.setChassisId(chassis, LldpChassisIdType::LOCALLY_ASSIGNED);
+  n.setPortId("1/1", LldpPortIdType::LOCALLY_ASSIGNED);
+  n.setSystemName(chassis + " name");
+  n.setTTL(seconds(10));
+  return n;
+}
+} // namespace
+
+TEST(LinkNeighborDB, refreshPostponesExpiry) {
+  LinkNeighborDB db;
+  auto now = steady_clock::now();
+
+  auto n1 = makeNeighbor(PortID(1), "neighbor1");
+  n1.setTTL(seconds(10), now + seconds(10));
+  db.update(n1);
+  auto n2 = makeNeighbor(PortID(2), "neighbor2");
+  n2.setTTL(seconds(10), now + seconds(20));
+  db.update(n2);
+
+  // Refreshed before expiring, the entry for the original expiration time is
+  // stale and must not remove it
+  n1.setTTL(seconds(10), now + seconds(30));
+  db.update(n1);
+
+  EXPECT_EQ(2, db.pruneExpiredNeighbors(now + seconds(15)));
+  EXPECT_EQ(1, db.pruneExpiredNeighbors(now + seconds(25)));
+  auto neighbors = db.getNeighbors();
+  ASSERT_EQ(1, neighbors.size());
+  EXPECT_EQ("neighbor1", neighbors[0].getChassisId());
+  EXPECT_EQ(0, db.pruneExpiredNeighbors(now + seconds(35)));
+}
+
+TEST(LinkNeighborDB, snapshot) {
+  LinkNeighborDB db;
+  db.update(makeNeighbor(PortID(1), "neighbor1"));
+
+  auto snapshot = db.getNeighborsSnapshot();
+  // Unchanged DB hands out the same snapshot
+  EXPECT_EQ(snapshot, db.getNeighborsSnapshot());
+
+  db.update(makeNeighbor(PortID(2), "neighbor2"));
+  EXPECT_EQ(1, snapshot->size());
+  EXPECT_EQ(2, db.getNeighborsSnapshot()->size());
+
+  db.portDown(PortID(1));
+  EXPECT_EQ(1, db.getNeighborsSnapshot()->size());
+  EXPECT_EQ(1, snapshot->size());
+}
+
+TEST(LinkNeighborDB, subscribers) {
+  using Type = LinkNeighborDB::NeighborChange::Type;
+  LinkNeighborDB db;
+  std::vector<std::pair<Type, std::string>> changes;
+  auto id = db.subscribe([&changes](const auto& batch) {
+    for (const auto& change : batch) {
+      changes.emplace_back(change.type, change.neighbor.getChassisId());
+    }
+  });
+
+  auto now = steady_clock::now();
+  auto n1 = makeNeighbor(PortID(1), "neighbor1");
+  n1.setTTL(seconds(10), now + seconds(10));
+  db.update(n1);
+  // Only extending the expiration is not a change
+  n1.setTTL(seconds(10), now + seconds(11));
+  db.update(n1);
+  n1.setSystemName("renamed");
+  db.update(n1);
+  auto n2 = makeNeighbor(PortID(2), "neighbor2");
+  n2.setTTL(seconds(10), now + seconds(10));
+  db.update(n2);
+  db.portDown(PortID(2));
+  db.pruneExpiredNeighbors(now + seconds(12));
+
+  std::vector<std::pair<Type, std::string>> expected = {
+      {Type::ADDED, "neighbor1"},
+      {Type::UPDATED, "neighbor1"},
+      {Type::ADDED, "neighbor2"},
+      {Type::REMOVED, "neighbor2"},
+      {Type::REMOVED, "neighbor1"},
+  };
+  EXPECT_EQ(expected, changes);
+
+  db.unsubscribe(id);
+  db.update(n2);
+  EXPECT_EQ(expected.size(), changes.size());
+}
+
+TEST(LinkNeighborDB, unsubscribeFromCallback) {
+  LinkNeighborDB db;
+  int calls = 0;
+  LinkNeighborDB::SubscriberId id{0};
+  id = db.subscribe([&](const auto& /* batch */) {
+    calls++;
+    db.unsubscribe(id);
+  });
+
+  auto now = steady_clock::now();
+  auto n1 = makeNeighbor(PortID(1), "neighbor1");
+  n1.setTTL(seconds(10), now + seconds(10));
+  db.update(n1);
+  auto n2 = makeNeighbor(PortID(2), "neighbor2");
+  n2.setTTL(seconds(10), now + seconds(10));
+  db.update(n2);
+  EXPECT_EQ(1, calls);
+}
@@ -13,8 +13,6 @@
 #include <folly/Singleton.h>
 #include <folly/logging/xlog.h>
 
-#include "fboss/agent/normalization/PortStatsProcessor.h"
-
 DEFINE_bool(
     enable_counter_normalization,
     false,
@@ -55,9 +53,7 @@ void Normalizer::processStats(
   if (XLOG_IS_ON(DBG6)) {
     print(hwStatsMap);
   }
-  normalization::PortStatsProcessor processor(
-      transformHandler_.get(), statsExporter_.get(), counterTagManager_.get());
-  processor.processStats(hwStatsMap);
+  portStatsProcessor_->processStats(hwStatsMap);
 
   XLOG(DBG5) << "normalizer processed stats";
 }
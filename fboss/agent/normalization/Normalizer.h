@@ -15,6 +15,7 @@
 
 #include "fboss/agent/hw/gen-cpp2/hardware_stats_types.h"
 #include "fboss/agent/normalization/CounterTagManager.h"
+#include "fboss/agent/normalization/PortStatsProcessor.h"
 #include "fboss/agent/normalization/StatsExporter.h"
 #include "fboss/agent/normalization/TransformHandler.h"
 
@@ -41,6 +42,12 @@ class Normalizer {
   std::unique_ptr<normalization::TransformHandler> transformHandler_;
   std::unique_ptr<normalization::StatsExporter> statsExporter_;
   std::unique_ptr<normalization::CounterTagManager> counterTagManager_;
+  // kept across cycles so its column buffers are reused
+  std::unique_ptr<normalization::PortStatsProcessor> portStatsProcessor_{
+      std::make_unique<normalization::PortStatsProcessor>(
+          transformHandler_.get(),
+          statsExporter_.get(),
+          counterTagManager_.get())};
 };
 
 } // namespace facebook::fboss
@@ -9,6 +9,8 @@
  */
 #include "fboss/agent/normalization/PortStatsProcessor.h"
 
+#include <array>
+
 #include <fb303/ServiceData.h>
 #include <fmt/core.h>
 #include <folly/logging/xlog.h>
@@ -20,6 +22,38 @@ namespace facebook::fboss::normalization {
 namespace {
 const std::string kPrefix = "counter_normalization";
 const std::string kInterfaceStatsModelName = "Interface_Stats";
+
+struct PortStatProperty {
+  const char* name;
+  TransformType type;
+  int32_t processIntervalSec;
+  int64_t (*getValue)(const HwPortStats&);
+};
+
+const std::array<PortStatProperty, 4> kPortStatProperties = {{
+    {"input_bps",
+     TransformType::BPS,
+     60,
+     [](const HwPortStats& stats) -> int64_t { return *stats.inBytes__ref(); }},
+    {"output_bps",
+     TransformType::BPS,
+     60,
+     [](const HwPortStats& stats) -> int64_t {
+       return *stats.outBytes__ref();
+     }},
+    {"total_input_discards",
+     TransformType::RATE,
+     60,
+     [](const HwPortStats& stats) -> int64_t {
+       return *stats.inDiscards__ref();
+     }},
+    {"total_output_discards",
+     TransformType::RATE,
+     60,
+     [](const HwPortStats& stats) -> int64_t {
+       return *stats.outDiscards__ref();
+     }},
+}};
 } // namespace
 
 PortStatsProcessor::PortStatsProcessor(
@@ -28,90 +62,94 @@ PortStatsProcessor::PortStatsProcessor(
     CounterTagManager* counterTagManager)
     : transformHandler_(transformHandler),
       statsExporter_(statsExporter),
-      counterTagManager_(counterTagManager) {}
+      counterTagManager_(counterTagManager) {
+  for (const auto& property : kPortStatProperties) {
+    properties_.push_back(Property{
+        property.name,
+        property.type,
+        property.processIntervalSec,
+        property.getValue,
+        transformHandler_->propertyIndex(property.name),
+        fmt::format(
+            "{}.{}.{}", kPrefix, kInterfaceStatsModelName, property.name)});
+    fb303::fbData->addStatExportType(
+        properties_.back().statKey, fb303::ExportType::COUNT);
+  }
+  columns_.values.resize(properties_.size());
+  columns_.results.resize(properties_.size());
+  columns_.valid.resize(properties_.size());
+}
 
 void PortStatsProcessor::processStats(
     const folly::F14FastMap<std::string, HwPortStats>& hwStatsMap) {
-  for (auto& [portName, hwPortStats] : hwStatsMap) {
-    process(
-        portName,
-        "input_bps",
-        StatTimestamp(*hwPortStats.timestamp__ref()),
-        *hwPortStats.inBytes__ref(),
-        TransformType::BPS,
-        60);
-    process(
-        portName,
-        "output_bps",
-        StatTimestamp(*hwPortStats.timestamp__ref()),
-        *hwPortStats.outBytes__ref(),
-        TransformType::BPS,
-        60);
-    process(
-        portName,
-        "total_input_discards",
-        StatTimestamp(*hwPortStats.timestamp__ref()),
-        *hwPortStats.inDiscards__ref(),
-        TransformType::RATE,
-        60);
-    process(
-        portName,
-        "total_output_discards",
-        StatTimestamp(*hwPortStats.timestamp__ref()),
-        *hwPortStats.outDiscards__ref(),
-        TransformType::RATE,
-        60);
+  fillColumns(hwStatsMap);
+  for (size_t i = 0; i < properties_.size(); ++i) {
+    const auto& property = properties_[i];
+    transformHandler_->transform(
+        property.type,
+        property.transformIndex,
+        columns_.portIndices,
+        columns_.timestamps,
+        columns_.values[i],
+        property.processIntervalSec,
+        columns_.results[i],
+        columns_.valid[i]);
   }
+  publish();
 
   statsExporter_->flushCounters();
 }
 
-void PortStatsProcessor::process(
-    const std::string& portName,
-    const std::string& normalizedPropertyName,
-    StatTimestamp propertyTimestamp,
-    int64_t propertyValue,
-    TransformType type,
-    int32_t processIntervalSec) {
-  std::optional<double> transformedValue;
-  switch (type) {
-    case TransformType::RATE:
-      transformedValue = transformHandler_->rate(
-          portName,
-          normalizedPropertyName,
-          propertyTimestamp,
-          propertyValue,
-          processIntervalSec);
-      break;
-    case TransformType::BPS:
-      transformedValue = transformHandler_->bps(
-          portName,
-          normalizedPropertyName,
-          propertyTimestamp,
-          propertyValue,
-          processIntervalSec);
-      break;
+void PortStatsProcessor::fillColumns(
+    const folly::F14FastMap<std::string, HwPortStats>& hwStatsMap) {
+  columns_.portNames.clear();
+  columns_.portIndices.clear();
+  columns_.timestamps.clear();
+  for (auto& values : columns_.values) {
+    values.clear();
+  }
+
+  for (auto& [portName, hwPortStats] : hwStatsMap) {
+    columns_.portNames.push_back(&portName);
+    columns_.portIndices.push_back(transformHandler_->portIndex(portName));
+    columns_.timestamps.emplace_back(*hwPortStats.timestamp__ref());
+    for (size_t i = 0; i < properties_.size(); ++i) {
+      columns_.values[i].push_back(properties_[i].getValue(hwPortStats));
+    }
   }
+}
 
-  if (transformedValue) {
-    auto counterTags = counterTagManager_->getCounterTags(portName);
-    // create formatted ODS counter and publish it
-    statsExporter_->publishPortStats(
-        portName,
-        normalizedPropertyName,
-        propertyTimestamp,
-        *transformedValue,
-        processIntervalSec,
-        std::move(counterTags));
+void PortStatsProcessor::publish() {
+  std::vector<int64_t> numPublished(properties_.size(), 0);
+  for (size_t row = 0; row < columns_.portNames.size(); ++row) {
+    const auto& portName = *columns_.portNames[row];
+    std::shared_ptr<std::vector<std::string>> counterTags;
+    bool haveCounterTags = false;
+    for (size_t i = 0; i < properties_.size(); ++i) {
+      if (!columns_.valid[i][row]) {
+        continue;
+      }
+      if (!haveCounterTags) {
+        counterTags = counterTagManager_->getCounterTags(portName);
+        haveCounterTags = true;
+      }
+      // create formatted ODS counter and publish it
+      statsExporter_->publishPortStats(
+          portName,
+          properties_[i].name,
+          columns_.timestamps[row],
+          columns_.results[i][row],
+          properties_[i].processIntervalSec,
+          counterTags);
+      ++numPublished[i];
+    }
+  }
 
-    fb303::fbData->addStatValue(
-        fmt::format(
-            "{}.{}.{}",
-            kPrefix,
-            kInterfaceStatsModelName,
-            normalizedPropertyName),
-        1,
-        fb303::ExportType::COUNT);
+  for (size_t i = 0; i < properties_.size(); ++i) {
+    if (numPublished[i]) {
+      fb303::fbData->addStatValueAggregated(
+          properties_[i].statKey, numPublished[i], numPublished[i]);
+    }
   }
 }
 
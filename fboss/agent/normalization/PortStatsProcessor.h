@@ -9,6 +9,9 @@
  */
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "folly/container/F14Map.h"
 
 #include "fboss/agent/hw/gen-cpp2/hardware_stats_types.h"
@@ -32,21 +35,41 @@ class PortStatsProcessor {
       const folly::F14FastMap<std::string, HwPortStats>& hwStatsMap);
 
  private:
-  // @param processIntervalSec: ODS has a minimal interval to accept a data
-  // point which is 15 seconds. Also, existing collections have different data
-  // interval for different counters. It's very important to support that to not
-  // break existing use cases during onbox migration
-  void process(
-      const std::string& portName,
-      const std::string& normalizedPropertyName,
-      StatTimestamp propertyTimestamp,
-      int64_t propertyValue,
-      TransformType type,
-      int32_t processIntervalSec);
+  // a normalized port property and what is needed to process it, resolved
+  // once so processing a cycle needs no per counter string lookups
+  struct Property {
+    std::string name;
+    TransformType type;
+    // ODS has a minimal interval to accept a data point which is 15
+    // seconds. Also, existing collections have different data interval for
+    // different counters. It's very important to support that to not break
+    // existing use cases during onbox migration
+    int32_t processIntervalSec;
+    int64_t (*getValue)(const HwPortStats&);
+    size_t transformIndex;
+    std::string statKey;
+  };
+
+  // one cycle of port stats, one row per port and one value column per
+  // property. Kept across cycles to reuse the buffers.
+  struct PortStatsColumns {
+    std::vector<const std::string*> portNames;
+    std::vector<size_t> portIndices;
+    std::vector<StatTimestamp> timestamps;
+    std::vector<std::vector<int64_t>> values;
+    std::vector<std::vector<double>> results;
+    std::vector<std::vector<uint8_t>> valid;
+  };
+
+  void fillColumns(
+      const folly::F14FastMap<std::string, HwPortStats>& hwStatsMap);
+  void publish();
 
   TransformHandler* transformHandler_;
   StatsExporter* statsExporter_;
   CounterTagManager* counterTagManager_;
+  std::vector<Property> properties_;
+  PortStatsColumns columns_;
 };
 
 } // namespace facebook::fboss::normalization
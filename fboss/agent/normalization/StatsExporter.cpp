@@ -33,13 +33,8 @@ void StatsExporter::publishPortStats(
     int32_t intervalSec,
     std::shared_ptr<std::vector<std::string>> tags) {
   OdsCounter counter;
-  counter.entity = fmt::format(
-      "{}{}:{}{}",
-      FLAGS_normalized_counter_entity_prefix,
-      deviceName_,
-      portName,
-      kEntitySuffix);
-  counter.key = fmt::format("FBNet:interface.{}", propertyName);
+  counter.entity = getEntity(portName);
+  counter.key = getKey(propertyName);
   counter.unixTime = timestamp;
   counter.value = value;
   counter.intervalSec = intervalSec;
@@ -48,6 +43,35 @@ void StatsExporter::publishPortStats(
   counterBuffer_.push_back(std::move(counter));
 }
 
+const std::string& StatsExporter::getEntity(const std::string& portName) {
+  auto it = entities_.find(portName);
+  if (it == entities_.end()) {
+    it = entities_
+             .emplace(
+                 portName,
+                 fmt::format(
+                     "{}{}:{}{}",
+                     FLAGS_normalized_counter_entity_prefix,
+                     deviceName_,
+                     portName,
+                     kEntitySuffix))
+             .first;
+  }
+  return it->second;
+}
+
+const std::string& StatsExporter::getKey(const std::string& propertyName) {
+  auto it = keys_.find(propertyName);
+  if (it == keys_.end()) {
+    it = keys_
+             .emplace(
+                 propertyName,
+                 fmt::format("FBNet:interface.{}", propertyName))
+             .first;
+  }
+  return it->second;
+}
+
 void GlogStatsExporter::flushCounters() {
   for (auto& counter : counterBuffer_) {
     XLOGF(
@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 
+#include <folly/container/F14Map.h>
 #include <gflags/gflags.h>
 
 DECLARE_string(normalized_counter_entity_prefix);
@@ -53,9 +54,17 @@ class StatsExporter {
   virtual ~StatsExporter() = default;
 
  protected:
+  // ODS entity and key names, formatted once per port and property
+  const std::string& getEntity(const std::string& portName);
+  const std::string& getKey(const std::string& propertyName);
+
   std::string deviceName_;
   // buffer counters so that we can publish to ODS in batch
   std::vector<OdsCounter> counterBuffer_;
+
+ private:
+  folly::F14FastMap<std::string, std::string> entities_;
+  folly::F14FastMap<std::string, std::string> keys_;
 };
 
 // just log ODS counters values without writing to ODS
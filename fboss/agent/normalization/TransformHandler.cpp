@@ -9,12 +9,34 @@
  */
 #include "fboss/agent/normalization/TransformHandler.h"
 
-#include <optional>
-
-#include <folly/MapUtil.h>
-
 namespace facebook::fboss::normalization {
 
+namespace {
+// Rate since lastCounter, which is replaced by counter once at least
+// processIntervalSec passed. Returns false when there is no rate yet.
+inline bool updateRate(
+    const Counter& counter,
+    Counter& lastCounter,
+    uint8_t& hasLastCounter,
+    int32_t processIntervalSec,
+    double& rate) {
+  if (!hasLastCounter) {
+    // no rate for the new counter
+    lastCounter = counter;
+    hasLastCounter = 1;
+    return false;
+  }
+  int64_t timeDiff = counter.timestamp - lastCounter.timestamp;
+  if (timeDiff < processIntervalSec) {
+    // skip processing this counter
+    return false;
+  }
+  rate = static_cast<double>(counter.value - lastCounter.value) / timeDiff;
+  lastCounter = counter;
+  return true;
+}
+} // namespace
+
 std::optional<double> TransformHandler::bps(
     const std::string& portName,
     const std::string& propertyName,
@@ -51,23 +73,73 @@ std::optional<double> TransformHandler::handleRate(
     const std::string& portName,
     const std::string& propertyName,
     int32_t processIntervalSec) {
-  if (auto lastPtr =
-          folly::get_ptr(lastCounterCache_, portName, propertyName)) {
-    auto timeDiff = counter.timestamp - lastPtr->timestamp;
-    if (timeDiff < processIntervalSec) {
-      // skip processing this counter
-      return std::nullopt;
-    }
-
-    double rate =
-        static_cast<double>(counter.value - lastPtr->value) / timeDiff;
-    *lastPtr = counter;
+  auto port = portIndex(portName);
+  auto& column = getColumn(propertyIndex(propertyName));
+  double rate;
+  if (updateRate(
+          counter,
+          column.lastCounters[port],
+          column.hasLastCounter[port],
+          processIntervalSec,
+          rate)) {
     return rate;
-  } else {
-    // create a new entry
-    lastCounterCache_[portName][propertyName] = counter;
-    // no rate for the new counter
-    return std::nullopt;
+  }
+  return std::nullopt;
+}
+
+size_t TransformHandler::portIndex(const std::string& portName) {
+  return portIndices_.try_emplace(portName, portIndices_.size())
+      .first->second;
+}
+
+size_t TransformHandler::propertyIndex(const std::string& propertyName) {
+  return propertyIndices_.try_emplace(propertyName, propertyIndices_.size())
+      .first->second;
+}
+
+TransformHandler::CounterColumn& TransformHandler::getColumn(
+    size_t propertyIndex) {
+  if (propertyIndex >= lastCounterColumns_.size()) {
+    lastCounterColumns_.resize(propertyIndex + 1);
+  }
+  auto& column = lastCounterColumns_[propertyIndex];
+  if (column.lastCounters.size() < portIndices_.size()) {
+    column.lastCounters.resize(portIndices_.size());
+    column.hasLastCounter.resize(portIndices_.size(), 0);
+  }
+  return column;
+}
+
+void TransformHandler::transform(
+    TransformType type,
+    size_t propertyIndex,
+    const std::vector<size_t>& portIndices,
+    const std::vector<StatTimestamp>& timestamps,
+    const std::vector<int64_t>& values,
+    int32_t processIntervalSec,
+    std::vector<double>& results,
+    std::vector<uint8_t>& valid) {
+  auto numPorts = portIndices.size();
+  results.resize(numPorts);
+  valid.resize(numPorts);
+
+  auto& column = getColumn(propertyIndex);
+  auto* lastCounters = column.lastCounters.data();
+  auto* hasLastCounter = column.hasLastCounter.data();
+  for (size_t i = 0; i < numPorts; ++i) {
+    auto port = portIndices[i];
+    valid[i] = updateRate(
+        Counter(timestamps[i], values[i]),
+        lastCounters[port],
+        hasLastCounter[port],
+        processIntervalSec,
+        results[i]);
+  }
+
+  if (type == TransformType::BPS) {
+    for (size_t i = 0; i < numPorts; ++i) {
+      results[i] = handleBytesToBits(results[i]);
+    }
   }
 }
 
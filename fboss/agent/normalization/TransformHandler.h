@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -39,20 +40,49 @@ class TransformHandler {
       int64_t propertyValue,
       int32_t processIntervalSec);
 
+  // Stable dense indices for ports and properties, assigned on first use.
+  // Callers processing a whole stats cycle look these up once and then
+  // use transform() instead of the per counter calls above.
+  size_t portIndex(const std::string& portName);
+  size_t propertyIndex(const std::string& propertyName);
+
+  // RATE or BPS transform of one property for a batch of ports.
+  // portIndices, timestamps and values are parallel columns; on return
+  // results[i] holds the transformed value of port portIndices[i] and
+  // valid[i] is 0 where the per counter call would have returned nullopt.
+  void transform(
+      TransformType type,
+      size_t propertyIndex,
+      const std::vector<size_t>& portIndices,
+      const std::vector<StatTimestamp>& timestamps,
+      const std::vector<int64_t>& values,
+      int32_t processIntervalSec,
+      std::vector<double>& results,
+      std::vector<uint8_t>& valid);
+
  private:
+  // last counters of one property, indexed by port index
+  struct CounterColumn {
+    std::vector<Counter> lastCounters;
+    std::vector<uint8_t> hasLastCounter;
+  };
+
   std::optional<double> handleRate(
       const Counter& counter,
       const std::string& portName,
       const std::string& propertyName,
       int32_t processIntervalSec);
 
+  CounterColumn& getColumn(size_t propertyIndex);
+
   static constexpr double handleBytesToBits(double bytesValue) {
     return bytesValue * 8;
   }
 
-  // {portName -> {propertyName, lastCounter}}
-  folly::F14FastMap<std::string, folly::F14FastMap<std::string, Counter>>
-      lastCounterCache_;
+  folly::F14FastMap<std::string, size_t> portIndices_;
+  folly::F14FastMap<std::string, size_t> propertyIndices_;
+  // {propertyIndex -> {portIndex -> lastCounter}}
+  std::vector<CounterColumn> lastCounterColumns_;
 };
 
 } // namespace facebook::fboss::normalization
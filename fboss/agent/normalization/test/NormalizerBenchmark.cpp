@@ -0,0 +1,193 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <fmt/core.h>
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "fboss/agent/normalization/CounterTagManager.h"
+#include "fboss/agent/normalization/PortStatsProcessor.h"
+#include "fboss/agent/normalization/StatsExporter.h"
+#include "fboss/agent/normalization/TransformHandler.h"
+
+/*
+ * Normalizes a stats cycle of a fully populated 512 port switch, with every
+ * counter due so each cycle publishes all of its ODS counters. The per
+ * counter variant looks up each port and property by name, as stats
+ * processing used to.
+ */
+
+using namespace facebook::fboss;
+using namespace facebook::fboss::normalization;
+
+namespace {
+
+constexpr int kNumPorts = 512;
+constexpr int32_t kIntervalSec = 60;
+
+// Drops the counters instead of logging them
+class NullStatsExporter : public StatsExporter {
+ public:
+  NullStatsExporter() : StatsExporter("rsw001.p001.f01.abc1") {}
+
+  void flushCounters() override {
+    counterBuffer_.clear();
+  }
+};
+
+folly::F14FastMap<std::string, HwPortStats> makeHwStatsMap() {
+  folly::F14FastMap<std::string, HwPortStats> hwStatsMap;
+  for (int i = 0; i < kNumPorts; ++i) {
+    HwPortStats stats;
+    stats.timestamp__ref() = 0;
+    stats.inBytes__ref() = 0;
+    stats.outBytes__ref() = 0;
+    stats.inDiscards__ref() = 0;
+    stats.outDiscards__ref() = 0;
+    hwStatsMap.emplace(
+        fmt::format("eth{}/{}/{}", i / 16 + 1, (i % 16) / 4 + 1, i % 4 + 1),
+        stats);
+  }
+  return hwStatsMap;
+}
+
+void setupCounterTags(
+    CounterTagManager& counterTagManager,
+    const folly::F14FastMap<std::string, HwPortStats>& hwStatsMap) {
+  cfg::SwitchConfig config;
+  for (const auto& entry : hwStatsMap) {
+    cfg::Port port;
+    port.name_ref() = entry.first;
+    port.counterTags_ref() = std::vector<std::string>{"fabric", "uplink"};
+    config.ports_ref()->push_back(port);
+  }
+  counterTagManager.reloadCounterTags(config);
+}
+
+// Moves every port one interval forward so all counters are due
+void advance(folly::F14FastMap<std::string, HwPortStats>& hwStatsMap) {
+  for (auto& entry : hwStatsMap) {
+    auto& stats = entry.second;
+    *stats.timestamp__ref() += kIntervalSec;
+    *stats.inBytes__ref() += 1000000;
+    *stats.outBytes__ref() += 2000000;
+    *stats.inDiscards__ref() += 10;
+    *stats.outDiscards__ref() += 20;
+  }
+}
+
+void processPerCounter(
+    TransformHandler& handler,
+    StatsExporter& exporter,
+    CounterTagManager& counterTagManager,
+    const std::string& portName,
+    const std::string& propertyName,
+    StatTimestamp timestamp,
+    int64_t value,
+    TransformType type) {
+  auto transformed = type == TransformType::BPS
+      ? handler.bps(portName, propertyName, timestamp, value, kIntervalSec)
+      : handler.rate(portName, propertyName, timestamp, value, kIntervalSec);
+  if (transformed) {
+    exporter.publishPortStats(
+        portName,
+        propertyName,
+        timestamp,
+        *transformed,
+        kIntervalSec,
+        counterTagManager.getCounterTags(portName));
+  }
+}
+
+} // namespace
+
+BENCHMARK(NormalizePerCounter512Ports, iters) {
+  folly::BenchmarkSuspender suspender;
+  TransformHandler handler;
+  NullStatsExporter exporter;
+  CounterTagManager counterTagManager;
+  auto hwStatsMap = makeHwStatsMap();
+  setupCounterTags(counterTagManager, hwStatsMap);
+
+  // the first cycle only seeds the last counters
+  for (unsigned int i = 0; i <= iters; ++i) {
+    advance(hwStatsMap);
+    if (i > 0) {
+      suspender.dismiss();
+    }
+    for (const auto& [portName, stats] : hwStatsMap) {
+      StatTimestamp timestamp(*stats.timestamp__ref());
+      processPerCounter(
+          handler,
+          exporter,
+          counterTagManager,
+          portName,
+          "input_bps",
+          timestamp,
+          *stats.inBytes__ref(),
+          TransformType::BPS);
+      processPerCounter(
+          handler,
+          exporter,
+          counterTagManager,
+          portName,
+          "output_bps",
+          timestamp,
+          *stats.outBytes__ref(),
+          TransformType::BPS);
+      processPerCounter(
+          handler,
+          exporter,
+          counterTagManager,
+          portName,
+          "total_input_discards",
+          timestamp,
+          *stats.inDiscards__ref(),
+          TransformType::RATE);
+      processPerCounter(
+          handler,
+          exporter,
+          counterTagManager,
+          portName,
+          "total_output_discards",
+          timestamp,
+          *stats.outDiscards__ref(),
+          TransformType::RATE);
+    }
+    exporter.flushCounters();
+    if (i > 0) {
+      suspender.rehire();
+    }
+  }
+}
+
+BENCHMARK_RELATIVE(NormalizeColumnar512Ports, iters) {
+  folly::BenchmarkSuspender suspender;
+  TransformHandler handler;
+  NullStatsExporter exporter;
+  CounterTagManager counterTagManager;
+  auto hwStatsMap = makeHwStatsMap();
+  setupCounterTags(counterTagManager, hwStatsMap);
+  PortStatsProcessor processor(&handler, &exporter, &counterTagManager);
+
+  // the first cycle only seeds the last counters
+  processor.processStats(hwStatsMap);
+  for (unsigned int i = 0; i < iters; ++i) {
+    advance(hwStatsMap);
+    suspender.dismiss();
+    processor.processStats(hwStatsMap);
+    suspender.rehire();
+  }
+}
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
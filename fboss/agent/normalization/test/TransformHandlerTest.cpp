@@ -81,4 +81,42 @@ TEST_F(TransformHandlerTest, bps) {
       *handler.bps("eth1", "bps_property_a", StatTimestamp(1020), 950, 5), 120);
 }
 
+TEST_F(TransformHandlerTest, transformColumns) {
+  auto eth0 = handler.portIndex("eth0");
+  auto eth1 = handler.portIndex("eth1");
+  auto property = handler.propertyIndex("bps_property_a");
+  std::vector<double> results;
+  std::vector<uint8_t> valid;
+
+  handler.transform(
+      TransformType::BPS,
+      property,
+      {eth0, eth1},
+      {StatTimestamp(1000), StatTimestamp(1000)},
+      {500, 700},
+      5,
+      results,
+      valid);
+  EXPECT_THAT(valid, ElementsAre(0, 0));
+
+  // eth1 is not due yet
+  handler.transform(
+      TransformType::BPS,
+      property,
+      {eth1, eth0},
+      {StatTimestamp(1002), StatTimestamp(1010)},
+      {800, 600},
+      5,
+      results,
+      valid);
+  EXPECT_THAT(valid, ElementsAre(0, 1));
+  EXPECT_DOUBLE_EQ(results[1], 80);
+
+  // shares last counters with the per counter calls
+  EXPECT_DOUBLE_EQ(
+      *handler.bps("eth1", "bps_property_a", StatTimestamp(1010), 800, 5), 80);
+  EXPECT_DOUBLE_EQ(
+      *handler.rate("eth0", "bps_property_a", StatTimestamp(1020), 750, 5), 15);
+}
+
 } // namespace facebook::fboss::normalization
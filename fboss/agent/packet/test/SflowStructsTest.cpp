@@ -220,3 +220,58 @@ TEST(SflowStructsTest, Serialize) {
     EXPECT_EQ(b.at(i), data[i]);
   }
 }
+
+TEST(SflowStructsTest, SerializeCounterSample) {
+  sflow::IfCounters counters{};
+  counters.ifIndex = 7;
+  counters.ifSpeed = 100000000000;
+  counters.ifOutOctets = 42;
+  EXPECT_EQ(counters.size(), 88);
+
+  std::vector<uint8_t> counterBuf(counters.size());
+  auto cbuf = folly::IOBuf::wrapBuffer(counterBuf.data(), counterBuf.size());
+  folly::io::RWPrivateCursor cc(cbuf.get());
+  counters.serialize(&cc);
+  EXPECT_TRUE(cc.isAtEnd());
+
+  sflow::CounterRecord crecord;
+  crecord.counterFormat = 1; // generic interface counters
+  crecord.counterDataLen = counterBuf.size();
+  crecord.counterData = counterBuf.data();
+
+  sflow::CounterSample csample;
+  csample.sequenceNumber = 3;
+  csample.sourceID = 7;
+  csample.counterRecordsCnt = 1;
+  csample.counterRecords = &crecord;
+  EXPECT_EQ(csample.size(crecord.size()), 108);
+
+  std::vector<uint8_t> b(csample.size(crecord.size()));
+  auto buf = folly::IOBuf::wrapBuffer(b.data(), b.size());
+  folly::io::RWPrivateCursor cursor(buf.get());
+  csample.serialize(&cursor);
+  EXPECT_TRUE(cursor.isAtEnd());
+
+  folly::io::Cursor reader(buf.get());
+  EXPECT_EQ(reader.readBE<uint32_t>(), 3); // seq no.
+  EXPECT_EQ(reader.readBE<uint32_t>(), 7); // source ID
+  EXPECT_EQ(reader.readBE<uint32_t>(), 1); // record cnt
+  EXPECT_EQ(reader.readBE<uint32_t>(), 1); // counter format
+  EXPECT_EQ(reader.readBE<uint32_t>(), 88); // counter data length
+  EXPECT_EQ(reader.readBE<uint32_t>(), 7); // ifIndex
+  reader.skip(4); // ifType
+  EXPECT_EQ(reader.readBE<uint64_t>(), 100000000000); // ifSpeed
+  reader.skip(4 + 4 + 8 + 6 * 4); // direction, status, ifIn*
+  EXPECT_EQ(reader.readBE<uint64_t>(), 42); // ifOutOctets
+}
+
+TEST(SflowStructsTest, SerializeIPv4AgentAddress) {
+  folly::IPAddress agentIP("10.0.0.1");
+  EXPECT_EQ(sflow::sizeIP(agentIP), 8);
+
+  std::vector<uint8_t> b(sflow::sizeIP(agentIP));
+  auto buf = folly::IOBuf::wrapBuffer(b.data(), b.size());
+  folly::io::RWPrivateCursor cursor(buf.get());
+  sflow::serializeIP(&cursor, agentIP);
+  EXPECT_EQ(b, std::vector<uint8_t>({0x00, 0x00, 0x00, 0x01, 10, 0, 0, 1}));
+}
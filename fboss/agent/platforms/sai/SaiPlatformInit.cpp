@@ -24,6 +24,7 @@
 #include "fboss/agent/platforms/sai/SaiBcmWedge40Platform.h"
 #include "fboss/agent/platforms/sai/SaiBcmYampPlatform.h"
 #include "fboss/agent/platforms/sai/SaiCloudRipperPlatform.h"
+#include "fboss/agent/platforms/sai/SaiFakePlatform.h"
 #include "fboss/agent/platforms/sai/SaiWedge400CPlatform.h"
 
 namespace facebook::fboss {
@@ -67,6 +68,10 @@ std::unique_ptr<SaiPlatform> chooseSaiPlatform(
   } else if (productInfo->getMode() == PlatformMode::FUJI) {
     return std::make_unique<SaiBcmFujiPlatform>(
         std::move(productInfo), localMac);
+  } else if (productInfo->getMode() == PlatformMode::FAKE_WEDGE) {
+    // Runs against FakeSai, e.g. benchmarks built with
+    // BUILD_SAI_FAKE_BENCHMARKS and started with --mode=fake_wedge
+    return std::make_unique<SaiFakePlatform>(std::move(productInfo));
   }
 
   return nullptr;
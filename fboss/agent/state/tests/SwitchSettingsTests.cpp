@@ -177,6 +177,18 @@ TEST(SwitchSettingsTest, applyBlockNeighbors) {
   EXPECT_EQ(
       switchSettingsV1->getBlockNeighbors()[0].second.str(),
       blockNeighbor.ipAddress_ref());
+
+  // Override the block list at runtime, like setNeighborsToBlock() does
+  stateV1->publish();
+  auto stateV2 = stateV1->clone();
+  stateV1->getSwitchSettings()->modify(&stateV2)->setBlockNeighbors({});
+  stateV2->publish();
+
+  // Reapplying the same config, even incrementally, resets the override
+  auto stateV3 = publishAndApplyConfig(
+      stateV2, &config, platform.get(), nullptr, &config);
+  ASSERT_NE(nullptr, stateV3);
+  EXPECT_EQ(stateV3->getSwitchSettings()->getBlockNeighbors().size(), 1);
 }
 
 TEST(SwitchSettingsTest, applyMacAddrsToBlock) {
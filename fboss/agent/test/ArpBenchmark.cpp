@@ -11,6 +11,8 @@
 
 #include <folly/Benchmark.h>
 #include <folly/Memory.h>
+#include "fboss/agent/ArpCache.h"
+#include "fboss/agent/ArpHandler.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/TunManager.h"
 #include "fboss/agent/hw/mock/MockRxPacket.h"
@@ -176,6 +178,39 @@ BENCHMARK(ArpRequestNotMine, numIters) {
   }
 }
 
+BENCHMARK(ArpCache100kNeighbors, numIters) {
+  // Enough neighbors for a large L2 domain. They are outside of the
+  // interface subnets, so the cache tracks and ages them but the resulting
+  // state updates are no-ops and the benchmark measures the cache itself.
+  constexpr uint32_t kNumNeighbors = 100000;
+  std::vector<IPAddressV4> ips;
+  BENCHMARK_SUSPEND {
+    ips.reserve(kNumNeighbors);
+    for (uint32_t i = 0; i < kNumNeighbors; ++i) {
+      ips.push_back(IPAddressV4::fromLongHBO((172u << 24) + i));
+    }
+  }
+
+  auto* evb = sw->getNeighborCacheEvb();
+  for (size_t n = 0; n < numIters; ++n) {
+    evb->runInEventBaseThreadAndWait([&]() {
+      auto cache = make_unique<ArpCache>(
+          sw.get(), sw->getState().get(), VlanID(1), "Vlan1", InterfaceID(1));
+      // Learn every neighbor, then refresh each of them once, which
+      // reschedules its aging timeout
+      for (int round = 0; round < 2; ++round) {
+        for (const auto& ip : ips) {
+          cache->receivedArpMine(
+              ip,
+              MacAddress("00:02:00:00:00:01"),
+              PortDescriptor(PortID(1)),
+              ARP_OP_REPLY);
+        }
+      }
+    });
+  }
+}
+
 int main(int argc, char** argv) {
   gflags::ParseCommandLineFlags(&argc, &argv, true);
 
@@ -12,6 +12,7 @@
 #include <folly/io/Cursor.h>
 #include <folly/io/IOBuf.h>
 #include "fboss/agent/AddressUtil.h"
+#include "fboss/agent/ArpCache.h"
 #include "fboss/agent/ArpHandler.h"
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/NeighborUpdater.h"
@@ -272,6 +273,32 @@ void testSendArpRequest(
   counters.checkDelta(SwitchStats::kCounterPrefix + "arp.reply.rx.sum", 0);
 }
 
+// Counts the state updates which changed the ARP table of VLAN 1
+class ArpTableUpdateCounter : public AutoRegisterStateObserver {
+ public:
+  explicit ArpTableUpdateCounter(SwSwitch* sw)
+      : AutoRegisterStateObserver(sw, "ArpTableUpdateCounter") {}
+
+  void stateUpdated(const StateDelta& delta) override {
+    auto oldVlan = delta.oldState()->getVlans()->getVlanIf(VlanID(1));
+    auto newVlan = delta.newState()->getVlans()->getVlanIf(VlanID(1));
+    if (oldVlan->getArpTable() != newVlan->getArpTable()) {
+      ++numUpdates;
+    }
+  }
+
+  std::atomic<int> numUpdates{0};
+};
+
+unique_ptr<ArpCache> createArpCache(SwSwitch* sw) {
+  unique_ptr<ArpCache> cache;
+  sw->getNeighborCacheEvb()->runInEventBaseThreadAndWait([&]() {
+    cache = make_unique<ArpCache>(
+        sw, sw->getState().get(), VlanID(1), "Vlan1", InterfaceID(1));
+  });
+  return cache;
+}
+
 } // unnamed namespace
 
 TEST(ArpTest, BasicSendRequest) {
@@ -1481,3 +1508,102 @@ TEST(ArpTest, receivedPacketWithRouteToDestination) {
   counters.checkDelta(SwitchStats::kCounterPrefix + "ipv4.nexthop.sum", 1);
   counters.checkDelta(SwitchStats::kCounterPrefix + "ipv4.no_arp.sum", 0);
 }
+
+TEST(ArpTest, NeighborUpdatesAreBatched) {
+  auto handle = setupTestHandle();
+  auto sw = handle->getSw();
+  ArpTableUpdateCounter counter(sw);
+  auto cache = createArpCache(sw);
+  auto* evb = sw->getNeighborCacheEvb();
+
+  // Neighbors learned while the update thread is busy are programmed in
+  // a single state update
+  auto release = blockUpdateThread(sw);
+  evb->runInEventBaseThreadAndWait([&]() {
+    for (int i = 11; i <= 13; i++) {
+      cache->receivedArpMine(
+          IPAddressV4(folly::to<string>("10.0.0.", i)),
+          MacAddress(folly::to<string>("02:10:20:30:40:", i)),
+          PortDescriptor(PortID(1)),
+          ARP_OP_REPLY);
+    }
+  });
+  release->post();
+  waitForStateUpdates(sw);
+
+  EXPECT_EQ(counter.numUpdates, 1);
+  for (int i = 11; i <= 13; i++) {
+    auto entry = getArpEntry(sw, IPAddressV4(folly::to<string>("10.0.0.", i)));
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(
+        entry->getMac(), MacAddress(folly::to<string>("02:10:20:30:40:", i)));
+    EXPECT_FALSE(entry->isPending());
+  }
+
+  evb->runInEventBaseThreadAndWait([&]() { cache.reset(); });
+}
+
+TEST(ArpTest, NeighborUpdatesAreAppliedInOrder) {
+  auto handle = setupTestHandle();
+  auto sw = handle->getSw();
+  ArpTableUpdateCounter counter(sw);
+  auto cache = createArpCache(sw);
+  auto* evb = sw->getNeighborCacheEvb();
+
+  auto release = blockUpdateThread(sw);
+  evb->runInEventBaseThreadAndWait([&]() {
+    cache->receivedArpMine(
+        IPAddressV4("10.0.0.11"),
+        MacAddress("02:10:20:30:40:11"),
+        PortDescriptor(PortID(1)),
+        ARP_OP_REPLY);
+    cache->receivedArpMine(
+        IPAddressV4("10.0.0.12"),
+        MacAddress("02:10:20:30:40:12"),
+        PortDescriptor(PortID(2)),
+        ARP_OP_REPLY);
+    // Both flushes cancel entries which were never programmed
+    cache->portFlushEntries(PortDescriptor(PortID(1)));
+    cache->portFlushEntries(PortDescriptor(PortID(2)));
+    // and a later entry for a flushed neighbor still sticks
+    cache->receivedArpMine(
+        IPAddressV4("10.0.0.11"),
+        MacAddress("02:10:20:30:40:22"),
+        PortDescriptor(PortID(1)),
+        ARP_OP_REPLY);
+  });
+  release->post();
+  waitForStateUpdates(sw);
+
+  EXPECT_EQ(counter.numUpdates, 1);
+  auto entry = getArpEntry(sw, IPAddressV4("10.0.0.11"));
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->getMac(), MacAddress("02:10:20:30:40:22"));
+  EXPECT_EQ(getArpEntry(sw, IPAddressV4("10.0.0.12")), nullptr);
+
+  evb->runInEventBaseThreadAndWait([&]() { cache.reset(); });
+}
+
+TEST(ArpTest, NeighborUpdatesOutliveCache) {
+  auto handle = setupTestHandle();
+  auto sw = handle->getSw();
+  auto cache = createArpCache(sw);
+  auto* evb = sw->getNeighborCacheEvb();
+
+  // The batch is still applied after the cache which queued it is gone
+  auto release = blockUpdateThread(sw);
+  evb->runInEventBaseThreadAndWait([&]() {
+    cache->receivedArpMine(
+        IPAddressV4("10.0.0.11"),
+        MacAddress("02:10:20:30:40:11"),
+        PortDescriptor(PortID(1)),
+        ARP_OP_REPLY);
+    cache.reset();
+  });
+  release->post();
+  waitForStateUpdates(sw);
+
+  auto entry = getArpEntry(sw, IPAddressV4("10.0.0.11"));
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->getMac(), MacAddress("02:10:20:30:40:11"));
+}
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/AsyncStateObserver.h"
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+using namespace facebook::fboss;
+using std::make_shared;
+using std::shared_ptr;
+
+namespace {
+
+class TestAsyncObserver : public AsyncStateObserver {
+ public:
+  TestAsyncObserver() : AsyncStateObserver("TestAsyncObserver") {}
+  ~TestAsyncObserver() override {
+    stopAsyncProcessing();
+  }
+
+  void stateUpdatedAsync(const StateDelta& delta) override {
+    if (!enteredOnce.exchange(true)) {
+      entered.post();
+    }
+    release.wait();
+    std::lock_guard<std::mutex> guard(lock);
+    deltas.emplace_back(delta.oldState(), delta.newState());
+    if (deltas.size() == expectedDeltas) {
+      done.post();
+    }
+  }
+
+  std::atomic<bool> enteredOnce{false};
+  folly::Baton<> entered;
+  folly::Baton<> release;
+  folly::Baton<> done;
+  size_t expectedDeltas{0};
+  std::mutex lock;
+  std::vector<std::pair<shared_ptr<SwitchState>, shared_ptr<SwitchState>>>
+      deltas;
+};
+
+std::vector<shared_ptr<SwitchState>> makeStates(int num) {
+  std::vector<shared_ptr<SwitchState>> states{make_shared<SwitchState>()};
+  for (auto i = 1; i < num; ++i) {
+    states.back()->publish();
+    states.push_back(states.back()->clone());
+  }
+  return states;
+}
+
+} // namespace
+
+TEST(AsyncStateObserver, coalescesWhileBusy) {
+  auto states = makeStates(5);
+  TestAsyncObserver observer;
+  observer.expectedDeltas = 2;
+
+  observer.stateUpdated(StateDelta(states[0], states[1]));
+  // First update is being processed, everything queued behind it must be
+  // folded into a single delta.
+  observer.entered.wait();
+  observer.stateUpdated(StateDelta(states[1], states[2]));
+  observer.stateUpdated(StateDelta(states[2], states[3]));
+  observer.stateUpdated(StateDelta(states[3], states[4]));
+  observer.release.post();
+  observer.done.wait();
+
+  std::lock_guard<std::mutex> guard(observer.lock);
+  ASSERT_EQ(2, observer.deltas.size());
+  EXPECT_EQ(states[0], observer.deltas[0].first);
+  EXPECT_EQ(states[1], observer.deltas[0].second);
+  EXPECT_EQ(states[1], observer.deltas[1].first);
+  EXPECT_EQ(states[4], observer.deltas[1].second);
+}
+
+TEST(AsyncStateObserver, noUpdatesAfterStop) {
+  auto states = makeStates(2);
+  TestAsyncObserver observer;
+  observer.stopAsyncProcessing();
+  observer.stateUpdated(StateDelta(states[0], states[1]));
+  // Nothing is processed once stopped
+  EXPECT_FALSE(observer.entered.try_wait_for(std::chrono::milliseconds(100)));
+}
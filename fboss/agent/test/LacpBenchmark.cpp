@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
+
+#include "fboss/agent/LacpController.h"
+#include "fboss/agent/LacpMachines.h"
+#include "fboss/agent/LacpTypes.h"
+#include "fboss/agent/LinkAggregationManager.h"
+
+#include <time.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+
+/*
+ * Counts LACPDUs instead of transmitting them, and how many times the LACP
+ * thread had to wake up to transmit them.
+ */
+class CountingLacpServicer : public LacpServicerIf {
+ public:
+  bool transmit(LACPDU /* lacpdu */, PortID /* portID */) override {
+    ++lacpdus;
+    ++transmissions;
+    return true;
+  }
+  size_t transmitBatch(
+      std::vector<std::pair<PortID, LACPDU>> lacpdus) override {
+    ++transmissions;
+    this->lacpdus += lacpdus.size();
+    return lacpdus.size();
+  }
+  void enableForwardingAndSetPartnerState(
+      PortID /* portID */,
+      AggregatePortID /* aggPortID */,
+      const ParticipantInfo& /* partnerState */) override {}
+  void disableForwardingAndSetPartnerState(
+      PortID /* portID */,
+      AggregatePortID /* aggPortID */,
+      const ParticipantInfo& /* partnerState */) override {}
+  void recordLacpTimeout() override {}
+  void recordLacpMismatchPduTeardown() override {}
+  std::vector<std::shared_ptr<LacpController>> getControllersFor(
+      folly::Range<std::vector<PortID>::const_iterator> ports) override {
+    std::vector<std::shared_ptr<LacpController>> filtered;
+    for (auto port : ports) {
+      filtered.push_back(controllers.at(static_cast<size_t>(port) - 1));
+    }
+    return filtered;
+  }
+
+  std::vector<std::shared_ptr<LacpController>> controllers;
+  std::atomic<uint64_t> lacpdus{0};
+  std::atomic<uint64_t> transmissions{0};
+};
+
+std::chrono::microseconds threadCpuTime(folly::EventBase* evb) {
+  std::chrono::microseconds cpuTime;
+  evb->runInEventBaseThreadAndWait([&cpuTime]() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    cpuTime = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec));
+  });
+  return cpuTime;
+}
+
+/*
+ * Runs the periodic transmission machines of numPorts LAG members using fast
+ * LACP timers for a few periods, and reports how much LACP thread CPU that
+ * took and how many times it had to transmit.
+ */
+void runPeriodicTransmission(
+    folly::UserCounters& counters,
+    size_t numPorts,
+    std::chrono::seconds duration) {
+  folly::BenchmarkSuspender suspender;
+  folly::ScopedEventBaseThread lacpThread("LacpBenchmark");
+  auto evb = lacpThread.getEventBase();
+  CountingLacpServicer servicer;
+
+  for (size_t i = 1; i <= numPorts; ++i) {
+    auto controller =
+        std::make_shared<LacpController>(PortID(i), evb, &servicer);
+    servicer.controllers.push_back(controller);
+    controller->startMachines();
+    controller->portUp();
+
+    // An active partner asking for short timeouts, as on a LAG with fast
+    // LACP timers
+    ParticipantInfo actorInfo;
+    actorInfo.state =
+        LacpState::ACTIVE | LacpState::AGGREGATABLE | LacpState::SHORT_TIMEOUT;
+    actorInfo.port = i;
+    controller->received(
+        LACPDU(actorInfo, ParticipantInfo::defaultParticipantInfo()));
+  }
+  // Let the initial exchange settle before measuring
+  std::this_thread::sleep_for(PeriodicTransmissionMachine::SHORT_PERIOD);
+  auto startCpu = threadCpuTime(evb);
+  auto startLacpdus = servicer.lacpdus.load();
+  auto startTransmissions = servicer.transmissions.load();
+  suspender.dismiss();
+
+  std::this_thread::sleep_for(duration);
+
+  suspender.rehire();
+  counters["lacp_cpu_us"] = (threadCpuTime(evb) - startCpu).count();
+  counters["lacpdus"] = servicer.lacpdus.load() - startLacpdus;
+  counters["transmit_calls"] =
+      servicer.transmissions.load() - startTransmissions;
+
+  for (auto& controller : servicer.controllers) {
+    controller->stopMachines();
+  }
+  evb->runInEventBaseThreadAndWait([&servicer]() {
+    servicer.controllers.clear();
+  });
+}
+
+} // namespace
+
+BENCHMARK_COUNTERS(LacpFastPeriodicTx512Ports, counters) {
+  runPeriodicTransmission(counters, 512, std::chrono::seconds(5));
+}
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
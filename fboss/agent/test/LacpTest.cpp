@@ -7,6 +7,7 @@
  *  of patent rights can be found in the PATENTS file in the same directory.
  *
  */
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <memory>
@@ -85,6 +86,11 @@ class LacpServiceInterceptor : public LacpServicerIf {
     // "Transmit" the frame
     return true;
   }
+  size_t transmitBatch(
+      std::vector<std::pair<PortID, LACPDU>> lacpdus) override {
+    batchSizes_.wlock()->push_back(lacpdus.size());
+    return LacpServicerIf::transmitBatch(std::move(lacpdus));
+  }
   void enableForwardingAndSetPartnerState(
       PortID portID,
       AggregatePortID aggPortID,
@@ -182,6 +188,15 @@ class LacpServiceInterceptor : public LacpServicerIf {
     return forwarding;
   }
 
+  std::vector<size_t> batchSizes() {
+    std::vector<size_t> sizes;
+
+    lacpEvb_->runInEventBaseThreadAndWait(
+        [this, &sizes]() { sizes = *batchSizes_.rlock(); });
+
+    return sizes;
+  }
+
   ~LacpServiceInterceptor() override {
     lacpEvb_->runInEventBaseThreadAndWait([this]() {
       for (auto& controller : controllers_) {
@@ -198,6 +213,7 @@ class LacpServiceInterceptor : public LacpServicerIf {
 
   using PortIDToLacpduMap = boost::container::flat_map<PortID, LACPDU>;
   folly::Synchronized<PortIDToLacpduMap> portToLastTransmission_;
+  folly::Synchronized<std::vector<size_t>> batchSizes_;
 
   folly::EventBase* lacpEvb_{nullptr};
   SwSwitch* sw_{nullptr};
@@ -274,6 +290,60 @@ TEST_F(LacpTest, nonAggregatablePortTransmitsIndividualBit) {
   controllerPtr->stopMachines();
 }
 
+/*
+ * Periodic transmissions of all ports on the LACP EventBase are driven by a
+ * single timer, so the LACPDUs of ports due at the same time must reach the
+ * servicer in a single batch.
+ */
+TEST_F(LacpTest, periodicTransmissionsAreBatched) {
+  LacpServiceInterceptor serviceInterceptor(lacpEvb());
+  const size_t kNumPorts = 8;
+
+  // Drive the scheduler off a clock of our own rather than its timer
+  auto& scheduler = PeriodicTransmissionScheduler::get(lacpEvb());
+  auto now = std::make_shared<std::chrono::steady_clock::time_point>(
+      std::chrono::steady_clock::now());
+  lacpEvb()->runInEventBaseThreadAndWait(
+      [&scheduler, now]() { scheduler.setClock([now]() { return *now; }); });
+
+  std::vector<std::shared_ptr<LacpController>> controllers;
+  for (size_t i = 1; i <= kNumPorts; ++i) {
+    auto controllerPtr = std::make_shared<LacpController>(
+        PortID(i), lacpEvb(), &serviceInterceptor);
+    serviceInterceptor.addController(controllerPtr);
+    controllers.push_back(controllerPtr);
+
+    controllerPtr->startMachines();
+    controllerPtr->portUp();
+
+    // An active partner asking for short timeouts moves the periodic
+    // transmission machine to the fast period
+    ParticipantInfo actorInfo;
+    actorInfo.state =
+        LacpState::ACTIVE | LacpState::AGGREGATABLE | LacpState::SHORT_TIMEOUT;
+    actorInfo.port = i;
+    controllerPtr->received(
+        LACPDU(actorInfo, ParticipantInfo::defaultParticipantInfo()));
+  }
+
+  // Nothing is due yet
+  lacpEvb()->runInEventBaseThreadAndWait([&scheduler]() { scheduler.tick(); });
+  EXPECT_TRUE(serviceInterceptor.batchSizes().empty());
+
+  // All ports are due one short period later, on the same tick
+  lacpEvb()->runInEventBaseThreadAndWait([&scheduler, now]() {
+    *now += PeriodicTransmissionMachine::SHORT_PERIOD;
+    scheduler.tick();
+  });
+  EXPECT_EQ(serviceInterceptor.batchSizes(), std::vector<size_t>{kNumPorts});
+
+  for (auto& controller : controllers) {
+    controller->stopMachines();
+  }
+  lacpEvb()->runInEventBaseThreadAndWait(
+      [&scheduler]() { scheduler.setClock(nullptr); });
+}
+
 /*
  * When link aggregation was first deployed to production, the following
  * logical sequence of events was observed:
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "fboss/agent/LookupClassRouteUpdater.h"
+#include "fboss/agent/NeighborUpdater.h"
+#include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/TestUtils.h"
+
+using namespace facebook::fboss;
+using folly::IPAddressV4;
+using folly::MacAddress;
+
+/*
+ * Scaled up version of LookupClassRouteUpdaterTests: many host routes behind
+ * a queue-per-host nexthop, and a neighbor resolving and going away. Each of
+ * those changes the classID of every route behind the neighbor.
+ */
+
+namespace {
+
+const VlanID kVlan(1);
+const PortID kPortID(1);
+const RouterID kRid(0);
+const ClientID kClientID(1001);
+const IPAddressV4 kNextHopA("10.0.0.2");
+const IPAddressV4 kNextHopB("10.0.0.3");
+const MacAddress kMacAddressA("01:02:03:04:05:06");
+
+void waitForNeighborAndRouteUpdates(SwSwitch* sw) {
+  sw->getNeighborUpdater()->waitForPendingUpdates();
+  waitForStateUpdates(sw);
+  sw->getNeighborUpdater()->waitForPendingUpdates();
+  waitForStateUpdates(sw);
+  // Neighbor updates may in turn cause route class Id updates
+  waitForRibUpdates(sw);
+  waitForStateUpdates(sw);
+}
+
+void addHostRoutes(SwSwitch* sw, uint32_t numRoutes) {
+  auto routeUpdater = sw->getRouteUpdater();
+  for (uint32_t i = 0; i < numRoutes; ++i) {
+    // 11.x.y.z/32, every other route also has a second nexthop
+    RouteNextHopSet nexthops{UnresolvedNextHop(kNextHopA, UCMP_DEFAULT_WEIGHT)};
+    if (i % 2) {
+      nexthops.emplace(UnresolvedNextHop(kNextHopB, UCMP_DEFAULT_WEIGHT));
+    }
+    routeUpdater.addRoute(
+        kRid,
+        IPAddressV4::fromLongHBO((11u << 24) + i),
+        32,
+        kClientID,
+        RouteNextHopEntry(nexthops, AdminDistance::MAX_ADMIN_DISTANCE));
+  }
+  routeUpdater.program();
+  waitForNeighborAndRouteUpdates(sw);
+}
+
+void neighborFlap(uint32_t numRoutes) {
+  folly::BenchmarkSuspender suspender;
+  auto config = testConfigAWithLookupClasses();
+  auto handle = createTestHandle(&config);
+  auto sw = handle->getSw();
+  addHostRoutes(sw, numRoutes);
+  suspender.dismiss();
+
+  // Neighbor gets a classID, all routes behind it inherit it
+  sw->getNeighborUpdater()->receivedArpMine(
+      kVlan,
+      kNextHopA,
+      kMacAddressA,
+      PortDescriptor(kPortID),
+      ArpOpCode::ARP_OP_REPLY);
+  waitForNeighborAndRouteUpdates(sw);
+
+  // And loses them again once it goes away
+  sw->getNeighborUpdater()->flushEntry(kVlan, kNextHopA);
+  waitForNeighborAndRouteUpdates(sw);
+
+  suspender.rehire();
+}
+
+} // namespace
+
+BENCHMARK(LookupClassRouteUpdaterNeighborFlap10kRoutes) {
+  neighborFlap(10000);
+}
+
+BENCHMARK(LookupClassRouteUpdaterNeighborFlap100kRoutes) {
+  neighborFlap(100000);
+}
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -152,6 +152,15 @@ class LookupClassRouteUpdaterTest : public ::testing::Test {
     }
   }
 
+  // Not in any interface subnet
+  AddrT kIpAddressUnreachable() {
+    if constexpr (std::is_same_v<AddrT, folly::IPAddressV4>) {
+      return IPAddressV4("100.100.100.1");
+    } else {
+      return IPAddressV6("3001:db00::1");
+    }
+  }
+
   RoutePrefix<AddrT> kroutePrefix1() const {
     if constexpr (std::is_same_v<AddrT, folly::IPAddressV4>) {
       return RoutePrefix<AddrT>{folly::IPAddressV4{"10.1.4.0"}, 24};
@@ -1011,6 +1020,30 @@ TYPED_TEST(LookupClassRouteUpdaterTest, ChangeNextHopSet) {
   this->verifyNumRoutesWithMultiNextHops(0);
 }
 
+TYPED_TEST(LookupClassRouteUpdaterTest, PrefixToNextHopsIndex) {
+  auto lookupClassRouteUpdater = this->sw_->getLookupClassRouteUpdater();
+  // Interface routes have nexthops in the cached subnets too
+  auto numPrefixes =
+      lookupClassRouteUpdater->getNumPrefixesWithNextHopsInCache();
+
+  this->addRoute(this->kroutePrefix1(), {this->kIpAddressA()});
+  EXPECT_EQ(
+      lookupClassRouteUpdater->getNumPrefixesWithNextHopsInCache(),
+      numPrefixes + 1);
+
+  // Routes without nexthops in a cached subnet are not indexed
+  this->addRoute(this->kroutePrefix2(), {this->kIpAddressUnreachable()});
+  EXPECT_EQ(
+      lookupClassRouteUpdater->getNumPrefixesWithNextHopsInCache(),
+      numPrefixes + 1);
+
+  this->removeRoute(this->kroutePrefix1());
+  this->removeRoute(this->kroutePrefix2());
+  EXPECT_EQ(
+      lookupClassRouteUpdater->getNumPrefixesWithNextHopsInCache(),
+      numPrefixes);
+}
+
 // Test cases verifying Neighbor changes
 
 TYPED_TEST(LookupClassRouteUpdaterTest, VerifyNeighborAddAndRemove) {
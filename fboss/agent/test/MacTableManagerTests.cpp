@@ -11,6 +11,7 @@
 #include <gtest/gtest.h>
 
 #include "fboss/agent/L2Entry.h"
+#include "fboss/agent/StateObserver.h"
 #include "fboss/agent/state/Port.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/state/Vlan.h"
@@ -18,9 +19,33 @@
 #include "fboss/agent/test/TestUtils.h"
 
 #include <folly/MacAddress.h>
+#include <folly/logging/xlog.h>
+
+#include <chrono>
 
 namespace facebook::fboss {
 
+namespace {
+// Counts state updates which changed the MAC table of the given vlan. Only
+// ever touched on the update thread.
+class MacTableUpdateCounter : public StateObserver {
+ public:
+  explicit MacTableUpdateCounter(VlanID vlanID) : vlanID_(vlanID) {}
+
+  void stateUpdated(const StateDelta& delta) override {
+    auto oldVlan = delta.oldState()->getVlans()->getVlanIf(vlanID_);
+    auto newVlan = delta.newState()->getVlans()->getVlanIf(vlanID_);
+    if (oldVlan->getMacTable() != newVlan->getMacTable()) {
+      ++numUpdates;
+    }
+  }
+  size_t numUpdates{0};
+
+ private:
+  VlanID vlanID_;
+};
+} // namespace
+
 class MacTableManagerTest : public ::testing::Test {
  public:
   using Func = folly::Function<void()>;
@@ -142,4 +167,38 @@ TEST_F(MacTableManagerTest, SameMacAgedCbTwice) {
   verifyMacIsDeleted();
 }
 
+TEST_F(MacTableManagerTest, MacLearningStorm) {
+  // Learning events which arrive while the update thread is busy must be
+  // applied together rather than one state update per MAC.
+  constexpr size_t kNumMacs = 50000;
+  MacTableUpdateCounter counter(kVlan());
+  sw_->registerStateObserver(&counter, "MacTableUpdateCounter");
+  auto release = blockUpdateThread(sw_);
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumMacs; ++i) {
+    sw_->l2LearningUpdateReceived(
+        L2Entry(
+            MacAddress::fromHBO(0x020000000000 + i),
+            kVlan(),
+            PortDescriptor(kPortID()),
+            L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING),
+        L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD);
+  }
+  release->post();
+  waitForStateUpdates(sw_);
+  auto drainTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  XLOG(INFO) << "Applied " << kNumMacs << " learning updates in "
+             << drainTime.count() << "ms";
+
+  verifyStateUpdate([&]() {
+    auto vlan = sw_->getState()->getVlans()->getVlan(kVlan());
+    EXPECT_EQ(kNumMacs, vlan->getMacTable()->size());
+    // Everything was queued behind the blocked update thread, so a single
+    // update drained all of it
+    EXPECT_EQ(1u, counter.numUpdates);
+  });
+  sw_->unregisterStateObserver(&counter);
+}
+
 } // namespace facebook::fboss
@@ -0,0 +1,256 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/SflowExporter.h"
+
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <unistd.h>
+
+DECLARE_int32(sflow_export_max_delay_ms);
+DECLARE_int32(sflow_max_datagram_size);
+
+using namespace facebook::fboss;
+
+namespace {
+
+// Collects whatever the exporter sends to it on localhost
+class LocalCollector {
+ public:
+  LocalCollector() {
+    socket_ = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    CHECK_GE(socket_, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    auto saddr = reinterpret_cast<sockaddr*>(&addr);
+    CHECK_EQ(bind(socket_, saddr, sizeof(addr)), 0);
+    socklen_t len = sizeof(addr);
+    CHECK_EQ(getsockname(socket_, saddr, &len), 0);
+    port_ = ntohs(addr.sin_port);
+  }
+  ~LocalCollector() {
+    close(socket_);
+  }
+
+  std::shared_ptr<SflowCollector> collector() const {
+    return std::make_shared<SflowCollector>("127.0.0.1", port_);
+  }
+
+  // All datagrams received so far
+  std::vector<std::string> receive() {
+    std::vector<std::string> datagrams;
+    std::array<char, 65536> buf;
+    ssize_t len;
+    while ((len = recv(socket_, buf.data(), buf.size(), MSG_DONTWAIT)) > 0) {
+      datagrams.emplace_back(buf.data(), len);
+    }
+    return datagrams;
+  }
+
+ private:
+  int socket_{-1};
+  uint16_t port_{0};
+};
+
+struct Sample {
+  uint32_t format;
+  std::string data;
+};
+
+struct Datagram {
+  uint32_t sequence;
+  std::vector<Sample> samples;
+};
+
+Datagram parseDatagram(const std::string& data) {
+  auto buf = folly::IOBuf::wrapBuffer(data.data(), data.size());
+  folly::io::Cursor cursor(buf.get());
+  EXPECT_EQ(cursor.readBE<uint32_t>(), 5);
+  auto addressType = cursor.readBE<uint32_t>();
+  cursor.skip(addressType == 1 ? 4 : 16);
+  cursor.skip(4); // sub agent id
+  Datagram datagram;
+  datagram.sequence = cursor.readBE<uint32_t>();
+  cursor.skip(4); // uptime
+  auto numSamples = cursor.readBE<uint32_t>();
+  for (uint32_t i = 0; i < numSamples; ++i) {
+    Sample sample;
+    sample.format = cursor.readBE<uint32_t>();
+    sample.data = cursor.readFixedString(cursor.readBE<uint32_t>());
+    datagram.samples.push_back(std::move(sample));
+  }
+  EXPECT_TRUE(cursor.isAtEnd());
+  return datagram;
+}
+
+SflowPacketInfo samplePacket(uint16_t srcPort, size_t length) {
+  std::string packet(length, '\xab');
+  return makeSflowPacketInfo(
+      true,
+      false,
+      srcPort,
+      0,
+      1,
+      folly::ByteRange(folly::StringPiece(packet)));
+}
+
+} // namespace
+
+class SflowExporterTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    table_.addExporter(collector_.collector());
+  }
+
+ protected:
+  gflags::FlagSaver flagSaver_;
+  LocalCollector collector_;
+  SflowExporterTable table_;
+};
+
+TEST_F(SflowExporterTest, thriftPerSample) {
+  auto info = samplePacket(1, 64);
+  table_.sendToAll(info);
+  table_.sendToAll(info);
+
+  auto datagrams = collector_.receive();
+  ASSERT_EQ(datagrams.size(), 2);
+  auto got = apache::thrift::BinarySerializer::deserialize<SflowPacketInfo>(
+      datagrams[0]);
+  EXPECT_EQ(got, info);
+}
+
+TEST_F(SflowExporterTest, batchFlowSamples) {
+  FLAGS_sflow_v5_export = true;
+  FLAGS_sflow_export_max_delay_ms = 60 * 1000;
+  table_.updateSamplingRates(PortID(1), 1000, 0);
+
+  constexpr auto kNumSamples = 20;
+  for (int i = 0; i < kNumSamples; ++i) {
+    table_.sendToAll(samplePacket(1, 1500));
+  }
+  // Nothing goes out until the samples are due
+  EXPECT_TRUE(collector_.receive().empty());
+  table_.flush();
+
+  auto datagrams = collector_.receive();
+  EXPECT_GT(datagrams.size(), 1);
+  size_t numSamples = 0;
+  uint32_t sequence = 0;
+  for (const auto& data : datagrams) {
+    EXPECT_LE(data.size(), static_cast<size_t>(FLAGS_sflow_max_datagram_size));
+    auto datagram = parseDatagram(data);
+    EXPECT_EQ(datagram.sequence, ++sequence);
+    for (const auto& sample : datagram.samples) {
+      EXPECT_EQ(sample.format, 1);
+      auto buf =
+          folly::IOBuf::wrapBuffer(sample.data.data(), sample.data.size());
+      folly::io::Cursor cursor(buf.get());
+      EXPECT_EQ(cursor.readBE<uint32_t>(), ++numSamples); // sequence
+      EXPECT_EQ(cursor.readBE<uint32_t>(), 1); // source id
+      EXPECT_EQ(cursor.readBE<uint32_t>(), 1000); // sampling rate
+      EXPECT_EQ(cursor.readBE<uint32_t>(), numSamples * 1000); // sample pool
+      cursor.skip(12); // drops, input, output
+      EXPECT_EQ(cursor.readBE<uint32_t>(), 1); // flow records
+      EXPECT_EQ(cursor.readBE<uint32_t>(), 1); // raw packet header
+      cursor.skip(8); // record length, header protocol
+      EXPECT_EQ(cursor.readBE<uint32_t>(), 1500); // frame length
+      cursor.skip(4); // stripped
+      EXPECT_EQ(cursor.readBE<uint32_t>(), kMaxSflowSnapLen);
+    }
+  }
+  EXPECT_EQ(numSamples, kNumSamples);
+
+  auto stats = table_.getCollectorStats(collector_.collector()->getID());
+  ASSERT_TRUE(stats.has_value());
+  EXPECT_EQ(stats->samplesSent, kNumSamples);
+  EXPECT_EQ(stats->datagramsSent, datagrams.size());
+  EXPECT_EQ(stats->samplesDropped, 0);
+}
+
+TEST_F(SflowExporterTest, counterSamples) {
+  FLAGS_sflow_v5_export = true;
+  FLAGS_sflow_export_max_delay_ms = 60 * 1000;
+  table_.updateSamplingRates(PortID(1), 1000, 0);
+  table_.updateSamplingRates(PortID(2), 0, 0);
+
+  auto ports = table_.portsDueForCounterSamples();
+  ASSERT_EQ(ports, std::vector<PortID>{PortID(1)});
+  // Not due again until the interval passes
+  EXPECT_TRUE(table_.portsDueForCounterSamples().empty());
+
+  HwPortStats stats;
+  *stats.inBytes__ref() = 1000;
+  *stats.outUnicastPkts__ref() = 10;
+  table_.addCounterSample(PortID(1), 100000000000, true, true, stats);
+  table_.flush();
+
+  auto datagrams = collector_.receive();
+  ASSERT_EQ(datagrams.size(), 1);
+  auto datagram = parseDatagram(datagrams[0]);
+  ASSERT_EQ(datagram.samples.size(), 1);
+  EXPECT_EQ(datagram.samples[0].format, 2);
+  const auto& data = datagram.samples[0].data;
+  auto buf = folly::IOBuf::wrapBuffer(data.data(), data.size());
+  folly::io::Cursor cursor(buf.get());
+  EXPECT_EQ(cursor.readBE<uint32_t>(), 1); // sequence
+  EXPECT_EQ(cursor.readBE<uint32_t>(), 1); // source id
+  EXPECT_EQ(cursor.readBE<uint32_t>(), 1); // counter records
+  EXPECT_EQ(cursor.readBE<uint32_t>(), 1); // generic interface counters
+  EXPECT_EQ(cursor.readBE<uint32_t>(), 88);
+  EXPECT_EQ(cursor.readBE<uint32_t>(), 1); // ifIndex
+  EXPECT_EQ(cursor.readBE<uint32_t>(), 6); // ifType
+  EXPECT_EQ(cursor.readBE<uint64_t>(), 100000000000); // ifSpeed
+  EXPECT_EQ(cursor.readBE<uint32_t>(), 1); // ifDirection
+  EXPECT_EQ(cursor.readBE<uint32_t>(), 3); // ifStatus
+  EXPECT_EQ(cursor.readBE<uint64_t>(), 1000); // ifInOctets
+  // Uninitialized counters are exported as 0
+  EXPECT_EQ(cursor.readBE<uint32_t>(), 0); // ifInUcastPkts
+  cursor.skip(5 * 4 + 8);
+  EXPECT_EQ(cursor.readBE<uint32_t>(), 10); // ifOutUcastPkts
+}
+
+TEST_F(SflowExporterTest, removedPortsAreNotSampled) {
+  FLAGS_sflow_v5_export = true;
+  table_.updateSamplingRates(PortID(1), 1000, 0);
+  table_.updateSamplingRates(PortID(2), 1000, 0);
+  table_.removeSamplingRates(PortID(1));
+  EXPECT_EQ(
+      table_.portsDueForCounterSamples(), std::vector<PortID>{PortID(2)});
+}
+
+TEST_F(SflowExporterTest, dropOversizedSamples) {
+  FLAGS_sflow_v5_export = true;
+  FLAGS_sflow_export_max_delay_ms = 60 * 1000;
+  FLAGS_sflow_max_datagram_size = 128;
+  table_.updateSamplingRates(PortID(1), 1000, 0);
+
+  table_.sendToAll(samplePacket(1, 1500));
+  table_.sendToAll(samplePacket(1, 16));
+  table_.flush();
+
+  auto datagrams = collector_.receive();
+  ASSERT_EQ(datagrams.size(), 1);
+  EXPECT_LE(
+      datagrams[0].size(), static_cast<size_t>(FLAGS_sflow_max_datagram_size));
+  EXPECT_EQ(parseDatagram(datagrams[0]).samples.size(), 1);
+
+  auto stats = table_.getCollectorStats(collector_.collector()->getID());
+  ASSERT_TRUE(stats.has_value());
+  EXPECT_EQ(stats->samplesSent, 1);
+  EXPECT_EQ(stats->samplesDropped, 1);
+  EXPECT_EQ(stats->datagramsDropped, 0);
+}
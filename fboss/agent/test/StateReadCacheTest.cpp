@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/StateReadCache.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+using namespace facebook::fboss;
+using std::make_shared;
+using std::shared_ptr;
+
+TEST(StateReadCache, CachedPerState) {
+  StateReadCache<int> cache("test_cached");
+  int numComputed = 0;
+  auto compute = [&]() { return ++numComputed; };
+
+  auto state1 = make_shared<SwitchState>();
+  EXPECT_EQ(1, *cache.getForState(state1, compute));
+  EXPECT_EQ(1, *cache.getForState(state1, compute));
+  EXPECT_EQ(1, numComputed);
+
+  // New state, recompute
+  auto state2 = make_shared<SwitchState>();
+  EXPECT_EQ(2, *cache.getForState(state2, compute));
+  EXPECT_EQ(2, *cache.getForState(state2, compute));
+  EXPECT_EQ(2, numComputed);
+
+  cache.invalidate();
+  EXPECT_EQ(3, *cache.getForState(state2, compute));
+}
+
+TEST(StateReadCache, CoalescedNotCached) {
+  StateReadCache<int> cache("test_not_cached");
+  int numComputed = 0;
+  auto compute = [&]() { return ++numComputed; };
+
+  EXPECT_EQ(1, *cache.getCoalesced(compute));
+  EXPECT_EQ(2, *cache.getCoalesced(compute));
+}
+
+TEST(StateReadCache, ErrorNotCached) {
+  StateReadCache<int> cache("test_error");
+  auto state = make_shared<SwitchState>();
+  EXPECT_THROW(
+      cache.getForState(
+          state, []() -> int { throw std::runtime_error("failed"); }),
+      std::runtime_error);
+  EXPECT_EQ(5, *cache.getForState(state, []() { return 5; }));
+}
+
+TEST(StateReadCache, ConcurrentCallsCoalesced) {
+  StateReadCache<int> cache("test_coalesced");
+  auto state = make_shared<SwitchState>();
+  std::atomic<int> numComputed{0};
+  folly::Baton<> entered;
+  folly::Baton<> release;
+
+  std::thread first([&]() {
+    auto result = cache.getForState(state, [&]() {
+      entered.post();
+      release.wait();
+      return ++numComputed;
+    });
+    EXPECT_EQ(1, *result);
+  });
+  entered.wait();
+
+  // Starts while the first computation is blocked, so it must wait for it
+  std::thread second([&]() {
+    auto result = cache.getForState(state, [&]() { return ++numComputed; });
+    EXPECT_EQ(1, *result);
+  });
+  // Give the second call time to find the in-flight computation. Should it
+  // get there only after the first call finished it hits the cache instead,
+  // either way nothing is computed twice.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  release.post();
+  first.join();
+  second.join();
+  EXPECT_EQ(1, numComputed.load());
+}
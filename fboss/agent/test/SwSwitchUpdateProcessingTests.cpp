@@ -30,6 +30,8 @@ using ::testing::ByRef;
 using ::testing::Eq;
 using ::testing::Return;
 
+DECLARE_bool(enable_state_update_pipelining);
+
 class SwSwitchUpdateProcessingTest : public ::testing::TestWithParam<bool> {
  public:
   void SetUp() override {
@@ -242,3 +244,72 @@ INSTANTIATE_TEST_CASE_P(
     SwSwitchUpdateProcessingTest,
     SwSwitchUpdateProcessingTest,
     ::testing::Values(true, false));
+
+class SwSwitchPipelinedUpdateProcessingTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    FLAGS_enable_state_update_pipelining = true;
+    auto state = testStateA();
+    state->publish();
+    handle = createTestHandle(state);
+    sw = handle->getSw();
+    sw->initialConfigApplied(std::chrono::steady_clock::now());
+    waitForStateUpdates(sw);
+  }
+
+  void TearDown() override {
+    sw = nullptr;
+    handle.reset();
+    FLAGS_enable_state_update_pipelining = false;
+  }
+
+ protected:
+  SwSwitch* sw{nullptr};
+  std::unique_ptr<HwTestHandle> handle{nullptr};
+};
+
+TEST_F(SwSwitchPipelinedUpdateProcessingTest, UpdatesAppliedInOrder) {
+  constexpr auto kNumUpdates = 100;
+  EXPECT_HW_CALL(sw, stateChanged(_)).Times(testing::AtLeast(1));
+  std::vector<std::shared_ptr<SwitchState>> seenStates;
+  for (auto i = 0; i < kNumUpdates; ++i) {
+    // Each update must be computed on top of the previous one, even if that
+    // one is still being programmed to hardware.
+    sw->updateState(
+        "Pipelined update", [&seenStates](const auto& state) {
+          if (!seenStates.empty()) {
+            EXPECT_EQ(seenStates.back(), state);
+          }
+          auto newState = state->clone();
+          seenStates.push_back(newState);
+          return newState;
+        });
+  }
+  waitForStateUpdates(sw);
+  ASSERT_EQ(kNumUpdates, seenStates.size());
+  EXPECT_EQ(seenStates.back(), sw->getState());
+}
+
+TEST_F(SwSwitchPipelinedUpdateProcessingTest, HwFailureProtectedRollback) {
+  auto origState = sw->getState();
+  auto newState = bringAllPortsUp(origState->clone());
+  newState->publish();
+  // Reject the protected update, the next update must then be computed on
+  // top of the state that made it to hardware.
+  EXPECT_HW_CALL(sw, stateChanged(_)).WillOnce(Return(origState));
+  EXPECT_THROW(
+      sw->updateStateWithHwFailureProtection(
+          "Reject update", [=](const auto& /*state*/) { return newState; }),
+      FbossHwUpdateError);
+  EXPECT_EQ(origState, sw->getState());
+
+  auto newerState = origState->clone();
+  StateDelta expectedDelta(origState, newerState);
+  EXPECT_HW_CALL(sw, stateChanged(Eq(testing::ByRef(expectedDelta))));
+  sw->updateState("Accept update", [=](const auto& state) {
+    EXPECT_EQ(origState, state);
+    return newerState;
+  });
+  waitForStateUpdates(sw);
+  EXPECT_EQ(newerState, sw->getState());
+}
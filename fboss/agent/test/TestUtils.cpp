@@ -202,9 +202,10 @@ shared_ptr<SwitchState> publishAndApplyConfig(
     const shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RoutingInformationBase* rib) {
+    RoutingInformationBase* rib,
+    const cfg::SwitchConfig* prevConfig) {
   state->publish();
-  return applyThriftConfig(state, config, platform, rib);
+  return applyThriftConfig(state, config, platform, rib, prevConfig);
 }
 
 std::unique_ptr<SwSwitch> setupMockSwitchWithoutHW(
@@ -292,6 +293,21 @@ std::shared_ptr<SwitchState> waitForStateUpdates(SwSwitch* sw) {
   return snapshot;
 }
 
+std::shared_ptr<folly::Baton<>> blockUpdateThread(SwSwitch* sw) {
+  auto blocked = std::make_shared<folly::Baton<>>();
+  auto release = std::make_shared<folly::Baton<>>();
+  sw->updateStateNoCoalescing(
+      "blockUpdateThread",
+      [blocked, release](const shared_ptr<SwitchState>& /* state */)
+          -> std::shared_ptr<SwitchState> {
+        blocked->post();
+        release->wait();
+        return nullptr;
+      });
+  blocked->wait();
+  return release;
+}
+
 void waitForBackgroundThread(SwSwitch* sw) {
   auto* evb = sw->getBackgroundEvb();
   evb->runInEventBaseThreadAndWait([]() { return; });
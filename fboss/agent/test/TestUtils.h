@@ -60,7 +60,8 @@ std::shared_ptr<SwitchState> publishAndApplyConfig(
     const std::shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RoutingInformationBase* rib = nullptr);
+    RoutingInformationBase* rib = nullptr,
+    const cfg::SwitchConfig* prevConfig = nullptr);
 
 /*
  * Create a SwSwitch for testing purposes, with the specified initial state.
@@ -105,6 +106,12 @@ MockPlatform* getMockPlatform(std::unique_ptr<SwSwitch>& sw);
  */
 std::shared_ptr<SwitchState> waitForStateUpdates(SwSwitch* sw);
 
+/*
+ * Block the update thread until the returned baton is posted, so that state
+ * updates queued in the meantime are picked up together once it is.
+ */
+std::shared_ptr<folly::Baton<>> blockUpdateThread(SwSwitch* sw);
+
 /*
  * Wait until all pending actions on the background thread
  * have been processed
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <sched.h>
+
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SysError.h"
+#include "fboss/agent/TunManager.h"
+#include "fboss/agent/state/Interface.h"
+#include "fboss/agent/state/InterfaceMap.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/TestUtils.h"
+
+/*
+ * Measures how long TunManager takes to bring up and tear down host
+ * interfaces at scale. The benchmark runs in its own network namespace, so
+ * it needs CAP_SYS_ADMIN but does not touch the host's interfaces, routes
+ * or rules, and no hardware is required.
+ */
+
+using namespace facebook::fboss;
+using folly::IPAddress;
+using folly::MacAddress;
+using std::make_shared;
+using std::make_unique;
+using std::shared_ptr;
+using std::unique_ptr;
+
+namespace {
+
+// Global state used by the benchmarks
+unique_ptr<HwTestHandle> handle;
+unique_ptr<folly::ScopedEventBaseThread> tunThread;
+
+shared_ptr<SwitchState> makeState(int numIntfs, int numAddrsPerIntf) {
+  auto state = make_shared<SwitchState>();
+  for (int i = 0; i < numIntfs; ++i) {
+    auto intf = make_shared<Interface>(
+        InterfaceID(2000 + i),
+        RouterID(0),
+        VlanID(2000 + i),
+        folly::to<std::string>("interface", 2000 + i),
+        MacAddress("02:00:01:00:00:01"),
+        9000,
+        true, /* is virtual */
+        false /* is state_sync disabled*/);
+    Interface::Addresses addrs;
+    for (int j = 0; j < numAddrsPerIntf; ++j) {
+      // 10.<i / 256>.<i % 256>.<j + 1>/24 and 2401:db00:<i>::<j + 1>/64
+      addrs.emplace(
+          IPAddress::fromLongHBO(
+              (10u << 24) | (static_cast<uint32_t>(i) << 8) | (j + 1)),
+          24);
+      addrs.emplace(
+          IPAddress(folly::to<std::string>("2401:db00:", i, "::", j + 1)),
+          64);
+    }
+    intf->setAddresses(addrs);
+    state->addIntf(intf);
+  }
+  return state;
+}
+
+void runSync(TunManager* tunMgr, const shared_ptr<SwitchState>& state) {
+  tunThread->getEventBase()->runInEventBaseThreadAndWait(
+      [&]() { tunMgr->sync(state); });
+}
+
+void syncBenchmark(size_t numIters, int numIntfs, int numAddrsPerIntf) {
+  unique_ptr<TunManager> tunMgr;
+  shared_ptr<SwitchState> state;
+  shared_ptr<SwitchState> emptyState;
+  BENCHMARK_SUSPEND {
+    tunMgr =
+        make_unique<TunManager>(handle->getSw(), tunThread->getEventBase());
+    state = makeState(numIntfs, numAddrsPerIntf);
+    emptyState = make_shared<SwitchState>();
+    // Probe up front so that it is not part of the measurement
+    runSync(tunMgr.get(), emptyState);
+  }
+
+  for (size_t n = 0; n < numIters; ++n) {
+    runSync(tunMgr.get(), state);
+    runSync(tunMgr.get(), emptyState);
+  }
+
+  BENCHMARK_SUSPEND {
+    tunThread->getEventBase()->runInEventBaseThreadAndWait(
+        [&]() { tunMgr.reset(); });
+  }
+}
+
+void init() {
+  // Run in a private network namespace
+  if (unshare(CLONE_NEWNET) != 0) {
+    throw SysError(errno, "Failed to create network namespace");
+  }
+
+  // TunManager only talks to the kernel, a mock switch is enough
+  handle = createTestHandle();
+  tunThread = make_unique<folly::ScopedEventBaseThread>("TunManagerBench");
+}
+
+} // unnamed namespace
+
+BENCHMARK(TunSync_10Intfs_1Addr, numIters) {
+  syncBenchmark(numIters, 10, 1);
+}
+
+BENCHMARK(TunSync_100Intfs_10Addrs, numIters) {
+  syncBenchmark(numIters, 100, 10);
+}
+
+BENCHMARK(TunSync_500Intfs_10Addrs, numIters) {
+  syncBenchmark(numIters, 500, 10);
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  // Creating the namespace and switch is done once, before the benchmarks
+  // run.
+  init();
+
+  folly::runBenchmarks();
+  return 0;
+}
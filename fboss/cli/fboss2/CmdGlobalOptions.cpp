@@ -42,6 +42,16 @@ void CmdGlobalOptions::init(CLI::App& app) {
          qsfpThriftPort_,
          "QsfpService thrift port to connect to")
       ->check(CLI::PositiveNumber);
+  app.add_option(
+         "--max-concurrent-hosts",
+         maxConcurrentHosts_,
+         "Maximum number of hosts queried at once")
+      ->check(CLI::PositiveNumber);
+  app.add_option(
+         "--request-timeout",
+         requestTimeoutMs_,
+         "Timeout (in ms) of each thrift request to a host")
+      ->check(CLI::PositiveNumber);
   app.add_option(
       "--color", color_, "color (no, yes => yes for tty and no for pipe)");
   app.add_option(
@@ -118,6 +118,14 @@ class CmdGlobalOptions {
     return bmcHttpPort_;
   }
 
+  int getMaxConcurrentHosts() const {
+    return maxConcurrentHosts_;
+  }
+
+  int getRequestTimeoutMs() const {
+    return requestTimeoutMs_;
+  }
+
   std::string getColor() const {
     return color_;
   }
@@ -152,6 +160,8 @@ class CmdGlobalOptions {
   int rackmonThriftPort_{7910};
   int sensorServiceThriftPort_{5970};
   int miscServiceThriftPort_{5971};
+  int maxConcurrentHosts_{32};
+  int requestTimeoutMs_{45000};
   std::string color_{"yes"};
   std::vector<std::string> filters_{};
 };
@@ -31,60 +31,13 @@
 #include "fboss/cli/fboss2/commands/show/transceiver/CmdShowTransceiver.h"
 #include "fboss/cli/fboss2/utils/CmdClientUtils.h"
 #include "fboss/cli/fboss2/utils/CmdUtils.h"
-#include "folly/futures/Future.h"
-#include "thrift/lib/cpp2/protocol/Serializer.h"
 
 #include <folly/Singleton.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/logging/xlog.h>
-#include <future>
+#include <algorithm>
 #include <iostream>
 
-template <typename CmdTypeT>
-void printTabular(
-    CmdTypeT& cmd,
-    std::vector<std::shared_future<
-        std::tuple<std::string, typename CmdTypeT::RetType, std::string>>>&
-        results,
-    std::ostream& out,
-    std::ostream& err) {
-  for (auto& result : results) {
-    auto [host, data, errStr] = result.get();
-    if (results.size() != 1) {
-      out << host << "::" << std::endl << std::string(80, '=') << std::endl;
-    }
-
-    if (errStr.empty()) {
-      cmd.printOutput(data);
-    } else {
-      err << errStr << std::endl << std::endl;
-    }
-  }
-}
-
-template <typename CmdTypeT>
-void printJson(
-    const CmdTypeT& /* cmd */,
-    std::vector<std::shared_future<
-        std::tuple<std::string, typename CmdTypeT::RetType, std::string>>>&
-        results,
-    std::ostream& out,
-    std::ostream& err) {
-  std::map<std::string, typename CmdTypeT::RetType> hostResults;
-  for (auto& result : results) {
-    auto [host, data, errStr] = result.get();
-    if (errStr.empty()) {
-      hostResults[host] = data;
-    } else {
-      err << host << "::" << std::endl << std::string(80, '=') << std::endl;
-      err << errStr << std::endl << std::endl;
-    }
-  }
-
-  out << apache::thrift::SimpleJSONSerializer::serialize<std::string>(
-             hostResults)
-      << std::endl;
-}
-
 namespace facebook::fboss {
 
 // Avoid template linker error
@@ -153,29 +106,31 @@ void CmdHandler<CmdTypeT, CmdTypeTraits>::run() {
     hosts = {"localhost"};
   }
 
-  std::vector<std::shared_future<std::tuple<std::string, RetType, std::string>>>
-      futureList;
+  // A bounded pool of workers, each reusing its thread's EventBase for
+  // the thrift clients of every host it queries
+  auto numThreads = std::min(
+      hosts.size(),
+      static_cast<size_t>(
+          CmdGlobalOptions::getInstance()->getMaxConcurrentHosts()));
+  folly::CPUThreadPoolExecutor executor(std::max<size_t>(numThreads, 1));
+  HostResultQueue<CmdTypeT> results;
   for (const auto& host : hosts) {
-    futureList.push_back(std::async(
-                             std::launch::async,
-                             &CmdHandler::asyncHandler,
-                             this,
-                             host /*, inArgs*/)
-                             .share());
+    executor.add(
+        [this, host, &results]() { results.enqueue(asyncHandler(host)); });
   }
 
+  bool success;
   if (CmdGlobalOptions::getInstance()->getFmt().isJson()) {
-    printJson(impl(), futureList, std::cout, std::cerr);
+    success = printJson(impl(), results, hosts.size(), std::cout, std::cerr);
   } else {
-    printTabular(impl(), futureList, std::cout, std::cerr);
+    success =
+        printTabular(impl(), results, hosts.size(), std::cout, std::cerr);
   }
+  executor.join();
 
-  for (auto& fut : futureList) {
-    auto [host, data, errStr] = fut.get();
-    // exit with failure if any of the calls failed
-    if (!errStr.empty()) {
-      exit(1);
-    }
+  // exit with failure if any of the calls failed
+  if (!success) {
+    exit(1);
   }
 }
 
@@ -21,7 +21,12 @@
 
 #include <fmt/color.h>
 #include <fmt/format.h>
+#include <folly/concurrency/UnboundedQueue.h>
+#include <folly/json.h>
 #include <folly/logging/xlog.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <iostream>
+#include <optional>
 #include <type_traits>
 #include <variant>
 
@@ -76,6 +81,76 @@ struct BaseCommandTraits {
   static constexpr std::array<std::string_view, 0> FILTERS{};
 };
 
+// (host, output, error) for one host, with an empty error on success
+template <typename CmdTypeT>
+using HostResult =
+    std::tuple<std::string, typename CmdTypeT::RetType, std::string>;
+
+// Results are queued by the worker threads as each host answers
+template <typename CmdTypeT>
+using HostResultQueue = folly::UMPSCQueue<HostResult<CmdTypeT>, true>;
+
+/*
+ * Print each host's output as soon as it arrives, so one slow host doesn't
+ * hold back the others. Returns false if any of the hosts failed.
+ */
+template <typename CmdTypeT>
+bool printTabular(
+    CmdTypeT& cmd,
+    HostResultQueue<CmdTypeT>& results,
+    size_t numHosts,
+    std::ostream& out,
+    std::ostream& err) {
+  bool success = true;
+  for (size_t i = 0; i < numHosts; i++) {
+    auto [host, data, errStr] = results.dequeue();
+    if (numHosts != 1) {
+      out << host << "::" << std::endl << std::string(80, '=') << std::endl;
+    }
+
+    if (errStr.empty()) {
+      cmd.printOutput(data);
+    } else {
+      success = false;
+      err << errStr << std::endl << std::endl;
+    }
+    out.flush();
+  }
+  return success;
+}
+
+/*
+ * Stream a JSON object of host -> output, with hosts in the order they
+ * answered.
+ */
+template <typename CmdTypeT>
+bool printJson(
+    const CmdTypeT& /* cmd */,
+    HostResultQueue<CmdTypeT>& results,
+    size_t numHosts,
+    std::ostream& out,
+    std::ostream& err) {
+  bool success = true;
+  bool first = true;
+  out << "{";
+  for (size_t i = 0; i < numHosts; i++) {
+    auto [host, data, errStr] = results.dequeue();
+    if (errStr.empty()) {
+      out << (first ? "" : ",") << folly::toJson(folly::dynamic(host)) << ":"
+          << apache::thrift::SimpleJSONSerializer::serialize<std::string>(
+                 data);
+      out.flush();
+      first = false;
+    } else {
+      success = false;
+      err << host << "::" << std::endl << std::string(80, '=') << std::endl;
+      err << errStr << std::endl << std::endl;
+    }
+  }
+  out << "}" << std::endl;
+  return success;
+}
+
 template <typename CmdTypeT, typename CmdTypeTraits>
 class CmdHandler {
   static_assert(
@@ -112,13 +187,22 @@ class CmdHandler {
 
   std::tuple<std::string, RetType, std::string> asyncHandler(
       const std::string& host) {
-    auto hostInfo = HostInfo(host);
-    XLOG(DBG2) << "host: " << host << " ip: " << hostInfo.getIpStr();
-
     std::string errStr;
     RetType result;
+    // Runs on a worker thread, so failures are reported with the result
+    // instead of thrown
+    std::optional<HostInfo> hostInfo;
+    try {
+      hostInfo.emplace(host);
+    } catch (std::exception const& err) {
+      errStr = folly::to<std::string>(
+          "Failed to resolve host '", host, "': '", err.what(), "'");
+      return std::make_tuple(host, result, errStr);
+    }
+    XLOG(DBG2) << "host: " << host << " ip: " << hostInfo->getIpStr();
+
     try {
-      result = queryClientHelper(hostInfo);
+      result = queryClientHelper(*hostInfo);
     } catch (std::exception const& err) {
       errStr = folly::to<std::string>("Thrift call failed: '", err.what(), "'");
     }
@@ -0,0 +1,124 @@
+// (c) Facebook, Inc. and its affiliates. Confidential and proprietary.
+
+#include <gtest/gtest.h>
+
+#include <folly/json.h>
+#include <sstream>
+#include <thread>
+
+#include "fboss/cli/fboss2/CmdHandler.h"
+#include "fboss/cli/fboss2/commands/show/arp/gen-cpp2/model_types.h"
+
+using namespace ::testing;
+
+namespace facebook::fboss {
+
+namespace {
+
+// Prints the ip of each entry to the same stream as the host headers
+class MockCmd {
+ public:
+  using RetType = cli::ShowArpModel;
+
+  explicit MockCmd(std::ostream& out) : out_(out) {}
+
+  void printOutput(const RetType& model) {
+    for (const auto& entry : model.get_arpEntries()) {
+      out_ << entry.get_ip() << std::endl;
+    }
+  }
+
+ private:
+  std::ostream& out_;
+};
+
+cli::ShowArpModel createModel(const std::string& ip) {
+  cli::ArpEntry entry;
+  entry.ip_ref() = ip;
+  cli::ShowArpModel model;
+  model.arpEntries_ref() = {entry};
+  return model;
+}
+
+std::string header(const std::string& host) {
+  return host + "::\n" + std::string(80, '=') + "\n";
+}
+
+} // namespace
+
+class CmdHandlerTestFixture : public testing::Test {
+ public:
+  /*
+   * Mock hosts answer from their own threads in the order given, the way
+   * the worker pool would when later hosts in the list reply first.
+   * host2 fails.
+   */
+  void answerHosts(const std::vector<std::string>& order) {
+    for (const auto& host : order) {
+      std::thread([this, host]() {
+        if (host == "host2") {
+          results.enqueue(
+              {host, cli::ShowArpModel(), "Thrift call failed: 'timeout'"});
+        } else {
+          results.enqueue({host, createModel(host + "-ip"), ""});
+        }
+      }).join();
+    }
+  }
+
+  HostResultQueue<MockCmd> results;
+  std::stringstream out;
+  std::stringstream err;
+};
+
+TEST_F(CmdHandlerTestFixture, printTabular) {
+  answerHosts({"host3", "host2", "host1"});
+
+  MockCmd cmd(out);
+  EXPECT_FALSE(printTabular(cmd, results, 3, out, err));
+
+  // Hosts are printed in the order they answered
+  EXPECT_EQ(
+      out.str(),
+      header("host3") + "host3-ip\n" + header("host2") + header("host1") +
+          "host1-ip\n");
+  EXPECT_EQ(err.str(), "Thrift call failed: 'timeout'\n\n");
+}
+
+TEST_F(CmdHandlerTestFixture, printTabularSingleHost) {
+  results.enqueue({"host1", createModel("host1-ip"), ""});
+
+  MockCmd cmd(out);
+  EXPECT_TRUE(printTabular(cmd, results, 1, out, err));
+  EXPECT_EQ(out.str(), "host1-ip\n");
+  EXPECT_TRUE(err.str().empty());
+}
+
+TEST_F(CmdHandlerTestFixture, printJson) {
+  answerHosts({"host3", "host2", "host1"});
+
+  MockCmd cmd(out);
+  EXPECT_FALSE(printJson(cmd, results, 3, out, err));
+
+  // The failed host is left out of the otherwise valid object
+  auto str = out.str();
+  EXPECT_LT(str.find("\"host3\""), str.find("\"host1\""));
+  auto json = folly::parseJson(str);
+  ASSERT_EQ(json.size(), 2);
+  EXPECT_EQ(json["host3"]["arpEntries"][0]["ip"], "host3-ip");
+  EXPECT_EQ(json["host1"]["arpEntries"][0]["ip"], "host1-ip");
+  EXPECT_EQ(json.count("host2"), 0);
+  EXPECT_EQ(
+      err.str(), header("host2") + "Thrift call failed: 'timeout'\n\n");
+}
+
+TEST_F(CmdHandlerTestFixture, printJsonAllHostsFailed) {
+  results.enqueue({"host2", cli::ShowArpModel(), "Thrift call failed"});
+
+  MockCmd cmd(out);
+  EXPECT_FALSE(printJson(cmd, results, 1, out, err));
+  EXPECT_EQ(out.str(), "{}\n");
+  EXPECT_EQ(err.str(), header("host2") + "Thrift call failed\n\n");
+}
+
+} // namespace facebook::fboss
@@ -21,7 +21,6 @@
 namespace facebook::fboss::utils {
 
 static auto constexpr kConnTimeout = 1000;
-static auto constexpr kRecvTimeout = 45000;
 static auto constexpr kSendTimeout = 5000;
 
 template <typename T>
@@ -41,7 +40,7 @@ std::unique_ptr<Client> createPlaintextClient(
   sock->setSendTimeout(kSendTimeout);
   auto channel =
       apache::thrift::HeaderClientChannel::newChannel(std::move(sock));
-  channel->setTimeout(kRecvTimeout);
+  channel->setTimeout(CmdGlobalOptions::getInstance()->getRequestTimeoutMs());
   return std::make_unique<Client>(std::move(channel));
 }
 
@@ -14,6 +14,7 @@
 #include <unordered_map>
 
 #include <boost/container/flat_map.hpp>
+#include <folly/container/F14Map.h>
 
 namespace facebook::fboss {
 /*
@@ -35,6 +36,9 @@ using RefMapUMap = std::unordered_map<K, V>;
 template <typename K, typename V>
 using RefMapFlatMap = boost::container::flat_map<K, V>;
 
+template <typename K, typename V>
+using RefMapF14NodeMap = folly::F14NodeMap<K, V>;
+
 template <template <class, class> class M, typename K, typename V>
 class RefMap {
  public:
@@ -122,13 +126,34 @@ class RefMap {
   }
 
  private:
+  /*
+   * The value, along with what it takes to remove it from the map once the
+   * last reference to it goes away. Allocated together with the shared_ptr
+   * control block, so that each value costs a single allocation.
+   */
+  struct Entry {
+    template <typename... Args>
+    Entry(MapType& map, const K& key, Args&&... args)
+        : map(map), key(key), value{std::forward<Args>(args)...} {}
+    ~Entry() {
+      // The key may have been cleared and reused since, by a value that is
+      // still alive. Only our own entry has expired by now.
+      auto itr = map.find(key);
+      if (itr != map.end() && itr->second.expired()) {
+        map.erase(itr);
+      }
+    }
+
+    MapType& map;
+    K key;
+    V value;
+  };
+
   template <typename... Args>
   std::shared_ptr<V> makeShared(const K& k, Args&&... args) {
-    auto del = [&m = map_, k](V* v) {
-      m.erase(k);
-      std::default_delete<V>()(v);
-    };
-    return std::shared_ptr<V>(new V{std::forward<Args>(args)...}, del);
+    auto entry =
+        std::make_shared<Entry>(map_, k, std::forward<Args>(args)...);
+    return std::shared_ptr<V>(entry, &entry->value);
   }
 
   template <typename... Args>
@@ -155,4 +180,7 @@ using UnorderedRefMap = RefMap<RefMapUMap, K, V>;
 template <typename K, typename V>
 using FlatRefMap = RefMap<RefMapFlatMap, K, V>;
 
+template <typename K, typename V>
+using F14NodeRefMap = RefMap<RefMapF14NodeMap, K, V>;
+
 } // namespace facebook::fboss
@@ -9,17 +9,25 @@
  */
 #pragma once
 
+#include <algorithm>
 #include "fboss/agent/FbossError.h"
 #include "fboss/lib/link_snapshots/RingBuffer.h"
 
 namespace facebook::fboss {
 
+template <typename T, size_t length>
+RingBuffer<T, length>::RingBuffer() {
+  buf.reserve(length);
+}
+
 template <typename T, size_t length>
 void RingBuffer<T, length>::write(T val) {
-  if (buf.size() == length) {
-    buf.pop_front();
+  if (buf.size() < length) {
+    buf.push_back(std::move(val));
+  } else {
+    buf[head] = std::move(val);
+    head = (head + 1) % length;
   }
-  buf.push_back(val);
 }
 
 template <typename T, size_t length>
@@ -27,7 +35,18 @@ const T RingBuffer<T, length>::last() const {
   if (buf.empty()) {
     throw FbossError("Attempted to read from empty RingBuffer");
   }
-  return buf.back();
+  return at(buf.size() - 1);
+}
+
+template <typename T, size_t length>
+std::vector<T> RingBuffer<T, length>::lastN(size_t n) const {
+  std::vector<T> entries;
+  auto count = std::min(n, buf.size());
+  entries.reserve(count);
+  for (auto i = buf.size() - count; i < buf.size(); i++) {
+    entries.push_back(at(i));
+  }
+  return entries;
 }
 
 template <typename T, size_t length>
@@ -37,24 +56,24 @@ bool RingBuffer<T, length>::empty() const {
 
 template <typename T, size_t length>
 typename RingBuffer<T, length>::iterator RingBuffer<T, length>::begin() {
-  return buf.begin();
+  return iterator(this, 0);
 }
 
 template <typename T, size_t length>
 typename RingBuffer<T, length>::iterator RingBuffer<T, length>::end() {
-  return buf.end();
+  return iterator(this, buf.size());
 }
 
 template <typename T, size_t length>
 typename RingBuffer<T, length>::const_iterator RingBuffer<T, length>::begin()
     const {
-  return buf.begin();
+  return const_iterator(this, 0);
 }
 
 template <typename T, size_t length>
 typename RingBuffer<T, length>::const_iterator RingBuffer<T, length>::end()
     const {
-  return buf.end();
+  return const_iterator(this, buf.size());
 }
 
 template <typename T, size_t length>
@@ -67,4 +86,14 @@ size_t RingBuffer<T, length>::maxSize() const {
   return length;
 }
 
+template <typename T, size_t length>
+T& RingBuffer<T, length>::at(size_t i) {
+  return buf[(head + i) % buf.size()];
+}
+
+template <typename T, size_t length>
+const T& RingBuffer<T, length>::at(size_t i) const {
+  return buf[(head + i) % buf.size()];
+}
+
 } // namespace facebook::fboss
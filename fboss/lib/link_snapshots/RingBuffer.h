@@ -10,17 +10,66 @@
 #pragma once
 
 #include <stddef.h>
-#include <list>
+#include <iterator>
+#include <vector>
 
 namespace facebook::fboss {
+
+/*
+ * Fixed capacity ring buffer, iterated from the oldest entry to the newest.
+ * Entries are stored contiguously and overwritten in place once the buffer
+ * is full, so writes don't allocate.
+ */
 template <typename T, size_t length>
 class RingBuffer {
+  template <typename Ring, typename Value>
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value*;
+    using reference = Value&;
+
+    Iterator(Ring* ring, size_t pos) : ring_(ring), pos_(pos) {}
+
+    reference operator*() const {
+      return ring_->at(pos_);
+    }
+    pointer operator->() const {
+      return &ring_->at(pos_);
+    }
+    Iterator& operator++() {
+      ++pos_;
+      return *this;
+    }
+    Iterator operator++(int) {
+      auto it = *this;
+      ++pos_;
+      return it;
+    }
+    bool operator==(const Iterator& other) const {
+      return ring_ == other.ring_ && pos_ == other.pos_;
+    }
+    bool operator!=(const Iterator& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    Ring* ring_;
+    size_t pos_;
+  };
+
  public:
-  using iterator = typename std::list<T>::iterator;
-  using const_iterator = typename std::list<T>::const_iterator;
+  using iterator = Iterator<RingBuffer, T>;
+  using const_iterator = Iterator<const RingBuffer, const T>;
+
+  RingBuffer();
 
   void write(T val);
   const T last() const;
+  // Up to the n newest entries, oldest first
+  std::vector<T> lastN(size_t n) const;
   bool empty() const;
   iterator begin();
   iterator end();
@@ -30,7 +79,13 @@ class RingBuffer {
   size_t maxSize() const;
 
  private:
-  std::list<T> buf;
+  // The i-th oldest entry
+  T& at(size_t i);
+  const T& at(size_t i) const;
+
+  std::vector<T> buf;
+  // Index of the oldest entry, once the buffer is full
+  size_t head{0};
 };
 
 } // namespace facebook::fboss
@@ -17,21 +17,21 @@ using namespace std::chrono;
 
 template <size_t intervalSeconds, size_t timespanSeconds>
 SnapshotManager<intervalSeconds, timespanSeconds>::SnapshotManager(
-    std::set<std::string> portNames)
-    : portNames_(portNames) {}
+    std::set<std::string> portNames,
+    std::shared_ptr<SnapshotStore> store)
+    : portNames_(portNames), store_(std::move(store)) {}
 
 template <size_t intervalSeconds, size_t timespanSeconds>
 void SnapshotManager<intervalSeconds, timespanSeconds>::addSnapshot(
     LinkSnapshot val) {
-  auto snapshot = SnapshotWrapper(val);
-  buf_.write(snapshot);
+  auto snapshot = SnapshotWrapper(std::move(val));
 
+  // Publish before buffering, so that the buffered copy is marked published
   if (numSnapshotsToPublish_ > 0) {
-    snapshot.publish(portNames_);
-  }
-  if (numSnapshotsToPublish_ > 0) {
+    snapshot.publish(portNames_, store_.get());
     numSnapshotsToPublish_--;
   }
+  buf_.write(std::move(snapshot));
 }
 
 template <size_t intervalSeconds, size_t timespanSeconds>
@@ -45,8 +45,19 @@ SnapshotManager<intervalSeconds, timespanSeconds>::getSnapshots() const {
 template <size_t intervalSeconds, size_t timespanSeconds>
 void SnapshotManager<intervalSeconds, timespanSeconds>::publishAllSnapshots() {
   for (auto& snapshot : buf_) {
-    snapshot.publish(portNames_);
+    snapshot.publish(portNames_, store_.get());
+  }
+}
+
+template <size_t intervalSeconds, size_t timespanSeconds>
+std::vector<LinkSnapshot>
+SnapshotManager<intervalSeconds, timespanSeconds>::getLastSnapshots(
+    size_t n) const {
+  std::vector<LinkSnapshot> snapshots;
+  for (auto& snapshot : buf_.lastN(n)) {
+    snapshots.push_back(std::move(snapshot.snapshot_));
   }
+  return snapshots;
 }
 
 template <size_t intervalSeconds, size_t timespanSeconds>
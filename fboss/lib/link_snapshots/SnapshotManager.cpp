@@ -16,16 +16,22 @@ using namespace std::chrono;
 
 namespace facebook::fboss {
 
-void SnapshotWrapper::publish(const std::set<std::string>& portNames) {
-  auto serializedSnapshot =
-      apache::thrift::SimpleJSONSerializer::serialize<std::string>(snapshot_);
+void SnapshotWrapper::publish(
+    const std::set<std::string>& portNames,
+    SnapshotStore* store) {
   if (!published_) {
+    auto serializedSnapshot =
+        apache::thrift::SimpleJSONSerializer::serialize<std::string>(
+            snapshot_);
     std::stringstream log;
     log << LinkSnapshotAlert() << "Collected snapshot for ports ";
     for (const auto& port : portNames) {
       log << PortParam(port);
     }
     XLOG(DBG2) << log.str() << " " << LinkSnapshotParam(serializedSnapshot);
+    if (store) {
+      store->addSnapshot(portNames, snapshot_);
+    }
     published_ = true;
   }
 }
@@ -12,8 +12,10 @@
 #include <stddef.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 #include <chrono>
-#include <list>
+#include <memory>
+#include <vector>
 #include "fboss/lib/link_snapshots/RingBuffer-defs.h"
+#include "fboss/lib/link_snapshots/SnapshotStore.h"
 #include "fboss/lib/phy/gen-cpp2/phy_types.h"
 #include "folly/logging/xlog.h"
 
@@ -26,8 +28,12 @@ using namespace fboss::phy;
 
 class SnapshotWrapper {
  public:
-  explicit SnapshotWrapper(LinkSnapshot snapshot) : snapshot_(snapshot) {}
-  void publish(const std::set<std::string>& portNames);
+  explicit SnapshotWrapper(LinkSnapshot snapshot)
+      : snapshot_(std::move(snapshot)) {}
+  // Logs the snapshot, and persists it if a store is given
+  void publish(
+      const std::set<std::string>& portNames,
+      SnapshotStore* store = nullptr);
 
   LinkSnapshot snapshot_;
   bool published_{false};
@@ -49,10 +55,14 @@ class SnapshotManager {
  public:
   static constexpr size_t length = timespanSeconds / intervalSeconds + 1;
 
-  explicit SnapshotManager(std::set<std::string> portNames);
+  explicit SnapshotManager(
+      std::set<std::string> portNames,
+      std::shared_ptr<SnapshotStore> store = nullptr);
   void addSnapshot(LinkSnapshot val);
   void publishAllSnapshots();
   const RingBuffer<SnapshotWrapper, length>& getSnapshots() const;
+  // Up to the n newest snapshots, oldest first
+  std::vector<LinkSnapshot> getLastSnapshots(size_t n) const;
   void publishFutureSnapshots(int numToPublish);
   void publishFutureSnapshots() {
     publishFutureSnapshots(length);
@@ -64,6 +74,8 @@ class SnapshotManager {
   RingBuffer<SnapshotWrapper, length> buf_;
   int numSnapshotsToPublish_{0};
   std::set<std::string> portNames_;
+  // Published snapshots are persisted here, if set
+  std::shared_ptr<SnapshotStore> store_;
 };
 
 } // namespace facebook::fboss
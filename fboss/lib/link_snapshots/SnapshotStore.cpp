@@ -0,0 +1,198 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/link_snapshots/SnapshotStore.h"
+
+#include <fcntl.h>
+#include <folly/Exception.h>
+#include <folly/ExceptionString.h>
+#include <folly/File.h>
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <folly/logging/xlog.h>
+#include <sys/stat.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include "fboss/agent/FbossError.h"
+
+namespace {
+constexpr uint32_t kMagic = 0x4c534e50; // "LSNP"
+constexpr uint32_t kVersion = 1;
+
+struct FileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t numSlots;
+  uint64_t slotSize;
+};
+} // namespace
+
+namespace facebook::fboss {
+
+struct SnapshotStore::SlotHeader {
+  // 0 for an empty or partially written slot
+  uint64_t sequence;
+  uint32_t portNamesLength;
+  uint32_t snapshotLength;
+};
+
+SnapshotStore::SnapshotStore(
+    std::string path,
+    size_t numSlots,
+    size_t slotSize)
+    : path_(std::move(path)), numSlots_(numSlots), slotSize_(slotSize) {
+  if (numSlots_ == 0 || slotSize_ <= sizeof(SlotHeader) ||
+      slotSize_ % alignof(SlotHeader) != 0) {
+    throw FbossError(
+        "Invalid link snapshot store layout: ",
+        numSlots_,
+        " slots of ",
+        slotSize_,
+        " bytes");
+  }
+}
+
+void SnapshotStore::openLocked() {
+  if (mapping_) {
+    return;
+  }
+  auto fileSize = sizeof(FileHeader) + numSlots_ * slotSize_;
+  folly::File file(path_, O_RDWR | O_CREAT | O_CLOEXEC);
+
+  bool valid = false;
+  FileHeader header;
+  struct stat st;
+  folly::checkUnixError(fstat(file.fd(), &st), "Failed to stat ", path_);
+  if (static_cast<size_t>(st.st_size) == fileSize &&
+      folly::preadFull(file.fd(), &header, sizeof(header), 0) ==
+          sizeof(header)) {
+    valid = header.magic == kMagic && header.version == kVersion &&
+        header.numSlots == numSlots_ && header.slotSize == slotSize_;
+  }
+  if (!valid) {
+    XLOG(INFO) << "Resetting link snapshot store " << path_;
+    // Truncating first zeroes out every slot. The blocks are allocated up
+    // front so that a full disk fails here rather than with a SIGBUS on a
+    // write to the mapping.
+    folly::checkUnixError(
+        ftruncate(file.fd(), 0), "Failed to truncate ", path_);
+    if (auto err = posix_fallocate(file.fd(), 0, fileSize)) {
+      folly::throwSystemErrorExplicit(err, "Failed to allocate ", path_);
+    }
+    header = FileHeader{kMagic, kVersion, numSlots_, slotSize_};
+    folly::checkUnixError(
+        folly::pwriteFull(file.fd(), &header, sizeof(header), 0),
+        "Failed to write header of ",
+        path_);
+  }
+
+  mapping_ = std::make_unique<folly::MemoryMapping>(
+      std::move(file),
+      0,
+      fileSize,
+      folly::MemoryMapping::Options().setWritable(true).setShared(true));
+
+  lastSequence_ = 0;
+  for (size_t i = 0; i < numSlots_; i++) {
+    lastSequence_ = std::max(lastSequence_, slotLocked(i)->sequence);
+  }
+}
+
+SnapshotStore::SlotHeader* SnapshotStore::slotLocked(size_t index) {
+  auto data = mapping_->writableRange().data();
+  return reinterpret_cast<SlotHeader*>(
+      data + sizeof(FileHeader) + index * slotSize_);
+}
+
+bool SnapshotStore::addSnapshot(
+    const std::set<std::string>& portNames,
+    const phy::LinkSnapshot& snapshot) {
+  auto ports = folly::join(",", portNames);
+  auto serialized =
+      apache::thrift::CompactSerializer::serialize<std::string>(snapshot);
+
+  std::lock_guard<std::mutex> g(mutex_);
+  if (sizeof(SlotHeader) + ports.size() + serialized.size() > slotSize_) {
+    XLOG(WARN) << "Link snapshot of " << serialized.size()
+               << " bytes for ports " << ports << " does not fit in "
+               << slotSize_ << " byte slots of " << path_;
+    numDropped_++;
+    return false;
+  }
+  try {
+    openLocked();
+  } catch (const std::exception& ex) {
+    XLOG(ERR) << "Failed to open link snapshot store " << path_ << ": "
+              << folly::exceptionStr(ex);
+    numDropped_++;
+    return false;
+  }
+
+  auto sequence = ++lastSequence_;
+  auto slot = slotLocked((sequence - 1) % numSlots_);
+  slot->sequence = 0;
+  slot->portNamesLength = ports.size();
+  slot->snapshotLength = serialized.size();
+  auto data = reinterpret_cast<char*>(slot + 1);
+  std::memcpy(data, ports.data(), ports.size());
+  std::memcpy(data + ports.size(), serialized.data(), serialized.size());
+  std::atomic_thread_fence(std::memory_order_release);
+  slot->sequence = sequence;
+  return true;
+}
+
+std::vector<phy::LinkSnapshot> SnapshotStore::getLastSnapshots(
+    const std::string& portName,
+    size_t n) {
+  std::lock_guard<std::mutex> g(mutex_);
+  try {
+    openLocked();
+  } catch (const std::exception& ex) {
+    XLOG(ERR) << "Failed to open link snapshot store " << path_ << ": "
+              << folly::exceptionStr(ex);
+    return {};
+  }
+
+  // Walk back from the newest slot
+  std::vector<phy::LinkSnapshot> snapshots;
+  auto count = std::min<uint64_t>(lastSequence_, numSlots_);
+  for (uint64_t i = 0; i < count && snapshots.size() < n; i++) {
+    auto sequence = lastSequence_ - i;
+    auto slot = slotLocked((sequence - 1) % numSlots_);
+    if (slot->sequence != sequence ||
+        sizeof(SlotHeader) + slot->portNamesLength + slot->snapshotLength >
+            slotSize_) {
+      continue;
+    }
+    auto data = reinterpret_cast<const char*>(slot + 1);
+    std::vector<folly::StringPiece> ports;
+    folly::split(
+        ",", folly::StringPiece(data, slot->portNamesLength), ports);
+    if (std::find(ports.begin(), ports.end(), portName) == ports.end()) {
+      continue;
+    }
+    snapshots.push_back(
+        apache::thrift::CompactSerializer::deserialize<phy::LinkSnapshot>(
+            folly::StringPiece(
+                data + slot->portNamesLength, slot->snapshotLength)));
+  }
+  std::reverse(snapshots.begin(), snapshots.end());
+  return snapshots;
+}
+
+size_t SnapshotStore::numDropped() const {
+  std::lock_guard<std::mutex> g(mutex_);
+  return numDropped_;
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <stddef.h>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <folly/system/MemoryMapping.h>
+#include "fboss/lib/phy/gen-cpp2/phy_types.h"
+
+namespace facebook::fboss {
+
+/*
+ * Published link snapshots, kept in a memory mapped file so they survive
+ * restarts.
+ *
+ * The file is a ring of numSlots fixed size slots shared by all ports. Each
+ * slot holds one compact serialized snapshot along with the names of the
+ * ports it was collected for, and snapshots too large for a slot are
+ * dropped. A slot's sequence number is written last, so a slot left half
+ * written by a crash is ignored. The file is reset if its layout doesn't
+ * match numSlots and slotSize.
+ *
+ * The file is opened on first use, as its directory may not exist yet when
+ * the store is created.
+ */
+class SnapshotStore {
+ public:
+  static constexpr size_t kDefaultNumSlots = 4096;
+  static constexpr size_t kDefaultSlotSize = 16 * 1024;
+
+  explicit SnapshotStore(
+      std::string path,
+      size_t numSlots = kDefaultNumSlots,
+      size_t slotSize = kDefaultSlotSize);
+
+  /*
+   * Persist a snapshot collected for portNames. Returns false if it was too
+   * large to store or the file could not be opened, in which case it is
+   * counted as dropped.
+   */
+  bool addSnapshot(
+      const std::set<std::string>& portNames,
+      const phy::LinkSnapshot& snapshot);
+
+  // Up to the n newest snapshots stored for portName, oldest first. Empty if
+  // the file could not be opened.
+  std::vector<phy::LinkSnapshot> getLastSnapshots(
+      const std::string& portName,
+      size_t n);
+
+  size_t numDropped() const;
+
+ private:
+  struct SlotHeader;
+
+  void openLocked();
+  SlotHeader* slotLocked(size_t index);
+
+  const std::string path_;
+  const size_t numSlots_;
+  const size_t slotSize_;
+
+  mutable std::mutex mutex_;
+  std::unique_ptr<folly::MemoryMapping> mapping_;
+  uint64_t lastSequence_{0};
+  size_t numDropped_{0};
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/link_snapshots/RingBuffer-defs.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+
+namespace {
+
+// Snapshots aren't default constructible either
+struct Entry {
+  explicit Entry(int value) : value(value) {}
+  int value;
+};
+
+template <typename Ring>
+std::vector<int> values(const Ring& ring) {
+  std::vector<int> result;
+  for (const auto& entry : ring) {
+    result.push_back(entry.value);
+  }
+  return result;
+}
+
+} // namespace
+
+TEST(RingBufferTest, empty) {
+  RingBuffer<Entry, 3> ring;
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(ring.size(), 0);
+  EXPECT_EQ(ring.maxSize(), 3);
+  EXPECT_EQ(ring.begin(), ring.end());
+  EXPECT_THROW(ring.last(), FbossError);
+  EXPECT_TRUE(ring.lastN(2).empty());
+}
+
+TEST(RingBufferTest, overwriteOldest) {
+  RingBuffer<Entry, 3> ring;
+  ring.write(Entry(1));
+  ring.write(Entry(2));
+  EXPECT_EQ(values(ring), std::vector<int>({1, 2}));
+
+  for (int i = 3; i <= 7; i++) {
+    ring.write(Entry(i));
+    EXPECT_EQ(ring.size(), 3);
+    EXPECT_EQ(ring.last().value, i);
+  }
+  EXPECT_EQ(values(ring), std::vector<int>({5, 6, 7}));
+
+  // Entries are updated in place
+  for (auto& entry : ring) {
+    entry.value *= 10;
+  }
+  EXPECT_EQ(values(ring), std::vector<int>({50, 60, 70}));
+}
+
+TEST(RingBufferTest, lastN) {
+  RingBuffer<Entry, 4> ring;
+  for (int i = 1; i <= 6; i++) {
+    ring.write(Entry(i));
+  }
+  EXPECT_EQ(values(ring.lastN(2)), std::vector<int>({5, 6}));
+  EXPECT_EQ(values(ring.lastN(10)), std::vector<int>({3, 4, 5, 6}));
+  EXPECT_TRUE(ring.lastN(0).empty());
+}
+
+TEST(RingBufferTest, copy) {
+  RingBuffer<Entry, 2> ring;
+  ring.write(Entry(1));
+  ring.write(Entry(2));
+  auto copy = ring;
+  copy.write(Entry(3));
+  EXPECT_EQ(values(ring), std::vector<int>({1, 2}));
+  EXPECT_EQ(values(copy), std::vector<int>({2, 3}));
+}
@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/link_snapshots/SnapshotStore.h"
+
+#include <folly/FileUtil.h>
+#include <folly/experimental/TestUtil.h>
+#include <gtest/gtest.h>
+#include "fboss/lib/link_snapshots/SnapshotManager-defs.h"
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr size_t kNumSlots = 8;
+constexpr size_t kSlotSize = 1024;
+
+phy::LinkSnapshot makeSnapshot(const std::string& portName, int32_t time) {
+  phy::PhyInfo phyInfo;
+  phyInfo.name_ref() = portName;
+  phyInfo.timeCollected_ref() = time;
+  phy::LinkSnapshot snapshot;
+  snapshot.phyInfo_ref() = phyInfo;
+  return snapshot;
+}
+
+std::vector<int32_t> times(const std::vector<phy::LinkSnapshot>& snapshots) {
+  std::vector<int32_t> result;
+  for (const auto& snapshot : snapshots) {
+    result.push_back(*snapshot.get_phyInfo().timeCollected_ref());
+  }
+  return result;
+}
+
+} // namespace
+
+class SnapshotStoreTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<SnapshotStore> makeStore(size_t numSlots = kNumSlots) {
+    return std::make_unique<SnapshotStore>(path_, numSlots, kSlotSize);
+  }
+
+  folly::test::TemporaryDirectory dir_;
+  std::string path_ = (dir_.path() / "snapshots").string();
+};
+
+TEST_F(SnapshotStoreTest, lastSnapshotsPerPort) {
+  auto store = makeStore();
+  EXPECT_TRUE(store->getLastSnapshots("eth1/1/1", 10).empty());
+
+  for (int i = 1; i <= 3; i++) {
+    EXPECT_TRUE(
+        store->addSnapshot({"eth1/1/1"}, makeSnapshot("eth1/1/1", 100 + i)));
+    EXPECT_TRUE(
+        store->addSnapshot({"eth1/2/1"}, makeSnapshot("eth1/2/1", 200 + i)));
+  }
+  EXPECT_EQ(
+      times(store->getLastSnapshots("eth1/1/1", 10)),
+      std::vector<int32_t>({101, 102, 103}));
+  EXPECT_EQ(
+      times(store->getLastSnapshots("eth1/2/1", 2)),
+      std::vector<int32_t>({202, 203}));
+  EXPECT_TRUE(store->getLastSnapshots("eth1/3/1", 10).empty());
+}
+
+TEST_F(SnapshotStoreTest, multiPortSnapshot) {
+  auto store = makeStore();
+  store->addSnapshot({"eth1/1/1", "eth1/1/2"}, makeSnapshot("eth1/1/1", 1));
+  EXPECT_EQ(store->getLastSnapshots("eth1/1/1", 10).size(), 1);
+  EXPECT_EQ(store->getLastSnapshots("eth1/1/2", 10).size(), 1);
+  EXPECT_TRUE(store->getLastSnapshots("eth1/1", 10).empty());
+}
+
+TEST_F(SnapshotStoreTest, wrapAround) {
+  auto store = makeStore();
+  for (size_t i = 1; i <= 3 * kNumSlots; i++) {
+    store->addSnapshot({"eth1/1/1"}, makeSnapshot("eth1/1/1", i));
+  }
+  auto snapshots = store->getLastSnapshots("eth1/1/1", 100);
+  ASSERT_EQ(snapshots.size(), kNumSlots);
+  EXPECT_EQ(*snapshots.front().get_phyInfo().timeCollected_ref(), 17);
+  EXPECT_EQ(*snapshots.back().get_phyInfo().timeCollected_ref(), 24);
+}
+
+TEST_F(SnapshotStoreTest, survivesRestart) {
+  auto store = makeStore();
+  for (size_t i = 1; i <= kNumSlots + 2; i++) {
+    store->addSnapshot({"eth1/1/1"}, makeSnapshot("eth1/1/1", i));
+  }
+  store.reset();
+
+  store = makeStore();
+  EXPECT_EQ(
+      times(store->getLastSnapshots("eth1/1/1", 2)),
+      std::vector<int32_t>({9, 10}));
+  // New snapshots carry on after the old ones
+  store->addSnapshot({"eth1/1/1"}, makeSnapshot("eth1/1/1", 11));
+  EXPECT_EQ(
+      times(store->getLastSnapshots("eth1/1/1", 3)),
+      std::vector<int32_t>({9, 10, 11}));
+
+  // A different layout starts over
+  store = makeStore(kNumSlots * 2);
+  EXPECT_TRUE(store->getLastSnapshots("eth1/1/1", 10).empty());
+}
+
+TEST_F(SnapshotStoreTest, corruptFile) {
+  folly::writeFile(std::string("not a snapshot store"), path_.c_str());
+  auto store = makeStore();
+  EXPECT_TRUE(store->getLastSnapshots("eth1/1/1", 10).empty());
+  store->addSnapshot({"eth1/1/1"}, makeSnapshot("eth1/1/1", 1));
+  EXPECT_EQ(store->getLastSnapshots("eth1/1/1", 10).size(), 1);
+}
+
+TEST_F(SnapshotStoreTest, snapshotTooLarge) {
+  auto store = makeStore();
+  EXPECT_FALSE(store->addSnapshot(
+      {"eth1/1/1"}, makeSnapshot(std::string(kSlotSize, 'x'), 1)));
+  EXPECT_EQ(store->numDropped(), 1);
+  EXPECT_TRUE(store->getLastSnapshots("eth1/1/1", 10).empty());
+}
+
+TEST_F(SnapshotStoreTest, publishedSnapshotsArePersisted) {
+  auto store = std::shared_ptr<SnapshotStore>(makeStore());
+  SnapshotManager<1, 3> manager({"eth1/1/1"}, store);
+  for (int i = 1; i <= 6; i++) {
+    manager.addSnapshot(makeSnapshot("eth1/1/1", i));
+  }
+  EXPECT_EQ(times(manager.getLastSnapshots(2)), std::vector<int32_t>({5, 6}));
+  // Only published snapshots are persisted
+  EXPECT_TRUE(store->getLastSnapshots("eth1/1/1", 10).empty());
+
+  manager.publishAllSnapshots();
+  manager.publishFutureSnapshots(1);
+  manager.addSnapshot(makeSnapshot("eth1/1/1", 7));
+  manager.addSnapshot(makeSnapshot("eth1/1/1", 8));
+  // Publishing again doesn't store the same snapshots twice
+  manager.publishAllSnapshots();
+  EXPECT_EQ(
+      times(store->getLastSnapshots("eth1/1/1", 10)),
+      std::vector<int32_t>({3, 4, 5, 6, 7, 8}));
+}
+
+TEST_F(SnapshotStoreTest, unopenableFile) {
+  auto store = std::make_shared<SnapshotStore>(
+      (dir_.path() / "missing" / "snapshots").string(), kNumSlots, kSlotSize);
+  EXPECT_FALSE(store->addSnapshot({"eth1/1/1"}, makeSnapshot("eth1/1/1", 1)));
+  EXPECT_EQ(store->numDropped(), 1);
+  EXPECT_TRUE(store->getLastSnapshots("eth1/1/1", 10).empty());
+
+  // Publishing still marks the snapshots published, and they are kept in
+  // memory
+  SnapshotManager<1, 3> manager({"eth1/1/1"}, store);
+  manager.addSnapshot(makeSnapshot("eth1/1/1", 2));
+  manager.publishAllSnapshots();
+  EXPECT_TRUE(manager.getSnapshots().last().published_);
+  EXPECT_EQ(store->numDropped(), 2);
+  EXPECT_EQ(times(manager.getLastSnapshots(10)), std::vector<int32_t>({2}));
+}
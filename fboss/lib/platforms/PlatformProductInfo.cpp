@@ -146,6 +146,8 @@ void PlatformProductInfo::initMode() {
       mode_ = PlatformMode::YAMP;
     } else if (FLAGS_mode == "fake_wedge40") {
       mode_ = PlatformMode::FAKE_WEDGE40;
+    } else if (FLAGS_mode == "fake_wedge") {
+      mode_ = PlatformMode::FAKE_WEDGE;
     } else if (FLAGS_mode == "wedge400") {
       mode_ = PlatformMode::WEDGE400;
     } else if (FLAGS_mode == "fuji") {
@@ -250,3 +250,30 @@ TEST(RefMap, UnorderedRefMapRefCountTest) {
   }
   EXPECT_EQ(refMap.referenceCount(101), 0);
 }
+
+TEST(RefMap, F14NodeRefMapRefCountTest) {
+  F14NodeRefMap<int, A> refMap;
+  EXPECT_EQ(refMap.referenceCount(101), 0);
+  {
+    auto x = refMap.refOrEmplace(101, 1);
+    EXPECT_EQ(refMap.referenceCount(101), 1);
+    {
+      auto y = refMap.refOrEmplace(101, 1);
+      EXPECT_EQ(refMap.referenceCount(101), 2);
+    }
+    EXPECT_EQ(refMap.referenceCount(101), 1);
+  }
+  EXPECT_EQ(refMap.referenceCount(101), 0);
+  EXPECT_EQ(refMap.size(), 0);
+}
+
+TEST(RefMap, releaseAfterClear) {
+  F14NodeRefMap<int, A> refMap;
+  auto a1 = refMap.refOrEmplace(42, 42).first;
+  refMap.clear();
+  // a value outliving its entry must not take a new entry with it
+  auto a2 = refMap.refOrEmplace(42, 420).first;
+  a1.reset();
+  EXPECT_EQ(refMap.size(), 1);
+  EXPECT_EQ(refMap.get(42)->x, 420);
+}
@@ -9,6 +9,7 @@
  */
 
 #include <folly/Benchmark.h>
+#include <folly/FileUtil.h>
 #include <folly/dynamic.h>
 #include <folly/init/Init.h>
 #include <folly/json.h>
@@ -29,6 +30,13 @@ DEFINE_bool(
     false,
     "Set to true will prepare the device for warmboot");
 
+DEFINE_string(
+    rusage_json_file,
+    "",
+    "Write the rusage summary to this file instead of stdout. Combined with "
+    "--json this keeps stdout parseable as the folly benchmark results, so "
+    "runs can be compared across commits");
+
 inline int64_t timevalToUsec(const timeval& tv) {
   return (int64_t(tv.tv_sec) * kUsecPerSecond) + tv.tv_usec;
 }
@@ -46,11 +54,17 @@ int main(int argc, char* argv[]) {
   getrusage(RUSAGE_SELF, &endUsage);
   auto cpuTime =
       (timevalToUsec(endUsage.ru_stime) - timevalToUsec(startUsage.ru_stime)) +
-      (timevalToUsec(endUsage.ru_utime) - timevalToUsec(endUsage.ru_utime));
+      (timevalToUsec(endUsage.ru_utime) - timevalToUsec(startUsage.ru_utime));
 
   folly::dynamic rusageJson = folly::dynamic::object;
   rusageJson["cpu_time_usec"] = cpuTime;
   rusageJson["max_rss"] = endUsage.ru_maxrss;
-  std::cout << toPrettyJson(rusageJson) << std::endl;
+  if (FLAGS_rusage_json_file.empty()) {
+    std::cout << toPrettyJson(rusageJson) << std::endl;
+  } else if (!folly::writeFile(
+                 toPrettyJson(rusageJson), FLAGS_rusage_json_file.c_str())) {
+    std::cerr << "Failed to write " << FLAGS_rusage_json_file << std::endl;
+    return 1;
+  }
   return 0;
 }
@@ -1,5 +1,6 @@
 // Copyright 2021-present Facebook. All Rights Reserved.
 #include "ModbusDevice.h"
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include "Log.h"
@@ -23,6 +24,8 @@ ModbusDevice::ModbusDevice(
   info_.deviceAddress = deviceAddress;
   info_.baudrate = registerMap.defaultBaudrate;
   info_.deviceType = registerMap.name;
+  maxReadGap_ = registerMap.maxReadGap;
+  maxReadLength_ = registerMap.maxReadLength;
 
   for (auto& it : registerMap.registerDescriptors) {
     info_.registerList.emplace_back(it.second);
@@ -103,6 +106,114 @@ void ModbusDevice::readFileRecord(
   command(req, resp, timeout);
 }
 
+void ModbusDevice::storeRegister(
+    RegisterStore& registerStore,
+    const Register& prevRegister,
+    uint32_t timestamp) {
+  auto& nextRegister = registerStore.front();
+  nextRegister.timestamp = timestamp;
+  bool changed = nextRegister != prevRegister;
+  // If we dont care about changes or if we do
+  // and we notice that the value is different
+  // from the previous, increment store to
+  // point to the next.
+  if (!nextRegister.desc.storeChangesOnly || changed) {
+    ++registerStore;
+  }
+  registerStore.scheduleNextPoll(timestamp, changed);
+}
+
+void ModbusDevice::reloadRegister(
+    RegisterStore& registerStore,
+    uint32_t timestamp) {
+  uint16_t registerOffset = registerStore.regAddr();
+  auto& nextRegister = registerStore.front();
+  // With a keep of 1, front and back are the same register, so the read
+  // overwrites the previous value.
+  Register prevRegister = registerStore.back();
+  try {
+    readHoldingRegisters(registerOffset, nextRegister.value);
+    storeRegister(registerStore, prevRegister, timestamp);
+  } catch (ModbusError& e) {
+    logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
+            << " ReadReg 0x" << std::hex << registerOffset << ' '
+            << registerStore.name() << " caught: " << e.what() << std::endl;
+    if (e.errorCode == ModbusErrorCode::ILLEGAL_DATA_ADDRESS) {
+      logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
+              << " ReadReg 0x" << std::hex << registerOffset << ' '
+              << registerStore.name()
+              << " unsupported. Disabled from monitoring" << std::endl;
+      registerStore.disable();
+    } else {
+      logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
+              << " ReadReg 0x" << std::hex << registerOffset << ' '
+              << registerStore.name() << " caught: " << e.what() << std::endl;
+    }
+  } catch (std::exception& e) {
+    logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
+            << " ReadReg 0x" << std::hex << registerOffset << ' '
+            << registerStore.name() << " caught: " << e.what() << std::endl;
+  }
+}
+
+void ModbusDevice::reloadRegisterSpan(
+    const std::vector<RegisterStore*>& span,
+    uint16_t begin,
+    uint32_t end,
+    uint32_t timestamp) {
+  if (span.size() == 1) {
+    reloadRegister(*span.front(), timestamp);
+    return;
+  }
+  std::vector<uint16_t> values(end - begin);
+  try {
+    readHoldingRegisters(begin, values);
+  } catch (ModbusError& e) {
+    logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
+            << " ReadRegs 0x" << std::hex << begin << "-0x" << end
+            << " caught: " << e.what() << std::endl;
+    if (e.errorCode != ModbusErrorCode::ILLEGAL_DATA_ADDRESS) {
+      // Transient, such as a busy device. The registers are still due,
+      // so the span is retried on the next cycle.
+      return;
+    }
+    // Either one of the registers or one in the gaps between them is
+    // not supported. Read them one at a time, which disables the
+    // unsupported ones. If none was, the gaps are at fault, so stop
+    // reading across them.
+    bool anyDisabled = false;
+    for (auto* registerStore : span) {
+      reloadRegister(*registerStore, timestamp);
+      anyDisabled |= !registerStore->isEnabled();
+    }
+    if (!anyDisabled) {
+      uint32_t prevEnd = begin;
+      for (auto* registerStore : span) {
+        if (registerStore->regAddr() > prevEnd) {
+          spanStarts_.insert(registerStore->regAddr());
+        }
+        prevEnd = std::max<uint32_t>(
+            prevEnd, registerStore->regAddr() + registerStore->length());
+      }
+    }
+    return;
+  } catch (std::exception& e) {
+    logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
+            << " ReadRegs 0x" << std::hex << begin << "-0x" << end
+            << " caught: " << e.what() << std::endl;
+    return;
+  }
+  for (auto* registerStore : span) {
+    Register prevRegister = registerStore->back();
+    auto first = values.begin() + (registerStore->regAddr() - begin);
+    std::copy(
+        first,
+        first + registerStore->length(),
+        registerStore->front().value.begin());
+    storeRegister(*registerStore, prevRegister, timestamp);
+  }
+}
+
 void ModbusDevice::monitor() {
   // If the number of consecutive failures has exceeded
   // a threshold, mark the device as dormant.
@@ -111,45 +222,34 @@ void ModbusDevice::monitor() {
     specialHandler.handle(*this);
   }
   std::unique_lock lk(registerListMutex_);
+  // Coalesce due registers close enough to each other into spans,
+  // each read in a single transaction. The register list is sorted
+  // by address.
+  std::vector<RegisterStore*> span;
+  uint16_t spanBegin = 0;
+  uint32_t spanEnd = 0;
   for (auto& registerStore : info_.registerList) {
-    uint16_t registerOffset = registerStore.regAddr();
-    auto& nextRegister = registerStore.front();
-    if (!registerStore.isEnabled()) {
+    if (!registerStore.isEnabled() || !registerStore.isDue(timestamp)) {
       continue;
     }
-    try {
-      readHoldingRegisters(registerOffset, nextRegister.value);
-      nextRegister.timestamp = timestamp;
-      // If we dont care about changes or if we do
-      // and we notice that the value is different
-      // from the previous, increment store to
-      // point to the next.
-      if (!nextRegister.desc.storeChangesOnly ||
-          nextRegister != registerStore.back()) {
-        ++registerStore;
-      }
-    } catch (ModbusError& e) {
-      logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
-              << " ReadReg 0x" << std::hex << registerOffset << ' '
-              << registerStore.name() << " caught: " << e.what() << std::endl;
-      if (e.errorCode == ModbusErrorCode::ILLEGAL_DATA_ADDRESS) {
-        logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
-                << " ReadReg 0x" << std::hex << registerOffset << ' '
-                << registerStore.name()
-                << " unsupported. Disabled from monitoring" << std::endl;
-        registerStore.disable();
-      } else {
-        logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
-                << " ReadReg 0x" << std::hex << registerOffset << ' '
-                << registerStore.name() << " caught: " << e.what() << std::endl;
-      }
-      continue;
-    } catch (std::exception& e) {
-      logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
-              << " ReadReg 0x" << std::hex << registerOffset << ' '
-              << registerStore.name() << " caught: " << e.what() << std::endl;
+    uint16_t begin = registerStore.regAddr();
+    uint32_t end = begin + registerStore.length();
+    if (!span.empty() && begin <= spanEnd + maxReadGap_ &&
+        std::max(end, spanEnd) - spanBegin <= maxReadLength_ &&
+        spanStarts_.find(begin) == spanStarts_.end()) {
+      span.push_back(&registerStore);
+      spanEnd = std::max(end, spanEnd);
       continue;
     }
+    if (!span.empty()) {
+      reloadRegisterSpan(span, spanBegin, spanEnd, timestamp);
+    }
+    span = {&registerStore};
+    spanBegin = begin;
+    spanEnd = end;
+  }
+  if (!span.empty()) {
+    reloadRegisterSpan(span, spanBegin, spanEnd, timestamp);
   }
 }
 
@@ -162,6 +262,7 @@ void ModbusDevice::setActive() {
   for (auto& registerStore : info_.registerList) {
     registerStore.enable();
   }
+  spanStarts_.clear();
   // Clear the num failures so we consider it active.
   info_.numConsecutiveFailures = 0;
 }
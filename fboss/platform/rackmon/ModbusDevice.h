@@ -3,6 +3,7 @@
 #include <nlohmann/json.hpp>
 #include <ctime>
 #include <iostream>
+#include <set>
 #include "Modbus.h"
 #include "ModbusCmds.h"
 #include "Register.h"
@@ -78,6 +79,26 @@ class ModbusDevice {
   ModbusDeviceRawData info_;
   std::mutex registerListMutex_{};
   std::vector<ModbusSpecialHandler> specialHandlers_{};
+  uint16_t maxReadGap_ = 0;
+  uint16_t maxReadLength_ = RegisterMap::kMaxReadLength;
+  // Registers after a gap which failed to be read along with the
+  // registers before them. These always start a new span.
+  std::set<uint16_t> spanStarts_{};
+
+  // Read a single register range and store its value.
+  void reloadRegister(RegisterStore& registerStore, uint32_t timestamp);
+  // Read a span of register ranges [begin, end) in one transaction.
+  void reloadRegisterSpan(
+      const std::vector<RegisterStore*>& span,
+      uint16_t begin,
+      uint32_t end,
+      uint32_t timestamp);
+  // Store the value read into the front of registerStore, where
+  // prevRegister is a copy of the last value stored before the read.
+  void storeRegister(
+      RegisterStore& registerStore,
+      const Register& prevRegister,
+      uint32_t timestamp);
 
  public:
   ModbusDevice(
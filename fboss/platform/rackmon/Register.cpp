@@ -1,5 +1,6 @@
 // Copyright 2021-present Facebook. All Rights Reserved.
 #include "Register.h"
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <numeric>
@@ -234,6 +235,17 @@ Register::operator RegisterValue() const {
   return RegisterValue(value, desc, timestamp);
 }
 
+void RegisterStore::scheduleNextPoll(time_t now, bool changed) {
+  if (changed || desc_.maxInterval <= desc_.interval) {
+    pollInterval_ = desc_.interval;
+  } else {
+    // Back off registers which keep reading the same value.
+    pollInterval_ = std::min(
+        desc_.maxInterval, std::max<uint32_t>(pollInterval_ * 2, 1));
+  }
+  nextPollTime_ = now + pollInterval_;
+}
+
 RegisterStore::operator std::string() const {
   std::stringstream ss;
 
@@ -327,6 +339,8 @@ void from_json(const json& j, RegisterDescriptor& i) {
   i.storeChangesOnly = j.value("changes_only", false);
   i.endian = j.value("endian", RegisterEndian::BIG);
   i.format = j.value("format", RegisterValueType::HEX);
+  i.interval = j.value("interval", 0);
+  i.maxInterval = j.value("max_interval", i.interval);
   if (i.format == RegisterValueType::FLOAT) {
     j.at("precision").get_to(i.precision);
   } else if (i.format == RegisterValueType::FLAGS) {
@@ -347,6 +361,8 @@ void to_json(json& j, const RegisterDescriptor& i) {
   j["changes_only"] = i.storeChangesOnly;
   j["format"] = i.format;
   j["endian"] = i.endian;
+  j["interval"] = i.interval;
+  j["max_interval"] = i.maxInterval;
   if (i.format == RegisterValueType::FLOAT) {
     j["precision"] = i.precision;
   } else if (i.format == RegisterValueType::FLAGS) {
@@ -427,6 +443,13 @@ void from_json(const json& j, RegisterMap& m) {
   j.at("name").get_to(m.name);
   j.at("preferred_baudrate").get_to(m.preferredBaudrate);
   j.at("default_baudrate").get_to(m.defaultBaudrate);
+  m.maxReadGap = j.value("max_read_gap", 0);
+  m.maxReadLength = j.value("max_read_length", RegisterMap::kMaxReadLength);
+  if (m.maxReadLength == 0 || m.maxReadLength > RegisterMap::kMaxReadLength) {
+    throw std::out_of_range(
+        "max_read_length must be between 1 and " +
+        std::to_string(RegisterMap::kMaxReadLength));
+  }
   std::vector<RegisterDescriptor> tmp;
   j.at("registers").get_to(tmp);
   for (auto& i : tmp) {
@@ -442,6 +465,8 @@ void to_json(json& j, const RegisterMap& m) {
   j["name"] = m.name;
   j["preferred_baudrate"] = m.preferredBaudrate;
   j["default_baudrate"] = m.preferredBaudrate;
+  j["max_read_gap"] = m.maxReadGap;
+  j["max_read_length"] = m.maxReadLength;
   j["registers"] = {};
   std::transform(
       m.registerDescriptors.begin(),
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <nlohmann/json.hpp>
+#include <ctime>
 #include <map>
 #include <utility>
 #include <vector>
@@ -50,6 +51,16 @@ struct RegisterDescriptor {
 
   // If the register stores flags, this provides the desc.
   FlagsDescType flags{};
+
+  // Minimum time in seconds between reads of the register. Zero reads
+  // it on every monitor cycle.
+  uint32_t interval = 0;
+
+  // If larger than interval, the time between reads doubles every time
+  // the register is read back unchanged, up to maxInterval, and drops
+  // back to interval once it changes. Useful for registers which rarely
+  // change, such as FW versions.
+  uint32_t maxInterval = 0;
 };
 
 struct RegisterValue {
@@ -154,12 +165,16 @@ struct RegisterStore {
   std::vector<Register> history_;
   int32_t idx_ = 0;
   bool enabled_ = true;
+  // Polling schedule, see RegisterDescriptor::interval.
+  time_t nextPollTime_ = 0;
+  uint32_t pollInterval_;
 
  public:
   explicit RegisterStore(const RegisterDescriptor& desc)
       : desc_(desc),
         regAddr_(desc.begin),
-        history_(desc.keep, Register(desc)) {}
+        history_(desc.keep, Register(desc)),
+        pollInterval_(desc.interval) {}
 
   bool isEnabled() {
     return enabled_;
@@ -189,6 +204,20 @@ struct RegisterStore {
     return regAddr_;
   }
 
+  // Number of registers in the range
+  uint16_t length() const {
+    return desc_.length;
+  }
+
+  // Returns true if the register is due to be read at time now.
+  bool isDue(time_t now) const {
+    return now >= nextPollTime_;
+  }
+
+  // Schedule the next read after a read at time now, which returned
+  // a value different from the previous read if changed is set.
+  void scheduleNextPoll(time_t now, bool changed);
+
   const std::string& name() const {
     return desc_.name;
   }
@@ -239,11 +268,18 @@ struct AddrRange {
 // representation of each JSON register map descriptors
 // at /etc/rackmon.d.
 struct RegisterMap {
+  // Most registers a single read holding registers response fits.
+  static constexpr uint16_t kMaxReadLength = 124;
   AddrRange applicableAddresses;
   std::string name;
   uint8_t probeRegister;
   uint32_t defaultBaudrate;
   uint32_t preferredBaudrate;
+  // Monitored registers at most maxReadGap registers apart are read
+  // in a single transaction of up to maxReadLength registers, and the
+  // registers in between are discarded.
+  uint16_t maxReadGap = 0;
+  uint16_t maxReadLength = kMaxReadLength;
   std::vector<SpecialHandlerInfo> specialHandlers;
   std::map<uint16_t, RegisterDescriptor> registerDescriptors;
   const RegisterDescriptor& at(uint16_t reg) const {
@@ -3,6 +3,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <thread>
+#include "SimulatedUARTDevice.h"
 
 using namespace std;
 using namespace testing;
@@ -640,3 +641,151 @@ TEST(ModbusSpecialHandler, BasicHandlingIntegerOneShot) {
   std::this_thread::sleep_for(1s);
   special.handle(dev);
 }
+
+// Register map with registers 0-1, 2-3, 4, 10-11 and 20, where 20 is
+// only read every minute. The simulated device has no registers 5-9.
+class ModbusDeviceSpanTest : public ::testing::Test {
+ protected:
+  SimulatedModbus modbus;
+  RegisterMap regmap;
+  void SetUp() override {
+    regmap = R"({
+      "name": "orv3_psu",
+      "address_range": [110, 140],
+      "probe_register": 104,
+      "default_baudrate": 19200,
+      "preferred_baudrate": 19200,
+      "registers": [
+        {"begin": 0, "length": 2, "format": "string", "name": "MFG_MODEL"},
+        {"begin": 2, "length": 2, "format": "string", "name": "MFG_DATE"},
+        {"begin": 4, "length": 1, "format": "integer", "name": "STATUS"},
+        {"begin": 10, "length": 2, "format": "integer", "name": "POWER"},
+        {
+          "begin": 20,
+          "length": 1,
+          "format": "integer",
+          "name": "FW_VERSION",
+          "interval": 60
+        }
+      ]
+    })"_json;
+    modbus.bus().setRegisters(0x32, 0, {0x6162, 0x6364, 0x3230, 0x3232, 5});
+    modbus.bus().setRegisters(0x32, 10, {0, 1});
+    modbus.bus().setRegisters(0x32, 20, {3});
+  }
+
+  size_t transactionsPerPoll(ModbusDevice& dev) {
+    size_t before = modbus.bus().transactions();
+    dev.monitor();
+    return modbus.bus().transactions() - before;
+  }
+};
+
+TEST_F(ModbusDeviceSpanTest, AdjacentRegisters) {
+  ModbusDevice dev(modbus, 0x32, regmap);
+  // 0-4 in one read, 10-11 and 20 in one each
+  EXPECT_EQ(transactionsPerPoll(dev), 3);
+  // 20 is not due yet
+  EXPECT_EQ(transactionsPerPoll(dev), 2);
+
+  ModbusDeviceValueData data = dev.getValueData();
+  ASSERT_EQ(data.registerList.size(), 5);
+  EXPECT_EQ(data.registerList[0].history[0].value.strValue, "abcd");
+  EXPECT_EQ(data.registerList[1].history[0].value.strValue, "2022");
+  EXPECT_EQ(data.registerList[2].history[0].value.intValue, 5);
+  EXPECT_EQ(data.registerList[3].history[0].value.intValue, 1);
+  EXPECT_EQ(data.registerList[4].history[0].value.intValue, 3);
+}
+
+TEST_F(ModbusDeviceSpanTest, GapTolerance) {
+  regmap.maxReadGap = 5;
+  modbus.bus().setRegisters(0x32, 5, {0, 0, 0, 0, 0});
+  ModbusDevice dev(modbus, 0x32, regmap);
+  // 0-11 in one read, 20 is too far away
+  EXPECT_EQ(transactionsPerPoll(dev), 2);
+  EXPECT_EQ(transactionsPerPoll(dev), 1);
+  ModbusDeviceValueData data = dev.getValueData();
+  EXPECT_EQ(data.registerList[3].history[0].value.intValue, 1);
+}
+
+TEST_F(ModbusDeviceSpanTest, MaxReadLength) {
+  regmap.maxReadLength = 3;
+  ModbusDevice dev(modbus, 0x32, regmap);
+  // 0-1, 2-4, 10-11 and 20
+  EXPECT_EQ(transactionsPerPoll(dev), 4);
+}
+
+TEST_F(ModbusDeviceSpanTest, UnsupportedGap) {
+  // Registers 5-9 do not exist on the device.
+  regmap.maxReadGap = 5;
+  ModbusDevice dev(modbus, 0x32, regmap);
+  // The span fails, so its 4 registers are read one by one
+  EXPECT_EQ(transactionsPerPoll(dev), 6);
+  // and the gap is not read again, leaving 0-4 and 10-11
+  EXPECT_EQ(transactionsPerPoll(dev), 2);
+  ModbusDeviceValueData data = dev.getValueData();
+  EXPECT_EQ(data.registerList[3].history.size(), 1);
+  EXPECT_EQ(data.registerList[3].history[0].value.intValue, 1);
+  EXPECT_EQ(dev.getInfo().mode, ModbusDeviceMode::ACTIVE);
+}
+
+TEST_F(ModbusDeviceSpanTest, UnsupportedRegister) {
+  SimulatedModbus modbus2;
+  modbus2.bus().setRegisters(0x32, 0, {0x6162, 0x6364});
+  modbus2.bus().setRegisters(0x32, 4, {5});
+  ModbusDevice dev2(modbus2, 0x32, regmap);
+  // 0-4 fails and is read one at a time, disabling 2-3.
+  // 10-11 and 20 fail on their own.
+  size_t before = modbus2.bus().transactions();
+  dev2.monitor();
+  EXPECT_EQ(modbus2.bus().transactions() - before, 6);
+  // Only 0-1 and 4 are left, read separately as 2-3 is now a gap.
+  before = modbus2.bus().transactions();
+  dev2.monitor();
+  EXPECT_EQ(modbus2.bus().transactions() - before, 2);
+}
+
+TEST_F(ModbusDeviceSpanTest, BusyDevice) {
+  regmap.maxReadGap = 5;
+  modbus.bus().setRegisters(0x32, 5, {0, 0, 0, 0, 0});
+  ModbusDevice dev(modbus, 0x32, regmap);
+  modbus.bus().failNext(ModbusErrorCode::SLAVE_DEVICE_BUSY);
+  // The failed span is not split up, and 20 is read on its own
+  EXPECT_EQ(transactionsPerPoll(dev), 2);
+  // 0-11 is retried as a whole
+  EXPECT_EQ(transactionsPerPoll(dev), 1);
+  ModbusDeviceValueData data = dev.getValueData();
+  EXPECT_EQ(data.registerList[3].history[0].value.intValue, 1);
+}
+
+TEST_F(ModbusDeviceSpanTest, ChangedValueResetsInterval) {
+  regmap = R"({
+    "name": "orv3_psu",
+    "address_range": [110, 140],
+    "probe_register": 104,
+    "default_baudrate": 19200,
+    "preferred_baudrate": 19200,
+    "registers": [
+      {
+        "begin": 10,
+        "length": 2,
+        "format": "integer",
+        "name": "POWER",
+        "keep": 1,
+        "max_interval": 60
+      }
+    ]
+  })"_json;
+  ModbusDevice dev(modbus, 0x32, regmap);
+  // The first read is a change, so the register is due again right away
+  EXPECT_EQ(transactionsPerPoll(dev), 1);
+  // Unchanged, so it backs off to a second
+  EXPECT_EQ(transactionsPerPoll(dev), 1);
+  std::this_thread::sleep_for(1s);
+  modbus.bus().setRegisters(0x32, 10, {0, 2});
+  EXPECT_EQ(transactionsPerPoll(dev), 1);
+  // The change brings it back to an interval of 0
+  EXPECT_EQ(transactionsPerPoll(dev), 1);
+  ModbusDeviceValueData data = dev.getValueData();
+  EXPECT_EQ(data.registerList[0].history[0].value.intValue, 2);
+}
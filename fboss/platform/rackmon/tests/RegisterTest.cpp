@@ -107,6 +107,31 @@ TEST(RegisterStoreTest, BasicOperation) {
   }
 }
 
+TEST(RegisterStoreTest, AdaptivePollInterval) {
+  RegisterDescriptor desc;
+  desc.length = 1;
+  desc.interval = 10;
+  desc.maxInterval = 35;
+  RegisterStore reg(desc);
+  EXPECT_TRUE(reg.isDue(0));
+
+  reg.scheduleNextPoll(100, true);
+  EXPECT_FALSE(reg.isDue(109));
+  EXPECT_TRUE(reg.isDue(110));
+  // Unchanged values back off up to maxInterval
+  reg.scheduleNextPoll(110, false);
+  EXPECT_FALSE(reg.isDue(129));
+  EXPECT_TRUE(reg.isDue(130));
+  reg.scheduleNextPoll(130, false);
+  EXPECT_TRUE(reg.isDue(165));
+  reg.scheduleNextPoll(165, false);
+  EXPECT_FALSE(reg.isDue(199));
+  EXPECT_TRUE(reg.isDue(200));
+  // A change goes back to interval
+  reg.scheduleNextPoll(200, true);
+  EXPECT_TRUE(reg.isDue(210));
+}
+
 TEST(RegisterStoreTest, DataRetrievalConversions) {
   RegisterDescriptor desc{
       0,
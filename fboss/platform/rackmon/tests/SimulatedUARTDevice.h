@@ -0,0 +1,133 @@
+// Copyright 2021-present Facebook. All Rights Reserved.
+#pragma once
+#include <algorithm>
+#include <map>
+#include <optional>
+#include "Modbus.h"
+#include "ModbusError.h"
+
+namespace rackmon {
+
+// A RS-485 bus with simulated Modbus devices on it. Devices answer read
+// holding registers requests from their register space, with an illegal
+// data address error if any register read is not part of it. Every
+// request written is counted as a bus transaction, so tests can check
+// how many a poll took.
+class SimulatedUARTDevice : public UARTDevice {
+  static constexpr uint8_t kReadHoldingRegisters = 0x3;
+  // addr -> {register -> value}
+  std::map<uint8_t, std::map<uint16_t, uint16_t>> registers_{};
+  std::vector<uint8_t> response_{};
+  size_t transactions_ = 0;
+  std::optional<ModbusErrorCode> nextError_{};
+
+  void makeError(uint8_t addr, uint8_t function, ModbusErrorCode code) {
+    Msg resp;
+    resp << addr << uint8_t(function | 0x80) << uint8_t(code);
+    Encoder::finalize(resp);
+    response_.assign(resp.begin(), resp.end());
+  }
+
+ protected:
+  void setAttribute(bool, int) override {}
+
+ public:
+  SimulatedUARTDevice() : UARTDevice("/dev/simulated", 19200) {}
+
+  void setRegisters(
+      uint8_t addr,
+      uint16_t begin,
+      const std::vector<uint16_t>& values) {
+    for (auto value : values) {
+      registers_[addr][begin++] = value;
+    }
+  }
+
+  // Answer the next request with code instead.
+  void failNext(ModbusErrorCode code) {
+    nextError_ = code;
+  }
+
+  size_t transactions() const {
+    return transactions_;
+  }
+
+  void open() override {}
+  void close() override {}
+
+  void write(const uint8_t* buf, size_t len) override {
+    transactions_++;
+    response_.clear();
+    Msg req;
+    std::copy(buf, buf + len, req.raw.begin());
+    req.len = len;
+    Encoder::decode(req);
+    auto dev = registers_.find(req.addr);
+    if (dev == registers_.end()) {
+      // Nobody answers.
+      return;
+    }
+    uint8_t function = req.raw[1];
+    if (nextError_) {
+      makeError(req.addr, function, *nextError_);
+      nextError_.reset();
+      return;
+    }
+    if (function != kReadHoldingRegisters) {
+      makeError(req.addr, function, ModbusErrorCode::ILLEGAL_FUNCTION);
+      return;
+    }
+    uint16_t begin = (req.raw[2] << 8) | req.raw[3];
+    uint16_t count = (req.raw[4] << 8) | req.raw[5];
+    Msg resp;
+    resp << req.addr << function << uint8_t(count * 2);
+    for (uint16_t reg = begin; reg < begin + count; reg++) {
+      auto it = dev->second.find(reg);
+      if (it == dev->second.end()) {
+        makeError(req.addr, function, ModbusErrorCode::ILLEGAL_DATA_ADDRESS);
+        return;
+      }
+      resp << it->second;
+    }
+    Encoder::finalize(resp);
+    response_.assign(resp.begin(), resp.end());
+  }
+
+  size_t read(uint8_t* buf, size_t exactLen, int /* timeoutMs */) override {
+    if (response_.empty()) {
+      throw TimeoutException();
+    }
+    size_t len = std::min(exactLen, response_.size());
+    std::copy(response_.begin(), response_.begin() + len, buf);
+    response_.clear();
+    return len;
+  }
+};
+
+// Modbus interface on a simulated bus.
+class SimulatedModbus : public Modbus {
+  SimulatedUARTDevice* device_ = nullptr;
+
+ public:
+  SimulatedModbus() : Modbus(std::cout) {
+    initialize(R"({
+      "device_path": "/dev/simulated",
+      "baudrate": 19200
+    })"_json);
+  }
+
+  std::unique_ptr<UARTDevice> makeDevice(
+      const std::string& /* deviceType */,
+      const std::string& /* devicePath */,
+      uint32_t /* baudrate */) override {
+    auto device = std::make_unique<SimulatedUARTDevice>();
+    device_ = device.get();
+    return device;
+  }
+
+  SimulatedUARTDevice& bus() {
+    return *device_;
+  }
+};
+
+} // namespace rackmon
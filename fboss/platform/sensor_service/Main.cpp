@@ -17,11 +17,6 @@ using namespace facebook::services;
 using namespace facebook::fboss::platform;
 using namespace facebook::fboss::platform::sensor_service;
 
-DEFINE_uint32(
-    sensor_fetch_interval,
-    5,
-    "The interval between each sensor data fetch");
-
 DEFINE_int32(
     stats_publish_interval,
     60,
@@ -43,14 +38,15 @@ int main(int argc, char** argv) {
 
   folly::FunctionScheduler scheduler;
 
-  // To fetch sensor data at define cadence
+  // To fetch sensor data at define cadence, each sensor is only read when
+  // its sampling interval is up
   auto sensorService = handler->getServiceImpl();
 
   SensorStatsPub publisher(handler->getServiceImpl());
 
   scheduler.addFunction(
       [sensorService]() { sensorService->fetchSensorData(); },
-      std::chrono::seconds(FLAGS_sensor_fetch_interval),
+      sensorService->getFetchInterval(),
       "fetchSensorData");
 
   scheduler.addFunction(
@@ -7,11 +7,17 @@
  *  of patent rights can be found in the PATENTS file in the same directory.
  *
  */
+#include <fcntl.h>
 #include <folly/FileUtil.h>
+#include <folly/String.h>
 #include <folly/dynamic.h>
 #include <folly/json.h>
+#include <folly/lang/Bits.h>
 #include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <algorithm>
+#include <array>
 
 #include "fboss/platform/helpers/Utils.h"
 #include "fboss/platform/sensor_service/GetSensorConfig.h"
@@ -28,7 +34,17 @@ const std::string kSensorFieldName = "name";
 const std::string kMockLmsensorJasonData =
     "/etc/sensor_service/sensors_output.json";
 const std::string kLmsensorCommand = "sensors -j";
+
+// Sysfs sensor attributes are a single short number
+constexpr size_t kMaxSysfsValueSize = 64;
 } // namespace
+
+DEFINE_uint32(
+    sensor_fetch_interval,
+    5,
+    "The interval (in seconds) between each sensor data fetch, for sensors "
+    "without a samplingIntervalMs in their config");
+
 namespace facebook::fboss::platform::sensor_service {
 using namespace facebook::fboss::platform::helpers;
 
@@ -43,7 +59,9 @@ void SensorServiceImpl::init() {
   }
 
   // Clear everything before init
+  sensors_.clear();
   sensorNameMap_.clear();
+  sensorPathMap_.clear();
   sensorTable_.sensorMapList_ref()->clear();
 
   // folly::dynamic sensorConf;
@@ -68,12 +86,38 @@ void SensorServiceImpl::init() {
         *sensorTable_.source_ref()));
   }
 
+  auto defaultInterval = std::chrono::milliseconds(
+      std::chrono::seconds(FLAGS_sensor_fetch_interval));
+  std::optional<std::chrono::milliseconds> minInterval;
   for (auto& sensor : *sensorTable_.sensorMapList_ref()) {
     for (auto& sensorIter : sensor.second) {
-      sensorNameMap_[*sensorIter.second.path_ref()] = sensorIter.first;
+      auto interval = defaultInterval;
+      if (auto samplingIntervalMs =
+              sensorIter.second.samplingIntervalMs_ref()) {
+        interval = std::chrono::milliseconds(*samplingIntervalMs);
+      }
+      if (interval.count() <= 0) {
+        throw std::runtime_error(
+            "Invalid sampling interval for sensor: " + sensorIter.first);
+      }
+      if (sensorNameMap_.count(sensorIter.first)) {
+        XLOG(WARN) << "Ignoring duplicate sensor " << sensorIter.first;
+        continue;
+      }
+      auto entry = std::make_unique<Sensor>();
+      entry->name = sensorIter.first;
+      entry->path = *sensorIter.second.path_ref();
+      entry->samplingInterval = interval;
+      sensorNameMap_[entry->name] = entry.get();
+      sensorPathMap_[entry->path].push_back(entry.get());
+      sensors_.push_back(std::move(entry));
+      minInterval = std::min(minInterval.value_or(interval), interval);
     }
   }
 
+  // Fetching at the shortest interval reads every sensor at most that late
+  fetchInterval_ = minInterval.value_or(defaultInterval);
+
   for (auto& pair : *sensorTable_.sensorMapList_ref()) {
     XLOG(INFO) << pair.first << ": ";
     for (auto& sensorPair : pair.second) {
@@ -82,114 +126,190 @@ void SensorServiceImpl::init() {
     }
   }
 
+  XLOG(INFO) << "Fetching sensor data every " << fetchInterval_.count()
+             << "ms";
   XLOG(INFO) << "-------------------";
 }
 
-std::optional<SensorData> SensorServiceImpl::getSensorData(
-    const std::string& sensorName) {
-  SensorData d;
-  d.name_ref() = "";
-
-  liveDataTable_.withRLock([&](auto& table) {
-    auto it = table.find(sensorName);
+void SensorServiceImpl::publish(
+    Sensor& sensor,
+    float value,
+    int64_t timeStamp) {
+  // Timestamps are in seconds, which fit in 32 bits until 2106
+  sensor.liveData.store(
+      (uint64_t(folly::bit_cast<uint32_t>(value)) << 32) | uint32_t(timeStamp),
+      std::memory_order_release);
+}
 
-    if (it != table.end()) {
-      d.name_ref() = it->first;
-      d.value_ref() = it->second.value;
-      d.timeStamp_ref() = it->second.timeStamp;
-    }
-  });
+std::optional<SensorData> SensorServiceImpl::getLiveData(
+    const Sensor& sensor) {
+  auto liveData = sensor.liveData.load(std::memory_order_acquire);
+  if (liveData == 0) {
+    return std::nullopt;
+  }
+  SensorData d;
+  d.name_ref() = sensor.name;
+  d.value_ref() = folly::bit_cast<float>(uint32_t(liveData >> 32));
+  d.timeStamp_ref() = int64_t(uint32_t(liveData));
+  return d;
+}
 
-  return *d.name_ref() == "" ? std::nullopt : std::optional<SensorData>{d};
+std::optional<SensorData> SensorServiceImpl::getSensorData(
+    const std::string& sensorName) {
+  auto it = sensorNameMap_.find(sensorName);
+  if (it == sensorNameMap_.end()) {
+    return std::nullopt;
+  }
+  return getLiveData(*it->second);
 }
 
 std::vector<SensorData> SensorServiceImpl::getSensorsData(
     const std::vector<std::string>& sensorNames) {
   std::vector<SensorData> sensorDataVec;
 
-  liveDataTable_.withRLock([&](auto& table) {
-    for (auto& pair : table) {
-      if (std::find(sensorNames.begin(), sensorNames.end(), pair.first) !=
-          sensorNames.end()) {
-        SensorData d;
-        d.name_ref() = pair.first;
-        d.value_ref() = pair.second.value;
-        d.timeStamp_ref() = pair.second.timeStamp;
-        sensorDataVec.push_back(d);
-      }
+  for (const auto& sensorName : sensorNames) {
+    if (auto d = getSensorData(sensorName)) {
+      sensorDataVec.push_back(std::move(*d));
     }
-  });
+  }
   return sensorDataVec;
 }
 
 std::vector<SensorData> SensorServiceImpl::getAllSensorData() {
   std::vector<SensorData> sensorDataVec;
 
-  liveDataTable_.withRLock([&](auto& table) {
-    for (auto& pair : table) {
-      SensorData d;
-      d.name_ref() = pair.first;
-      d.value_ref() = pair.second.value;
-      d.timeStamp_ref() = pair.second.timeStamp;
-      sensorDataVec.push_back(d);
+  for (const auto& sensor : sensors_) {
+    if (auto d = getLiveData(*sensor)) {
+      sensorDataVec.push_back(std::move(*d));
     }
-  });
+  }
   return sensorDataVec;
 }
 
-void SensorServiceImpl::fetchSensorData() {
-  if (sensorSource_ == SensorSource::LMSENSOR) {
-    int retVal = 0;
-    std::string ret = execCommandUnchecked(kLmsensorCommand, retVal);
+bool SensorServiceImpl::isDue(
+    const Sensor& sensor,
+    std::chrono::steady_clock::time_point now) const {
+  // Fetches may run a little early, read a sensor now if it is due closer to
+  // now than to the next fetch
+  return sensor.nextDue <= now + fetchInterval_ / 2;
+}
+
+void SensorServiceImpl::scheduleNext(
+    Sensor& sensor,
+    std::chrono::steady_clock::time_point now) {
+  // Stay on schedule, unless fetches fell behind by a whole interval
+  sensor.nextDue += sensor.samplingInterval;
+  if (sensor.nextDue <= now) {
+    sensor.nextDue = now + sensor.samplingInterval;
+  }
+}
+
+void SensorServiceImpl::fetchSensorData(bool allSensors) {
+  auto start = std::chrono::steady_clock::now();
+  auto now = now_();
+  SensorFetchStats stats;
 
-    if (retVal != 0) {
-      throw std::runtime_error("Run " + kLmsensorCommand + " failed!");
+  std::vector<Sensor*> dueSensors;
+  for (auto& sensor : sensors_) {
+    if (allSensors || isDue(*sensor, now)) {
+      dueSensors.push_back(sensor.get());
+      scheduleNext(*sensor, now);
     }
+  }
+
+  // The sensors command and mock data report every sensor at once, so run
+  // them whenever any sensor is due
+  bool anyDue = !dueSensors.empty();
 
-    parseSensorJsonData(ret);
+  if (sensorSource_ == SensorSource::LMSENSOR) {
+    if (anyDue) {
+      int retVal = 0;
+      std::string ret = execCommandUnchecked(kLmsensorCommand, retVal);
+
+      if (retVal != 0) {
+        throw std::runtime_error("Run " + kLmsensorCommand + " failed!");
+      }
 
+      parseSensorJsonData(ret, stats);
+    }
   } else if (sensorSource_ == SensorSource::SYSFS) {
-    // ToDo
-    // Get sensor value via read from path (key of sensorTable_)
-    getSensorDataFromPath();
+    getSensorDataFromPath(dueSensors, stats);
   } else if (sensorSource_ == SensorSource::MOCK) {
-    std::string sensorDataJson;
-    if (folly::readFile(kMockLmsensorJasonData.c_str(), sensorDataJson)) {
-      parseSensorJsonData(sensorDataJson);
-    } else {
-      throw std::runtime_error(
-          "Can not find sensor data json file: " + kMockLmsensorJasonData);
+    if (anyDue) {
+      std::string sensorDataJson;
+      if (folly::readFile(kMockLmsensorJasonData.c_str(), sensorDataJson)) {
+        parseSensorJsonData(sensorDataJson, stats);
+      } else {
+        throw std::runtime_error(
+            "Can not find sensor data json file: " + kMockLmsensorJasonData);
+      }
     }
   } else {
     throw std::runtime_error(
         "Unknow Sensor Source selected : " +
         folly::to<std::string>(static_cast<int>(sensorSource_)));
   }
+
+  stats.duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  XLOG(DBG2) << "Read " << stats.sensorsRead << " sensors with "
+             << stats.syscalls << " syscalls in " << stats.duration.count()
+             << "us";
+  *lastFetchStats_.wlock() = stats;
 }
 
-void SensorServiceImpl::getSensorDataFromPath() {
-  auto dataTable = liveDataTable_.wlock();
+std::optional<float> SensorServiceImpl::readSensorFile(
+    Sensor& sensor,
+    SensorFetchStats& stats) {
+  if (!sensor.file) {
+    stats.syscalls++;
+    int fd = folly::openNoInt(sensor.path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return std::nullopt;
+    }
+    sensor.file = folly::File(fd, true /* ownsFd */);
+  }
 
+  // Reading a sysfs attribute from offset 0 regenerates its value, so the
+  // file stays open across reads
+  std::array<char, kMaxSysfsValueSize> buf;
+  stats.syscalls++;
+  auto len = folly::preadNoInt(sensor.file.fd(), buf.data(), buf.size(), 0);
+  if (len <= 0) {
+    // The device may be gone, reopen the path on the next read
+    sensor.file = folly::File();
+    return std::nullopt;
+  }
+  auto value = folly::tryTo<float>(
+      folly::trimWhitespace(folly::StringPiece(buf.data(), len)));
+  if (value.hasError()) {
+    return std::nullopt;
+  }
+  return *value;
+}
+
+void SensorServiceImpl::getSensorDataFromPath(
+    const std::vector<Sensor*>& dueSensors,
+    SensorFetchStats& stats) {
   auto now = helpers::nowInSecs();
-  for (const auto& [path, name] : sensorNameMap_) {
-    std::string sensorInput;
-
-    if (folly::readFile(path.c_str(), sensorInput)) {
-      (*dataTable)[name].value = folly::to<float>(sensorInput);
-      (*dataTable)[name].timeStamp = now;
-      XLOG(INFO) << name << "(" << path << ")"
-                 << " : " << (*dataTable)[name].value;
+  for (auto sensor : dueSensors) {
+    stats.sensorsRead++;
+    if (auto value = readSensorFile(*sensor, stats)) {
+      publish(*sensor, *value, now);
+      XLOG(DBG1) << sensor->name << "(" << sensor->path << ")"
+                 << " : " << *value;
     } else {
-      XLOG(INFO) << "Can not read data for " << name << " from " << path;
+      XLOG(INFO) << "Can not read data for " << sensor->name << " from "
+                 << sensor->path;
     }
   }
 }
 
-void SensorServiceImpl::parseSensorJsonData(const std::string& strJson) {
+void SensorServiceImpl::parseSensorJsonData(
+    const std::string& strJson,
+    SensorFetchStats& stats) {
   folly::dynamic sensorJson = folly::parseJson(strJson);
 
-  auto dataTable = liveDataTable_.wlock();
-
   auto now = helpers::nowInSecs();
   for (auto& firstPair : sensorJson.items()) {
     // Key is pair.first, value is pair.second
@@ -198,20 +318,19 @@ void SensorServiceImpl::parseSensorJsonData(const std::string& strJson) {
         std::string sensorPath = folly::to<std::string>(
             firstPair.first.asString(), ":", secondPair.first.asString());
         // Only check sensor data that the name is in the configuration file
-        if (secondPair.second.isObject() &&
-            (sensorNameMap_.count(sensorPath) != 0)) {
+        auto it = sensorPathMap_.find(sensorPath);
+        if (secondPair.second.isObject() && it != sensorPathMap_.end()) {
           // Get value only for now
           for (auto& thirdPair : secondPair.second.items()) {
             if (thirdPair.first.asString().find("_input") !=
                 std::string::npos) {
-              (*dataTable)[sensorNameMap_[sensorPath]].value =
-                  folly::to<float>(thirdPair.second.asString());
-              (*dataTable)[sensorNameMap_[sensorPath]].timeStamp = now;
-
-              XLOG(INFO) << sensorNameMap_[sensorPath] << " : "
-                         << (*dataTable)[sensorNameMap_[sensorPath]].value
-                         << " >>>> "
-                         << (*dataTable)[sensorNameMap_[sensorPath]].timeStamp;
+              auto value = folly::to<float>(thirdPair.second.asString());
+              for (auto sensor : it->second) {
+                stats.sensorsRead++;
+                publish(*sensor, value, now);
+                XLOG(DBG1) << sensor->name << " : " << value << " >>>> "
+                           << now;
+              }
             }
           }
         }
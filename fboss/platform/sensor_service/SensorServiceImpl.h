@@ -10,11 +10,17 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include "fboss/platform/sensor_service/if/gen-cpp2/sensor_config_types.h"
 #include "fboss/platform/sensor_service/if/gen-cpp2/sensor_service_types.h"
+#include "folly/File.h"
 #include "folly/Synchronized.h"
 
 namespace facebook::fboss::platform::sensor_service {
@@ -36,18 +42,25 @@ enum class SensorType {
   UNKNOWN,
 };
 
-struct SensorLiveData {
-  float value;
-  int64_t timeStamp;
+// What a single fetchSensorData() call cost
+struct SensorFetchStats {
+  uint32_t sensorsRead{0};
+  uint32_t syscalls{0};
+  std::chrono::microseconds duration{0};
 };
 
 class SensorServiceImpl {
  public:
+  // Source of the time sensors are scheduled by, replaced by tests
+  using NowFn = std::function<std::chrono::steady_clock::time_point()>;
+
   SensorServiceImpl() {
     init();
   }
-  explicit SensorServiceImpl(const std::string& confFileName)
-      : confFileName_{confFileName} {
+  explicit SensorServiceImpl(
+      const std::string& confFileName,
+      NowFn now = &std::chrono::steady_clock::now)
+      : confFileName_{confFileName}, now_(std::move(now)) {
     init();
   }
 
@@ -55,9 +68,34 @@ class SensorServiceImpl {
   std::vector<SensorData> getSensorsData(
       const std::vector<std::string>& sensorNames);
   std::vector<SensorData> getAllSensorData();
-  void fetchSensorData();
+  /*
+   * Samples the sensors whose sampling interval is up, or every sensor if
+   * allSensors is set. Meant to be called every getFetchInterval().
+   */
+  void fetchSensorData(bool allSensors = false);
+
+  // Shortest sampling interval of all sensors
+  std::chrono::milliseconds getFetchInterval() const {
+    return fetchInterval_;
+  }
+  SensorFetchStats getLastFetchStats() const {
+    return *lastFetchStats_.rlock();
+  }
 
  private:
+  struct Sensor {
+    std::string name;
+    std::string path;
+    std::chrono::milliseconds samplingInterval{0};
+    // Sampled by the first fetchSensorData() call at or after this time
+    std::chrono::steady_clock::time_point nextDue;
+    // Kept open for sysfs sensors, which are reread from offset 0
+    folly::File file;
+    // Last reading, value bits and timestamp packed into one word so that
+    // thrift reads never wait on a fetch. Zero until the first reading.
+    std::atomic<uint64_t> liveData{0};
+  };
+
   // Sensor config file full path
   std::string confFileName_{};
 
@@ -65,16 +103,30 @@ class SensorServiceImpl {
 
   SensorConfig sensorTable_;
 
-  // Sensor Name map, sensor path -> sensor name
-  std::unordered_map<std::string, std::string> sensorNameMap_;
+  // All configured sensors, only their live data changes after init()
+  std::vector<std::unique_ptr<Sensor>> sensors_;
+  // Sensor name -> sensor
+  std::unordered_map<std::string, Sensor*> sensorNameMap_;
+  // Sensor path -> sensors sharing it
+  std::unordered_map<std::string, std::vector<Sensor*>> sensorPathMap_;
 
-  // Live sensor data table, sensor name -> sensor live data
-  folly::Synchronized<std::unordered_map<std::string, struct SensorLiveData>>
-      liveDataTable_;
+  NowFn now_{&std::chrono::steady_clock::now};
+  std::chrono::milliseconds fetchInterval_{0};
+  folly::Synchronized<SensorFetchStats> lastFetchStats_;
 
   void init();
-  void parseSensorJsonData(const std::string&);
-  void getSensorDataFromPath();
+  void parseSensorJsonData(const std::string&, SensorFetchStats& stats);
+  void getSensorDataFromPath(
+      const std::vector<Sensor*>& dueSensors,
+      SensorFetchStats& stats);
+  std::optional<float> readSensorFile(Sensor& sensor, SensorFetchStats& stats);
+  bool isDue(const Sensor& sensor, std::chrono::steady_clock::time_point now)
+      const;
+  static void scheduleNext(
+      Sensor& sensor,
+      std::chrono::steady_clock::time_point now);
+  static void publish(Sensor& sensor, float value, int64_t timeStamp);
+  static std::optional<SensorData> getLiveData(const Sensor& sensor);
 };
 
 } // namespace facebook::fboss::platform::sensor_service
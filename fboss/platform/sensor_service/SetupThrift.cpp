@@ -34,7 +34,7 @@ setupThrift() {
       std::make_shared<SensorServiceImpl>(FLAGS_config_path);
 
   // Fetch sensor data once to warmup
-  sensorService->fetchSensorData();
+  sensorService->fetchSensorData(true /* allSensors */);
 
   return helpers::setupThrift<SensorServiceThriftHandler>(
       sensorService, FLAGS_thrift_port);
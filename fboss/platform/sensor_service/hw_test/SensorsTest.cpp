@@ -68,8 +68,8 @@ TEST_F(SensorsTest, getSomeSensors) {
   EXPECT_EQ(response1.sensorData_ref()->size(), 1);
   // Burn a second
   std::this_thread::sleep_for(std::chrono::seconds(1));
-  // Refresh sensors
-  getService()->fetchSensorData();
+  // Refresh sensors, their sampling intervals aren't up yet
+  getService()->fetchSensorData(true /* allSensors */);
   auto response2 = getSensors({"PCH_TEMP"});
   EXPECT_EQ(response2.sensorData_ref()->size(), 1);
   // Response2 sensor collection time stamp should be later
@@ -17,6 +17,8 @@ struct Sensor {
   5: string compute;
   /* unit for sensor value, e.g. V, A, RPM, etc. */
   6: string unit;
+  /* How often to sample the sensor, defaults to --sensor_fetch_interval */
+  7: optional i32 samplingIntervalMs;
 }
 
 /* Name -> sensor map, the name will be in this format: "SUB_FRU_1:SUB_FRU_2:...:SUB_FRU_N:SENSOR_NAME" */
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2004-present, Meta Platforms, Inc. and affiliates.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <boost/filesystem.hpp>
+#include <folly/FileUtil.h>
+#include <folly/dynamic.h>
+#include <folly/experimental/TestUtil.h>
+#include <folly/json.h>
+
+#include "fboss/platform/sensor_service/SensorServiceImpl.h"
+
+namespace facebook::fboss::platform::sensor_service {
+
+/*
+ * Sysfs sensor attributes in a temporary directory, on tmpfs when there is
+ * one, and a sysfs sensor config pointing at them.
+ */
+class FakeSysfs {
+ public:
+  FakeSysfs()
+      : dir_(
+            "fake_sysfs",
+            boost::filesystem::exists("/dev/shm") ? "/dev/shm" : "") {}
+
+  void addSensor(
+      const std::string& name,
+      int value,
+      std::optional<int> samplingIntervalMs = std::nullopt) {
+    folly::dynamic sensor = folly::dynamic::object("path", pathOf(name));
+    if (samplingIntervalMs) {
+      sensor["samplingIntervalMs"] = *samplingIntervalMs;
+    }
+    sensors_[name] = std::move(sensor);
+    setValue(name, value);
+  }
+
+  // Rewrites the attribute in place, as the kernel would
+  void setValue(const std::string& name, int value) {
+    folly::writeFile(folly::to<std::string>(value, "\n"), pathOf(name).c_str());
+  }
+
+  void remove(const std::string& name) {
+    boost::filesystem::remove(pathOf(name));
+  }
+
+  std::unique_ptr<SensorServiceImpl> makeService(
+      SensorServiceImpl::NowFn now = &std::chrono::steady_clock::now) {
+    auto confFileName = (dir_.path() / "sensor_config.json").string();
+    folly::dynamic config = folly::dynamic::object("source", "sysfs")(
+        "sensorMapList", folly::dynamic::object("FAKE", sensors_));
+    folly::writeFile(folly::toJson(config), confFileName.c_str());
+    return std::make_unique<SensorServiceImpl>(confFileName, std::move(now));
+  }
+
+  std::string pathOf(const std::string& name) const {
+    return (dir_.path() / name).string();
+  }
+
+ private:
+  folly::test::TemporaryDirectory dir_;
+  folly::dynamic sensors_ = folly::dynamic::object;
+};
+
+} // namespace facebook::fboss::platform::sensor_service
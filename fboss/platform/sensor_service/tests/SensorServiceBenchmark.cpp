@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2004-present, Meta Platforms, Inc. and affiliates.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <folly/FileUtil.h>
+#include <folly/init/Init.h>
+
+#include "fboss/platform/sensor_service/tests/FakeSysfs.h"
+
+/*
+ * A fetch cycle over a fake sysfs with every sensor due. The per file
+ * variant opens, reads and closes each attribute, as sysfs sensors used to
+ * be fetched.
+ */
+
+using namespace facebook::fboss::platform::sensor_service;
+
+namespace {
+
+constexpr int kNumSensors = 256;
+
+std::vector<std::string> addSensors(FakeSysfs& sysfs) {
+  std::vector<std::string> names;
+  for (int i = 0; i < kNumSensors; i++) {
+    names.push_back(folly::to<std::string>("SENSOR_", i));
+    sysfs.addSensor(names.back(), i * 1000);
+  }
+  return names;
+}
+
+} // namespace
+
+BENCHMARK(FetchReadFile256Sensors, iters) {
+  folly::BenchmarkSuspender suspender;
+  FakeSysfs sysfs;
+  auto names = addSensors(sysfs);
+  std::vector<std::string> paths;
+  for (const auto& name : names) {
+    paths.push_back(sysfs.pathOf(name));
+  }
+  suspender.dismiss();
+
+  for (unsigned int i = 0; i < iters; ++i) {
+    for (const auto& path : paths) {
+      std::string sensorInput;
+      folly::readFile(path.c_str(), sensorInput);
+      folly::doNotOptimizeAway(folly::to<float>(sensorInput));
+    }
+  }
+}
+
+BENCHMARK_RELATIVE(FetchPread256Sensors, iters) {
+  folly::BenchmarkSuspender suspender;
+  FakeSysfs sysfs;
+  addSensors(sysfs);
+  auto service = sysfs.makeService();
+  // Opens every file
+  service->fetchSensorData(true /* allSensors */);
+  suspender.dismiss();
+
+  for (unsigned int i = 0; i < iters; ++i) {
+    service->fetchSensorData(true /* allSensors */);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
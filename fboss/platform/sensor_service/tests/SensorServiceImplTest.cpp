@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2004-present, Meta Platforms, Inc. and affiliates.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/platform/sensor_service/tests/FakeSysfs.h"
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+DECLARE_uint32(sensor_fetch_interval);
+
+using namespace facebook::fboss::platform::sensor_service;
+
+class SensorServiceImplTest : public ::testing::Test {
+ protected:
+  gflags::FlagSaver flagSaver_;
+  FakeSysfs sysfs_;
+};
+
+TEST_F(SensorServiceImplTest, readSysfsSensors) {
+  sysfs_.addSensor("CPU_TEMP", 45000);
+  sysfs_.addSensor("FAN1_RPM", 9000);
+  auto service = sysfs_.makeService();
+
+  service->fetchSensorData();
+  auto cpuTemp = service->getSensorData("CPU_TEMP");
+  ASSERT_TRUE(cpuTemp.has_value());
+  EXPECT_EQ(*cpuTemp->value_ref(), 45000);
+  EXPECT_GT(*cpuTemp->timeStamp_ref(), 0);
+  EXPECT_EQ(service->getAllSensorData().size(), 2);
+  EXPECT_FALSE(service->getSensorData("bogusSensor_foo").has_value());
+
+  auto sensors = service->getSensorsData({"FAN1_RPM", "bogusSensor_foo"});
+  ASSERT_EQ(sensors.size(), 1);
+  EXPECT_EQ(*sensors[0].name_ref(), "FAN1_RPM");
+  EXPECT_EQ(*sensors[0].value_ref(), 9000);
+
+  // Files stay open, new values are read back from the same fd
+  sysfs_.setValue("CPU_TEMP", 47000);
+  service->fetchSensorData(true /* allSensors */);
+  EXPECT_EQ(*service->getSensorData("CPU_TEMP")->value_ref(), 47000);
+}
+
+TEST_F(SensorServiceImplTest, syscallsPerCycle) {
+  constexpr int kNumSensors = 64;
+  for (int i = 0; i < kNumSensors; i++) {
+    sysfs_.addSensor(folly::to<std::string>("SENSOR_", i), i * 1000);
+  }
+  auto service = sysfs_.makeService();
+
+  // Open and read each file once, then only read them
+  service->fetchSensorData();
+  auto stats = service->getLastFetchStats();
+  EXPECT_EQ(stats.sensorsRead, kNumSensors);
+  EXPECT_EQ(stats.syscalls, 2 * kNumSensors);
+
+  service->fetchSensorData(true /* allSensors */);
+  stats = service->getLastFetchStats();
+  EXPECT_EQ(stats.sensorsRead, kNumSensors);
+  EXPECT_EQ(stats.syscalls, kNumSensors);
+}
+
+TEST_F(SensorServiceImplTest, perSensorSamplingInterval) {
+  FLAGS_sensor_fetch_interval = 5;
+  sysfs_.addSensor("FAST", 1, 1000);
+  sysfs_.addSensor("SLOW", 1, 3000);
+  sysfs_.addSensor("DEFAULT", 1);
+  std::chrono::steady_clock::time_point now;
+  auto service = sysfs_.makeService([&now]() { return now; });
+  EXPECT_EQ(service->getFetchInterval(), std::chrono::milliseconds(1000));
+
+  auto fetch = [&]() {
+    service->fetchSensorData();
+    return service->getLastFetchStats().sensorsRead;
+  };
+
+  std::vector<uint32_t> sensorsRead;
+  for (int i = 0; i < 6; i++) {
+    sensorsRead.push_back(fetch());
+    now += std::chrono::seconds(1);
+  }
+  EXPECT_EQ(sensorsRead, std::vector<uint32_t>({3, 1, 1, 2, 1, 2}));
+
+  // Sensors are read by time, not by how often fetches run
+  sysfs_.setValue("FAST", 2);
+  sysfs_.setValue("SLOW", 2);
+  EXPECT_EQ(fetch(), 2);
+  EXPECT_EQ(*service->getSensorData("FAST")->value_ref(), 2);
+  EXPECT_EQ(*service->getSensorData("SLOW")->value_ref(), 2);
+  EXPECT_EQ(fetch(), 0);
+
+  // A slightly early fetch still reads the sensors due
+  now += std::chrono::milliseconds(900);
+  EXPECT_EQ(fetch(), 1);
+
+  // After a stall every sensor is read once, then the schedule restarts
+  now += std::chrono::seconds(100);
+  EXPECT_EQ(fetch(), 3);
+  now += std::chrono::seconds(1);
+  EXPECT_EQ(fetch(), 1);
+
+  // Forced fetches read everything
+  service->fetchSensorData(true /* allSensors */);
+  EXPECT_EQ(service->getLastFetchStats().sensorsRead, 3);
+}
+
+TEST_F(SensorServiceImplTest, missingSensor) {
+  sysfs_.addSensor("PRESENT", 1);
+  sysfs_.addSensor("ABSENT", 1);
+  sysfs_.remove("ABSENT");
+  auto service = sysfs_.makeService();
+
+  service->fetchSensorData();
+  EXPECT_TRUE(service->getSensorData("PRESENT").has_value());
+  EXPECT_FALSE(service->getSensorData("ABSENT").has_value());
+  EXPECT_EQ(service->getAllSensorData().size(), 1);
+
+  // Picked up once it shows up
+  sysfs_.setValue("ABSENT", 2);
+  service->fetchSensorData(true /* allSensors */);
+  EXPECT_EQ(*service->getSensorData("ABSENT")->value_ref(), 2);
+}